@@ -0,0 +1,179 @@
+#ifndef HARDCHESS_CORE_ATTACKTABLES_H
+#define HARDCHESS_CORE_ATTACKTABLES_H
+
+#include "HardChess/Core/CommonTypes.h"
+#include <array>
+#include <cstdint>
+
+namespace HardChess {
+
+    // Static geometry of the 8x8 board, generated at compile time. Squares use the
+    // board numbering (row * 8 + col, 0 = a8); masks have bit n set for square n.
+    // Everything here is constexpr data in the read-only segment, so adding a table
+    // costs nothing at startup.
+    namespace AttackTables {
+
+        using SquareMask = std::uint64_t;
+
+        // Destination squares of one leaper or one slider ray, nearest first
+        struct SquareList {
+            std::uint8_t count;
+            std::uint8_t squares[8];
+        };
+
+        // Ray directions: the four straight ones first, then the four diagonals
+        constexpr int DIRECTIONS[8][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+        constexpr int STRAIGHT_DIRECTIONS = 4;
+
+        namespace Detail {
+            constexpr int KNIGHT_STEPS[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+
+            constexpr bool onBoard(int row, int col) { return row >= 0 && row < 8 && col >= 0 && col < 8; }
+
+            constexpr int popCount(SquareMask mask) {
+                int count = 0;
+                for (; mask; mask &= mask - 1) ++count;
+                return count;
+            }
+
+            constexpr std::array<SquareList, 64> leaperTargets(const int (&steps)[8][2]) {
+                std::array<SquareList, 64> table{};
+                for (int square = 0; square < 64; ++square) {
+                    SquareList& list = table[square];
+                    for (const auto& step : steps) {
+                        int row = square / 8 + step[0];
+                        int col = square % 8 + step[1];
+                        if (onBoard(row, col)) list.squares[list.count++] = static_cast<std::uint8_t>(row * 8 + col);
+                    }
+                }
+                return table;
+            }
+
+            constexpr std::array<SquareMask, 64> toMasks(const std::array<SquareList, 64>& lists) {
+                std::array<SquareMask, 64> masks{};
+                for (int square = 0; square < 64; ++square) {
+                    for (int i = 0; i < lists[square].count; ++i) masks[square] |= SquareMask(1) << lists[square].squares[i];
+                }
+                return masks;
+            }
+
+            constexpr std::array<std::array<SquareList, 8>, 64> rays() {
+                std::array<std::array<SquareList, 8>, 64> table{};
+                for (int square = 0; square < 64; ++square) {
+                    for (int d = 0; d < 8; ++d) {
+                        SquareList& ray = table[square][d];
+                        int row = square / 8 + DIRECTIONS[d][0];
+                        int col = square % 8 + DIRECTIONS[d][1];
+                        for (; onBoard(row, col); row += DIRECTIONS[d][0], col += DIRECTIONS[d][1]) {
+                            ray.squares[ray.count++] = static_cast<std::uint8_t>(row * 8 + col);
+                        }
+                    }
+                }
+                return table;
+            }
+
+            // Direction index from a to b, or -1 if the squares do not share a line
+            constexpr int direction(int a, int b) {
+                int dr = b / 8 - a / 8;
+                int dc = b % 8 - a % 8;
+                if (a == b || (dr != 0 && dc != 0 && dr != dc && dr != -dc)) return -1;
+                int sr = dr > 0 ? 1 : (dr < 0 ? -1 : 0);
+                int sc = dc > 0 ? 1 : (dc < 0 ? -1 : 0);
+                for (int d = 0; d < 8; ++d) {
+                    if (DIRECTIONS[d][0] == sr && DIRECTIONS[d][1] == sc) return d;
+                }
+                return -1;
+            }
+
+            constexpr std::array<std::array<SquareMask, 64>, 64> between() {
+                std::array<std::array<SquareMask, 64>, 64> table{};
+                for (int a = 0; a < 64; ++a) {
+                    for (int b = 0; b < 64; ++b) {
+                        int d = direction(a, b);
+                        if (d < 0) continue;
+                        for (int row = a / 8 + DIRECTIONS[d][0], col = a % 8 + DIRECTIONS[d][1]; row * 8 + col != b;
+                             row += DIRECTIONS[d][0], col += DIRECTIONS[d][1]) {
+                            table[a][b] |= SquareMask(1) << (row * 8 + col);
+                        }
+                    }
+                }
+                return table;
+            }
+
+            constexpr std::array<std::array<SquareMask, 64>, 64> lines() {
+                std::array<std::array<SquareMask, 64>, 64> table{};
+                for (int a = 0; a < 64; ++a) {
+                    for (int b = 0; b < 64; ++b) {
+                        int d = direction(a, b);
+                        if (d < 0) continue;
+                        SquareMask line = SquareMask(1) << a;
+                        for (int sign = -1; sign <= 1; sign += 2) {
+                            int row = a / 8 + sign * DIRECTIONS[d][0];
+                            int col = a % 8 + sign * DIRECTIONS[d][1];
+                            for (; onBoard(row, col); row += sign * DIRECTIONS[d][0], col += sign * DIRECTIONS[d][1]) {
+                                line |= SquareMask(1) << (row * 8 + col);
+                            }
+                        }
+                        table[a][b] = line;
+                    }
+                }
+                return table;
+            }
+        } // namespace Detail
+
+        inline constexpr std::array<SquareList, 64> KNIGHT_TARGETS = Detail::leaperTargets(Detail::KNIGHT_STEPS);
+        inline constexpr std::array<SquareList, 64> KING_TARGETS = Detail::leaperTargets(DIRECTIONS);
+        inline constexpr std::array<SquareMask, 64> KNIGHT_ATTACKS = Detail::toMasks(KNIGHT_TARGETS);
+        inline constexpr std::array<SquareMask, 64> KING_ATTACKS = Detail::toMasks(KING_TARGETS);
+        inline constexpr std::array<std::array<SquareList, 8>, 64> RAYS = Detail::rays(); // [square][direction]
+        // Squares strictly between two aligned squares; 0 if they are not on one line
+        inline constexpr std::array<std::array<SquareMask, 64>, 64> BETWEEN = Detail::between();
+        // The whole rank, file or diagonal through two aligned squares; 0 otherwise
+        inline constexpr std::array<std::array<SquareMask, 64>, 64> LINE = Detail::lines();
+
+        constexpr SquareMask squareMask(int square) { return SquareMask(1) << square; }
+        inline int squareOf(Position pos) { return pos.row * 8 + pos.col; }
+        inline bool contains(SquareMask mask, Position pos) { return mask & squareMask(squareOf(pos)); }
+
+        // Both squares on one rank or file (straight) or one diagonal
+        constexpr bool isStraight(int from, int to) { return from != to && (from / 8 == to / 8 || from % 8 == to % 8); }
+        constexpr bool isDiagonal(int from, int to) { return LINE[from][to] != 0 && !isStraight(from, to); }
+
+        // Known counts on an empty board: 336 knight moves, 420 king moves, and 896
+        // straight and 560 diagonal (from, to) pairs
+        static_assert(KNIGHT_TARGETS[0].count == 2 && KNIGHT_TARGETS[27].count == 8, "knight targets");
+        static_assert(KING_TARGETS[0].count == 3 && KING_TARGETS[27].count == 8, "king targets");
+        static_assert(KNIGHT_ATTACKS[0] == (squareMask(10) | squareMask(17)), "knight from a8 reaches c7 and b6");
+        static_assert(KING_ATTACKS[63] == (squareMask(54) | squareMask(55) | squareMask(62)), "king from h1");
+        static_assert(RAYS[0][1].count == 7 && RAYS[0][7].count == 7 && RAYS[0][0].count == 0, "rays from a8");
+        static_assert(RAYS[36][4].squares[0] == 27 && RAYS[36][4].count == 4, "ray e4 towards a8");
+        static_assert(Detail::popCount(BETWEEN[0][63]) == 6 && BETWEEN[0][63] == BETWEEN[63][0], "between a8 h1");
+        static_assert(BETWEEN[0][1] == 0 && BETWEEN[0][17] == 0 && BETWEEN[5][5] == 0, "between adjacent or unaligned");
+        static_assert(BETWEEN[56][58] == squareMask(57), "between a1 c1");
+        static_assert(Detail::popCount(LINE[0][9]) == 8 && LINE[0][9] == LINE[63][54], "long diagonal");
+        static_assert(LINE[7][0] == 0xFF && LINE[0][56] == 0x0101010101010101ULL, "rank 8 and a-file");
+        static_assert(LINE[0][17] == 0, "knight-distance squares share no line");
+
+        namespace Detail {
+            constexpr bool checkTotals() {
+                int knight = 0, king = 0, straight = 0, diagonal = 0;
+                for (int a = 0; a < 64; ++a) {
+                    knight += popCount(KNIGHT_ATTACKS[a]);
+                    king += popCount(KING_ATTACKS[a]);
+                    for (int b = 0; b < 64; ++b) {
+                        if (isStraight(a, b)) ++straight;
+                        else if (LINE[a][b]) ++diagonal;
+                        // Between squares always lie on the line, excluding the endpoints
+                        if ((BETWEEN[a][b] & ~LINE[a][b]) || (BETWEEN[a][b] & (squareMask(a) | squareMask(b)))) return false;
+                    }
+                }
+                return knight == 336 && king == 420 && straight == 896 && diagonal == 560;
+            }
+        } // namespace Detail
+        static_assert(Detail::checkTotals(), "attack table totals");
+
+    } // namespace AttackTables
+
+} // namespace HardChess
+
+#endif // HARDCHESS_CORE_ATTACKTABLES_H
@@ -3,19 +3,78 @@
 
 #include "HardChess/Core/CommonTypes.h"
 #include "HardChess/Core/Piece.h" // For Piece, not just forward declaration
+#include "HardChess/Core/Move.h"
+#include "HardChess/Core/AttackTables.h"
+#include "HardChess/Core/Zobrist.h"
+#include <cstdint>
 #include <vector>
 #include <memory> // For std::unique_ptr
+#include <string>
+#include <string_view>
+#include <cstddef>
 
 // Forward declare specific piece types to avoid full includes here if only creating them
 namespace HardChess {
     class Pawn; class Rook; class Knight; class Bishop; class Queen; class King;
 
+    // Squares (row * 8 + col) holding one color's pieces of one type, in no particular
+    // order. A legal position has at most 16 pieces per color, so lists never fill up.
+    struct PieceList {
+        static constexpr int CAPACITY = 16;
+        std::uint8_t count = 0;
+        std::uint8_t squares[CAPACITY] = {};
+
+        const std::uint8_t* begin() const { return squares; }
+        const std::uint8_t* end() const { return squares + count; }
+    };
+
     class Board {
       private:
-        std::vector<std::vector<std::unique_ptr<Piece>>> grid;
+        std::unique_ptr<Piece> grid[8][8];
         Position whiteKingPos;
         Position blackKingPos;
 
+        // Kept in step with grid by every method that places, removes or moves a piece
+        PieceList pieceLists[2][7];          // [White, Black][PieceType]
+        std::uint8_t listSlot[64];           // Index of an occupied square in its piece list
+        AttackTables::SquareMask occupied;   // Bit per occupied square
+        std::uint64_t positionKey;           // Zobrist key without the en passant part (see getKey)
+
+        static int colorIndex(Color color) { return color == Color::WHITE ? 0 : 1; }
+        void addToPieceList(const Piece& piece, int square) {
+            PieceList& list = pieceLists[colorIndex(piece.getColor())][static_cast<int>(piece.getType())];
+            if (list.count == PieceList::CAPACITY)
+                return;
+            listSlot[square] = list.count;
+            list.squares[list.count++] = static_cast<std::uint8_t>(square);
+            occupied |= AttackTables::squareMask(square);
+            positionKey ^= Zobrist::pieceKey(piece.getType(), piece.getColor(), square);
+        }
+        void removeFromPieceList(const Piece& piece, int square) {
+            PieceList& list = pieceLists[colorIndex(piece.getColor())][static_cast<int>(piece.getType())];
+            std::uint8_t last = list.squares[--list.count];
+            list.squares[listSlot[square]] = last;
+            listSlot[last] = listSlot[square];
+            occupied &= ~AttackTables::squareMask(square);
+            positionKey ^= Zobrist::pieceKey(piece.getType(), piece.getColor(), square);
+        }
+        void moveInPieceList(const Piece& piece, int from, int to) {
+            PieceList& list = pieceLists[colorIndex(piece.getColor())][static_cast<int>(piece.getType())];
+            list.squares[listSlot[from]] = static_cast<std::uint8_t>(to);
+            listSlot[to] = listSlot[from];
+            occupied ^= AttackTables::squareMask(from) | AttackTables::squareMask(to);
+            positionKey ^= Zobrist::pieceKey(piece.getType(), piece.getColor(), from) ^
+                           Zobrist::pieceKey(piece.getType(), piece.getColor(), to);
+        }
+        void rebuildPieceLists(); // Also recomputes positionKey from scratch
+
+        // Position state carried by FEN alongside piece placement
+        Color sideToMove;
+        unsigned char castlingRights; // CastlingRight flags
+        Position enPassantSquare;     // Square behind a double-pushed pawn, invalid if none
+        int halfmoveClock;
+        int fullmoveNumber;
+
         // For move validation state (temporary move for check detection)
         struct ValidationMoveState {
             Position start, end;
@@ -30,10 +89,44 @@ namespace HardChess {
         Board(const Board& other); // Deep copy constructor
         Board& operator=(const Board& other); // Deep copy assignment
 
+        // Upper bound on the length of a FEN string written by writeFEN (excluding terminator)
+        static constexpr std::size_t MAX_FEN_LENGTH = 96;
+
         void initializeBoard();
 
+        // FEN import/export. fromFEN validates the whole record before touching the board
+        // and leaves it unchanged on failure; parsing itself does not allocate.
+        bool fromFEN(std::string_view fen);
+        std::string toFEN() const;
+        std::size_t writeFEN(char* out) const; // out must hold MAX_FEN_LENGTH chars; not terminated
+
+        static std::unique_ptr<Piece> createPiece(PieceType type, Color color, Position pos);
+
+        Color getSideToMove() const { return sideToMove; }
+        void setSideToMove(Color color) {
+            if (color != sideToMove) positionKey ^= Zobrist::key(Zobrist::TURN_OFFSET);
+            sideToMove = color;
+        }
+        unsigned char getCastlingRights() const { return castlingRights; }
+        Position getEnPassantSquare() const { return enPassantSquare; }
+        int getHalfmoveClock() const { return halfmoveClock; } // Plies since the last capture or pawn move
+        bool isFiftyMoveDraw() const { return halfmoveClock >= 100; }
+        int getFullmoveNumber() const { return fullmoveNumber; }
+
+        // Equal to Zobrist::hash(*this), maintained incrementally: O(1) per move. Only
+        // positions with an en passant square pay for the capture test polyglot requires.
+        std::uint64_t getKey() const {
+            return enPassantSquare.isValid() ? positionKey ^ Zobrist::enPassantKey(*this) : positionKey;
+        }
+
         std::unique_ptr<Piece> getPiece(Position pos) const;
-        Piece* getPiecePtr(Position pos) const;
+        Piece* getPiecePtr(Position pos) const { return pos.isValid() ? grid[pos.row][pos.col].get() : nullptr; }
+
+        // Live pieces only, without scanning empty squares
+        const PieceList& pieces(Color color, PieceType type) const {
+            return pieceLists[colorIndex(color)][static_cast<int>(type)];
+        }
+        AttackTables::SquareMask occupiedSquares() const { return occupied; }
 
         void setPiece(Position pos, std::unique_ptr<Piece> piece);
         std::unique_ptr<Piece> removePiece(Position pos);
@@ -52,6 +145,17 @@ namespace HardChess {
         void revertValidationMove(Position start, Position end, std::unique_ptr<Piece> originalPieceAtEnd);
 
         bool promotePawn(Position pawnPos, PieceType promotionType);
+
+        // Full-rules move generation and make/unmake, including castling and en passant
+        // (implemented in MoveGenerator.cpp). Moves are generated for the side to move.
+        void generatePseudoLegalMoves(std::vector<Move>& moves) const;
+        void generateLegalMoves(std::vector<Move>& moves);
+        bool isLegalMove(const Move& pseudoLegalMove); // Does not leave the mover's king attacked
+        void makeMove(const Move& move, MoveUndo& undo);
+        void undoMove(const Move& move, MoveUndo& undo);
+        void applyMove(const Move& move); // makeMove when the move will not be taken back
+        Move decodeMove(std::uint16_t code) const; // Inverse of Move::encode for this position
+        Move completeMove(Position from, Position to, PieceType promotion = PieceType::NONE) const; // Infers the flags
     };
 
 } // namespace HardChess
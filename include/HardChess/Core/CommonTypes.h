@@ -10,6 +10,16 @@ namespace HardChess {
     enum class Color { NONE, WHITE, BLACK };
     enum class PieceType { NONE, PAWN, ROOK, KNIGHT, BISHOP, QUEEN, KING };
 
+    // Castling rights bit flags, combined into Board's castling mask (FEN "KQkq")
+    enum CastlingRight : unsigned char {
+        NO_CASTLING = 0,
+        WHITE_KINGSIDE = 1,
+        WHITE_QUEENSIDE = 2,
+        BLACK_KINGSIDE = 4,
+        BLACK_QUEENSIDE = 8,
+        ALL_CASTLING = 15
+    };
+
     struct Position {
         int row;
         int col;
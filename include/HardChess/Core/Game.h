@@ -2,12 +2,25 @@
 #define HARDCHESS_CORE_GAME_H
 
 #include "HardChess/Core/Board.h"
+#include "HardChess/Core/GameRecord.h"
+#include "HardChess/Core/LegalMoveSet.h"
 #include "HardChess/Core/Player.h"
+#include "HardChess/Core/RepetitionHistory.h"
+#include "HardChess/Engine/HintSearch.h"
+#include "HardChess/Engine/MateSolver.h"
+#include "HardChess/Engine/OpeningBook.h"
+#include "HardChess/Engine/Search.h"
+#include "HardChess/Engine/Tablebase.h"
 #include "HardChess/UI/ConsoleUI.h" // Game needs UI to interact
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
 
 namespace HardChess {
 
-    enum class RoundState { ONGOING, CHECKMATE_WHITE_WINS, CHECKMATE_BLACK_WINS, STALEMATE };
+    // ABANDONED: the player to move typed exit; the round has no result and the match stops
+    enum class RoundState { ONGOING, CHECKMATE_WHITE_WINS, CHECKMATE_BLACK_WINS, STALEMATE, DRAW, ABANDONED };
 
     class Game {
       private:
@@ -17,21 +30,62 @@ namespace HardChess {
         Player* currentPlayer;
         ConsoleUI& ui;
         RoundState roundState;
+        GameRecord history; // Moves of the current round
+        RepetitionHistory positions; // Keys of the round's positions, for threefold repetition
+        LegalMoveSet legalMoves; // Of the current position; see currentMoves()
+        const OpeningBook* book; // Not owned; may be null
+        const Tablebase* tablebase; // Not owned; may be null
+        const Player* tablebaseWinner; // Of the tablebase verdict last shown this round; nullptr if none
+        int computerMoveTimeMs;
+        std::unique_ptr<Search> search; // Created on the computer's first search
+        int hintTimeMs;
+        int hintLines;
+        std::unique_ptr<HintSearch> hints; // Created on the first `hint` request
+        MateLimits mateLimits;
+        std::unique_ptr<MateSolver> mateSolver; // Created on the first `mate` request
+        std::mt19937_64 bookRandom;
+        std::vector<Move> notationScratch; // Reused by Notation::toSAN
+        std::uint32_t id; // Unique per Game in the process; tags its event log entries
 
-        Position parsePosition(const std::string& s) const;
+        // The legal moves of the current position, generated at most once per position
+        const LegalMoveSet& currentMoves() {
+            legalMoves.update(board);
+            return legalMoves;
+        }
         bool makeMove(Position start, Position end, PieceType promotionType = PieceType::NONE);
-        bool canPlayerMakeAnyLegalMove(Player* player);
+        void executeMove(const Move& move); // Applies a validated move and records it
+        void playComputerTurn();
         void switchPlayer();
         void checkForEndOfRound();
+        void startHint();
+        void solveMate();
 
       public:
         Game(Player* p1, Player* p2, ConsoleUI& consoleUi);
-        
+
+        // Computer players play perfect endgames from the tablebase, book moves while the
+        // book has any, and search otherwise. Tablebase draws, threefold repetition and the
+        // fifty-move rule also end the round.
+        void setOpeningBook(const OpeningBook* openingBook) { book = openingBook; }
+        void setTablebase(const Tablebase* endgameTables) { tablebase = endgameTables; }
+        void setComputerMoveTime(int milliseconds) { computerMoveTimeMs = milliseconds; }
+        // Search budget of the `hint` command, which runs while the prompt waits for input
+        void setHintTime(int milliseconds) { hintTimeMs = milliseconds; }
+        // Candidate moves the `hint` command suggests, best first
+        void setHintLines(int lines) { hintLines = lines; }
+        // Budget of the `mate` command, which looks for a forced mate for the player to move
+        void setMateLimits(const MateLimits& limits) { mateLimits = limits; }
+
         void startRound();
+        // Starts a round from a FEN position instead; false (and nothing changed) if invalid
+        bool startRoundFromFEN(std::string_view fen);
         void playTurn();
+        bool canPlayerMakeAnyLegalMove(Player* player);
         bool isRoundOver() const;
         Player* getRoundWinner() const; // nullptr if draw or ongoing
         RoundState getRoundState() const { return roundState; }
+        std::uint32_t getId() const { return id; }
+        const GameRecord& getHistory() const { return history; } // Its result is set once the round ends
     };
 
 } // namespace HardChess
@@ -0,0 +1,58 @@
+#ifndef HARDCHESS_CORE_GAMERECORD_H
+#define HARDCHESS_CORE_GAMERECORD_H
+
+#include "HardChess/Core/Move.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HardChess {
+
+    enum class GameResult : unsigned char { UNKNOWN, WHITE_WINS, BLACK_WINS, DRAW };
+
+    // Read-only window over a run of 16-bit encoded moves (see Move::encode).
+    // Points into a GameRecord buffer or a mapped archive; never owns memory.
+    struct MoveCodeView {
+        const std::uint16_t* codes = nullptr;
+        std::size_t count = 0;
+
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        std::uint16_t operator[](std::size_t i) const { return codes[i]; }
+        const std::uint16_t* begin() const { return codes; }
+        const std::uint16_t* end() const { return codes + count; }
+    };
+
+    // Compact record of one game: result, optional start position and two bytes per move
+    class GameRecord {
+      private:
+        std::vector<std::uint16_t> moves;
+        std::string startFEN; // Empty for the standard initial position
+        GameResult result;
+
+      public:
+        GameRecord();
+
+        void clear();
+        void reserve(std::size_t plies) { moves.reserve(plies); }
+        void append(const Move& move) { moves.push_back(move.encode()); }
+        void appendCode(std::uint16_t code) { moves.push_back(code); }
+        void removeLast() { if (!moves.empty()) moves.pop_back(); }
+
+        void setStartFEN(std::string_view fen) { startFEN.assign(fen.data(), fen.size()); }
+        const std::string& getStartFEN() const { return startFEN; }
+        void setResult(GameResult r) { result = r; }
+        GameResult getResult() const { return result; }
+
+        MoveCodeView getMoves() const { return MoveCodeView{moves.data(), moves.size()}; }
+        std::size_t size() const { return moves.size(); }
+    };
+
+    GameResult parseGameResult(std::string_view token); // "1-0", "0-1", "1/2-1/2"; anything else UNKNOWN
+    const char* gameResultString(GameResult result);    // Inverse; UNKNOWN gives "*"
+
+} // namespace HardChess
+
+#endif // HARDCHESS_CORE_GAMERECORD_H
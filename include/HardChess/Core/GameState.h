@@ -1,8 +1,8 @@
 #ifndef GAMESTATE_H
 #define GAMESTATE_H
 
+#include "HardChess/Core/GameRecord.h"
 #include <string>
-#include <vector>
 
 // Removed POWER_UP_SELECTION from GamePhase for HardChess
 enum class GamePhase {
@@ -16,7 +16,7 @@ private:
     std::string lastMoveDescription;
     bool isCheck;
     bool isCheckmate;
-    std::vector<std::string> gameHistory;
+    HardChess::GameRecord gameHistory; // Two bytes per move, see HardChess::Move::encode
     
 public:
     GameState();
@@ -37,12 +37,14 @@ public:
     bool getCheckmate() const { return isCheckmate; }
     
     // Move history
-    void addMove(const std::string& move);
-    std::vector<std::string> getHistory() const { return gameHistory; }
-    void clearHistory() { gameHistory.clear(); }
+    void addMove(const HardChess::Move& move, const std::string& description = std::string());
+    HardChess::MoveCodeView getHistory() const { return gameHistory.getMoves(); } // Zero-copy view
+    const HardChess::GameRecord& getRecord() const { return gameHistory; }
+    const std::string& getLastMoveDescription() const { return lastMoveDescription; }
+    void clearHistory() { gameHistory.clear(); lastMoveDescription.clear(); }
     
     // Utility
     std::string getPhaseString() const;
 };
 
-#endif // GAMESTATE_H
\ No newline at end of file
+#endif // GAMESTATE_H
@@ -0,0 +1,64 @@
+#ifndef HARDCHESS_CORE_LEGALMOVESET_H
+#define HARDCHESS_CORE_LEGALMOVESET_H
+
+#include "HardChess/Core/AttackTables.h"
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/Move.h"
+#include <cstdint>
+#include <vector>
+
+namespace HardChess {
+
+    // The legal moves of one position, generated once and then queried many times: move
+    // input, the promotion prompt, check and mate detection and hints all read the same
+    // set. Moves are kept sorted by (origin, destination, promotion), so a lookup is a
+    // binary search, and a bit mask records which squares have a move at all. The set is
+    // tied to the position's Zobrist key; update() regenerates only when the key changed.
+    class LegalMoveSet {
+      public:
+        static constexpr int MAX_MOVES = 256; // No legal position has more than 218
+
+        LegalMoveSet() : key(0), valid(false), check(false), count(0), origins(0) {}
+
+        // Makes the set hold board's legal moves; returns true if it had to generate them
+        bool update(Board& board);
+        void clear() { valid = false; }
+        bool isFor(const Board& board) const { return valid && key == board.getKey(); }
+
+        bool empty() const { return count == 0; }
+        int size() const { return count; }
+        const Move& operator[](int index) const { return entries[index].move; }
+        bool inCheck() const { return check; } // The side to move is in check
+
+        // The legal move from -> to with this promotion (ignored unless the move promotes),
+        // or nullptr if there is none
+        const Move* find(Position from, Position to, PieceType promotion = PieceType::NONE) const;
+        // from -> to is legal only with a promotion piece
+        bool requiresPromotion(Position from, Position to) const;
+        bool hasMovesFrom(Position from) const {
+            return from.isValid() && (origins & AttackTables::squareMask(squareIndex(from))) != 0;
+        }
+
+      private:
+        struct Entry {
+            std::uint16_t order; // origin << 9 | destination << 3 | promotion code
+            Move move;
+        };
+
+        std::uint64_t key;
+        bool valid;
+        bool check;
+        int count;
+        AttackTables::SquareMask origins;
+        Entry entries[MAX_MOVES];
+        std::vector<Move> generated; // Reused generation buffer
+
+        static std::uint16_t orderOf(Position from, Position to, unsigned promotionCode) {
+            return static_cast<std::uint16_t>(squareIndex(from) << 9 | squareIndex(to) << 3 | promotionCode);
+        }
+        const Entry* firstBetween(Position from, Position to) const; // First entry for from -> to, or end
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_CORE_LEGALMOVESET_H
@@ -0,0 +1,86 @@
+#ifndef HARDCHESS_CORE_MATCH_H
+#define HARDCHESS_CORE_MATCH_H
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/GameRecord.h"
+#include "HardChess/Core/LegalMoveSet.h"
+#include "HardChess/Core/Move.h"
+#include "HardChess/Core/Player.h"
+#include "HardChess/Core/RepetitionHistory.h"
+#include "HardChess/Util/EventLog.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace HardChess {
+
+    class Tablebase;
+
+    enum class RoundEnd { NONE, CHECKMATE, STALEMATE, FIFTY_MOVES, REPETITION, TABLEBASE_DRAW, RESIGNATION };
+
+    // A whole HardChess match with no console attached, for driving many at once: the
+    // same rules main.cpp plays interactively. Player 1 has White in every round; a
+    // decisive round scores for the winner and costs the loser a heart; the match goes to
+    // the first to win ROUNDS_TO_WIN rounds, or to the opponent of a player out of hearts.
+    // Drawn rounds change nothing and are replayed. A finished round stays on the board,
+    // for reporting, until nextRound(). With an event log open it records the events the
+    // console match does, each round under its own Event::game.
+    class Match {
+      public:
+        static constexpr int ROUNDS_TO_WIN = 2;
+
+        // Player 2 may be the engine; the match only records it, someone else moves for it
+        Match(const std::string& whiteName, const std::string& blackName, bool computerBlack);
+
+        // With tables set, a round also ends drawn in a position they prove drawn, as in Game
+        void setTablebase(const Tablebase* endgameTables) { tablebase = endgameTables; }
+
+        // A legal move of the side to move from SAN ("Nf3") or coordinates ("e7e8q")
+        bool parseMove(std::string_view text, Move& move);
+        // Plays a legal move; returns how it ended the round, NONE if the round goes on
+        RoundEnd play(const Move& move);
+        RoundEnd resign(); // The side to move gives up the round
+        void nextRound();  // After a round ended, unless the match is over
+
+        Board& board() { return position; }
+        const RepetitionHistory& positions() const { return history; }
+        const LegalMoveSet& legalMoves() { legal.update(position); return legal; }
+        const Player& white() const { return player1; }
+        const Player& black() const { return player2; }
+        int round() const { return roundNumber; }
+        bool isRoundOver() const { return ended != RoundEnd::NONE; }
+        bool isOver() const { return over; }
+        bool computerToMove() const;
+        const Player* roundWinner() const { return winnerOfRound; } // Of the finished round; nullptr for a draw
+        const Player* winner() const; // Of the match, once it is over
+
+        static const char* describe(RoundEnd end); // "checkmate", "stalemate", ...
+
+        // The scoring rules, shared with the console match in main.cpp. A decided round
+        // scores for the winner and costs the loser a heart; a loser out of hearts hands the
+        // winner the match.
+        static void scoreRound(Player& winner, Player& loser);
+        static bool isMatchOver(const Player& white, const Player& black);
+        static const Player* matchWinner(const Player& white, const Player& black); // nullptr until over
+
+      private:
+        Player player1;
+        Player player2;
+        Board position;
+        RepetitionHistory history;
+        LegalMoveSet legal;
+        const Tablebase* tablebase; // Not owned; may be null
+        int roundNumber;
+        std::uint32_t roundId; // Event::game of the current round
+        RoundEnd ended;
+        bool over;
+        const Player* winnerOfRound;
+
+        RoundEnd finishRound(RoundEnd end, Player* winner);
+        void logRoundStart();
+        void logResult(EventLog::EventType type, std::uint32_t game, GameResult result, const Player* winner);
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_CORE_MATCH_H
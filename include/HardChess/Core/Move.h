@@ -0,0 +1,71 @@
+#ifndef HARDCHESS_CORE_MOVE_H
+#define HARDCHESS_CORE_MOVE_H
+
+#include "HardChess/Core/CommonTypes.h"
+#include <cstdint>
+#include <memory>
+
+namespace HardChess {
+
+    // Move flags; a move may combine CAPTURE with EN_PASSANT or a promotion
+    enum MoveFlag : unsigned char {
+        MOVE_QUIET = 0,
+        MOVE_CAPTURE = 1,
+        MOVE_EN_PASSANT = 2,
+        MOVE_CASTLE = 4,
+        MOVE_DOUBLE_PUSH = 8
+    };
+
+    // Square numbering used by compact encodings: 0 = a8 ... 63 = h1 (row * 8 + col)
+    inline int squareIndex(Position pos) { return pos.row * 8 + pos.col; }
+    inline Position squareAt(int index) { return Position(index >> 3, index & 7); }
+
+    struct Move {
+        Position from;
+        Position to;
+        PieceType promotion;
+        unsigned char flags;
+
+        Move(Position f = Position(), Position t = Position(), PieceType promo = PieceType::NONE, unsigned char fl = MOVE_QUIET)
+            : from(f), to(t), promotion(promo), flags(fl) {}
+
+        bool isCapture() const { return (flags & MOVE_CAPTURE) != 0; }
+        bool isEnPassant() const { return (flags & MOVE_EN_PASSANT) != 0; }
+        bool isCastle() const { return (flags & MOVE_CASTLE) != 0; }
+        bool isValid() const { return from.isValid() && to.isValid(); }
+
+        // 16-bit form: bits 0-5 destination, 6-11 origin, 12-14 promotion
+        // (0 none, 1 knight, 2 bishop, 3 rook, 4 queen). Flags are not stored;
+        // Board::decodeMove restores them from the position.
+        std::uint16_t encode() const {
+            unsigned promo = 0;
+            switch (promotion) {
+                case PieceType::KNIGHT: promo = 1; break;
+                case PieceType::BISHOP: promo = 2; break;
+                case PieceType::ROOK: promo = 3; break;
+                case PieceType::QUEEN: promo = 4; break;
+                default: break;
+            }
+            return static_cast<std::uint16_t>(squareIndex(to) | (squareIndex(from) << 6) | (promo << 12));
+        }
+
+        bool operator==(const Move& other) const {
+            return from == other.from && to == other.to && promotion == other.promotion;
+        }
+        bool operator!=(const Move& other) const { return !(*this == other); }
+    };
+
+    // Everything Board::undoMove needs to restore the position before a makeMove
+    struct MoveUndo {
+        std::unique_ptr<Piece> captured;   // Piece removed by the move, if any
+        std::unique_ptr<Piece> promotedPawn; // Original pawn replaced on promotion
+        Position capturedAt;
+        bool moverHadMoved;
+        unsigned char castlingRights;
+        Position enPassantSquare;
+        int halfmoveClock;
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_CORE_MOVE_H
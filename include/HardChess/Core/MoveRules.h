@@ -0,0 +1,88 @@
+#ifndef HARDCHESS_CORE_MOVERULES_H
+#define HARDCHESS_CORE_MOVERULES_H
+
+#include "HardChess/Core/AttackTables.h"
+#include "HardChess/Core/Board.h"
+
+namespace HardChess {
+
+    // Piece movement rules as plain inline functions, specialized on piece type and
+    // color so pawn direction and promotion row are compile-time constants. The Piece
+    // classes forward their virtual isValidMove here; hot paths call the kernels
+    // directly and need neither a virtual call nor a Piece object.
+    namespace MoveRules {
+
+        template <Color Side>
+        constexpr int pawnDirection() { return Side == Color::WHITE ? -1 : 1; }
+
+        template <Color Side>
+        constexpr int promotionRow() { return Side == Color::WHITE ? 0 : 7; }
+
+        inline bool isPromotionSquare(Color side, Position square) {
+            return square.row == (side == Color::WHITE ? promotionRow<Color::WHITE>() : promotionRow<Color::BLACK>());
+        }
+
+        // Piece-level rules only: whether the move leaves the own king in check is the
+        // caller's business, as with Piece::isValidMove
+        template <PieceType Type, Color Side>
+        inline bool isValidMove(Position start, Position end, const Board& board, bool hasMoved) {
+            if (!start.isValid() || !end.isValid() || start == end) return false;
+            const Piece* target = board.getPiecePtr(end);
+            if (target && target->getColor() == Side) return false;
+
+            if constexpr (Type == PieceType::PAWN) {
+                constexpr int forward = pawnDirection<Side>();
+                int dr = end.row - start.row;
+                int dc = end.col - start.col;
+                if (dc == 0) {
+                    if (target) return false;
+                    if (dr == forward) return true;
+                    return dr == 2 * forward && !hasMoved && !board.getPiecePtr(Position(start.row + forward, start.col));
+                }
+                return (dc == 1 || dc == -1) && dr == forward && target; // En passant is handled by the move generator
+            } else if constexpr (Type == PieceType::KNIGHT) {
+                return AttackTables::contains(AttackTables::KNIGHT_ATTACKS[AttackTables::squareOf(start)], end);
+            } else if constexpr (Type == PieceType::KING) {
+                // Castling is handled by the move generator
+                return AttackTables::contains(AttackTables::KING_ATTACKS[AttackTables::squareOf(start)], end);
+            } else if constexpr (Type == PieceType::ROOK || Type == PieceType::BISHOP || Type == PieceType::QUEEN) {
+                int from = AttackTables::squareOf(start);
+                int to = AttackTables::squareOf(end);
+                bool aligned = Type == PieceType::ROOK     ? AttackTables::isStraight(from, to)
+                               : Type == PieceType::BISHOP ? AttackTables::isDiagonal(from, to)
+                                                           : AttackTables::LINE[from][to] != 0;
+                return aligned && board.isPathClear(start, end);
+            } else {
+                return false;
+            }
+        }
+
+        template <PieceType Type>
+        inline bool isValidMove(Color color, Position start, Position end, const Board& board, bool hasMoved) {
+            return color == Color::WHITE ? isValidMove<Type, Color::WHITE>(start, end, board, hasMoved)
+                                         : isValidMove<Type, Color::BLACK>(start, end, board, hasMoved);
+        }
+
+        // Switch dispatch for callers that only know the type at run time
+        inline bool isValidMove(PieceType type, Color color, Position start, Position end, const Board& board,
+                                bool hasMoved) {
+            switch (type) {
+                case PieceType::PAWN: return isValidMove<PieceType::PAWN>(color, start, end, board, hasMoved);
+                case PieceType::KNIGHT: return isValidMove<PieceType::KNIGHT>(color, start, end, board, hasMoved);
+                case PieceType::BISHOP: return isValidMove<PieceType::BISHOP>(color, start, end, board, hasMoved);
+                case PieceType::ROOK: return isValidMove<PieceType::ROOK>(color, start, end, board, hasMoved);
+                case PieceType::QUEEN: return isValidMove<PieceType::QUEEN>(color, start, end, board, hasMoved);
+                case PieceType::KING: return isValidMove<PieceType::KING>(color, start, end, board, hasMoved);
+                default: return false;
+            }
+        }
+
+        inline bool isValidMove(const Piece& piece, Position start, Position end, const Board& board) {
+            return isValidMove(piece.getType(), piece.getColor(), start, end, board, piece.getHasMoved());
+        }
+
+    } // namespace MoveRules
+
+} // namespace HardChess
+
+#endif // HARDCHESS_CORE_MOVERULES_H
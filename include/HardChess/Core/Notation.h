@@ -0,0 +1,51 @@
+#ifndef HARDCHESS_CORE_NOTATION_H
+#define HARDCHESS_CORE_NOTATION_H
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/Move.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HardChess {
+
+    class LegalMoveSet;
+
+    namespace Notation {
+
+        // "e4" -> Position(4, 4); false on anything that is not exactly a square
+        bool parseSquare(std::string_view text, Position& square);
+
+        // Coordinate notation as typed at the move prompt: "e2e4", "a7a8q".
+        // parseCoordinate checks the shape only (two squares and an optional q, r, b or n),
+        // not legality; promotion is NONE without a suffix.
+        // formatCoordinate writes at most 5 chars and returns the length written.
+        bool parseCoordinate(std::string_view text, Position& from, Position& to, PieceType& promotion);
+        std::size_t formatCoordinate(const Move& move, char* out);
+        std::string toCoordinate(const Move& move);
+
+        // Resolves a Standard Algebraic Notation token ("Nf3", "exd5", "e8=Q+", "O-O")
+        // against the position. Only moves matching the token are legality-checked,
+        // so a typical resolution costs one pseudo-legal generation and one make/unmake.
+        // scratch is reused between calls to avoid reallocating the move list.
+        bool parseSAN(Board& board, std::string_view san, Move& move, std::vector<Move>& scratch);
+        // The same against moves, board's legal moves, which needs no legality checks at all
+        bool parseSAN(const Board& board, std::string_view san, const LegalMoveSet& moves, Move& move);
+
+        // Longest SAN formatSAN writes: "Qa1xb2#" or "exd8=Q#"
+        constexpr std::size_t MAX_SAN_LENGTH = 7;
+
+        // Standard Algebraic Notation of a legal move in board's position: "Nf3", "exd5",
+        // "e8=Q+", "Raxd1#", "O-O". Rivals for the destination are found from the piece
+        // lists and attack tables, and only those are legality-checked. The move is made
+        // and unmade on board for the check suffix; the replies are generated, into
+        // scratch, only when it gives check. Returns the length written to out.
+        std::size_t formatSAN(Board& board, const Move& move, char* out, std::vector<Move>& scratch);
+        std::string toSAN(Board& board, const Move& move, std::vector<Move>& scratch);
+
+    } // namespace Notation
+
+} // namespace HardChess
+
+#endif // HARDCHESS_CORE_NOTATION_H
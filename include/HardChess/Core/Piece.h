@@ -2,6 +2,7 @@
 #define HARDCHESS_CORE_PIECE_H
 
 #include "HardChess/Core/CommonTypes.h"
+#include "HardChess/Util/Allocators.h"
 #include <vector>
 #include <string>
 #include <memory>
@@ -20,6 +21,12 @@ namespace HardChess {
             : color(c), type(pt), position(pos), hasMoved(false) {}
         virtual ~Piece() = default;
 
+        // Pieces are allocated from a per-thread pool of fixed-size blocks, so board
+        // copies and promotions stop calling the global allocator once it has warmed up
+        static void* operator new(std::size_t size);
+        static void operator delete(void* block, std::size_t size) noexcept;
+        static AllocatorStats poolStats(); // The calling thread's requests
+
         Color getColor() const { return color; }
         PieceType getType() const { return type; }
         Position getPosition() const { return position; }
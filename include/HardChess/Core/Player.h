@@ -12,14 +12,16 @@ namespace HardChess {
         Color color;
         int hearts;
         int score; // Rounds won
+        bool computer; // Moves are chosen by the engine instead of read from the console
 
       public:
-        Player(const std::string& name, Color c);
+        Player(const std::string& name, Color c, bool isComputerPlayer = false);
 
         const std::string& getName() const;
         Color getColor() const;
         int getHearts() const;
         int getScore() const;
+        bool isComputer() const;
         
         std::string getColorString() const;
 
@@ -0,0 +1,57 @@
+#ifndef HARDCHESS_CORE_REPETITIONHISTORY_H
+#define HARDCHESS_CORE_REPETITIONHISTORY_H
+
+#include <cstdint>
+
+namespace HardChess {
+
+    // Keys (Board::getKey) of the positions of a game, oldest first, kept in a ring buffer.
+    // Recording a move is O(1). A position can only recur after the last capture or pawn
+    // move, so lookups scan back no further than the halfmove clock, and only through
+    // positions with the same side to move. Cheap enough to use at every search node.
+    class RepetitionHistory {
+      public:
+        // The fifty-move rule caps the useful window at 100 plies; the rest is room for
+        // the plies a search adds on top of the game
+        static constexpr int CAPACITY = 256;
+
+        RepetitionHistory() : count(0) {}
+
+        void reset(std::uint64_t startKey) {
+            count = 0;
+            push(startKey);
+        }
+        void push(std::uint64_t key) { keys[count++ & MASK] = key; }
+        void pop() { --count; }
+
+        int size() const { return count; }
+        std::uint64_t current() const { return keys[(count - 1) & MASK]; }
+
+        // Earlier occurrences of the current position within the last halfmoveClock plies,
+        // counting no further than stopAt
+        int repetitions(int halfmoveClock, int stopAt = 2) const {
+            int limit = halfmoveClock < count - 1 ? halfmoveClock : count - 1;
+            if (limit > CAPACITY - 1) limit = CAPACITY - 1;
+            std::uint64_t key = current();
+            int found = 0;
+            // Returning to a position takes at least four plies
+            for (int back = 4; back <= limit; back += 2) {
+                if (keys[(count - 1 - back) & MASK] == key && ++found >= stopAt) break;
+            }
+            return found;
+        }
+
+        // Third occurrence: the game is drawn
+        bool isThreefold(int halfmoveClock) const { return repetitions(halfmoveClock, 2) >= 2; }
+        // Any recurrence; a search scores it as a draw, since either side could repeat again
+        bool isRepetition(int halfmoveClock) const { return repetitions(halfmoveClock, 1) >= 1; }
+
+      private:
+        static constexpr int MASK = CAPACITY - 1;
+        std::uint64_t keys[CAPACITY];
+        int count;
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_CORE_REPETITIONHISTORY_H
@@ -0,0 +1,98 @@
+#ifndef HARDCHESS_ENGINE_ANALYSISCACHE_H
+#define HARDCHESS_ENGINE_ANALYSISCACHE_H
+
+#include "HardChess/Engine/Search.h"
+#include "HardChess/IO/MappedFile.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace HardChess {
+
+    // One search result as stored on disk: 64 bytes, little-endian
+    struct CachedAnalysis {
+        std::uint64_t key = 0;      // Zobrist key of the analysed position
+        std::uint64_t nodes = 0;
+        std::uint16_t move = 0;     // Move::encode() of the best move
+        std::int16_t score = 0;     // Centipawns for the side to move, as SearchResult::score
+        std::uint8_t depth = 0;
+        std::uint8_t hasMove = 0;
+        std::uint8_t pvLength = 0;
+        std::uint8_t reserved = 0;
+        std::uint16_t pv[16] = {};  // First moves of the principal variation, encoded
+        std::uint32_t reserved2 = 0;
+        std::uint32_t checksum = 0; // Over the 60 bytes before it; torn appends fail it
+
+        static constexpr int MAX_PV = 16;
+
+        static CachedAnalysis from(std::uint64_t positionKey, const SearchResult& result);
+    };
+    static_assert(sizeof(CachedAnalysis) == 64, "CachedAnalysis is the on-disk record");
+
+    // Persistent cache of search results (".hcac"), shared by successive runs and by
+    // processes running at the same time:
+    //   header  { char magic[8] = "HCACACHE"; u32 version; u32 recordSize; u64 sortedCount;
+    //             u64 reserved[5]; }
+    //   sorted  sortedCount records ordered by key, one per key, as compact() leaves them
+    //   log     records appended since, in any order
+    // The file is only ever appended to, and whole records at a time; the header changes
+    // only when compact() renames a new file into place. Readers map the file as it was
+    // on open() and never lock. Appends take an exclusive flock so records from several
+    // processes do not interleave. A crash can leave at most one torn record at the end:
+    // a partial one is cut off before the next append, and one that fails its checksum
+    // is skipped by readers and dropped by compact().
+    class AnalysisCache {
+      public:
+        AnalysisCache();
+        ~AnalysisCache(); // Flushes pending records
+        AnalysisCache(const AnalysisCache&) = delete;
+        AnalysisCache& operator=(const AnalysisCache&) = delete;
+
+        // writable creates the file if needed and allows store(); false if the file is
+        // missing (read-only), unreadable or not an analysis cache
+        bool open(const std::string& path, bool writable);
+        bool close();
+        bool isOpen() const { return opened; }
+
+        // The deepest result for key searched to at least minDepth, or proving a mate. Safe
+        // from any thread.
+        bool find(std::uint64_t key, int minDepth, CachedAnalysis& out);
+
+        // Queues a result; it is visible to find() at once and written by flush(), which
+        // runs on its own every FLUSH_RECORDS records. Safe from any thread.
+        void store(const CachedAnalysis& entry);
+        bool flush();
+
+        // Rewrites the file with one record per key (the deepest), sorted, and renames it
+        // over the original. Readers that already mapped the old file keep reading it.
+        static bool compact(const std::string& path, std::size_t& recordsBefore, std::size_t& recordsAfter);
+
+        std::uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+        std::uint64_t misses() const { return missCount.load(std::memory_order_relaxed); }
+        std::size_t size() const { return sortedCount + logged.size(); } // Distinct keys known at open, roughly
+
+        static constexpr std::size_t FLUSH_RECORDS = 256;
+
+      private:
+        MappedFile file;
+        std::string path;
+        const CachedAnalysis* records;                           // In the mapping: the sorted section, then the log
+        std::size_t sortedCount;
+        std::unordered_map<std::uint64_t, CachedAnalysis> logged; // Log records, and this process's stores
+        std::vector<CachedAnalysis> pending;                      // Stored but not yet written
+        std::mutex mutex;                                         // Guards logged and pending
+        int fd;                                                   // Append descriptor when writable
+        bool opened;
+        std::atomic<std::uint64_t> hitCount;
+        std::atomic<std::uint64_t> missCount;
+
+        bool flushLocked();
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_ENGINE_ANALYSISCACHE_H
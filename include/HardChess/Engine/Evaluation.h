@@ -0,0 +1,22 @@
+#ifndef HARDCHESS_ENGINE_EVALUATION_H
+#define HARDCHESS_ENGINE_EVALUATION_H
+
+#include "HardChess/Core/Board.h"
+
+namespace HardChess {
+
+    namespace Evaluation {
+
+        // Centipawn values indexed by PieceType
+        constexpr int pieceValues[7] = {0, 100, 500, 320, 330, 900, 0};
+
+        // Static evaluation in centipawns from the side to move's point of view:
+        // material plus piece-square tables, with the king table blended towards
+        // the endgame as non-pawn material comes off the board.
+        int evaluate(const Board& board);
+
+    } // namespace Evaluation
+
+} // namespace HardChess
+
+#endif // HARDCHESS_ENGINE_EVALUATION_H
@@ -0,0 +1,66 @@
+#ifndef HARDCHESS_ENGINE_HINTSEARCH_H
+#define HARDCHESS_ENGINE_HINTSEARCH_H
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/Move.h"
+#include "HardChess/Core/RepetitionHistory.h"
+#include "HardChess/Engine/Search.h"
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace HardChess {
+
+    struct Hint {
+        struct Candidate {
+            std::string san;
+            int score = 0;
+        };
+
+        Move move;
+        std::string san;      // The move in Standard Algebraic Notation
+        int score = 0;        // Centipawns for the side to move
+        int depth = 0;        // Deepest completed iteration within the budget
+        long long nodes = 0;
+        int elapsedMs = 0;
+        bool hasMove = false;
+        std::vector<Candidate> alternatives; // The next best moves, best first, when more lines were asked for
+
+        // "Nf3 (+0.35, depth 9, 48213 nodes in 200 ms); also e4 (+0.30), d4 (+0.28)"
+        std::string describe() const;
+    };
+
+    // Suggests a move for a human player: a search bounded by a time budget that runs on
+    // a worker thread, so the move prompt keeps accepting input meanwhile. With more than one
+    // line it is a multi-PV search, and the runners-up come with the hint. The finished
+    // hint is handed to a callback on the worker thread. cancel() (or starting another
+    // hint) stops the search within a node check and suppresses the callback.
+    class HintSearch {
+      public:
+        using Callback = std::function<void(const Hint&)>;
+
+        HintSearch();
+        ~HintSearch(); // Cancels a running hint
+        HintSearch(const HintSearch&) = delete;
+        HintSearch& operator=(const HintSearch&) = delete;
+
+        // Searches a copy of board, whose game so far is history, for at most timeMs,
+        // suggesting the best `lines` moves
+        void start(const Board& board, const RepetitionHistory& history, int timeMs, int lines, Callback onDone);
+        void cancel();
+        bool running() const { return worker.joinable() && !finished.load(std::memory_order_acquire); }
+
+      private:
+        Board position;
+        RepetitionHistory positions;
+        Search search;
+        std::thread worker;
+        std::atomic<bool> cancelled;
+        std::atomic<bool> finished;
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_ENGINE_HINTSEARCH_H
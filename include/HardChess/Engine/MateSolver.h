@@ -0,0 +1,118 @@
+#ifndef HARDCHESS_ENGINE_MATESOLVER_H
+#define HARDCHESS_ENGINE_MATESOLVER_H
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/Move.h"
+#include "HardChess/Core/RepetitionHistory.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HardChess {
+
+    // Budget for one mate search; zero means the default
+    struct MateLimits {
+        long long nodes = 0;        // Positions expanded; 0 for no limit
+        std::size_t memoryMB = 0;   // Proof table size (default 64)
+        int maxMoves = 0;           // Longest mate looked for, in moves of the attacker (default 30)
+    };
+
+    enum class MateStatus { MATE, NO_MATE, UNKNOWN };
+
+    struct MateResult {
+        MateStatus status = MateStatus::UNKNOWN; // NO_MATE: none within maxMoves; UNKNOWN: out of nodes
+        int mateIn = 0;             // Moves of the attacker to mate against the best defence
+        bool shortest = false;      // No shorter mate exists (false if the nodes ran out first)
+        std::vector<Move> line;     // Attacker's moves and the longest defence, ending in mate
+        long long nodes = 0;
+        double seconds = 0;
+        std::size_t tableEntries = 0;
+        int collections = 0;        // Garbage collections of the proof table
+
+        // "Mate in 3: Qh5+ Ke7 Qf7+ Kd6 Qd5#", "No forced mate" or "No mate found in 100000
+        // nodes"
+        std::string describe(const Board& root) const;
+    };
+
+    // Depth-first proof-number search (df-pn) for a forced mate by the side to move.
+    // Every node carries a proof number (how many positions still need proving to show
+    // the mate) and a disproof number (the same for refuting it); the search always
+    // descends into the most proving child and backs out as soon as a threshold is
+    // crossed, so it follows narrow forcing lines far deeper than a full-width search.
+    //
+    // The numbers live in a hash table of fixed size. When it fills, a garbage
+    // collection drops the unresolved entries that cost least to recompute, keeping
+    // proofs, so memory stays bounded however long the search runs. Repetitions and the
+    // fifty-move rule count as disproofs. Once a mate is proven the search is repeated
+    // with the horizon just short of it, reusing the table, until no shorter mate exists or
+    // the nodes run out; the line is the shortest mate found. A reported mate is always
+    // forced. One instance per thread; the table's memory is reused between searches.
+    class MateSolver {
+      public:
+        static constexpr int MAX_MOVES = 60;
+        static constexpr int DEFAULT_MAX_MOVES = 30;
+        static constexpr std::size_t DEFAULT_MEMORY_MB = 64;
+
+        MateSolver();
+
+        MateResult solve(Board& board, const MateLimits& limits, const RepetitionHistory* gameHistory = nullptr);
+
+        // Asks a running solve to return as soon as possible (safe from any thread)
+        void stop() { stopRequested.store(true, std::memory_order_relaxed); }
+
+      private:
+        static constexpr int MAX_PLY = 2 * MAX_MOVES;
+        static constexpr std::uint16_t NO_PROOF = 0xFFFF;
+
+        struct Entry {
+            std::uint64_t key;
+            std::uint32_t pn;
+            std::uint32_t dn;
+            std::uint32_t work;     // Nodes spent below this position: what a collection weighs
+            // Results outlive the numbers, which the same position reached at another depth
+            // overwrites: a proof holds wherever at least its plies to mate remain, a
+            // disproof wherever no more plies remain than when it was found
+            std::uint16_t proof;    // Plies to mate of the shortest proof, NO_PROOF if none
+            std::uint8_t disproof;  // Most plies remaining at a disproof, 0 if none
+            std::uint8_t used;
+        };
+
+        struct Child {
+            Move move;
+            std::uint64_t key;
+            std::uint32_t pn;       // Fixed values, or the first estimate
+            std::uint32_t dn;
+            std::uint16_t distance; // Plies to mate when fixed as proven
+            bool fixed;             // Decided without a table entry: repetition, horizon, mate at the horizon
+        };
+
+        std::vector<Entry> table;
+        std::size_t mask;
+        std::size_t entries;
+        int collections;
+        std::vector<Child> children[MAX_PLY + 1];
+        std::vector<Move> scratch;
+        RepetitionHistory history;
+        int maxPly;
+        long long nodes;
+        long long nodeLimit;
+        bool aborted;
+        std::atomic<bool> stopRequested;
+
+        void resize(std::size_t memoryMB);
+        const Entry* probe(std::uint64_t key) const;
+        void store(std::uint64_t key, std::uint32_t pn, std::uint32_t dn, std::uint16_t distance, int remaining,
+                   std::uint64_t work);
+        void collect();
+        void value(const Child& child, int remaining, std::uint32_t& pn, std::uint32_t& dn, std::uint16_t& distance) const;
+
+        bool expand(Board& board, int ply);
+        void search(Board& board, int ply, std::uint32_t thresholdPn, std::uint32_t thresholdDn);
+        void extractLine(Board& board, int plies, std::vector<Move>& line);
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_ENGINE_MATESOLVER_H
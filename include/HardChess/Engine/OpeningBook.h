@@ -0,0 +1,61 @@
+#ifndef HARDCHESS_ENGINE_OPENINGBOOK_H
+#define HARDCHESS_ENGINE_OPENINGBOOK_H
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/IO/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace HardChess {
+
+    // One polyglot book entry. On disk each entry is 16 bytes, big-endian, and the file
+    // is sorted by key so all moves for a position are contiguous.
+    struct BookEntry {
+        std::uint64_t key = 0;
+        std::uint16_t move = 0; // Polyglot move encoding, see OpeningBook::encodeMove
+        std::uint16_t weight = 0;
+        std::uint32_t learn = 0;
+    };
+
+    // Read-only polyglot (".bin") opening book. The file is memory-mapped, so lookups
+    // are a binary search over the page cache and several processes share one copy.
+    class OpeningBook {
+      private:
+        MappedFile file;
+        std::size_t count;
+
+        BookEntry entryAt(std::size_t i) const;
+
+      public:
+        static constexpr std::size_t ENTRY_SIZE = 16;
+        static constexpr std::size_t MAX_MOVES = 64; // Per position; more are ignored
+
+        OpeningBook();
+
+        bool open(const std::string& path); // false if unreadable or not a whole number of entries
+        void close();
+        bool isOpen() const { return file.isOpen(); }
+        std::size_t size() const { return count; }
+
+        // Copies up to maxEntries entries for key into out and returns how many were found
+        std::size_t find(std::uint64_t key, BookEntry* out, std::size_t maxEntries) const;
+
+        // Picks a book move for the position with probability proportional to its weight.
+        // Entries that are not legal here (hash collisions, corrupt books) are skipped.
+        bool probe(Board& board, std::mt19937_64& rng, Move& move) const;
+
+        // Polyglot move encoding: to file (bits 0-2), to rank (3-5), from file (6-8),
+        // from rank (9-11), promotion (12-14; 1=N 2=B 3=R 4=Q). Castling is written as
+        // the king capturing its own rook (e1h1, e1a1, e8h8, e8a8).
+        static std::uint16_t encodeMove(const Move& move);
+        static bool decodeMove(std::uint16_t code, Board& board, Move& move); // Matched against legal moves
+
+        static void writeEntry(const BookEntry& entry, unsigned char* out); // ENTRY_SIZE bytes
+        static BookEntry readEntry(const unsigned char* in);
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_ENGINE_OPENINGBOOK_H
@@ -0,0 +1,130 @@
+#ifndef HARDCHESS_ENGINE_SEARCH_H
+#define HARDCHESS_ENGINE_SEARCH_H
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/Move.h"
+#include "HardChess/Core/RepetitionHistory.h"
+#include "HardChess/Util/Allocators.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace HardChess {
+
+    // Budget for one search; zero means "no limit" for depth, nodes and timeMs.
+    // At least one of depth, nodes or timeMs should be set.
+    struct SearchLimits {
+        int depth = 0;
+        long long nodes = 0;
+        int timeMs = 0;
+        int multiPv = 0;        // Best root moves to report with their own scores and PVs; 0 means 1
+    };
+
+    // One root move's line
+    struct SearchLine {
+        Move move;
+        int score = 0;          // Exact, from the side to move's point of view
+        int depth = 0;          // Iteration the score comes from
+        long long nodes = 0;    // Nodes spent below this move over all iterations
+        std::vector<Move> pv;   // Starts with move
+    };
+
+    struct SearchResult {
+        Move bestMove;
+        int score = 0;          // Centipawns from the side to move's point of view
+        int depth = 0;          // Last fully completed iteration
+        long long nodes = 0;
+        std::vector<Move> pv;
+        bool hasMove = false;   // False when the root position has no legal move
+        // The best min(multiPv, legal moves) root moves, best first; lines[0] is bestMove,
+        // score and pv. Empty if not even the first iteration completed.
+        std::vector<SearchLine> lines;
+    };
+
+    // Iterative-deepening alpha-beta search with quiescence. Repetitions and the
+    // fifty-move rule score as draws. One instance per thread;
+    // the move lists and PV table are reused between searches, and per-node scratch
+    // comes from the calling thread's Arena, rewound as each node returns.
+    //
+    // Multi-PV shares one pass over the root moves per iteration rather than running K
+    // searches: the root window's lower bound is the K-th best score found so far instead
+    // of the best, so every move that makes the top K gets an exact score and its own PV
+    // while the rest fail low as cheaply as in a single-PV search. Root moves are searched
+    // in the order of the previous iteration's scores, each following its own previous PV,
+    // and a table of the best move found in each position (cleared per search by a
+    // generation stamp) orders the moves below them, so each iteration reuses the one
+    // before, whatever K is.
+    class Search {
+      public:
+        static constexpr int MAX_PLY = 64;
+        static constexpr int MATE_SCORE = 30000;
+        static constexpr int MATE_BOUND = MATE_SCORE - MAX_PLY; // Scores beyond this are mates
+
+        Search();
+
+        // gameHistory, if given, holds the game's positions up to and including board's, so
+        // lines that repeat a position played earlier in the game are scored as draws
+        SearchResult run(Board& board, const SearchLimits& limits, const RepetitionHistory* gameHistory = nullptr);
+
+        // Asks a running search to return as soon as possible (safe from any thread).
+        // The result holds the last completed iteration. The request stays until
+        // clearStop(), so a stop() that lands before run() gets going still stops it.
+        void stop() { stopRequested.store(true, std::memory_order_relaxed); }
+        // Withdraws a stop request; call it before reusing a Search that was stopped
+        void clearStop() { stopRequested.store(false, std::memory_order_relaxed); }
+
+        // Mate distance in moves for a mate score (negative when being mated), 0 otherwise
+        static int mateInMoves(int score);
+
+      private:
+        static constexpr int HASH_MOVE_BITS = 18;
+
+        struct HashMove {
+            std::uint32_t check;        // High half of the key
+            std::uint16_t move;         // Move::encode(), 0 for none
+            std::uint8_t generation;    // The search that stored it
+            std::uint8_t depth;
+        };
+
+        struct RootMove {
+            Move move;
+            int score;                  // Exact if it made the top K, else an upper bound
+            int depth;
+            long long nodes;
+            std::vector<Move> pv;
+            int iterationScore;         // The running iteration's, committed once it completes
+            std::vector<Move> iterationPv;
+        };
+
+        std::vector<Move> moveLists[MAX_PLY + 1];
+        int* orderScores[MAX_PLY + 1];
+        Move pvTable[MAX_PLY + 1][MAX_PLY + 1];
+        int pvLength[MAX_PLY + 1];
+        std::vector<Move> previousPv;
+        std::vector<RootMove> rootMoves;
+        std::vector<int> bestScores; // The running iteration's top exact root scores, best first
+        std::vector<HashMove> hashMoves;
+        std::uint8_t generation;
+        RepetitionHistory history; // The game's positions followed by the current line
+
+        SearchLimits limits;
+        std::chrono::steady_clock::time_point deadline;
+        long long nodes;
+        bool aborted;
+        std::atomic<bool> stopRequested;
+        Arena* scratch;
+
+        void searchRoot(Board& board, int depth, int lines);
+        int negamax(Board& board, int depth, int alpha, int beta, int ply);
+        int quiescence(Board& board, int alpha, int beta, int ply);
+        std::uint16_t probeHashMove(std::uint64_t key) const;
+        void storeHashMove(std::uint64_t key, const Move& move, int depth);
+        void orderMoves(const Board& board, int ply, std::uint16_t hashMove = 0);
+        void pickNext(int ply, std::size_t index);
+        bool shouldStop();
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_ENGINE_SEARCH_H
@@ -0,0 +1,116 @@
+#ifndef HARDCHESS_ENGINE_TABLEBASE_H
+#define HARDCHESS_ENGINE_TABLEBASE_H
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/IO/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace HardChess {
+
+    // Material of one endgame table: the non-king pieces of each side, strongest first.
+    // Tables are stored with White as the stronger side; "KRvKP" covers KP v KR too.
+    struct TbMaterial {
+        PieceType pieces[2][3] = {}; // [0] White, [1] Black
+        int counts[2] = {0, 0};
+
+        static bool parse(std::string_view name, TbMaterial& material); // "KQvK", "KRPvK", ...
+        std::string name() const;
+        std::uint32_t key() const; // Distinct for every material, colors distinguished
+        int men() const { return 2 + counts[0] + counts[1]; }
+        bool hasPawns() const;
+        bool isCanonical() const; // White's pieces are at least as strong as Black's
+        TbMaterial canonical() const; // Sides swapped if needed, pieces strongest first
+        std::size_t entryCount() const;
+    };
+
+    // Up to four men in table form. Squares are numbered a1 = 0 .. h8 = 63; kings come
+    // first (White, Black), followed by White's and then Black's other pieces.
+    struct TbPosition {
+        int men = 0;
+        PieceType types[4] = {};
+        Color colors[4] = {};
+        int squares[4] = {};
+        Color sideToMove = Color::WHITE;
+
+        TbMaterial material() const;
+        // false for positions a table cannot describe (too many men, castling rights, en passant)
+        static bool fromBoard(const Board& board, TbPosition& position);
+    };
+
+    // One byte per position: 0 draw, 1 not a legal position, otherwise 2 + plies to mate.
+    // Odd ply counts are wins for the side to move, even ones (0 = mated) losses.
+    namespace TbValue {
+        constexpr std::uint8_t DRAW = 0;
+        constexpr std::uint8_t INVALID = 1;
+        constexpr std::uint8_t UNKNOWN = 255; // Only while generating
+        constexpr int MAX_PLIES = 252;
+
+        inline std::uint8_t fromPlies(int plies) { return static_cast<std::uint8_t>(plies + 2); }
+        inline bool isDecisive(std::uint8_t value) { return value >= 2 && value != UNKNOWN; }
+        inline int plies(std::uint8_t value) { return value - 2; }
+        inline bool isWin(std::uint8_t value) { return isDecisive(value) && (plies(value) & 1); }
+        inline bool isLoss(std::uint8_t value) { return isDecisive(value) && !(plies(value) & 1); }
+    } // namespace TbValue
+
+    enum class TbOutcome { LOSS, DRAW, WIN };
+
+    struct TbResult {
+        TbOutcome outcome = TbOutcome::DRAW; // For the side to move
+        int plies = 0;                       // Plies to mate with best play; 0 for draws
+    };
+
+    // Memory-mapped endgame tables produced by tbgen. File layout ("<name>.hctb"):
+    //   header { char magic[4] = "HCTB"; u32 version; char name[16]; u64 entryCount; }
+    //   values { u8 value[entryCount]; }  indexed by Tablebase::index
+    class Tablebase {
+      private:
+        struct Table {
+            TbMaterial material;
+            MappedFile file;
+            const std::uint8_t* values = nullptr;
+            std::size_t count = 0;
+        };
+        std::vector<std::unique_ptr<Table>> tables;
+        std::unordered_map<std::uint32_t, const Table*> byKey;
+        int largestTable;
+
+      public:
+        static constexpr int MAX_MEN = 4;
+        static constexpr std::size_t HEADER_SIZE = 32;
+        static constexpr std::uint32_t VERSION = 1;
+
+        Tablebase();
+
+        bool open(const std::string& directory); // Maps every .hctb file; false if none
+        bool load(const std::string& path);
+        std::size_t size() const { return tables.size(); }
+        int maxMen() const { return largestTable; }
+
+        // Value for the side to move, or false if no table covers the position
+        bool lookup(const TbPosition& position, std::uint8_t& value) const;
+        bool probe(const Board& board, TbResult& result) const;
+        // The move that wins fastest, holds the draw, or loses slowest
+        bool bestMove(Board& board, Move& move, TbResult& result) const;
+
+        // Indexing, shared with the generator. canonicalize() swaps colors so White is the
+        // stronger side, orders the pieces and applies board symmetry: all eight for
+        // pawnless tables (White king in the a1-d1-d4 triangle), left-right otherwise.
+        static void canonicalize(TbPosition& position);
+        static std::size_t index(const TbPosition& canonicalPosition);
+        static void decode(const TbMaterial& material, std::size_t index, TbPosition& position);
+
+        static std::string fileName(const TbMaterial& material);
+        static bool writeTable(const std::string& path, const TbMaterial& material, const std::uint8_t* values,
+                               std::size_t count);
+        static bool readTable(const std::string& path, const TbMaterial& material, std::vector<std::uint8_t>& values);
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_ENGINE_TABLEBASE_H
@@ -0,0 +1,48 @@
+#ifndef HARDCHESS_ENGINE_TABLEBASEGENERATOR_H
+#define HARDCHESS_ENGINE_TABLEBASEGENERATOR_H
+
+#include "HardChess/Engine/Tablebase.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace HardChess {
+
+    struct TbGenerationReport {
+        std::string name;
+        bool loaded = false; // Read from an existing file instead of generated
+        std::size_t entries = 0;
+        std::size_t legal = 0;
+        std::size_t wins = 0; // For the side to move
+        std::size_t losses = 0;
+        std::size_t draws = 0;
+        int longestMate = 0; // Plies
+        double seconds = 0;
+        std::size_t bytes = 0;
+    };
+
+    // Retrograde analysis for the tables of Tablebase. Captures and promotions lead into
+    // smaller or different tables, which are generated (or loaded from the output
+    // directory) first. Within a table, positions are resolved in order of distance to
+    // mate: every newly decided position marks its predecessors (found by unmaking
+    // moves) as won, or re-checks whether all their moves now lose.
+    class TablebaseGenerator {
+      private:
+        std::string directory;
+        unsigned threads;
+        std::unordered_map<std::uint32_t, std::vector<std::uint8_t>> tables;
+
+        bool build(const TbMaterial& material, TbGenerationReport& report);
+
+      public:
+        TablebaseGenerator(const std::string& outputDirectory, unsigned threadCount = 0);
+
+        // Generates material and everything it converts into; one report per table touched
+        bool generate(const TbMaterial& material, std::vector<TbGenerationReport>& reports);
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_ENGINE_TABLEBASEGENERATOR_H
@@ -0,0 +1,43 @@
+#ifndef HARDCHESS_IO_BUFFEREDWRITER_H
+#define HARDCHESS_IO_BUFFEREDWRITER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HardChess {
+
+    // Output file written through one large buffer: one write(2) per buffer-full
+    // instead of one per record.
+    class BufferedWriter {
+      private:
+        int fd;
+        bool ownsFd;
+        std::vector<char> buffer;
+        std::size_t used;
+        bool failed;
+
+      public:
+        explicit BufferedWriter(std::size_t bufferSize = 1 << 20);
+        ~BufferedWriter(); // Flushes and closes
+        BufferedWriter(const BufferedWriter&) = delete;
+        BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+        // "-" or "" writes stdout. append keeps existing contents.
+        bool open(const std::string& path, bool append = false);
+        bool close();
+
+        void write(const void* data, std::size_t size);
+        void write(std::string_view text) { write(text.data(), text.size()); }
+        void put(char ch) {
+            if (used == buffer.size()) flush();
+            buffer[used++] = ch;
+        }
+        bool flush();
+        bool ok() const { return !failed; }
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_IO_BUFFEREDWRITER_H
@@ -0,0 +1,84 @@
+#ifndef HARDCHESS_IO_GAMEARCHIVE_H
+#define HARDCHESS_IO_GAMEARCHIVE_H
+
+#include "HardChess/Core/GameRecord.h"
+#include "HardChess/IO/BufferedWriter.h"
+#include "HardChess/IO/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HardChess {
+
+    // Binary game archive (".hcga"), little-endian. It is lossy: a game keeps its moves,
+    // result and start position only. PGN tags (players, event, date, ratings), comments
+    // and variations are not stored, so keep the PGN when those matter.
+    //
+    // Layout:
+    //   header  { char magic[4] = "HCGA"; u32 version; u64 gameCount; u64 indexOffset; u64 reserved; }
+    //   games   { varint head = moveCount << 3 | hasFEN << 2 | result;
+    //             if hasFEN: u8 fenLength; char fen[fenLength];
+    //             zero padding to even; u16 moves[moveCount]; }   each game starts 2-byte aligned
+    // The head is LEB128: 7 bits a byte, low first, so a game under 2048 plies with the
+    // standard start costs two bytes before its moves, and half a byte of index.
+    //   index   { u64 offset[ceil(gameCount / 16)]; }  8-byte aligned, the offset of every
+    //             16th game: game i is found by skipping at most 15 heads from entry i / 16
+    constexpr std::size_t gameArchiveIndexStride = 16;
+
+    struct GameArchiveHeader {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t gameCount;
+        std::uint64_t indexOffset;
+        std::uint64_t reserved;
+    };
+
+    // One game as stored in a mapped archive; all views point into the mapping
+    struct ArchivedGame {
+        GameResult result = GameResult::UNKNOWN;
+        std::string_view startFEN; // Empty for the standard initial position
+        MoveCodeView moves;
+    };
+
+    class GameArchiveWriter {
+      private:
+        BufferedWriter out;
+        std::vector<std::uint64_t> offsets; // Of every gameArchiveIndexStride-th game
+        std::uint64_t games;
+        std::uint64_t position;
+        std::string path;
+        bool isOpen;
+
+      public:
+        GameArchiveWriter();
+        ~GameArchiveWriter();
+
+        bool open(const std::string& archivePath);
+        bool add(const GameRecord& record); // false if the record cannot be stored (e.g. > 65535 plies)
+        bool close();                       // Writes the index and finalizes the header
+        std::size_t gameCount() const { return static_cast<std::size_t>(games); }
+    };
+
+    class GameArchive {
+      private:
+        MappedFile file;
+        const std::uint64_t* index;
+        std::uint64_t count;
+
+        // Reads the game at offset; next receives where the following game starts
+        bool gameAt(std::uint64_t offset, ArchivedGame& out, std::uint64_t& next) const;
+
+      public:
+        GameArchive();
+
+        bool open(const std::string& archivePath); // Validates header and index bounds
+        std::size_t size() const { return static_cast<std::size_t>(count); }
+        bool game(std::size_t i, ArchivedGame& out) const;
+        std::size_t bytes() const { return file.size(); }
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_IO_GAMEARCHIVE_H
@@ -0,0 +1,37 @@
+#ifndef HARDCHESS_IO_LINEREADER_H
+#define HARDCHESS_IO_LINEREADER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HardChess {
+
+    // Streams lines from a file or stdin through one fixed buffer, so memory use does
+    // not depend on the input size. Returned lines are views into the buffer and stay
+    // valid only until the next call to next().
+    class LineReader {
+      private:
+        int fd;
+        bool ownsFd;
+        std::vector<char> buffer;
+        std::size_t begin;
+        std::size_t end;
+        bool atEof;
+
+        bool fill();
+
+      public:
+        explicit LineReader(std::size_t bufferSize = 1 << 20);
+        ~LineReader();
+        LineReader(const LineReader&) = delete;
+        LineReader& operator=(const LineReader&) = delete;
+
+        bool open(const std::string& path); // "-" or "" reads stdin
+        bool next(std::string_view& line);  // Strips the trailing "\n" / "\r\n"
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_IO_LINEREADER_H
@@ -0,0 +1,40 @@
+#ifndef HARDCHESS_IO_MAPPEDFILE_H
+#define HARDCHESS_IO_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace HardChess {
+
+    // Read-only memory mapping of a whole file. Pages are shared through the OS page
+    // cache, so several processes mapping the same file do not duplicate it in RAM.
+    class MappedFile {
+      private:
+        const char* mapping;
+        std::size_t length;
+        bool opened;
+
+      public:
+        MappedFile();
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool open(const std::string& path); // false if the file cannot be opened or mapped
+        void close();
+
+        bool isOpen() const { return opened; }
+        const char* data() const { return mapping; }
+        std::size_t size() const { return length; }
+        std::string_view view() const { return std::string_view(mapping, length); }
+
+        // Hints the kernel that the mapping will be read front to back
+        void adviseSequential() const;
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_IO_MAPPEDFILE_H
@@ -0,0 +1,93 @@
+#ifndef HARDCHESS_IO_PGNREADER_H
+#define HARDCHESS_IO_PGNREADER_H
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/GameRecord.h"
+#include "HardChess/Core/Move.h"
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace HardChess {
+
+    // One game inside a PGN buffer. Both sections point into the caller's buffer
+    // (usually a MappedFile), so nothing is copied per game.
+    struct PgnGame {
+        std::string_view tagSection; // "[Name "value"]" lines
+        std::string_view movetext;   // Moves, comments, variations and the result token
+
+        // Raw tag value without the surrounding quotes; empty if the tag is missing
+        std::string_view tag(std::string_view name) const;
+    };
+
+    // Callbacks fired while a game is replayed. Every hook is optional.
+    class PgnVisitor {
+      public:
+        virtual ~PgnVisitor() = default;
+        virtual void onGameStart(const PgnGame& /*game*/, const Board& /*board*/) {}
+        // board is the position before the move is applied
+        virtual void onMove(const Board& /*board*/, const Move& /*move*/, std::string_view /*san*/) {}
+        // result is the movetext termination token ("1-0", "0-1", "1/2-1/2", "*"), ok is false on replay errors
+        virtual void onGameEnd(const PgnGame& /*game*/, const Board& /*board*/, std::string_view /*result*/, bool /*ok*/) {}
+    };
+
+    // Collects every successfully replayed game into a GameRecord and hands it to sink.
+    // The record is reused between games, so the sink must copy what it keeps.
+    class PgnRecordBuilder : public PgnVisitor {
+      private:
+        GameRecord record;
+        std::function<void(const GameRecord&)> sink;
+
+      public:
+        explicit PgnRecordBuilder(std::function<void(const GameRecord&)> recordSink);
+        void onGameStart(const PgnGame& game, const Board& board) override;
+        void onMove(const Board& board, const Move& move, std::string_view san) override;
+        void onGameEnd(const PgnGame& game, const Board& board, std::string_view result, bool ok) override;
+    };
+
+    struct PgnStats {
+        std::size_t games = 0;
+        std::size_t moves = 0;
+        std::size_t errors = 0; // Games abandoned on an illegal or unparsable move
+
+        PgnStats& operator+=(const PgnStats& other) {
+            games += other.games;
+            moves += other.moves;
+            errors += other.errors;
+            return *this;
+        }
+    };
+
+    class PgnReader {
+      private:
+        std::string_view text;
+        std::size_t offset;
+
+      public:
+        explicit PgnReader(std::string_view pgnText);
+
+        // Advances to the next game; false at end of input
+        bool nextGame(PgnGame& game);
+
+        // Replays the movetext of one game onto board, starting from its FEN tag or the
+        // initial position. scratch is a reusable move list. Returns false on the first bad move.
+        static bool replayGame(const PgnGame& game, Board& board, std::vector<Move>& scratch,
+                               PgnVisitor* visitor, PgnStats& stats);
+
+        // Reads and replays every game in text on the calling thread
+        static PgnStats replayAll(std::string_view text, PgnVisitor* visitor = nullptr);
+
+        // Cuts text into at most parts slices that each start at a game boundary: a tag
+        // pair line after a blank line, outside any {comment}
+        static std::vector<std::string_view> splitAtGameBoundaries(std::string_view text, unsigned parts);
+
+        // Replays slices of text on separate threads. visitors, if given, must hold one
+        // visitor per thread; each is only ever called from its own thread.
+        static PgnStats replayParallel(std::string_view text, unsigned threads,
+                                       const std::vector<PgnVisitor*>& visitors = {});
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_IO_PGNREADER_H
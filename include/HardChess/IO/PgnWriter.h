@@ -0,0 +1,53 @@
+#ifndef HARDCHESS_IO_PGNWRITER_H
+#define HARDCHESS_IO_PGNWRITER_H
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/GameRecord.h"
+#include "HardChess/Core/Move.h"
+#include "HardChess/IO/BufferedWriter.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HardChess {
+
+    struct PgnTag {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    // Writes GameRecords as PGN in export format: tags, then SAN movetext (from
+    // Notation::formatSAN) wrapped below 80 columns, then the result. The board, the
+    // move-list scratch and the text buffer are reused between games.
+    class PgnWriter {
+      private:
+        BufferedWriter out;
+        Board board;
+        std::vector<Move> scratch;
+        std::string text;      // The game being written; reaches out only once it is complete
+        std::size_t lineStart; // Offset in text of the current movetext line
+        std::size_t games;
+        bool writing;
+
+        void writeToken(std::string_view token);
+        void writeTag(std::string_view name, std::string_view value);
+
+      public:
+        PgnWriter();
+        ~PgnWriter();
+
+        // "-" writes stdout; append adds games after the file's existing contents
+        bool open(const std::string& path, bool append = false);
+        // Writes one game. The Result tag, and SetUp/FEN for a non-standard start, are
+        // added after tags. False if the start position or a move does not fit the game.
+        bool add(const GameRecord& record, const std::vector<PgnTag>& tags = {});
+        bool flush() { return out.flush(); }
+        bool close();
+        bool isOpen() const { return writing; }
+        std::size_t gameCount() const { return games; }
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_IO_PGNWRITER_H
@@ -0,0 +1,66 @@
+#ifndef HARDCHESS_IO_PNG_H
+#define HARDCHESS_IO_PNG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HardChess {
+
+    namespace Png {
+
+        // 8-bit RGBA pixels, row by row, top row first
+        struct Image {
+            int width = 0;
+            int height = 0;
+            std::vector<std::uint8_t> pixels;
+        };
+
+        // Decodes a non-interlaced PNG with 8-bit samples (grayscale, RGB or palette,
+        // with or without alpha) to RGBA; false on anything else or on corrupt data.
+        // Self-contained inflate, so the renderer needs no image library.
+        bool decode(const std::uint8_t* data, std::size_t size, Image& image);
+        bool load(const std::string& path, Image& image);
+
+    } // namespace Png
+
+    // Writes PNG images and animated PNGs (APNG, one fcTL/fdAT pair per frame) from RGB
+    // or RGBA pixels. Rows get the Sub or Up filter, whichever leaves smaller residuals,
+    // and deflate uses fixed Huffman codes with a hash-chain match finder: cheap, and
+    // effective on diagrams made of flat squares and repeated sprites. Every buffer is
+    // kept between images, so encoding a stream of frames allocates nothing once warm.
+    class PngEncoder {
+      public:
+        PngEncoder();
+
+        // Replaces out with a complete PNG of width x height pixels; channels is 3 or 4
+        void encode(const std::uint8_t* pixels, int width, int height, int channels, std::vector<std::uint8_t>& out);
+
+        // An animation of exactly `frames` frames, each shown for delayMs; loops == 0
+        // repeats forever. Frames are appended to out as they are added.
+        void beginAnimation(int width, int height, int channels, int frames, int delayMs, int loops,
+                            std::vector<std::uint8_t>& out);
+        void addFrame(const std::uint8_t* pixels, std::vector<std::uint8_t>& out);
+        void endAnimation(std::vector<std::uint8_t>& out);
+
+      private:
+        int width;
+        int height;
+        int channels;
+        int delayMs;
+        std::uint32_t sequence; // APNG chunk sequence number
+        bool firstFrame;
+        std::vector<std::uint8_t> filtered;   // Rows, each prefixed with its filter type
+        std::vector<std::uint8_t> compressed; // zlib stream of filtered
+        std::vector<std::int32_t> head;       // Latest position per 3-byte hash
+        std::vector<std::int32_t> previous;   // Earlier position with the same hash, per window slot
+
+        void filterRows(const std::uint8_t* pixels);
+        void compress();
+        void writeHeader(std::vector<std::uint8_t>& out);
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_IO_PNG_H
@@ -0,0 +1,122 @@
+#ifndef HARDCHESS_IO_POSITIONINDEX_H
+#define HARDCHESS_IO_POSITIONINDEX_H
+
+#include "HardChess/IO/BufferedWriter.h"
+#include "HardChess/IO/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HardChess {
+
+    // Opening-explorer index (".hcpi"), little-endian:
+    //   header  { char magic[8] = "HCPINDEX"; u32 version; u32 blockCount; u64 positionCount;
+    //             u64 entryCount; u64 gameCount; u64 keysOffset; u64 offsetsOffset; u64 reserved; }
+    //   blocks  Runs of entries sorted by (key, move), a position never split across two
+    //           blocks. Each entry is five LEB128 varints: key minus the previous entry's key
+    //           (the block's first key for its first entry), move, White wins, draws, Black
+    //           wins.
+    //   keys    { u64 firstKey[blockCount]; }        8-byte aligned
+    //   offsets { u64 blockOffset[blockCount + 1]; } the last one ends the final block
+    // An entry counts the games that played `move` (Move::encode()) from the position with
+    // that Zobrist key; move 0 counts games that ended there.
+    struct PositionIndexHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t blockCount;
+        std::uint64_t positionCount;
+        std::uint64_t entryCount;
+        std::uint64_t gameCount;
+        std::uint64_t keysOffset;
+        std::uint64_t offsetsOffset;
+        std::uint64_t reserved;
+    };
+
+    // Results of the games that reached a position, or that played one move from it
+    struct ExplorerCounts {
+        std::uint64_t whiteWins = 0;
+        std::uint64_t draws = 0;     // Including unfinished games
+        std::uint64_t blackWins = 0;
+
+        std::uint64_t games() const { return whiteWins + draws + blackWins; }
+    };
+
+    struct ExplorerMove {
+        std::uint16_t move = 0; // Move::encode(); Board::decodeMove restores the flags
+        ExplorerCounts counts;
+    };
+
+    // One aggregated (position, move) pair, as the builder hands them to the writer
+    struct PositionIndexEntry {
+        std::uint64_t key;
+        std::uint16_t move;
+        std::uint16_t padding;
+        std::uint32_t whiteWins;
+        std::uint32_t draws;
+        std::uint32_t blackWins;
+    };
+
+    // Writes entries in (key, move) order, which the caller guarantees; blocks close at
+    // the first position boundary past BLOCK_BYTES.
+    class PositionIndexWriter {
+      private:
+        BufferedWriter out;
+        std::string path;
+        std::vector<std::uint64_t> firstKeys;
+        std::vector<std::uint64_t> offsets;
+        std::vector<unsigned char> block; // Encoded entries of the open block
+        std::uint64_t position;           // Bytes written so far
+        std::uint64_t previousKey;
+        std::uint64_t positionCount;
+        std::uint64_t entryCount;
+        bool isOpen;
+
+        void flushBlock();
+
+      public:
+        static constexpr std::size_t BLOCK_BYTES = 1024;
+
+        PositionIndexWriter();
+        ~PositionIndexWriter();
+
+        bool open(const std::string& indexPath);
+        void add(const PositionIndexEntry& entry);
+        bool close(std::uint64_t gameCount); // Writes the tables and finalizes the header
+
+        std::uint64_t positions() const { return positionCount; }
+        std::uint64_t entries() const { return entryCount; }
+    };
+
+    // Read-only, memory-mapped index. A lookup is a binary search over the mapped block
+    // keys and a scan of one block of a few KB; nothing is read on open beyond the
+    // header, so opening is instant and processes share the pages.
+    class PositionIndex {
+      private:
+        MappedFile file;
+        const std::uint64_t* firstKeys;
+        const std::uint64_t* offsets;
+        PositionIndexHeader header;
+
+      public:
+        PositionIndex();
+
+        bool open(const std::string& indexPath); // Validates the header and table bounds
+        bool isOpen() const { return file.isOpen(); }
+
+        // Totals over every game that reached the position with this key, and up to
+        // maxMoves of the moves played from it, in Move::encode() order. Returns the
+        // number of moves found (possibly more than maxMoves); total.games() is 0 for a
+        // position the index has never seen.
+        std::size_t find(std::uint64_t key, ExplorerCounts& total, ExplorerMove* moves, std::size_t maxMoves) const;
+
+        std::uint64_t positions() const { return header.positionCount; }
+        std::uint64_t entries() const { return header.entryCount; }
+        std::uint64_t games() const { return header.gameCount; }
+        std::size_t blocks() const { return header.blockCount; }
+        std::size_t bytes() const { return file.size(); }
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_IO_POSITIONINDEX_H
@@ -0,0 +1,94 @@
+#ifndef HARDCHESS_IO_TRAININGDATA_H
+#define HARDCHESS_IO_TRAININGDATA_H
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/IO/BufferedWriter.h"
+#include "HardChess/IO/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace HardChess {
+
+    // One labelled position for evaluator training: 32 bytes, little-endian
+    struct PackedPosition {
+        std::uint64_t occupancy = 0;  // Bit i set when square i (0 = a8 ... 63 = h1) holds a piece
+        std::uint8_t pieces[16] = {}; // A nibble per occupied square in ascending order, low nibble
+                                      // first: PieceType, plus 8 for Black
+        std::int16_t score = 0;       // Search score in centipawns for the side to move
+        std::int8_t result = 0;       // Game result for the side to move: 1 win, 0 draw, -1 loss
+        std::uint8_t flags = 0;       // Bit 0 Black to move; bits 1-4 castling rights (CastlingRight)
+        std::uint8_t enPassant = 64;  // En passant target square, 64 for none
+        std::uint8_t halfmoveClock = 0;
+        std::uint16_t fullmoveNumber = 1;
+
+        static constexpr std::uint8_t NO_SQUARE = 64;
+        static constexpr std::size_t MAX_FEN_LENGTH = 96;
+
+        static PackedPosition pack(const Board& board, int score, int result);
+
+        bool whiteToMove() const { return (flags & 1) == 0; }
+        // Writes the position as FEN without allocating; out must hold MAX_FEN_LENGTH chars.
+        // Returns the length (not terminated).
+        std::size_t writeFEN(char* out) const;
+    };
+    static_assert(sizeof(PackedPosition) == 32, "PackedPosition is the on-disk record");
+
+    // Training data shard (".hctd"), little-endian:
+    //   header  { char magic[8] = "HCTRDATA"; u32 version; u32 recordSize; u64 recordCount;
+    //             u64 seed; }
+    //   records { PackedPosition record[recordCount]; }
+    // seed is the shard's generator seed, so a shard can be reproduced on its own.
+    struct TrainingDataHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t recordSize;
+        std::uint64_t recordCount;
+        std::uint64_t seed;
+    };
+    static_assert(sizeof(TrainingDataHeader) == sizeof(PackedPosition), "records stay aligned after the header");
+
+    class TrainingDataWriter {
+      private:
+        BufferedWriter out;
+        std::string path;
+        std::uint64_t count;
+        std::uint64_t seed;
+        bool isOpen;
+
+      public:
+        TrainingDataWriter();
+        ~TrainingDataWriter();
+
+        bool open(const std::string& shardPath, std::uint64_t shardSeed);
+        void add(const PackedPosition& record) { out.write(&record, sizeof(record)); ++count; }
+        bool close(); // Finalizes the header
+        std::uint64_t size() const { return count; }
+    };
+
+    // Streams the records of a shard straight out of the mapping; next() never allocates
+    class TrainingDataReader {
+      private:
+        MappedFile file;
+        const PackedPosition* records;
+        std::uint64_t count;
+        std::uint64_t cursor;
+        std::uint64_t shardSeed;
+
+      public:
+        TrainingDataReader();
+
+        bool open(const std::string& shardPath); // Validates header and length
+        bool next(const PackedPosition*& record) {
+            if (cursor == count) return false;
+            record = records + cursor++;
+            return true;
+        }
+        void rewind() { cursor = 0; }
+        std::size_t size() const { return static_cast<std::size_t>(count); }
+        std::uint64_t seed() const { return shardSeed; }
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_IO_TRAININGDATA_H
@@ -0,0 +1,101 @@
+#ifndef HARDCHESS_NET_MATCHSERVER_H
+#define HARDCHESS_NET_MATCHSERVER_H
+
+#include "HardChess/Engine/Search.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace HardChess {
+
+    class OpeningBook;
+    enum class RoundEnd;
+    class Tablebase;
+    class ThreadPool;
+
+    struct ServerOptions {
+        std::string address = "7070";          // See Socket.h; TCP binds to 127.0.0.1 unless told otherwise
+        unsigned loops = 1;                    // Event-loop threads sharing the sessions
+        unsigned engineThreads = 0;            // Engine compute pool; 0 uses every core
+        SearchLimits engineLimits;             // Per computer move once out of book and tables
+        const OpeningBook* book = nullptr;
+        const Tablebase* tablebase = nullptr;
+    };
+
+    // Hosts many HardChess matches at once, one per connection, over a line protocol.
+    // A few event-loop threads own the sockets and the matches; engine moves run on a
+    // separate pool and come back to the owning loop, so a long search never holds up
+    // other sessions and an idle session costs a descriptor and a few hundred bytes.
+    //
+    //   server: hello hardchess 1                        on connect
+    //   match WHITE BLACK|computer -> ok match WHITE BLACK rounds 2 hearts 3, round 1 start
+    //   move SAN|COORD   -> played COORD SAN; then, with the computer to move, later
+    //                       engine COORD SAN SOURCE
+    //   resign, board (board FEN), moves (moves COORD...), ping (pong), stats, quit (bye)
+    //
+    // A move or resignation that ends a round is followed by
+    //   round N end 1-0|0-1|1/2-1/2 REASON score W B hearts W B
+    // and then either "round N+1 start" or "match end white|black|draw score W B hearts W B".
+    // Anything refused gets "error TEXT".
+    class MatchServer {
+      public:
+        explicit MatchServer(const ServerOptions& options);
+        ~MatchServer();
+        MatchServer(const MatchServer&) = delete;
+        MatchServer& operator=(const MatchServer&) = delete;
+
+        bool listen(std::string& error); // Binds the address; false with error set on failure
+        void run();  // Serves until stop(); the calling thread runs the first loop
+        void stop(); // From any thread; a signal handler writes to stopDescriptor() instead
+        // Writing a byte to this descriptor stops the server from its first loop. write(2) is
+        // async-signal-safe, so a SIGINT handler may do it. Valid once listen() succeeds.
+        int stopDescriptor() const { return stopWrite; }
+
+      private:
+        struct Loop;
+        struct Session;
+        struct EngineReply;
+
+        ServerOptions options;
+        int listenFd;
+        int stopRead;                          // Pipe behind stopDescriptor(), watched by the first loop
+        int stopWrite;
+        std::vector<std::unique_ptr<Loop>> loops;
+        std::unique_ptr<ThreadPool> engines;
+        std::atomic<bool> stopping;
+        std::atomic<bool> acceptPaused;        // Out of descriptors: the listen socket is unwatched
+        unsigned nextLoop;                     // Round-robin target for accepted sessions
+        std::atomic<std::uint64_t> nextSerial;
+        std::chrono::steady_clock::time_point started;
+
+        std::atomic<long long> sessionsOpen;
+        std::atomic<long long> matchesStarted;
+        std::atomic<long long> movesPlayed;    // By clients
+        std::atomic<long long> engineMoves;
+        std::atomic<long long> engineMicros;   // Spent computing engine moves, summed over the pool
+
+        void serve(Loop& loop);
+        void acceptAll();
+        void resumeAccepting(); // First loop only
+        void adopt(Loop& loop, int fd);
+        void drainWake(Loop& loop);
+        void readFrom(Loop& loop, Session& session);
+        void send(Session& session, const std::string& line); // Queued; settle() writes it
+        void flush(Loop& loop, Session& session);
+        void settle(Loop& loop, Session& session); // Writes what is queued, closes if finished
+        void closeSession(Loop& loop, int fd);
+        void handleLine(Loop& loop, Session& session, const std::string& line);
+        void startMatch(Session& session, const std::string& white, const std::string& black);
+        void playMove(Loop& loop, Session& session, const std::string& text);
+        void reportRoundEnd(Session& session, RoundEnd end);
+        void askEngine(Loop& loop, Session& session);
+        void engineReplied(Loop& loop, const EngineReply& reply);
+        std::string statsLine() const;
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_NET_MATCHSERVER_H
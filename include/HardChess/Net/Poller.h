@@ -0,0 +1,44 @@
+#ifndef HARDCHESS_NET_POLLER_H
+#define HARDCHESS_NET_POLLER_H
+
+#include <cstddef>
+#include <vector>
+
+namespace HardChess {
+
+    // Readiness of many non-blocking descriptors: epoll on Linux, where waiting costs the
+    // same with ten thousand idle sockets as with ten, and poll(2) elsewhere. Level
+    // triggered: a descriptor is reported for as long as it stays readable (or writable,
+    // while write interest is on).
+    class Poller {
+      public:
+        struct Event {
+            int fd;
+            bool readable;
+            bool writable;
+            bool hangup; // Error or peer closed; a read will say which
+        };
+
+        Poller();
+        ~Poller();
+        Poller(const Poller&) = delete;
+        Poller& operator=(const Poller&) = delete;
+
+        bool open();
+        bool add(int fd, bool wantWrite = false);
+        bool modify(int fd, bool wantWrite);
+        void remove(int fd);
+        // Waits up to timeoutMs (-1: indefinitely) and replaces events with what is ready;
+        // false only on a real error (an interrupted wait returns true with no events)
+        bool wait(std::vector<Event>& events, int timeoutMs);
+
+      private:
+        int handle; // The epoll descriptor; unused with poll(2)
+        std::vector<int> watched; // poll(2) only: the registered descriptors
+        std::vector<bool> writeInterest; // poll(2) only: per entry of watched
+        std::vector<char> buffer; // epoll_event or pollfd records, reused
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_NET_POLLER_H
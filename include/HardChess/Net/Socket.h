@@ -0,0 +1,28 @@
+#ifndef HARDCHESS_NET_SOCKET_H
+#define HARDCHESS_NET_SOCKET_H
+
+#include <string>
+
+namespace HardChess {
+
+    // Stream sockets for the match server and its clients. An address is "PORT" or
+    // "HOST:PORT" for TCP (HOST a numeric IPv4 address, 127.0.0.1 when left out), or
+    // "unix:PATH" for a Unix-domain socket. All return -1 and set error on failure.
+    namespace Socket {
+
+        // A non-blocking listening socket; a stale Unix socket file at PATH is replaced
+        int listenOn(const std::string& address, std::string& error);
+        // A blocking connection, made non-blocking by the caller if it wants
+        int connectTo(const std::string& address, std::string& error);
+        bool setNonBlocking(int fd);
+        // Sends short writes at once instead of waiting to coalesce them (TCP only)
+        void setNoDelay(int fd);
+        // Lifts the open-descriptor limit to the hard limit, for thousands of sessions;
+        // returns the limit now in force
+        long raiseDescriptorLimit();
+
+    } // namespace Socket
+
+} // namespace HardChess
+
+#endif // HARDCHESS_NET_SOCKET_H
@@ -0,0 +1,71 @@
+#ifndef HARDCHESS_UI_BOARDRENDERER_H
+#define HARDCHESS_UI_BOARDRENDERER_H
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/CommonTypes.h"
+#include "HardChess/Core/Move.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HardChess {
+
+    class ThreadPool;
+
+    // The twelve piece textures, each decoded once and scaled down to one square, kept
+    // premultiplied by alpha in a single contiguous buffer.
+    class SpriteAtlas {
+      public:
+        SpriteAtlas();
+
+        // Loads white_pawn.png ... black_king.png (first letter in either case) from
+        // textureDir, scaling each to squareSize pixels. Textures decode in parallel when
+        // a pool is given. On failure, error() names the texture at fault.
+        bool load(const std::string& textureDir, int squareSize, ThreadPool* pool = nullptr);
+
+        int squareSize() const { return size; }
+        // size x size RGBA, premultiplied; nullptr for PieceType::NONE
+        const std::uint8_t* sprite(Color color, PieceType type) const;
+        const std::string& error() const { return failure; }
+
+      private:
+        int size;
+        std::vector<std::uint8_t> pixels; // Sprites in slot order: white pawn..king, black pawn..king
+        std::string failure;
+
+        static int slotOf(Color color, PieceType type) {
+            return (color == Color::BLACK ? 6 : 0) + static_cast<int>(type) - 1;
+        }
+    };
+
+    struct RenderStyle {
+        bool flip = false; // Black at the bottom
+        std::uint8_t light[3] = {240, 217, 181};
+        std::uint8_t dark[3] = {181, 136, 99};
+        std::uint8_t lightHighlight[3] = {205, 210, 106}; // Squares of the last move
+        std::uint8_t darkHighlight[3] = {170, 162, 58};
+    };
+
+    // Composites board diagrams as 8-bit RGB frames, 8 squares by 8 squares of the atlas's
+    // size. The caller owns the frame and passes the same one back for the next image, so
+    // steady-state rendering allocates nothing. A renderer is read-only after
+    // construction; threads share one and bring their own frames.
+    class BoardRenderer {
+      public:
+        BoardRenderer(const SpriteAtlas& spriteAtlas, const RenderStyle& renderStyle);
+
+        int width() const { return 8 * atlas.squareSize(); }
+        int height() const { return width(); }
+        static constexpr int CHANNELS = 3;
+
+        // lastMove, if given, highlights its origin and destination squares
+        void render(const Board& board, const Move* lastMove, std::vector<std::uint8_t>& frame) const;
+
+      private:
+        const SpriteAtlas& atlas;
+        RenderStyle style;
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_UI_BOARDRENDERER_H
@@ -1,7 +1,9 @@
 #ifndef HARDCHESS_UI_CONSOLEUI_H
 #define HARDCHESS_UI_CONSOLEUI_H
 
+#include <mutex>
 #include <string>
+#include <string_view>
 #include "HardChess/Core/CommonTypes.h"
 
 // Forward declarations to minimize include dependencies in header
@@ -11,33 +13,65 @@ namespace HardChess {
     class Piece;
     enum class PieceType;
     class Position;
+    namespace Stats {
+        struct Snapshot;
+    }
 }
 
 namespace HardChess {
 
+    // How displayBoard draws. PLAIN prints the whole board each time. ANSI_DIFF pins the
+    // board to the top of the terminal, scrolls everything else below it, and rewrites
+    // only the squares that changed. QUIET skips per-move rendering, for batch play.
+    enum class RenderMode { PLAIN, ANSI_DIFF, QUIET };
+
     class ConsoleUI {
       public:
-        ConsoleUI() = default;
+        ConsoleUI();
+        ~ConsoleUI(); // Gives the terminal its full scrolling region back in ANSI_DIFF mode
+        ConsoleUI(const ConsoleUI&) = delete;
+        ConsoleUI& operator=(const ConsoleUI&) = delete;
+
+        void setRenderMode(RenderMode mode);
+        RenderMode getRenderMode() const { return renderMode; }
+        static bool parseRenderMode(std::string_view name, RenderMode& mode); // "plain", "ansi" or "quiet"
 
         // Main menu and help
         int displayMainMenu() const;
         void displayHelpAndRules() const;
 
-        // Game UI
+        // Game UI. The board is formatted into one reusable buffer and written with a single
+        // call; flip draws it from Black's side.
         void displayBoard(const Board& board, bool flip = false) const;
         void displayPlayerStats(const Player& player1, const Player& player2) const;
         void displayPlayerTurn(const Player* currentPlayer) const;
         void displayMessage(const std::string& message) const;
+        void displayStats(const Stats::Snapshot& snapshot) const; // Engine counters and turn timers
+        // A finished hint; may be called from the hint's worker thread while a prompt waits.
+        // Every write to the console takes the same lock, so it never lands mid-line.
+        void displayHint(const std::string& hint) const;
 
+        // A move or command as typed; "exit" when the player quits, or input has ended
         std::string getPlayerMove(const Player& player) const;
         std::string promptForPieceSelection(const std::string& promptMessage) const;
 
         void displayRoundResult(Player* winner) const; // nullptr for draw
-        void displayMatchResult(Player* winner) const; // nullptr for draw
+        void displayMatchResult(const Player* winner) const; // nullptr for draw
 
         std::string formatPosition(Position pos) const; // Helper to convert Position to "a1" string
 
         PieceType promptPawnPromotionChoice(const Player& player) const;
+
+      private:
+        RenderMode renderMode;
+        mutable std::string frame;       // Output buffer, reused for every board
+        mutable char shownSquares[64];   // ANSI_DIFF: what each screen cell shows, in screen order
+        mutable bool boardOnScreen;
+        mutable bool shownFlip;
+        mutable std::mutex output;       // Held while writing; never while waiting for input
+
+        void formatFullBoard(const Board& board, bool flip) const;
+        void releaseTerminal() const; // With output held
     };
 
 } // namespace HardChess
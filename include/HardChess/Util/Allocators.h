@@ -0,0 +1,270 @@
+#ifndef HARDCHESS_UTIL_ALLOCATORS_H
+#define HARDCHESS_UTIL_ALLOCATORS_H
+
+#include "HardChess/Util/Stats.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <vector>
+
+namespace HardChess {
+
+    // Counters kept by the allocators below. "requests" are calls made to the allocator;
+    // "system" counts the calls it had to pass on to the global operator new, which stop
+    // growing once the allocator has warmed up. The same events also go to the Stats
+    // counters POOL_REQUESTS, HEAP_FALLBACKS and ARENA_BYTES.
+    struct AllocatorStats {
+        std::uint64_t requests = 0;
+        std::uint64_t releases = 0;
+        std::uint64_t requestedBytes = 0;
+        std::uint64_t systemAllocations = 0;
+        std::uint64_t systemBytes = 0;
+        std::uint64_t highWaterBytes = 0; // Arena only: most bytes in use at once
+        std::uint64_t resets = 0;         // Arena only
+    };
+
+    // Fixed-size blocks for small objects of one size class. Each thread allocates from and
+    // frees to its own free list without locking; lists are refilled from, and overflow
+    // into, a shared depot, so blocks freed on another thread are reused. Chunks are never
+    // returned to the system: a block may outlive the thread that allocated it. Once a
+    // thread's free list is gone (blocks freed during thread exit or static teardown, say
+    // by a static Board) its calls go straight to the depot.
+    template <std::size_t BlockSize>
+    class FixedPool {
+      public:
+        static constexpr std::size_t BLOCK_SIZE = (BlockSize + 15) & ~std::size_t(15);
+        static constexpr std::size_t BATCH = 64;              // Blocks moved to or from the depot at once
+        static constexpr std::size_t BLOCKS_PER_CHUNK = 256;
+
+        static void* allocate() {
+            if (cacheGone()) return allocateShared();
+            Cache& local = cache();
+            if (!local.head) refill(local);
+            Node* node = local.head;
+            local.head = node->next;
+            --local.count;
+            ++local.stats.requests;
+            local.stats.requestedBytes += BLOCK_SIZE;
+            Stats::count(Stats::Counter::POOL_REQUESTS);
+            return node;
+        }
+
+        static void deallocate(void* block) noexcept {
+            Node* node = static_cast<Node*>(block);
+            if (cacheGone()) {
+                Depot& shared = depot();
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                node->next = shared.head;
+                shared.head = node;
+                ++shared.count;
+                return;
+            }
+            Cache& local = cache();
+            node->next = local.head;
+            local.head = node;
+            ++local.stats.releases;
+            if (++local.count >= 2 * BATCH) spill(local, BATCH);
+        }
+
+        // Requests made by the calling thread
+        static AllocatorStats threadStats() { return cache().stats; }
+
+        // Chunks taken from the system by all threads together
+        static AllocatorStats globalStats() {
+            AllocatorStats stats;
+            stats.systemAllocations = depot().chunks.load(std::memory_order_relaxed);
+            stats.systemBytes = stats.systemAllocations * BLOCK_SIZE * BLOCKS_PER_CHUNK;
+            return stats;
+        }
+
+      private:
+        struct Node {
+            Node* next;
+        };
+
+        struct Depot {
+            std::mutex mutex;
+            Node* head = nullptr;
+            std::size_t count = 0;
+            std::atomic<std::uint64_t> chunks{0};
+        };
+
+        struct Cache {
+            Node* head = nullptr;
+            std::size_t count = 0;
+            AllocatorStats stats;
+            // The thread's Stats counters are created first, so they outlive the cache
+            Cache() { Stats::local(); }
+            ~Cache() { // Hand the free list on when the thread exits
+                spill(*this, count);
+                cacheGone() = true;
+            }
+        };
+
+        // Never destroyed, so caches of threads that exit late can still spill into it
+        static Depot& depot() {
+            static Depot* shared = new Depot();
+            return *shared;
+        }
+
+        static Cache& cache() {
+            thread_local Cache local;
+            return local;
+        }
+
+        // Set when the calling thread's cache is destroyed. A bool has no destructor, so
+        // unlike the cache it can still be read for the rest of the thread's teardown.
+        static bool& cacheGone() {
+            thread_local bool gone = false;
+            return gone;
+        }
+
+        // One block without a thread cache: from the depot, or a new chunk whose other
+        // blocks go to the depot
+        static void* allocateShared() {
+            Depot& shared = depot();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            if (!shared.head) {
+                char* chunk = static_cast<char*>(::operator new(BLOCK_SIZE * BLOCKS_PER_CHUNK));
+                shared.chunks.fetch_add(1, std::memory_order_relaxed);
+                for (std::size_t i = BLOCKS_PER_CHUNK; i-- > 0;) {
+                    Node* node = reinterpret_cast<Node*>(chunk + i * BLOCK_SIZE);
+                    node->next = shared.head;
+                    shared.head = node;
+                }
+                shared.count += BLOCKS_PER_CHUNK;
+            }
+            Node* node = shared.head;
+            shared.head = node->next;
+            --shared.count;
+            return node;
+        }
+
+        static void refill(Cache& local) {
+            Depot& shared = depot();
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                for (std::size_t i = 0; i < BATCH && shared.head; ++i) {
+                    Node* node = shared.head;
+                    shared.head = node->next;
+                    --shared.count;
+                    node->next = local.head;
+                    local.head = node;
+                    ++local.count;
+                }
+            }
+            if (local.head) return;
+
+            char* chunk = static_cast<char*>(::operator new(BLOCK_SIZE * BLOCKS_PER_CHUNK));
+            shared.chunks.fetch_add(1, std::memory_order_relaxed);
+            ++local.stats.systemAllocations;
+            local.stats.systemBytes += BLOCK_SIZE * BLOCKS_PER_CHUNK;
+            Stats::count(Stats::Counter::HEAP_FALLBACKS);
+            for (std::size_t i = BLOCKS_PER_CHUNK; i-- > 0;) {
+                Node* node = reinterpret_cast<Node*>(chunk + i * BLOCK_SIZE);
+                node->next = local.head;
+                local.head = node;
+            }
+            local.count += BLOCKS_PER_CHUNK;
+        }
+
+        static void spill(Cache& local, std::size_t blocks) {
+            if (blocks == 0) return;
+            Depot& shared = depot();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            for (std::size_t i = 0; i < blocks && local.head; ++i) {
+                Node* node = local.head;
+                local.head = node->next;
+                --local.count;
+                node->next = shared.head;
+                shared.head = node;
+                ++shared.count;
+            }
+        }
+    };
+
+    // Bump allocator for scratch data with a stack discipline: take a mark, allocate,
+    // rewind to the mark. reset() and rewind() are O(1) and keep the chunks for reuse,
+    // so a warmed-up arena serves every request without touching the system allocator.
+    // Only trivially destructible data belongs here; nothing is destroyed on rewind.
+    class Arena {
+      public:
+        struct Marker {
+            std::size_t chunk;
+            std::size_t offset;
+        };
+
+        // Rewinds on destruction; for scratch data with the lifetime of a scope
+        class Scope {
+          public:
+            explicit Scope(Arena& arena) : arena(arena), marker(arena.mark()) {}
+            ~Scope() { arena.rewind(marker); }
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+          private:
+            Arena& arena;
+            Marker marker;
+        };
+
+        explicit Arena(std::size_t chunkBytes = 64 * 1024);
+        ~Arena();
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+            if (current < chunks.size()) {
+                const Chunk& chunk = chunks[current];
+                std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunk.data);
+                std::size_t start = ((base + offset + alignment - 1) & ~(std::uintptr_t(alignment) - 1)) - base;
+                if (start + bytes <= chunk.size) {
+                    offset = start + bytes;
+                    ++counters.requests;
+                    counters.requestedBytes += bytes;
+                    Stats::count(Stats::Counter::ARENA_BYTES, bytes);
+                    if (chunk.usedBefore + offset > counters.highWaterBytes) counters.highWaterBytes = chunk.usedBefore + offset;
+                    return chunk.data + start;
+                }
+            }
+            return allocateSlow(bytes, alignment);
+        }
+
+        template <typename T>
+        T* allocateArray(std::size_t count) {
+            return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+        }
+
+        Marker mark() const { return Marker{current, offset}; }
+        void rewind(Marker marker);
+        void reset(); // Everything allocated so far is released
+
+        std::size_t bytesInUse() const;
+        const AllocatorStats& stats() const { return counters; }
+
+        // The calling thread's arena, for search-local and round-local scratch data
+        static Arena& local();
+
+      private:
+        struct Chunk {
+            char* data;
+            std::size_t size;
+            std::size_t usedBefore; // Bytes in the chunks before this one, when it was entered
+        };
+        std::vector<Chunk> chunks;
+        std::size_t chunkBytes;
+        std::size_t current;
+        std::size_t offset;
+        AllocatorStats counters;
+
+        void* allocateSlow(std::size_t bytes, std::size_t alignment);
+    };
+
+    // One-line key=value summaries of a set of counters, for benchmarks and tools
+    void writeAllocatorStats(std::ostream& out, const char* name, const AllocatorStats& stats);
+
+} // namespace HardChess
+
+#endif // HARDCHESS_UTIL_ALLOCATORS_H
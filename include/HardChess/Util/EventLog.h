@@ -0,0 +1,86 @@
+#ifndef HARDCHESS_UTIL_EVENTLOG_H
+#define HARDCHESS_UTIL_EVENTLOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Structured log of game and match events. record() copies a fixed-size event into the
+// calling thread's own ring buffer and returns; it never locks, allocates or touches a
+// file. A background writer thread drains every ring into a JSONL or binary file. When a
+// ring is full the event is dropped and counted instead, so a slow disk costs log
+// entries, never game time; the writer reports each batch of drops in the log itself.
+
+namespace HardChess {
+    namespace EventLog {
+
+        enum class EventType : std::uint8_t {
+            ROUND_START,  // values[0]: round number
+            MOVE,         // color, piece: the mover; move, ply
+            CAPTURE,      // color, piece: the captured piece; move
+            PROMOTION,    // color: the mover; piece: promoted to; move
+            CHECK,        // color: the side in check
+            ROUND_RESULT, // result; values[0], values[1]: White's and Black's match score
+            MATCH_RESULT, // color: the winner (NONE if undetermined); values: final scores
+            DROPPED,      // Written by the log: values[0] events lost since the last DROPPED
+            COUNT
+        };
+
+        enum class Format { JSONL, BINARY };
+
+        // The binary format is a 16-byte header ("HCEVENTS", version, record size) followed
+        // by these records as they are in memory.
+        struct Event {
+            std::uint64_t timeNs = 0;   // Since open(); filled in by record()
+            std::uint32_t thread = 0;   // Recording thread, numbered by first use; filled in
+            std::uint32_t game = 0;     // Identifies the round (see Game::getId)
+            EventType type = EventType::MOVE;
+            std::uint8_t color = 0;     // A Color value
+            std::uint8_t piece = 0;     // A PieceType value
+            std::uint8_t result = 0;    // A GameResult value
+            std::uint16_t move = 0;     // Move::encode()
+            std::uint16_t ply = 0;      // Half-moves played before the event's move
+            std::int32_t values[2] = {0, 0};
+        };
+        static_assert(sizeof(Event) == 32, "Event is the binary record");
+
+        struct Totals {
+            std::uint64_t recorded = 0; // Accepted into a ring
+            std::uint64_t written = 0;  // Formatted by the writer
+            std::uint64_t dropped = 0;  // Lost to full rings
+        };
+
+        // Starts the writer thread on a new file; ringEvents (rounded up to a power of two)
+        // is the per-thread backlog the writer may fall behind by before events drop.
+        // false if a log is already open or the file cannot be created.
+        bool open(const std::string& path, Format format, std::size_t ringEvents = 4096);
+        // Stops recording, lets the writer drain every ring, and closes the file; false if
+        // any write failed
+        bool close();
+
+        namespace detail {
+            extern std::atomic<bool> active;
+            void push(const Event& event);
+        }
+
+        inline bool isOpen() { return detail::active.load(std::memory_order_relaxed); }
+
+        // Costs one relaxed load when no log is open
+        inline void record(const Event& event) {
+            if (isOpen()) detail::push(event);
+        }
+
+        // Since the last open(); safe to call while threads record
+        Totals totals();
+
+        // JSONL for a .jsonl path (and anything else), binary for .bin
+        Format formatFor(const std::string& path);
+
+        // A fresh Event::game value, unique in the process; each round takes one
+        std::uint32_t newGameId();
+
+    } // namespace EventLog
+} // namespace HardChess
+
+#endif // HARDCHESS_UTIL_EVENTLOG_H
@@ -0,0 +1,137 @@
+#ifndef HARDCHESS_UTIL_EXTERNALSORT_H
+#define HARDCHESS_UTIL_EXTERNALSORT_H
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+namespace HardChess {
+
+    // Sorts an arbitrary number of fixed-size records in bounded memory: records are
+    // buffered up to the memory budget, each full buffer is sorted and spilled to a
+    // temporary run file, and finish() streams a k-way merge of the runs.
+    template <typename Record, typename Less>
+    class ExternalSorter {
+        static_assert(std::is_trivially_copyable<Record>::value, "records are written to disk byte for byte");
+
+      private:
+        std::vector<Record> buffer;
+        std::size_t maxRecords;
+        std::string tempDirectory;
+        std::vector<std::string> runs;
+        Less less;
+        bool failed;
+
+        bool spill() {
+            std::sort(buffer.begin(), buffer.end(), less);
+            std::string path = tempDirectory + "/hardchess-sort-XXXXXX";
+            int fd = mkstemp(&path[0]);
+            if (fd < 0) return failed = false;
+            std::FILE* out = fdopen(fd, "wb");
+            if (!out) {
+                ::close(fd);
+                return failed = false;
+            }
+            bool ok = std::fwrite(buffer.data(), sizeof(Record), buffer.size(), out) == buffer.size();
+            ok = std::fclose(out) == 0 && ok;
+            runs.push_back(path);
+            buffer.clear();
+            if (!ok) failed = true;
+            return ok;
+        }
+
+        // Sequential reader over one sorted run
+        struct Run {
+            std::FILE* file = nullptr;
+            std::vector<Record> block;
+            std::size_t position = 0;
+            std::size_t filled = 0;
+
+            bool next(Record& record) {
+                if (position == filled) {
+                    filled = std::fread(block.data(), sizeof(Record), block.size(), file);
+                    position = 0;
+                    if (filled == 0) return false;
+                }
+                record = block[position++];
+                return true;
+            }
+        };
+
+      public:
+        // memoryBytes bounds the in-memory buffer; merge buffers take the same budget split across runs
+        ExternalSorter(std::size_t memoryBytes, std::string directory, Less comparator = Less())
+            : maxRecords(std::max<std::size_t>(memoryBytes / sizeof(Record), 1024)),
+              tempDirectory(directory.empty() ? "." : directory), less(comparator), failed(false) {
+            buffer.reserve(maxRecords);
+        }
+
+        ~ExternalSorter() {
+            for (const std::string& run : runs) std::remove(run.c_str());
+        }
+
+        ExternalSorter(const ExternalSorter&) = delete;
+        ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+        bool add(const Record& record) {
+            buffer.push_back(record);
+            if (buffer.size() >= maxRecords) return spill();
+            return !failed;
+        }
+
+        std::size_t runCount() const { return runs.size(); }
+
+        // Calls sink(record) for every record in sorted order. Returns false on I/O errors.
+        template <typename Sink>
+        bool finish(Sink&& sink) {
+            if (failed) return false;
+            if (runs.empty()) {
+                std::sort(buffer.begin(), buffer.end(), less);
+                for (const Record& record : buffer) sink(record);
+                buffer.clear();
+                return true;
+            }
+            if (!buffer.empty() && !spill()) return false;
+            buffer.shrink_to_fit();
+
+            std::vector<Run> readers(runs.size());
+            std::size_t blockRecords = std::max<std::size_t>(maxRecords / runs.size(), 256);
+            for (std::size_t i = 0; i < runs.size(); ++i) {
+                readers[i].file = std::fopen(runs[i].c_str(), "rb");
+                if (!readers[i].file) {
+                    for (Run& run : readers) if (run.file) std::fclose(run.file);
+                    return false;
+                }
+                readers[i].block.resize(blockRecords);
+            }
+
+            struct Head {
+                Record record;
+                std::size_t run;
+            };
+            auto after = [this](const Head& a, const Head& b) { return less(b.record, a.record); };
+            std::priority_queue<Head, std::vector<Head>, decltype(after)> heads(after);
+            for (std::size_t i = 0; i < readers.size(); ++i) {
+                Head head;
+                head.run = i;
+                if (readers[i].next(head.record)) heads.push(head);
+            }
+            while (!heads.empty()) {
+                Head head = heads.top();
+                heads.pop();
+                sink(head.record);
+                if (readers[head.run].next(head.record)) heads.push(head);
+            }
+            for (Run& run : readers) std::fclose(run.file);
+            return true;
+        }
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_UTIL_EXTERNALSORT_H
@@ -0,0 +1,76 @@
+#ifndef HARDCHESS_UTIL_REORDERBUFFER_H
+#define HARDCHESS_UTIL_REORDERBUFFER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace HardChess {
+
+    // Restores input order for results produced out of order by a worker pool.
+    // Items are numbered 0, 1, 2, ...; at most `window` items may be in flight past the
+    // next one to be taken, so memory stays bounded no matter how long the input is.
+    // Workers never wait on each other: only admission (the producer) waits for room.
+    template <typename T>
+    class ReorderBuffer {
+      private:
+        std::vector<T> slots;
+        std::vector<bool> ready;
+        std::size_t nextOut;
+        std::size_t total; // Number of items that will ever be put, once known
+        bool closed;
+        std::mutex mutex;
+        std::condition_variable readyChanged;
+        std::condition_variable spaceChanged;
+
+      public:
+        explicit ReorderBuffer(std::size_t window)
+            : slots(window), ready(window, false), nextOut(0), total(0), closed(false) {}
+
+        // Blocks the producer until item `index` fits in the window
+        void admit(std::size_t index) {
+            std::unique_lock<std::mutex> lock(mutex);
+            spaceChanged.wait(lock, [&] { return index < nextOut + slots.size(); });
+        }
+
+        // Stores the result for an admitted item (any thread)
+        void put(std::size_t index, T value) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                std::size_t slot = index % slots.size();
+                slots[slot] = std::move(value);
+                ready[slot] = true;
+            }
+            readyChanged.notify_all();
+        }
+
+        // No items past `count` will be admitted
+        void close(std::size_t count) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                total = count;
+                closed = true;
+            }
+            readyChanged.notify_all();
+        }
+
+        // Takes the next item in order; false once every item has been taken
+        bool take(T& value) {
+            std::unique_lock<std::mutex> lock(mutex);
+            std::size_t slot = nextOut % slots.size();
+            readyChanged.wait(lock, [&] { return ready[slot] || (closed && nextOut >= total); });
+            if (!ready[slot]) return false;
+            value = std::move(slots[slot]);
+            ready[slot] = false;
+            ++nextOut;
+            lock.unlock();
+            spaceChanged.notify_all();
+            return true;
+        }
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_UTIL_REORDERBUFFER_H
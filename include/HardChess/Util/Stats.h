@@ -0,0 +1,127 @@
+#ifndef HARDCHESS_UTIL_STATS_H
+#define HARDCHESS_UTIL_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// Hot-path instrumentation. Each thread bumps its own counters without locking or
+// atomic read-modify-write; snapshot() sums every thread's counters on demand.
+// Building with -DHARDCHESS_NO_STATS (make STATS=0) turns count() and ScopedTimer
+// into no-ops, so instrumented code costs nothing in such builds.
+
+namespace HardChess {
+    namespace Stats {
+
+#ifdef HARDCHESS_NO_STATS
+        constexpr bool ENABLED = false;
+#else
+        constexpr bool ENABLED = true;
+#endif
+
+        enum class Counter {
+            LEGALITY_PROBES,   // Checks that a move does not leave the mover in check
+            KING_IN_CHECK,     // Board::isKingInCheck calls
+            BOARD_COPIES,
+            PIECE_CLONES,
+            SEARCH_NODES,
+            BOOK_PROBES,
+            BOOK_HITS,
+            TABLEBASE_PROBES,
+            TABLEBASE_HITS,
+            MOVE_CACHE_HITS,   // LegalMoveSet::update answered from the cached set
+            MOVE_CACHE_MISSES,
+            POOL_REQUESTS,     // FixedPool blocks handed out
+            HEAP_FALLBACKS,    // Pool and arena chunks taken from the global operator new
+            ARENA_BYTES,       // Bytes handed out by arenas
+            COUNT
+        };
+
+        // Phases of Game::playTurn
+        enum class Timer {
+            TURN,              // The whole turn
+            PLAYER_INPUT,      // Waiting for a human move
+            MOVE_VALIDATION,
+            COMPUTER_MOVE,
+            BOARD_DISPLAY,
+            END_OF_ROUND_CHECK,
+            COUNT
+        };
+
+        constexpr int COUNTER_COUNT = static_cast<int>(Counter::COUNT);
+        constexpr int TIMER_COUNT = static_cast<int>(Timer::COUNT);
+
+        const char* name(Counter counter);
+        const char* name(Timer timer);
+
+        struct Snapshot {
+            std::uint64_t counters[COUNTER_COUNT] = {};
+            std::uint64_t timerNs[TIMER_COUNT] = {};
+            std::uint64_t timerCalls[TIMER_COUNT] = {};
+
+            std::uint64_t operator[](Counter counter) const { return counters[static_cast<int>(counter)]; }
+        };
+
+        // One thread's counters. Only the owning thread writes them; the relaxed atomics
+        // let snapshot() read them from another thread, and compile to plain moves.
+        struct ThreadCounters {
+            std::atomic<std::uint64_t> counters[COUNTER_COUNT];
+            std::atomic<std::uint64_t> timerNs[TIMER_COUNT];
+            std::atomic<std::uint64_t> timerCalls[TIMER_COUNT];
+
+            ThreadCounters();
+            ~ThreadCounters(); // Folds the totals into the retired threads' sums
+            ThreadCounters(const ThreadCounters&) = delete;
+            ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+            static void add(std::atomic<std::uint64_t>& slot, std::uint64_t amount) {
+                slot.store(slot.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+            }
+        };
+
+        inline ThreadCounters& local() {
+            thread_local ThreadCounters counters;
+            return counters;
+        }
+
+        inline void count(Counter counter, std::uint64_t amount = 1) {
+            if constexpr (ENABLED) ThreadCounters::add(local().counters[static_cast<int>(counter)], amount);
+        }
+
+        // Adds the time from construction to destruction to a timer
+        class ScopedTimer {
+          public:
+            explicit ScopedTimer(Timer timer) : timer(timer) {
+                if constexpr (ENABLED) begin = std::chrono::steady_clock::now();
+            }
+            ~ScopedTimer() {
+                if constexpr (ENABLED) {
+                    auto elapsed = std::chrono::steady_clock::now() - begin;
+                    ThreadCounters& counters = local();
+                    ThreadCounters::add(counters.timerNs[static_cast<int>(timer)],
+                                        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                    ThreadCounters::add(counters.timerCalls[static_cast<int>(timer)], 1);
+                }
+            }
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+          private:
+            Timer timer;
+            std::chrono::steady_clock::time_point begin;
+        };
+
+        // Totals over all threads, live and finished, since the last reset()
+        Snapshot snapshot();
+        void reset();
+
+        // Human-readable table, for the `stats` command
+        void writeText(std::ostream& out, const Snapshot& snapshot);
+        // A single JSON object with "counters" and "timers" members
+        void writeJson(std::ostream& out, const Snapshot& snapshot);
+
+    } // namespace Stats
+} // namespace HardChess
+
+#endif // HARDCHESS_UTIL_STATS_H
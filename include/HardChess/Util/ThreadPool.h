@@ -0,0 +1,46 @@
+#ifndef HARDCHESS_UTIL_THREADPOOL_H
+#define HARDCHESS_UTIL_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace HardChess {
+
+    // Fixed set of worker threads fed from a bounded FIFO. submit() blocks while the
+    // queue is full, which gives producers natural backpressure.
+    class ThreadPool {
+      private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::size_t capacity;
+        std::size_t active;
+        bool stopping;
+        std::mutex mutex;
+        std::condition_variable taskAvailable;
+        std::condition_variable spaceAvailable;
+        std::condition_variable idle;
+
+        void workerLoop();
+
+      public:
+        // threads == 0 uses the hardware concurrency; queueCapacity == 0 uses 4 tasks per thread
+        explicit ThreadPool(unsigned threads = 0, std::size_t queueCapacity = 0);
+        ~ThreadPool(); // Finishes queued tasks, then joins
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void submit(std::function<void()> task);
+        void waitIdle(); // Until the queue is empty and no task is running
+        unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+        static unsigned defaultThreadCount();
+    };
+
+} // namespace HardChess
+
+#endif // HARDCHESS_UTIL_THREADPOOL_H
@@ -0,0 +1,145 @@
+// Allocation benchmark for the piece pool and the search arena.
+//
+// Usage: allocbench [rounds]
+//
+// Counts every call to the global operator new while the program runs the work
+// that used to allocate: board construction and copies, make/unmake with
+// promotions, and searches. Each workload runs once to warm the allocators up and
+// then `rounds` more times. In steady state board copies and make/unmake must not
+// reach the global allocator at all, a search may allocate only the vectors it
+// returns (the PV, the line list and one PV per line), and neither the pool nor the
+// arena may take another chunk from the system. Prints allocations/op and ns/op per
+// workload, followed by the allocator stats report. Exits non-zero if the steady
+// state allocates more than that.
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Engine/Search.h"
+#include "HardChess/Util/Allocators.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace HardChess;
+
+namespace {
+    std::uint64_t globalAllocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++globalAllocations;
+    if (void* block = std::malloc(size == 0 ? 1 : size)) return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+namespace {
+
+    const char* const promotionFen = "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1";
+
+    long walk(Board& board, int depth, std::vector<Move>* lists) {
+        std::vector<Move>& moves = lists[depth];
+        board.generateLegalMoves(moves);
+        if (depth == 1) return static_cast<long>(moves.size());
+        long nodes = 0;
+        for (const Move& move : moves) {
+            MoveUndo undo;
+            board.makeMove(move, undo);
+            nodes += walk(board, depth - 1, lists);
+            board.undoMove(move, undo);
+        }
+        return nodes;
+    }
+
+    struct Measurement {
+        double allocationsPerOp;
+        double nsPerOp;
+        std::uint64_t poolChunks;
+        std::uint64_t arenaChunks;
+    };
+
+    // Runs the workload once to warm up, then `rounds` times under measurement
+    template <typename Body>
+    Measurement measure(int rounds, long opsPerRound, Body body) {
+        body();
+        std::uint64_t poolBefore = Piece::poolStats().systemAllocations;
+        std::uint64_t arenaBefore = Arena::local().stats().systemAllocations;
+        std::uint64_t allocationsBefore = globalAllocations;
+        auto begin = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) body();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        double ops = static_cast<double>(opsPerRound) * rounds;
+        return Measurement{(globalAllocations - allocationsBefore) / ops, seconds * 1e9 / ops,
+                           Piece::poolStats().systemAllocations - poolBefore,
+                           Arena::local().stats().systemAllocations - arenaBefore};
+    }
+
+    bool report(const char* name, const Measurement& m, double allowedPerOp) {
+        std::cout << name << " allocations/op=" << m.allocationsPerOp << " ns/op=" << m.nsPerOp
+                  << " pool-chunks=" << m.poolChunks << " arena-chunks=" << m.arenaChunks << std::endl;
+        bool ok = m.poolChunks == 0 && m.arenaChunks == 0 && m.allocationsPerOp <= allowedPerOp;
+        if (!ok) std::cerr << "allocbench: " << name << " allocates in steady state" << std::endl;
+        return ok;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 20;
+    Board start;
+    Board promotions;
+    promotions.fromFEN(promotionFen);
+    bool ok = true;
+
+    const int copies = 10000;
+    ok &= report("board-copy", measure(rounds, copies, [&] {
+        for (int i = 0; i < copies; ++i) {
+            Board copy = i & 1 ? start : promotions;
+            if (!copy.findKing(Color::WHITE).isValid()) std::abort();
+        }
+    }), 0);
+
+    ok &= report("board-construct", measure(rounds, copies, [&] {
+        for (int i = 0; i < copies; ++i) {
+            Board fresh;
+            if (!fresh.findKing(Color::BLACK).isValid()) std::abort();
+        }
+    }), 0);
+
+    // Make/unmake over a tree with promotions, reusing one move list per depth
+    std::vector<Move> lists[4];
+    long walkNodes = 0;
+    Measurement walkMeasurement = measure(rounds, 1, [&] { walkNodes = walk(promotions, 3, lists); });
+    std::cout << "walk nodes=" << walkNodes << std::endl;
+    ok &= report("make-unmake-walk", walkMeasurement, 0);
+
+    Search search;
+    SearchLimits limits;
+    limits.depth = 4;
+    long long searchNodes = 0;
+    ok &= report("search", measure(rounds, 1, [&] {
+        SearchResult result = search.run(promotions, limits);
+        searchNodes = result.nodes;
+    }), 3);
+    std::cout << "search nodes=" << searchNodes << std::endl;
+
+    limits.multiPv = 4;
+    ok &= report("search-multipv4", measure(rounds, 1, [&] {
+        SearchResult result = search.run(promotions, limits);
+        searchNodes = result.nodes;
+    }), 2 + limits.multiPv);
+    std::cout << "search-multipv4 nodes=" << searchNodes << std::endl;
+
+    Arena::local().reset();
+    writeAllocatorStats(std::cout, "piece-pool", Piece::poolStats());
+    writeAllocatorStats(std::cout, "search-arena", Arena::local().stats());
+    std::cout << "search-arena bytes-in-use=" << Arena::local().bytesInUse() << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+// Game archive versus PGN: size and load time.
+//
+// Usage: archivebench [games.pgn] [archive.hcga]
+//
+// Loads the PGN corpus by replaying it, converts it to a binary archive, then loads the
+// archive two ways: a raw scan of every stored move, and a full replay that decodes each
+// move onto a Board. With no file it runs the built-in sample corpus and fails unless it
+// archives at least 4x smaller than its PGN. The archive drops PGN tags (see GameArchive.h),
+// so the sample keeps few of them: the ratio measures the move encoding, not deleted tags.
+
+#include "HardChess/IO/GameArchive.h"
+#include "HardChess/IO/MappedFile.h"
+#include "HardChess/IO/PgnReader.h"
+#include "SampleGames.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+using namespace HardChess;
+
+namespace {
+
+    constexpr double minSampleRatio = 4.0;
+
+    double secondsSince(std::chrono::steady_clock::time_point begin) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return seconds > 0 ? seconds : 1e-9;
+    }
+
+    // Converts and reloads one corpus; false if the archive does not round-trip.
+    // ratio receives PGN bytes over archive bytes.
+    bool run(const std::string& name, std::string_view pgn, const std::string& archivePath, bool keep, double& ratio) {
+        auto begin = std::chrono::steady_clock::now();
+        PgnStats pgnStats = PgnReader::replayAll(pgn);
+        double pgnSeconds = secondsSince(begin);
+
+        GameArchiveWriter writer;
+        if (!writer.open(archivePath)) {
+            std::cerr << "archivebench: cannot create " << archivePath << std::endl;
+            return false;
+        }
+        PgnRecordBuilder builder([&](const GameRecord& record) { writer.add(record); });
+        PgnReader::replayAll(pgn, &builder);
+        writer.close();
+
+        begin = std::chrono::steady_clock::now();
+        GameArchive archive;
+        if (!archive.open(archivePath)) {
+            std::cerr << "archivebench: cannot open " << archivePath << std::endl;
+            return false;
+        }
+        std::size_t scannedMoves = 0;
+        unsigned checksum = 0;
+        ArchivedGame game;
+        for (std::size_t i = 0; i < archive.size(); ++i) {
+            archive.game(i, game);
+            for (std::uint16_t code : game.moves) checksum += code;
+            scannedMoves += game.moves.size();
+        }
+        double scanSeconds = secondsSince(begin);
+
+        begin = std::chrono::steady_clock::now();
+        Board board;
+        std::size_t replayedMoves = 0;
+        for (std::size_t i = 0; i < archive.size(); ++i) {
+            archive.game(i, game);
+            if (game.startFEN.empty()) board.initializeBoard();
+            else board.fromFEN(game.startFEN);
+            for (std::uint16_t code : game.moves) board.applyMove(board.decodeMove(code));
+            replayedMoves += game.moves.size();
+        }
+        double replaySeconds = secondsSince(begin);
+        if (!keep) std::remove(archivePath.c_str());
+
+        ratio = static_cast<double>(pgn.size()) / archive.bytes();
+        std::cout << name << " pgn: bytes=" << pgn.size() << " games=" << pgnStats.games << " moves=" << pgnStats.moves
+                  << " load-seconds=" << pgnSeconds << std::endl;
+        std::cout << name << " archive: bytes=" << archive.bytes() << " games=" << archive.size()
+                  << " moves=" << scannedMoves << " scan-seconds=" << scanSeconds << " replay-seconds=" << replaySeconds
+                  << " (checksum " << checksum << ")" << std::endl;
+        std::cout << name << " size ratio=" << ratio << " scan speedup=" << pgnSeconds / scanSeconds
+                  << " replay speedup=" << pgnSeconds / replaySeconds << std::endl;
+        if (replayedMoves != pgnStats.moves || archive.size() != pgnStats.games - pgnStats.errors) {
+            std::cerr << "archivebench: " << name << " archive does not hold every game and move" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string archivePath = argc > 2 ? argv[2] : "archivebench.hcga";
+    double ratio = 0;
+    if (argc > 1) {
+        MappedFile file;
+        if (!file.open(argv[1])) {
+            std::cerr << "archivebench: cannot map " << argv[1] << std::endl;
+            return 2;
+        }
+        return run("file", file.view(), archivePath, argc > 2, ratio) ? 0 : 1;
+    }
+
+    bool ok = run("sample", buildSampleCorpus(5000), archivePath, false, ratio);
+    if (ratio < minSampleRatio) {
+        std::cerr << "archivebench: sample corpus archives only " << ratio << "x smaller, want " << minSampleRatio << "x"
+                  << std::endl;
+        ok = false;
+    }
+    if (ok) std::cout << "all checks passed" << std::endl;
+    return ok ? 0 : 1;
+}
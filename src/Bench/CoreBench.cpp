@@ -0,0 +1,299 @@
+// Microbenchmarks for core Board and Game operations, with JSON output.
+//
+// Usage: corebench [--min-time MS] [--filter TEXT] [-o FILE]
+//   --min-time MS   Measuring time per benchmark and phase (default 200)
+//   --filter TEXT   Only benchmarks whose name contains TEXT
+//   -o FILE         Write the JSON report to FILE instead of stdout
+//
+// Each operation runs over a fixed suite of opening, middlegame and endgame
+// positions, grouped by phase. The loop is repeated until the minimum time has
+// passed, then ns/op, ops/sec and allocations/op are reported. allocations/op
+// counts calls to the global operator new; pool_requests/op counts Piece blocks
+// taken from the piece pool. The report is a single JSON object meant for
+// diffing between commits (`make bench` runs this).
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/Game.h"
+#include "HardChess/Core/LegalMoveSet.h"
+#include "HardChess/Core/Player.h"
+#include "HardChess/UI/ConsoleUI.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+    std::uint64_t globalAllocations = 0;
+    volatile std::uint64_t sink = 0; // Keeps results alive so the calls are not optimized out
+}
+
+void* operator new(std::size_t size) {
+    ++globalAllocations;
+    if (void* block = std::malloc(size == 0 ? 1 : size)) return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+namespace {
+
+    struct Phase {
+        const char* name;
+        std::vector<const char*> positions;
+    };
+
+    const Phase suite[] = {
+        {"opening",
+         {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+          "r1bqkbnr/pppp1ppp/2n5/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3",
+          "rnbqkb1r/pp2pppp/3p1n2/8/3NP3/8/PPP2PPP/RNBQKB1R w KQkq - 1 5",
+          "rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq c6 0 2"}},
+        {"middlegame",
+         {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+          "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+          "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+          "2r2rk1/pp1bqppp/2n1pn2/3p4/2PP4/P1NBPN2/1P3PPP/R2Q1RK1 w - - 0 13"}},
+        {"endgame",
+         {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+          "8/8/3k4/8/8/2r5/8/4K2Q w - - 0 1",
+          "8/5k2/3p4/1p1P1p2/1P3P2/6K1/8/8 w - - 0 1",
+          "8/8/8/3k4/8/8/8/2BNK3 w - - 0 1"}},
+    };
+
+    struct Options {
+        double minSeconds = 0.2;
+        std::string filter;
+        std::string output;
+    };
+
+    void usage() {
+        std::cerr << "usage: corebench [--min-time MS] [--filter TEXT] [-o FILE]" << std::endl;
+        std::exit(2);
+    }
+
+    Options parseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) usage();
+                return argv[++i];
+            };
+            if (arg == "--min-time") options.minSeconds = std::atof(value().c_str()) / 1000.0;
+            else if (arg == "--filter") options.filter = value();
+            else if (arg == "-o") options.output = value();
+            else usage();
+        }
+        return options;
+    }
+
+    struct Result {
+        std::string name;
+        std::string phase;
+        std::uint64_t ops;
+        double seconds;
+        std::uint64_t allocations;
+        std::uint64_t poolRequests;
+    };
+
+    // Calls body(), which performs some number of operations and returns that number,
+    // until minSeconds have passed; one untimed call first warms caches and allocators
+    template <typename Body>
+    Result run(const std::string& name, const std::string& phase, double minSeconds, Body body) {
+        body();
+        std::uint64_t ops = 0;
+        std::uint64_t allocationsBefore = globalAllocations;
+        std::uint64_t poolBefore = Piece::poolStats().requests;
+        auto begin = std::chrono::steady_clock::now();
+        double seconds = 0;
+        do {
+            ops += body();
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        } while (seconds < minSeconds);
+        return Result{name, phase, ops, seconds, globalAllocations - allocationsBefore,
+                      Piece::poolStats().requests - poolBefore};
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Result>& results, double minSeconds) {
+        out << "{\n  \"benchmark\": \"corebench\",\n  \"min_time_ms\": " << minSeconds * 1000 << ",\n  \"suite\": {";
+        for (std::size_t p = 0; p < sizeof(suite) / sizeof(suite[0]); ++p) {
+            out << (p ? ", " : "") << '"' << suite[p].name << "\": " << suite[p].positions.size();
+        }
+        out << "},\n  \"results\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            double ops = static_cast<double>(r.ops);
+            out << "    {\"name\": \"" << r.name << "\", \"phase\": \"" << r.phase << "\", \"ops\": " << r.ops
+                << ", \"ns_per_op\": " << r.seconds * 1e9 / ops << ", \"ops_per_sec\": " << ops / r.seconds
+                << ", \"allocations_per_op\": " << r.allocations / ops
+                << ", \"pool_requests_per_op\": " << r.poolRequests / ops << "}"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options = parseOptions(argc, argv);
+    std::vector<Result> results;
+    auto wanted = [&](const char* name) { return options.filter.empty() || std::string(name).find(options.filter) != std::string::npos; };
+
+    ConsoleUI ui;
+    Player white("White", Color::WHITE);
+    Player black("Black", Color::BLACK);
+
+    for (const Phase& phase : suite) {
+        std::vector<Board> boards(phase.positions.size());
+        std::vector<std::unique_ptr<Game>> games;
+        for (std::size_t i = 0; i < phase.positions.size(); ++i) {
+            games.push_back(std::make_unique<Game>(&white, &black, ui));
+            if (!boards[i].fromFEN(phase.positions[i]) || !games[i]->startRoundFromFEN(phase.positions[i])) {
+                std::cerr << "corebench: bad position " << phase.positions[i] << std::endl;
+                return 2;
+            }
+        }
+
+        // One quiet move per position for movePiece, played and taken back
+        std::vector<Move> quietMoves;
+        for (Board& board : boards) {
+            std::vector<Move> moves;
+            board.generateLegalMoves(moves);
+            for (const Move& move : moves) {
+                if (move.flags == MOVE_QUIET && move.promotion == PieceType::NONE) {
+                    quietMoves.push_back(move);
+                    break;
+                }
+            }
+        }
+
+        if (wanted("board_copy")) {
+            results.push_back(run("board_copy", phase.name, options.minSeconds, [&] {
+                for (const Board& board : boards) {
+                    Board copy(board);
+                    sink = sink + copy.findKing(Color::WHITE).row;
+                }
+                return static_cast<std::uint64_t>(boards.size());
+            }));
+        }
+        if (wanted("move_piece")) {
+            results.push_back(run("move_piece", phase.name, options.minSeconds, [&] {
+                std::uint64_t ops = 0;
+                for (std::size_t i = 0; i < quietMoves.size(); ++i) {
+                    boards[i].movePiece(quietMoves[i].from, quietMoves[i].to);
+                    boards[i].movePiece(quietMoves[i].to, quietMoves[i].from);
+                    ops += 2;
+                }
+                return ops;
+            }));
+        }
+        if (wanted("is_path_clear")) {
+            results.push_back(run("is_path_clear", phase.name, options.minSeconds, [&] {
+                std::uint64_t clear = 0;
+                for (const Board& board : boards) {
+                    for (int from = 0; from < 64; ++from) {
+                        for (int to = 0; to < 64; ++to) clear += board.isPathClear(squareAt(from), squareAt(to));
+                    }
+                }
+                sink = sink + clear;
+                return static_cast<std::uint64_t>(boards.size()) * 64 * 64;
+            }));
+        }
+        if (wanted("is_square_attacked")) {
+            results.push_back(run("is_square_attacked", phase.name, options.minSeconds, [&] {
+                std::uint64_t attacked = 0;
+                for (const Board& board : boards) {
+                    for (int square = 0; square < 64; ++square) {
+                        attacked += board.isSquareAttacked(squareAt(square), Color::WHITE);
+                        attacked += board.isSquareAttacked(squareAt(square), Color::BLACK);
+                    }
+                }
+                sink = sink + attacked;
+                return static_cast<std::uint64_t>(boards.size()) * 128;
+            }));
+        }
+        if (wanted("is_king_in_check")) {
+            results.push_back(run("is_king_in_check", phase.name, options.minSeconds, [&] {
+                std::uint64_t checks = 0;
+                for (const Board& board : boards) {
+                    checks += board.isKingInCheck(Color::WHITE);
+                    checks += board.isKingInCheck(Color::BLACK);
+                }
+                sink = sink + checks;
+                return static_cast<std::uint64_t>(boards.size()) * 2;
+            }));
+        }
+        if (wanted("get_possible_moves")) {
+            results.push_back(run("get_possible_moves", phase.name, options.minSeconds, [&] {
+                std::uint64_t calls = 0;
+                for (const Board& board : boards) {
+                    for (int square = 0; square < 64; ++square) {
+                        const Piece* piece = board.getPiecePtr(squareAt(square));
+                        if (!piece) continue;
+                        std::vector<Position> moves = piece->getPossibleMoves(squareAt(square), board);
+                        sink = sink + moves.size();
+                        ++calls;
+                    }
+                }
+                return calls;
+            }));
+        }
+        if (wanted("can_player_make_any_legal_move")) {
+            results.push_back(run("can_player_make_any_legal_move", phase.name, options.minSeconds, [&] {
+                std::uint64_t calls = 0;
+                for (std::size_t i = 0; i < games.size(); ++i) {
+                    Player* mover = boards[i].getSideToMove() == Color::WHITE ? &white : &black;
+                    sink = sink + games[i]->canPlayerMakeAnyLegalMove(mover);
+                    ++calls;
+                }
+                return calls;
+            }));
+        }
+        if (wanted("legal_move_set")) {
+            // A full regeneration each time, as on the first query in a new position
+            LegalMoveSet legal;
+            results.push_back(run("legal_move_set", phase.name, options.minSeconds, [&] {
+                for (Board& board : boards) {
+                    legal.clear();
+                    legal.update(board);
+                    sink = sink + legal.size();
+                }
+                return static_cast<std::uint64_t>(boards.size());
+            }));
+        }
+    }
+
+    if (wanted("initialize_board")) {
+        Board board;
+        results.push_back(run("initialize_board", "all", options.minSeconds, [&] {
+            board.initializeBoard();
+            sink = sink + board.findKing(Color::WHITE).row;
+            return std::uint64_t(1);
+        }));
+    }
+
+    if (options.output.empty()) {
+        writeJson(std::cout, results, options.minSeconds);
+    } else {
+        std::ofstream out(options.output);
+        writeJson(out, results, options.minSeconds);
+        if (!out) {
+            std::cerr << "corebench: cannot write " << options.output << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
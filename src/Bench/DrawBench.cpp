@@ -0,0 +1,209 @@
+// Incremental position keys, repetition detection and the fifty-move rule.
+//
+// Usage: drawbench [passes]
+//
+// Checks the built-in keys against the reference keys of the polyglot book format,
+// that Board::getKey() matches a full Zobrist::hash() at every node of a
+// shallow walk over positions with castling, en passant and promotions, and after
+// every undo; that a knight shuffle becomes a threefold repetition on exactly the
+// right ply; that lookups stop at the halfmove clock; and that the
+// halfmove clock reaches the fifty-move draw and resets. Then measures ns per
+// getKey() against a full hash, ns per RepetitionHistory push plus lookup, and
+// search nodes/sec with repetition checks on a shuffling position.
+// Exits non-zero on any mismatch.
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/Notation.h"
+#include "HardChess/Core/RepetitionHistory.h"
+#include "HardChess/Core/Zobrist.h"
+#include "HardChess/Engine/Search.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    const char* const walkPositions[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    };
+
+    // Positions and keys from the polyglot book format description
+    struct ReferenceKey {
+        const char* fen;
+        std::uint64_t key;
+    };
+    const ReferenceKey referenceKeys[] = {
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0x463b96181691fc9cULL},
+        {"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0x823c9b50fd114196ULL},
+        {"rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2", 0x0756b94461c50fb0ULL},
+        {"rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2", 0x662fafb965db29d4ULL},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", 0x22a48b5a8e47ff78ULL},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3", 0x652a607ca3f242c1ULL},
+        {"rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4", 0x00fdd303c946bdd9ULL},
+        {"rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3", 0x3c8123ea7b067637ULL},
+        {"rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4", 0x5c3f9b829b279560ULL},
+    };
+
+    bool failed = false;
+
+    void check(bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "drawbench: " << what << std::endl;
+            failed = true;
+        }
+    }
+
+    long walkKeys(Board& board, int depth, std::vector<Move>* lists) {
+        if (board.getKey() != Zobrist::hash(board)) {
+            std::cerr << "drawbench: key mismatch at " << board.toFEN() << std::endl;
+            failed = true;
+            return 0;
+        }
+        if (depth == 0) return 1;
+        std::vector<Move>& moves = lists[depth];
+        board.generateLegalMoves(moves);
+        long nodes = 0;
+        for (const Move& move : moves) {
+            std::uint64_t before = board.getKey();
+            MoveUndo undo;
+            board.makeMove(move, undo);
+            nodes += walkKeys(board, depth - 1, lists);
+            board.undoMove(move, undo);
+            if (board.getKey() != before) {
+                std::cerr << "drawbench: key not restored after " << Notation::toCoordinate(move) << std::endl;
+                failed = true;
+            }
+        }
+        return nodes;
+    }
+
+    void play(Board& board, RepetitionHistory& history, const char* coordinate) {
+        Position from, to;
+        std::string_view text(coordinate);
+        if (!Notation::parseSquare(text.substr(0, 2), from) || !Notation::parseSquare(text.substr(2, 2), to)) std::abort();
+        board.applyMove(board.completeMove(from, to));
+        history.push(board.getKey());
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point begin) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int passes = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    // The built-in table is polyglot's
+    for (const ReferenceKey& reference : referenceKeys) {
+        Board board;
+        if (!board.fromFEN(reference.fen)) std::abort();
+        if (Zobrist::hash(board) != reference.key || board.getKey() != reference.key) {
+            std::cerr << "drawbench: not the polyglot key for " << reference.fen << std::endl;
+            failed = true;
+        }
+    }
+
+    // Incremental keys against full recomputation
+    std::vector<Move> lists[4];
+    long walked = 0;
+    for (const char* fen : walkPositions) {
+        Board board;
+        if (!board.fromFEN(fen)) std::abort();
+        walked += walkKeys(board, 3, lists);
+        Board copy(board);
+        check(copy.getKey() == board.getKey(), "copied board has a different key");
+    }
+    std::cout << "key walk nodes=" << walked << std::endl;
+
+    // Knight shuffle: the start position occurs for the third time after eight plies
+    const char* const shuffle[] = {"g1f3", "g8f6", "f3g1", "f6g8"};
+    Board board;
+    RepetitionHistory history;
+    history.reset(board.getKey());
+    for (int ply = 1; ply <= 8; ++ply) {
+        play(board, history, shuffle[(ply - 1) % 4]);
+        check(history.isRepetition(board.getHalfmoveClock()) == (ply >= 4), "shuffle repetition ply");
+        check(history.isThreefold(board.getHalfmoveClock()) == (ply == 8), "shuffle threefold ply");
+    }
+
+    // Lookups go no further back than the halfmove clock allows
+    check(history.repetitions(3, 10) == 0 && history.repetitions(8, 10) == 2, "scan window ignores the halfmove clock");
+
+    // Pawn moves in between: the shuffle after them repeats from a new position
+    Board pawnBoard;
+    RepetitionHistory pawnHistory;
+    pawnHistory.reset(pawnBoard.getKey());
+    for (const char* move : {"g1f3", "g8f6", "f3g1", "f6g8", "e2e4", "e7e5"}) play(pawnBoard, pawnHistory, move);
+    for (int ply = 0; ply < 8; ++ply) play(pawnBoard, pawnHistory, shuffle[ply % 4]);
+    check(pawnBoard.getHalfmoveClock() == 8, "halfmove clock after the shuffle");
+    check(pawnHistory.isThreefold(pawnBoard.getHalfmoveClock()), "threefold after the pawn moves");
+
+    // Fifty-move rule
+    Board quiet;
+    if (!quiet.fromFEN("8/8/4k3/8/8/3K4/4P3/8 w - - 99 80")) std::abort();
+    check(!quiet.isFiftyMoveDraw(), "fifty-move draw too early");
+    Board pawnPush(quiet);
+    RepetitionHistory unused;
+    unused.reset(quiet.getKey());
+    play(quiet, unused, "d3d4");
+    check(quiet.isFiftyMoveDraw() && quiet.getHalfmoveClock() == 100, "fifty-move draw missed");
+    play(pawnPush, unused, "e2e4");
+    check(pawnPush.getHalfmoveClock() == 0, "pawn move did not reset the halfmove clock");
+
+    // Cost of the incremental key against a full hash
+    Board middlegame;
+    if (!middlegame.fromFEN(walkPositions[0])) std::abort();
+    const int keyRounds = 1000000;
+    std::uint64_t sum = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < keyRounds * passes / 20; ++i) sum += middlegame.getKey() + static_cast<std::uint64_t>(i);
+    double incremental = secondsSince(begin);
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < keyRounds * passes / 20; ++i) sum += Zobrist::hash(middlegame) + static_cast<std::uint64_t>(i);
+    double full = secondsSince(begin);
+    double keyOps = keyRounds * passes / 20.0;
+    std::cout << "getKey ns/op=" << incremental * 1e9 / keyOps << " hash ns/op=" << full * 1e9 / keyOps
+              << " (checksum " << (sum & 0xffff) << ")" << std::endl;
+
+    // Push plus lookup over a long reversible stretch, as a search does at every node
+    RepetitionHistory ring;
+    ring.reset(board.getKey());
+    std::uint64_t keys[4];
+    for (int i = 0; i < 4; ++i) {
+        play(board, ring, shuffle[i]);
+        keys[i] = board.getKey();
+    }
+    const long ringOps = 2000000L * passes / 20;
+    long found = 0;
+    begin = std::chrono::steady_clock::now();
+    for (long i = 0; i < ringOps; ++i) {
+        ring.push(keys[i & 3]);
+        found += ring.isRepetition(static_cast<int>(i % 100));
+        ring.pop();
+    }
+    double ringSeconds = secondsSince(begin);
+    std::cout << "repetition push+lookup ns/op=" << ringSeconds * 1e9 / ringOps << " (found " << found << ")" << std::endl;
+
+    // Search with repetition and fifty-move checks at every node
+    Board shuffling;
+    if (!shuffling.fromFEN("r5k1/5pp1/7p/8/8/7P/5PP1/1R4K1 w - - 0 40")) std::abort();
+    Search search;
+    SearchLimits limits;
+    limits.depth = 5;
+    long long nodes = 0;
+    begin = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes / 10 + 1; ++pass) nodes += search.run(shuffling, limits).nodes;
+    double searchSeconds = secondsSince(begin);
+    std::cout << "search nodes=" << nodes << " nodes/sec=" << static_cast<long long>(nodes / searchSeconds) << std::endl;
+
+    if (failed) return 1;
+    std::cout << "all checks passed" << std::endl;
+    return 0;
+}
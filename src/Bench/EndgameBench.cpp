@@ -0,0 +1,171 @@
+// Sparse-position benchmark for the per-color piece lists.
+//
+// Usage: endgamebench [passes]
+//
+// Endgames are where scanning all 64 squares for a handful of pieces wastes the
+// most. For a fixed set of endgame positions this measures perft nodes/sec
+// (move generation plus make/unmake), isSquareAttacked probes/sec over every
+// square and both colors, and evaluations/sec. It checks the perft counts and
+// attack totals against known values, and checks that the piece lists still match
+// the board at every node of a shallow walk.
+// Exits non-zero on any mismatch.
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Engine/Evaluation.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    struct Reference {
+        const char* fen;
+        int depth;
+        long nodes;
+    };
+
+    const Reference positions[] = {
+        {"8/8/8/4k3/8/8/8/R3K3 w - - 0 1", 5, 246330},
+        {"8/8/3k4/8/8/2r5/8/4K2Q w - - 0 1", 4, 117212},
+        {"8/8/1k6/8/3P4/8/2r5/4K2R w - - 0 1", 4, 55205},
+        {"8/8/8/3k4/8/8/8/2BNK3 w - - 0 1", 5, 191280},
+        {"8/5k2/3p4/1p1P1p2/1P3P2/6K1/8/8 w - - 0 1", 6, 40520},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, 674624},
+        {"8/6k1/8/8/2Q5/8/1q3PK1/8 w - - 0 1", 4, 367867},
+    };
+    constexpr int positionCount = sizeof(positions) / sizeof(positions[0]);
+    constexpr long attackedPerPass = 682846; // Attacked (square, color) pairs over 20000 rounds
+
+    // The piece lists must hold exactly the pieces on the board
+    bool listsMatchBoard(const Board& board) {
+        int listed = 0;
+        for (Color color : {Color::WHITE, Color::BLACK}) {
+            for (int t = static_cast<int>(PieceType::PAWN); t <= static_cast<int>(PieceType::KING); ++t) {
+                for (int square : board.pieces(color, static_cast<PieceType>(t))) {
+                    const Piece* piece = board.getPiecePtr(squareAt(square));
+                    if (!piece || piece->getColor() != color || static_cast<int>(piece->getType()) != t) return false;
+                    if (!(board.occupiedSquares() & AttackTables::squareMask(square))) return false;
+                    ++listed;
+                }
+            }
+        }
+        int occupied = 0;
+        for (int square = 0; square < 64; ++square) occupied += board.getPiecePtr(squareAt(square)) != nullptr;
+        return listed == occupied;
+    }
+
+    bool checkLists(Board& board, int depth) {
+        if (!listsMatchBoard(board)) return false;
+        if (depth == 0) return true;
+        std::vector<Move> moves;
+        board.generateLegalMoves(moves);
+        for (const Move& move : moves) {
+            MoveUndo undo;
+            board.makeMove(move, undo);
+            bool ok = checkLists(board, depth - 1);
+            board.undoMove(move, undo);
+            if (!ok) return false;
+        }
+        return listsMatchBoard(board);
+    }
+
+    long perft(Board& board, int depth, std::vector<std::vector<Move>>& lists) {
+        std::vector<Move>& moves = lists[depth];
+        board.generateLegalMoves(moves);
+        if (depth == 1) return static_cast<long>(moves.size());
+        long nodes = 0;
+        for (const Move& move : moves) {
+            MoveUndo undo;
+            board.makeMove(move, undo);
+            nodes += perft(board, depth - 1, lists);
+            board.undoMove(move, undo);
+        }
+        return nodes;
+    }
+
+    template <typename Body>
+    double timed(Body body) {
+        auto begin = std::chrono::steady_clock::now();
+        body();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int passes = argc > 1 ? std::atoi(argv[1]) : 1;
+    Board boards[positionCount];
+    for (int i = 0; i < positionCount; ++i) {
+        if (!boards[i].fromFEN(positions[i].fen)) {
+            std::cerr << "endgamebench: bad position " << positions[i].fen << std::endl;
+            return 2;
+        }
+    }
+
+    const char* const promotions = "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1";
+    Board promotionBoard;
+    promotionBoard.fromFEN(promotions);
+    for (int i = 0; i < positionCount; ++i) {
+        if (!checkLists(boards[i], 3)) {
+            std::cerr << "endgamebench: piece lists out of step with the board below " << positions[i].fen << std::endl;
+            return 1;
+        }
+    }
+    if (!checkLists(promotionBoard, 3)) {
+        std::cerr << "endgamebench: piece lists out of step with the board below " << promotions << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<Move>> lists(8);
+    long nodes = 0;
+    bool failed = false;
+    double perftSeconds = timed([&] {
+        for (int pass = 0; pass < passes; ++pass) {
+            for (int i = 0; i < positionCount; ++i) {
+                long count = perft(boards[i], positions[i].depth, lists);
+                if (pass == 0 && count != positions[i].nodes) {
+                    std::cerr << "endgamebench: perft " << count << " expected " << positions[i].nodes << " for "
+                              << positions[i].fen << std::endl;
+                    failed = true;
+                }
+                if (pass == 0) std::cout << positions[i].fen << " perft(" << positions[i].depth << ")=" << count << std::endl;
+                nodes += count;
+            }
+        }
+    });
+
+    long attacked = 0;
+    const int attackRounds = 20000 * passes;
+    double attackSeconds = timed([&] {
+        for (int pass = 0; pass < passes; ++pass) {
+            for (int round = 0; round < 20000; ++round) {
+                const Board& board = boards[round % positionCount];
+                for (int square = 0; square < 64; ++square) {
+                    attacked += board.isSquareAttacked(squareAt(square), Color::WHITE);
+                    attacked += board.isSquareAttacked(squareAt(square), Color::BLACK);
+                }
+            }
+        }
+    });
+
+    if (attacked != attackedPerPass * passes) {
+        std::cerr << "endgamebench: " << attacked << " attacked squares, expected " << attackedPerPass * passes << std::endl;
+        failed = true;
+    }
+
+    long checksum = 0;
+    const int evaluations = 2000000 * passes;
+    double evalSeconds = timed([&] {
+        for (int i = 0; i < evaluations; ++i) checksum += Evaluation::evaluate(boards[i % positionCount]);
+    });
+
+    std::cout << "perft nodes=" << nodes << " nodes/sec=" << static_cast<long>(nodes / perftSeconds) << std::endl;
+    std::cout << "attack probes=" << 128L * attackRounds << " attacked=" << attacked
+              << " probes/sec=" << static_cast<long>(128L * attackRounds / attackSeconds) << std::endl;
+    std::cout << "evaluations=" << evaluations << " checksum=" << checksum
+              << " evaluations/sec=" << static_cast<long>(evaluations / evalSeconds) << std::endl;
+    return failed ? 1 : 0;
+}
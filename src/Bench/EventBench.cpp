@@ -0,0 +1,164 @@
+// Cost of recording game events from many threads at once.
+//
+// Usage: eventbench [threads] [events-per-thread] [output.jsonl]
+//
+// Every thread records a stream of move events, first through EventLog (per-thread
+// rings drained by the writer thread) and then, as the baseline, straight to a shared
+// stream under a mutex the way console output serializes game threads. Reports ns per
+// event on the recording threads and events/sec for both. Checks that every event is
+// either written or counted as dropped, that the JSONL file has one line per written
+// event, that the binary file holds whole 32-byte records, and that a log with tiny
+// rings drops rather than blocks.
+// Exits non-zero on any mismatch.
+
+#include "HardChess/Util/EventLog.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    bool failed = false;
+
+    void check(bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "eventbench: " << what << std::endl;
+            failed = true;
+        }
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point begin) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    EventLog::Event moveEvent(int thread, long i) {
+        EventLog::Event event;
+        event.type = EventLog::EventType::MOVE;
+        event.game = static_cast<std::uint32_t>(thread + 1);
+        event.ply = static_cast<std::uint16_t>(i);
+        event.color = static_cast<std::uint8_t>(1 + (i & 1));
+        event.piece = static_cast<std::uint8_t>(1 + i % 6);
+        event.move = static_cast<std::uint16_t>((i * 2654435761u) & 0x0fff);
+        return event;
+    }
+
+    // Runs body(thread) on `threads` threads; returns the wall time
+    template <typename Body>
+    double onThreads(int threads, Body body) {
+        std::vector<std::thread> workers;
+        auto begin = std::chrono::steady_clock::now();
+        for (int t = 0; t < threads; ++t) workers.emplace_back(body, t);
+        for (std::thread& worker : workers) worker.join();
+        return secondsSince(begin);
+    }
+
+    long countLines(const std::string& path) {
+        std::ifstream in(path);
+        std::string line;
+        long lines = 0;
+        while (std::getline(in, line)) ++lines;
+        return lines;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int threads = argc > 1 ? std::atoi(argv[1]) : 4;
+    long perThread = argc > 2 ? std::atol(argv[2]) : 200000;
+    std::string path = argc > 3 ? argv[3] : "eventbench.jsonl";
+    if (threads <= 0 || perThread <= 0) {
+        std::cerr << "usage: eventbench [threads] [events-per-thread] [output.jsonl]" << std::endl;
+        return 2;
+    }
+    const long total = threads * perThread;
+
+    // Through the rings. Threads pause now and then, as games do between moves, which is
+    // what lets a writer on a busy machine keep up.
+    if (!EventLog::open(path, EventLog::Format::JSONL, 1 << 14)) {
+        std::cerr << "eventbench: cannot open " << path << std::endl;
+        return 2;
+    }
+    std::vector<double> recordSeconds(threads);
+    double logSeconds = onThreads(threads, [&](int thread) {
+        double busy = 0;
+        for (long i = 0; i < perThread; i += 256) {
+            auto begin = std::chrono::steady_clock::now();
+            for (long j = i; j < i + 256 && j < perThread; ++j) EventLog::record(moveEvent(thread, j));
+            busy += secondsSince(begin);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        recordSeconds[thread] = busy;
+    });
+    EventLog::Totals logged = EventLog::totals();
+    auto drainBegin = std::chrono::steady_clock::now();
+    check(EventLog::close(), "writing the log failed");
+    double drainSeconds = secondsSince(drainBegin);
+    check(logged.recorded + logged.dropped == static_cast<std::uint64_t>(total), "events neither recorded nor dropped");
+    long dropNotes = logged.dropped > 0 ? 1 : 0; // At least one "dropped" line when anything was lost
+    long lines = countLines(path);
+    check(lines >= static_cast<long>(logged.recorded) + dropNotes, "JSONL has fewer lines than recorded events");
+    double busy = 0;
+    for (double seconds : recordSeconds) busy += seconds;
+    std::cout << "eventlog threads=" << threads << " events=" << total << " recorded=" << logged.recorded
+              << " dropped=" << logged.dropped << " record ns/event=" << busy * 1e9 / total
+              << " wall events/sec=" << static_cast<long long>(total / logSeconds)
+              << " final drain ms=" << drainSeconds * 1000 << std::endl;
+
+    // Baseline: formatting and writing on the game thread, one stream behind a mutex
+    std::ofstream shared(path + ".baseline");
+    std::mutex streamMutex;
+    std::vector<double> baselineSeconds(threads);
+    double lockedSeconds = onThreads(threads, [&](int thread) {
+        double busyBaseline = 0;
+        for (long i = 0; i < perThread; i += 256) {
+            auto begin = std::chrono::steady_clock::now();
+            for (long j = i; j < i + 256 && j < perThread; ++j) {
+                EventLog::Event event = moveEvent(thread, j);
+                std::lock_guard<std::mutex> lock(streamMutex);
+                shared << "{\"game\":" << event.game << ",\"type\":\"move\",\"ply\":" << event.ply
+                       << ",\"move\":" << event.move << "}" << std::endl;
+            }
+            busyBaseline += secondsSince(begin);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        baselineSeconds[thread] = busyBaseline;
+    });
+    shared.close();
+    std::remove((path + ".baseline").c_str());
+    double busyBaseline = 0;
+    for (double seconds : baselineSeconds) busyBaseline += seconds;
+    std::cout << "mutex+stream threads=" << threads << " record ns/event=" << busyBaseline * 1e9 / total
+              << " wall events/sec=" << static_cast<long long>(total / lockedSeconds) << std::endl;
+
+    // Tiny rings and no pauses: the writer must fall behind, and recording must not wait
+    if (!EventLog::open(path, EventLog::Format::BINARY, 16)) {
+        std::cerr << "eventbench: cannot reopen " << path << std::endl;
+        return 2;
+    }
+    double burstSeconds = onThreads(threads, [&](int thread) {
+        for (long i = 0; i < perThread; ++i) EventLog::record(moveEvent(thread, i));
+    });
+    EventLog::Totals burst = EventLog::totals();
+    check(EventLog::close(), "writing the binary log failed");
+    check(burst.recorded + burst.dropped == static_cast<std::uint64_t>(total), "burst events neither recorded nor dropped");
+    check(burst.dropped > 0 || total <= 16L * threads, "tiny rings dropped nothing");
+    std::ifstream binary(path, std::ios::binary | std::ios::ate);
+    long long bytes = static_cast<long long>(binary.tellg());
+    check(bytes >= 16 + 32LL * static_cast<long long>(burst.recorded) && (bytes - 16) % 32 == 0,
+          "binary log is not a header plus one record per written event");
+    std::cout << "burst (16-event rings) recorded=" << burst.recorded << " dropped=" << burst.dropped
+              << " record ns/event=" << burstSeconds * threads * 1e9 / total << std::endl;
+    std::remove(path.c_str());
+
+    if (failed) return 1;
+    std::cout << "all checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,122 @@
+// FEN round-trip benchmark.
+//
+// Usage: fenbench [corpus.fen] [passes]
+//
+// First checks that every position of the built-in reference set survives
+// fromFEN -> toFEN byte for byte, then measures round-trip throughput over the
+// corpus (one FEN or EPD record per line; the reference set when no file is given).
+// Exits non-zero if any record fails to parse or does not round-trip stably.
+
+#include "HardChess/Core/Board.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    const char* const referencePositions[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1",
+        "rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq c6 0 2",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "4k3/8/8/8/8/8/8/4K2R w K - 0 1",
+        "8/8/8/8/8/8/6k1/4K2R b K - 12 47",
+        "8/8/4k3/8/8/8/3QK3/8 w - - 0 60",
+        "8/8/8/4k3/8/8/4P3/4K3 w - - 0 1",
+        "8/8/8/8/8/5k2/8/2BNK3 w - - 3 71",
+        "r1bqkbnr/pppp1ppp/2n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3",
+        "rnbqkb1r/ppp1pppp/5n2/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3",
+        "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 30",
+        "8/P7/8/8/8/8/8/k6K w - - 0 1",
+        "3r2k1/p4ppp/8/8/8/8/P4PPP/3R2K1 b - - 4 25",
+    };
+
+    std::vector<std::string> loadCorpus(const char* path) {
+        std::vector<std::string> corpus;
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "fenbench: cannot open " << path << std::endl;
+            std::exit(2);
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line[0] != '#') corpus.push_back(line);
+        }
+        return corpus;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Board board;
+    char buffer[Board::MAX_FEN_LENGTH];
+
+    // Exact round trip of the reference set
+    int failures = 0;
+    for (const char* fen : referencePositions) {
+        std::size_t length = 0;
+        if (!board.fromFEN(fen) || (length = board.writeFEN(buffer), std::string(buffer, length) != fen)) {
+            std::cerr << "round-trip mismatch: " << fen << " -> " << std::string(buffer, length) << std::endl;
+            ++failures;
+        }
+    }
+    std::cout << "reference set: " << (sizeof(referencePositions) / sizeof(referencePositions[0])) - failures
+              << "/" << sizeof(referencePositions) / sizeof(referencePositions[0]) << " exact round trips" << std::endl;
+
+    std::vector<std::string> corpus;
+    if (argc > 1) {
+        corpus = loadCorpus(argv[1]);
+    } else {
+        corpus.assign(std::begin(referencePositions), std::end(referencePositions));
+    }
+    int passes = argc > 2 ? std::atoi(argv[2]) : (argc > 1 ? 1 : 50000);
+    if (corpus.empty() || passes < 1) {
+        std::cerr << "fenbench: empty corpus" << std::endl;
+        return 2;
+    }
+
+    // Stability check: a second round trip must reproduce the first serialization
+    Board second;
+    char again[Board::MAX_FEN_LENGTH];
+    for (const std::string& fen : corpus) {
+        if (!board.fromFEN(fen)) {
+            std::cerr << "rejected: " << fen << std::endl;
+            ++failures;
+            continue;
+        }
+        std::size_t length = board.writeFEN(buffer);
+        if (!second.fromFEN(std::string_view(buffer, length)) || second.writeFEN(again) != length ||
+            std::memcmp(buffer, again, length) != 0) {
+            std::cerr << "unstable round trip: " << fen << std::endl;
+            ++failures;
+        }
+    }
+
+    std::size_t checksum = 0;
+    std::size_t positions = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const std::string& fen : corpus) {
+            if (board.fromFEN(fen)) {
+                checksum += board.writeFEN(buffer);
+                ++positions;
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    std::cout << "positions: " << positions << ", seconds: " << seconds
+              << ", positions/sec: " << static_cast<long long>(positions / (seconds > 0 ? seconds : 1e-9))
+              << ", bytes written: " << checksum << std::endl;
+    return failures == 0 ? 0 : 1;
+}
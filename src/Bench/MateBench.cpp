@@ -0,0 +1,205 @@
+// Mate solver benchmark: df-pn against the alpha-beta search.
+//
+// Usage: matebench [seconds]
+//
+// For a fixed set of mating puzzles and basic endings this runs MateSolver and checks
+// the mate length against known values, that no shorter mate was left open, and that
+// the reported line is legal, alternates correctly and ends in checkmate. One ending is
+// solved again in a 1 MB table so the garbage collection runs, and must give the same
+// mate. The basic endings are also looked up in KQvK and KRvK tables generated into a
+// scratch directory: the solver's mate length must match the tables', and every move of
+// its line must keep to best play by both sides. Each position
+// is then handed to the alpha-beta Search at the depth the mate
+// needs (2N-1 plies), capped at [seconds] each (default 10), to compare the time to
+// the same answer. Reports nodes/sec for both.
+// Exits non-zero on any mismatch.
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Engine/MateSolver.h"
+#include "HardChess/Engine/Search.h"
+#include "HardChess/Engine/Tablebase.h"
+#include "HardChess/Engine/TablebaseGenerator.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    struct Reference {
+        const char* fen;
+        int mateIn;
+    };
+
+    const Reference positions[] = {
+        {"6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1", 1},
+        {"6k1/8/5K2/8/8/8/8/7R w - - 0 1", 2},
+        {"8/8/8/8/8/8/k7/2K1Q3 w - - 0 1", 2},
+        {"6k1/pp4p1/2p5/2bp4/8/P5Pb/1P3rrP/2BRRN1K b - - 0 1", 2},
+        {"r1b2k1r/ppp1bppp/8/1B1Q4/5q2/2P5/PPP2PPP/R3R1K1 w - - 1 1", 2},
+        {"r2qkb1r/pp2nppp/3p4/2pNN1B1/2BnP3/3P4/PPP2PPP/R2bK2R w KQkq - 1 1", 2},
+        {"2r3k1/p4p2/3Rp2p/1p2P1pK/8/1P4P1/P3Q2P/1q6 b - - 0 1", 3},
+        {"3q1r1k/2p4p/1p1pBrp1/p2Pp3/2PnP3/5PP1/PP1Q2K1/5R1R w - - 1 1", 3},
+        {"r1bk3r/pppq1ppp/5n2/4N1N1/2Bp4/Bn6/P4PPP/4R1K1 w - - 1 1", 4},
+        {"8/8/8/8/2k5/8/8/1K2Q3 w - - 0 1", 6},
+    };
+    constexpr int positionCount = sizeof(positions) / sizeof(positions[0]);
+    constexpr int collectedPosition = positionCount - 1; // Needs more than a 1 MB table holds
+    constexpr long long nodeLimit = 2000000;
+
+    // The line must be legal, end in checkmate, and give the attacker mateIn moves
+    bool lineMates(Board board, const std::vector<Move>& line, int mateIn) {
+        if (line.size() != static_cast<std::size_t>(2 * mateIn - 1)) return false;
+        std::vector<Move> moves;
+        for (const Move& move : line) {
+            board.generateLegalMoves(moves);
+            bool legal = false;
+            for (const Move& candidate : moves) legal = legal || candidate.encode() == move.encode();
+            if (!legal) return false;
+            board.applyMove(move);
+        }
+        board.generateLegalMoves(moves);
+        return moves.empty() && board.isKingInCheck(board.getSideToMove());
+    }
+
+    // With best play by both sides the distance to mate falls by one every ply: a
+    // defender move that shortens it more is not the longest defence
+    bool lineOptimal(Board board, const std::vector<Move>& line, const Tablebase& tablebase, int plies) {
+        for (const Move& move : line) {
+            board.applyMove(move);
+            TbResult after;
+            if (!tablebase.probe(board, after) || after.plies != --plies) return false;
+        }
+        return plies == 0;
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point begin) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return seconds > 0 ? seconds : 1e-9;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int capSeconds = argc > 1 ? std::atoi(argv[1]) : 10;
+    if (capSeconds <= 0) capSeconds = 10;
+    Board boards[positionCount];
+    for (int i = 0; i < positionCount; ++i) {
+        if (!boards[i].fromFEN(positions[i].fen)) {
+            std::cerr << "matebench: bad position " << positions[i].fen << std::endl;
+            return 2;
+        }
+    }
+
+    // Exact mate lengths for the pawnless endings
+    std::filesystem::path tableDirectory =
+        std::filesystem::temp_directory_path() / ("hardchess-matebench-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(tableDirectory);
+    TablebaseGenerator generator(tableDirectory.string());
+    std::vector<TbGenerationReport> reports;
+    Tablebase tablebase;
+    for (const char* name : {"KQvK", "KRvK"}) {
+        TbMaterial material;
+        if (!TbMaterial::parse(name, material) || !generator.generate(material, reports)) {
+            std::cerr << "matebench: cannot generate " << name << " in " << tableDirectory.string() << std::endl;
+            std::filesystem::remove_all(tableDirectory);
+            return 2;
+        }
+    }
+    bool tablesOpen = tablebase.open(tableDirectory.string());
+    std::filesystem::remove_all(tableDirectory); // The mappings stay valid
+    if (!tablesOpen) {
+        std::cerr << "matebench: cannot open the generated tables" << std::endl;
+        return 2;
+    }
+
+    bool failed = false;
+    int tableChecks = 0;
+    auto solver = std::make_unique<MateSolver>();
+    auto search = std::make_unique<Search>();
+    MateLimits limits;
+    limits.nodes = nodeLimit;
+    long long solverNodes = 0, searchNodes = 0;
+    double solverSeconds = 0, searchSeconds = 0;
+    int solverFound = 0, searchFound = 0;
+
+    for (int i = 0; i < positionCount; ++i) {
+        const Reference& reference = positions[i];
+        MateResult result = solver->solve(boards[i], limits);
+        solverNodes += result.nodes;
+        solverSeconds += result.seconds;
+        std::cout << reference.fen << "\n  df-pn: " << result.describe(boards[i]) << " nodes=" << result.nodes
+                  << " seconds=" << result.seconds << std::endl;
+        if (result.status != MateStatus::MATE || result.mateIn != reference.mateIn || !result.shortest) {
+            std::cerr << "matebench: expected a shortest mate in " << reference.mateIn << " for " << reference.fen
+                      << std::endl;
+            failed = true;
+        } else if (!lineMates(boards[i], result.line, reference.mateIn)) {
+            std::cerr << "matebench: line does not end in mate for " << reference.fen << std::endl;
+            failed = true;
+        } else {
+            ++solverFound;
+        }
+        TbResult exact;
+        if (tablebase.probe(boards[i], exact)) {
+            ++tableChecks;
+            std::cout << "  tablebase: " << (exact.outcome == TbOutcome::WIN ? "win" : "no win") << " in "
+                      << exact.plies << " plies" << std::endl;
+            if (exact.outcome != TbOutcome::WIN || (exact.plies + 1) / 2 != result.mateIn) {
+                std::cerr << "matebench: the tablebase disagrees on " << reference.fen << std::endl;
+                failed = true;
+            } else if (!lineOptimal(boards[i], result.line, tablebase, exact.plies)) {
+                std::cerr << "matebench: the line strays from best play for " << reference.fen << std::endl;
+                failed = true;
+            }
+        }
+
+        SearchLimits searchLimits;
+        searchLimits.depth = 2 * reference.mateIn - 1;
+        searchLimits.timeMs = capSeconds * 1000;
+        auto begin = std::chrono::steady_clock::now();
+        SearchResult searched = search->run(boards[i], searchLimits);
+        double seconds = secondsSince(begin);
+        searchNodes += searched.nodes;
+        searchSeconds += seconds;
+        bool found = Search::mateInMoves(searched.score) == reference.mateIn;
+        searchFound += found;
+        std::cout << "  alpha-beta: depth=" << searched.depth << (found ? " mate found" : " no mate")
+                  << " nodes=" << searched.nodes << " seconds=" << seconds << std::endl;
+    }
+
+    // A table far too small for the ending: collections must run and the answer not change
+    MateLimits small = limits;
+    small.memoryMB = 1;
+    MateResult collected = solver->solve(boards[collectedPosition], small);
+    std::cout << "1 MB table: " << collected.describe(boards[collectedPosition]) << " nodes=" << collected.nodes
+              << " collections=" << collected.collections << " entries=" << collected.tableEntries << std::endl;
+    if (collected.collections == 0 || collected.status != MateStatus::MATE ||
+        collected.mateIn != positions[collectedPosition].mateIn ||
+        !lineMates(boards[collectedPosition], collected.line, collected.mateIn)) {
+        std::cerr << "matebench: solving in a 1 MB table went wrong" << std::endl;
+        failed = true;
+    }
+
+    if (tableChecks != 3) {
+        std::cerr << "matebench: expected 3 positions in the tables, found " << tableChecks << std::endl;
+        failed = true;
+    }
+
+    if (solverSeconds <= 0) solverSeconds = 1e-9;
+    std::cout << "df-pn: mates=" << solverFound << "/" << positionCount << " nodes=" << solverNodes
+              << " seconds=" << solverSeconds << " nodes/sec=" << static_cast<long long>(solverNodes / solverSeconds)
+              << std::endl;
+    std::cout << "alpha-beta: mates=" << searchFound << "/" << positionCount << " nodes=" << searchNodes
+              << " seconds=" << searchSeconds << " nodes/sec=" << static_cast<long long>(searchNodes / searchSeconds)
+              << std::endl;
+    std::cout << "speedup=" << searchSeconds / solverSeconds << "x" << std::endl;
+    if (!failed) std::cout << "all checks passed" << std::endl;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,179 @@
+// Multi-PV benchmark: time to depth with K lines against a single line.
+//
+// Usage: multipvbench [depth]   (at least 2)
+//
+// For a fixed set of middlegame positions this searches to [depth] (default 5) plies
+// with one line and with K = 2, 4 and 8 lines, reporting nodes and time to depth
+// for each K relative to K = 1. For the cost the shared root pass avoids, it also times
+// the naive alternative: a separate search below every root move. It checks that the
+// best line's score matches the single-PV search, that the lines are sorted with
+// distinct first moves and legal PVs from the requested depth, and that the K scores
+// are exactly the K best of those separate searches.
+// Exits non-zero on any mismatch.
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/Notation.h"
+#include "HardChess/Engine/Search.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    const char* const positions[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    };
+    constexpr int positionCount = sizeof(positions) / sizeof(positions[0]);
+    const int lineCounts[] = {1, 2, 4, 8};
+    constexpr int lineCountCount = sizeof(lineCounts) / sizeof(lineCounts[0]);
+
+    struct Totals {
+        long long nodes = 0;
+        double seconds = 0;
+    };
+
+    bool legalLine(Board board, const std::vector<Move>& pv) {
+        std::vector<Move> moves;
+        for (const Move& move : pv) {
+            board.generateLegalMoves(moves);
+            bool legal = false;
+            for (const Move& candidate : moves) legal = legal || candidate.encode() == move.encode();
+            if (!legal) return false;
+            board.applyMove(move);
+        }
+        return true;
+    }
+
+    // Whatever went wrong with the lines, or an empty string
+    std::string checkLines(const SearchResult& result, const SearchResult& single, Board& board, int depth, int lines) {
+        std::vector<Move> legal;
+        board.generateLegalMoves(legal);
+        std::size_t expected = static_cast<std::size_t>(lines) < legal.size() ? lines : legal.size();
+        if (result.lines.size() != expected) return "wrong number of lines";
+        if (result.lines[0].score != single.score || result.score != single.score) return "best score differs from single-PV";
+        if (result.lines[0].move != result.bestMove) return "lines[0] is not the best move";
+        for (std::size_t i = 0; i < result.lines.size(); ++i) {
+            const SearchLine& line = result.lines[i];
+            if (i > 0 && line.score > result.lines[i - 1].score) return "lines out of order";
+            for (std::size_t j = 0; j < i; ++j) {
+                if (result.lines[j].move == line.move) return "a move reported twice";
+            }
+            if (line.depth != depth) return "line from another depth";
+            if (line.pv.empty() || line.pv[0] != line.move || !legalLine(board, line.pv)) return "bad PV";
+        }
+        return std::string();
+    }
+
+    std::string coordinate(const Move& move) {
+        char text[5];
+        return std::string(text, Notation::formatCoordinate(move, text));
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point begin) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return seconds > 0 ? seconds : 1e-9;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int depth = argc > 1 ? std::atoi(argv[1]) : 5;
+    if (depth < 2) depth = 5; // The separate searches go one ply less deep
+    Board boards[positionCount];
+    for (int i = 0; i < positionCount; ++i) {
+        if (!boards[i].fromFEN(positions[i])) {
+            std::cerr << "multipvbench: bad position " << positions[i] << std::endl;
+            return 2;
+        }
+    }
+
+    bool failed = false;
+    auto search = std::make_unique<Search>();
+    Totals shared[lineCountCount];
+    Totals separate; // A search below every root move, at the largest K
+    const int widest = lineCounts[lineCountCount - 1];
+
+    for (int i = 0; i < positionCount; ++i) {
+        SearchLimits limits;
+        limits.depth = depth;
+        SearchResult single;
+        for (int k = 0; k < lineCountCount; ++k) {
+            limits.multiPv = lineCounts[k];
+            auto begin = std::chrono::steady_clock::now();
+            SearchResult result = search->run(boards[i], limits);
+            shared[k].seconds += secondsSince(begin);
+            shared[k].nodes += result.nodes;
+            if (k == 0) single = result;
+
+            std::string problem = checkLines(result, single, boards[i], depth, lineCounts[k]);
+            if (!problem.empty()) {
+                std::cerr << "multipvbench: " << problem << " with " << lineCounts[k] << " lines for " << positions[i]
+                          << std::endl;
+                failed = true;
+                continue;
+            }
+            if (lineCounts[k] != widest) continue;
+
+            // Without the shared pass, ranking the moves takes a search below every one of them
+            std::cout << positions[i] << std::endl;
+            SearchLimits childLimits;
+            childLimits.depth = depth - 1;
+            std::vector<Move> legal;
+            boards[i].generateLegalMoves(legal);
+            std::vector<int> scores;
+            for (const Move& move : legal) {
+                Board child = boards[i];
+                child.applyMove(move);
+                auto childBegin = std::chrono::steady_clock::now();
+                SearchResult childResult = search->run(child, childLimits);
+                separate.seconds += secondsSince(childBegin);
+                separate.nodes += childResult.nodes;
+                // Mate distances count from the child: one ply further from here
+                int score = -childResult.score;
+                if (score > Search::MATE_BOUND) --score;
+                else if (score < -Search::MATE_BOUND) ++score;
+                scores.push_back(score);
+                for (const SearchLine& line : result.lines) {
+                    if (line.move == move && line.score != score) {
+                        std::cerr << "multipvbench: line " << coordinate(move) << " scored " << line.score
+                                  << ", its own search says " << score << " for " << positions[i] << std::endl;
+                        failed = true;
+                    }
+                }
+            }
+            std::sort(scores.begin(), scores.end(), std::greater<int>());
+            for (std::size_t j = 0; j < result.lines.size(); ++j) {
+                const SearchLine& line = result.lines[j];
+                if (line.score != scores[j]) {
+                    std::cerr << "multipvbench: line " << j + 1 << " scored " << line.score << " but the "
+                              << j + 1 << "th best move scores " << scores[j] << " for " << positions[i] << std::endl;
+                    failed = true;
+                }
+                std::cout << "  " << coordinate(line.move) << " score=" << line.score << " depth=" << line.depth
+                          << " nodes=" << line.nodes << std::endl;
+            }
+        }
+    }
+
+    for (int k = 0; k < lineCountCount; ++k) {
+        std::cout << "multipv=" << lineCounts[k] << " depth=" << depth << " nodes=" << shared[k].nodes
+                  << " seconds=" << shared[k].seconds << " nodes/sec=" << static_cast<long long>(shared[k].nodes / shared[k].seconds)
+                  << " time-to-depth=" << shared[k].seconds / shared[0].seconds << "x" << std::endl;
+    }
+    std::cout << "separate searches of every move for " << widest << " lines: nodes=" << separate.nodes
+              << " seconds=" << separate.seconds << " (" << separate.seconds / shared[lineCountCount - 1].seconds
+              << "x the shared pass)" << std::endl;
+    if (!failed) std::cout << "all checks passed" << std::endl;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,85 @@
+// PGN replay benchmark.
+//
+// Usage: pgnbench [archive.pgn] [threads]
+//
+// Memory-maps the archive (or builds an in-memory corpus from the built-in sample
+// games when no file is given), then replays every game through the move rules,
+// first on one thread and then split at game boundaries across threads.
+// Reports games/sec and moves/sec; exits non-zero if any game fails to replay, or if
+// splitting cuts a game whose comments hold blank lines followed by '[' lines.
+
+#include "HardChess/IO/MappedFile.h"
+#include "HardChess/IO/PgnReader.h"
+#include "SampleGames.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace HardChess;
+
+namespace {
+
+    void report(const char* label, const PgnStats& stats, double seconds) {
+        if (seconds <= 0) seconds = 1e-9;
+        std::cout << label << ": games=" << stats.games << " moves=" << stats.moves << " errors=" << stats.errors
+                  << " seconds=" << seconds << " games/sec=" << static_cast<long long>(stats.games / seconds)
+                  << " moves/sec=" << static_cast<long long>(stats.moves / seconds) << std::endl;
+    }
+
+    // Games whose comments look like game starts after a blank line; every split of them
+    // must still replay every game
+    bool splitsAtRealBoundaries() {
+        std::string text;
+        for (int i = 0; i < 200; ++i) {
+            text += "[Event \"Split\"]\n[Result \"1-0\"]\n\n1. e4 {Quoting another game:\n\n[Event \"Inner\"]\n\n1. d4 d5}"
+                    " e5 2. Nf3 {\n\n[%clk 0:01:00]} Nc6 1-0\n\n";
+        }
+        for (unsigned parts = 2; parts <= 64; parts *= 2) {
+            PgnStats total;
+            for (std::string_view slice : PgnReader::splitAtGameBoundaries(text, parts)) total += PgnReader::replayAll(slice);
+            if (total.games != 200 || total.moves != 800 || total.errors != 0) {
+                std::cerr << "pgnbench: splitting into " << parts << " parts cut a game inside a comment" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MappedFile file;
+    std::string generated;
+    std::string_view text;
+
+    if (argc > 1) {
+        if (!file.open(argv[1])) {
+            std::cerr << "pgnbench: cannot map " << argv[1] << std::endl;
+            return 2;
+        }
+        file.adviseSequential();
+        text = file.view();
+    } else {
+        generated = buildSampleCorpus(5000);
+        text = generated;
+    }
+
+    unsigned threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    auto begin = std::chrono::steady_clock::now();
+    PgnStats sequential = PgnReader::replayAll(text);
+    report("sequential", sequential, std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count());
+
+    begin = std::chrono::steady_clock::now();
+    PgnStats parallel = PgnReader::replayParallel(text, threads);
+    std::string label = "parallel x" + std::to_string(threads);
+    report(label.c_str(), parallel, std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count());
+
+    bool consistent = sequential.games == parallel.games && sequential.moves == parallel.moves;
+    if (!consistent) std::cerr << "pgnbench: parallel replay disagrees with sequential replay" << std::endl;
+    bool splits = splitsAtRealBoundaries();
+    return (sequential.errors == 0 && consistent && splits) ? 0 : 1;
+}
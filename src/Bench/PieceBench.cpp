@@ -0,0 +1,163 @@
+// Piece move-rule probe benchmark.
+//
+// Usage: piecebench [passes]
+//
+// Probes every (piece, target square) pair of a fixed position set through four
+// paths and reports ns/probe for each:
+//   legacy    the original per-class rules (cloning getPiece, kept here as the baseline)
+//   virtual   Piece::isValidMove, now a thin adapter over MoveRules
+//   switch    MoveRules::isValidMove dispatching on PieceType at run time
+//   template  MoveRules::isValidMove<Type, Side>, dispatched once per piece
+// Exits non-zero if any path disagrees with the legacy rules.
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/MoveRules.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace HardChess;
+
+namespace {
+
+    const char* const positions[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "8/8/4k3/8/8/8/3QK3/8 w - - 0 60",
+    };
+    constexpr int positionCount = sizeof(positions) / sizeof(positions[0]);
+
+    // The rules as they were implemented in the Piece subclasses before MoveRules
+    bool legacyIsValidMove(const Piece& piece, Position start, Position end, const Board& board) {
+        if (!end.isValid() || start == end) return false;
+        std::unique_ptr<Piece> targetPiece = board.getPiece(end);
+        if (targetPiece && targetPiece->getColor() == piece.getColor()) return false;
+        int dr = std::abs(start.row - end.row);
+        int dc = std::abs(start.col - end.col);
+        switch (piece.getType()) {
+            case PieceType::PAWN: {
+                int forwardDirection = piece.getColor() == Color::WHITE ? -1 : 1;
+                if (end.col == start.col && end.row == start.row + forwardDirection && !targetPiece) return true;
+                if (!piece.getHasMoved() && end.col == start.col && end.row == start.row + 2 * forwardDirection && !targetPiece) {
+                    if (!board.getPiece(Position(start.row + forwardDirection, start.col))) return true;
+                }
+                return dc == 1 && end.row == start.row + forwardDirection && targetPiece;
+            }
+            case PieceType::KNIGHT: return (dr == 2 && dc == 1) || (dr == 1 && dc == 2);
+            case PieceType::KING: return dr <= 1 && dc <= 1;
+            case PieceType::ROOK: return (start.row == end.row || start.col == end.col) && board.isPathClear(start, end);
+            case PieceType::BISHOP: return dr == dc && board.isPathClear(start, end);
+            case PieceType::QUEEN:
+                return (start.row == end.row || start.col == end.col || dr == dc) && board.isPathClear(start, end);
+            default: return false;
+        }
+    }
+
+    template <PieceType Type, Color Side>
+    long probeTargets(const Piece& piece, Position start, const Board& board) {
+        long valid = 0;
+        bool hasMoved = piece.getHasMoved();
+        for (int e = 0; e < 64; ++e) valid += MoveRules::isValidMove<Type, Side>(start, Position(e / 8, e % 8), board, hasMoved);
+        return valid;
+    }
+
+    template <Color Side>
+    long probeTargets(const Piece& piece, Position start, const Board& board) {
+        switch (piece.getType()) {
+            case PieceType::PAWN: return probeTargets<PieceType::PAWN, Side>(piece, start, board);
+            case PieceType::KNIGHT: return probeTargets<PieceType::KNIGHT, Side>(piece, start, board);
+            case PieceType::BISHOP: return probeTargets<PieceType::BISHOP, Side>(piece, start, board);
+            case PieceType::ROOK: return probeTargets<PieceType::ROOK, Side>(piece, start, board);
+            case PieceType::QUEEN: return probeTargets<PieceType::QUEEN, Side>(piece, start, board);
+            case PieceType::KING: return probeTargets<PieceType::KING, Side>(piece, start, board);
+            default: return 0;
+        }
+    }
+
+    enum class Path { LEGACY, VIRTUAL, SWITCH, TEMPLATE };
+
+    long runPass(const Board* boards, Path path) {
+        long valid = 0;
+        for (int b = 0; b < positionCount; ++b) {
+            const Board& board = boards[b];
+            for (int r = 0; r < 8; ++r) {
+                for (int c = 0; c < 8; ++c) {
+                    const Piece* piece = board.getPiecePtr(Position(r, c));
+                    if (!piece) continue;
+                    Position start(r, c);
+                    if (path == Path::TEMPLATE) {
+                        valid += piece->getColor() == Color::WHITE ? probeTargets<Color::WHITE>(*piece, start, board)
+                                                                   : probeTargets<Color::BLACK>(*piece, start, board);
+                        continue;
+                    }
+                    for (int e = 0; e < 64; ++e) {
+                        Position end(e / 8, e % 8);
+                        if (path == Path::LEGACY) valid += legacyIsValidMove(*piece, start, end, board);
+                        else if (path == Path::VIRTUAL) valid += piece->isValidMove(start, end, board);
+                        else valid += MoveRules::isValidMove(*piece, start, end, board);
+                    }
+                }
+            }
+        }
+        return valid;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int passes = argc > 1 ? std::atoi(argv[1]) : 2000;
+    Board boards[positionCount];
+    long probesPerPass = 0;
+    for (int b = 0; b < positionCount; ++b) {
+        if (!boards[b].fromFEN(positions[b])) {
+            std::cerr << "piecebench: bad position " << positions[b] << std::endl;
+            return 2;
+        }
+        for (int r = 0; r < 8; ++r) {
+            for (int c = 0; c < 8; ++c) probesPerPass += boards[b].getPiecePtr(Position(r, c)) ? 64 : 0;
+        }
+    }
+
+    // Every path must agree with the legacy rules on every probe
+    int mismatches = 0;
+    for (int b = 0; b < positionCount; ++b) {
+        for (int s = 0; s < 64; ++s) {
+            const Piece* piece = boards[b].getPiecePtr(Position(s / 8, s % 8));
+            if (!piece) continue;
+            for (int e = 0; e < 64; ++e) {
+                Position start(s / 8, s % 8);
+                Position end(e / 8, e % 8);
+                bool expected = legacyIsValidMove(*piece, start, end, boards[b]);
+                if (piece->isValidMove(start, end, boards[b]) != expected ||
+                    MoveRules::isValidMove(*piece, start, end, boards[b]) != expected) {
+                    ++mismatches;
+                }
+            }
+        }
+    }
+    if (mismatches > 0) {
+        std::cerr << "piecebench: " << mismatches << " probes disagree with the legacy rules" << std::endl;
+        return 1;
+    }
+
+    const char* names[] = {"legacy", "virtual", "switch", "template"};
+    long reference = -1;
+    for (int p = 0; p < 4; ++p) {
+        Path path = static_cast<Path>(p);
+        long valid = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) valid += runPass(boards, path);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        if (reference < 0) reference = valid;
+        if (valid != reference) {
+            std::cerr << "piecebench: " << names[p] << " counted " << valid << " valid moves, expected " << reference << std::endl;
+            return 1;
+        }
+        std::cout << names[p] << ": " << seconds * 1e9 / (static_cast<double>(probesPerPass) * passes) << " ns/probe"
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,36 @@
+// Sample PGN shared by the benchmarks that need a corpus when no archive is given.
+#ifndef HARDCHESS_BENCH_SAMPLEGAMES_H
+#define HARDCHESS_BENCH_SAMPLEGAMES_H
+
+#include <string>
+
+namespace {
+
+    // A handful of real and constructed games exercising castling, en passant,
+    // promotion, comments, NAGs and variations
+    const char* const sampleGames =
+        "[Event \"Paris\"]\n[Site \"Paris FRA\"]\n[Date \"1858.??.??\"]\n[White \"Paul Morphy\"]\n"
+        "[Black \"Duke Karl / Count Isouard\"]\n[Result \"1-0\"]\n\n"
+        "1.e4 e5 2.Nf3 d6 3.d4 Bg4 {This is a weak move already.} 4.dxe5 Bxf3 5.Qxf3 dxe5 6.Bc4 Nf6\n"
+        "7.Qb3 Qe7 8.Nc3 c6 9.Bg5 b5 10.Nxb5 cxb5 11.Bxb5+ Nbd7 12.O-O-O Rd8 13.Rxd7 Rxd7\n"
+        "14.Rd1 Qe6 15.Bxd7+ Nxd7 16.Qb8+ Nxb8 17.Rd8# 1-0\n\n"
+        "[Event \"Legal trap\"]\n[Result \"1-0\"]\n\n"
+        "1. e4 e5 2. Nf3 d6 3. Bc4 Bg4 4. Nc3 g6? (4... Nf6 5. h3) 5. Nxe5! Bxd1 $4 6. Bxf7+ Ke7 7. Nd5# 1-0\n\n"
+        "[Event \"Castling and en passant\"]\n[Result \"*\"]\n\n"
+        "1. e4 Nf6 2. e5 d5 3. exd6 cxd6 4. Nf3 Nc6 5. Be2 e6 6. O-O Be7 7. d4 O-O 8. c4 b6\n"
+        "9. Nc3 Bb7 10. d5 exd5 11. cxd5 Nb8 12. Be3 Nbd7 13. Qd2 Rc8 14. Rac1 a6 15. a4 Nc5 *\n\n"
+        "[Event \"Promotion\"]\n[SetUp \"1\"]\n[FEN \"8/P7/8/8/8/8/8/k6K w - - 0 1\"]\n[Result \"1-0\"]\n\n"
+        "1. a8=Q+ Kb2 2. Qb7+ Kc3 3. Qb1 Kd4 4. Kg2 Ke5 5. Qe1+ Kd5 6. Kf3 Kd6 7. Kf4 Kd7 8. Ke5 Kc7\n"
+        "9. Qc3+ Kb7 10. Kd6 Kb6 11. Qb4+ Ka6 12. Kc6 Ka7 13. Qb7# 1-0\n\n"
+        "[Event \"Fool's mate\"]\n[Result \"0-1\"]\n\n1. f3 e5 2. g4 Qh4# 0-1\n\n"
+        "[Event \"Scholar's mate\"]\n[Result \"1-0\"]\n\n1. e4 e5 2. Qh5 Nc6 3. Bc4 Nf6?? 4. Qxf7# 1-0\n\n";
+
+    std::string buildSampleCorpus(int copies) {
+        std::string corpus;
+        for (int i = 0; i < copies; ++i) corpus += sampleGames;
+        return corpus;
+    }
+
+} // namespace
+
+#endif // HARDCHESS_BENCH_SAMPLEGAMES_H
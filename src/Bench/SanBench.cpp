@@ -0,0 +1,174 @@
+// SAN parse and print throughput, with a PGN export round trip.
+//
+// Usage: sanbench [-o export.pgn] [games.pgn]
+//
+// Replays the corpus (built-in sample corpus when no file is given) to time SAN
+// parsing, prints every move back with Notation::formatSAN and compares it with the
+// corpus text, then exports the games with PgnWriter and replays the export.
+// Reports SAN moves/sec for each phase; exits non-zero on any mismatch.
+
+#include "HardChess/Core/Notation.h"
+#include "HardChess/IO/MappedFile.h"
+#include "HardChess/IO/PgnReader.h"
+#include "HardChess/IO/PgnWriter.h"
+#include "SampleGames.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    struct Options {
+        std::string exportPath = "sanbench.pgn";
+        std::string input; // Empty for the built-in corpus
+    };
+
+    void usage() {
+        std::cerr << "usage: sanbench [-o export.pgn] [games.pgn]" << std::endl;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+                options.exportPath = argv[++i];
+            } else if (argv[i][0] == '-' || !options.input.empty()) {
+                return false;
+            } else {
+                options.input = argv[i];
+            }
+        }
+        return true;
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point begin) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return seconds > 0 ? seconds : 1e-9;
+    }
+
+    void report(const char* label, std::size_t moves, double seconds) {
+        std::cout << label << ": moves=" << moves << " seconds=" << seconds
+                  << " moves/sec=" << static_cast<long long>(moves / seconds) << std::endl;
+    }
+
+    // The corpus token as formatSAN would print it: no annotation glyphs, letter-O castling
+    std::string_view normalize(std::string_view san, std::string& buffer) {
+        while (!san.empty() && (san.back() == '!' || san.back() == '?')) san.remove_suffix(1);
+        if (san.size() >= 3 && san[0] == '0') {
+            buffer.assign(san.data(), san.size());
+            for (char& ch : buffer) {
+                if (ch == '0') ch = 'O';
+            }
+            return buffer;
+        }
+        return san;
+    }
+
+    // Keeps every replayed game and the corpus's own SAN for each of its moves
+    class CorpusCollector : public PgnVisitor {
+      public:
+        std::vector<GameRecord> games;
+        std::vector<std::string_view> tokens; // Point into the corpus text
+
+        void onGameStart(const PgnGame& game, const Board& /*board*/) override {
+            games.emplace_back();
+            std::string_view fen = game.tag("FEN");
+            if (!fen.empty()) games.back().setStartFEN(fen);
+        }
+        void onMove(const Board& /*board*/, const Move& move, std::string_view san) override {
+            games.back().append(move);
+            tokens.push_back(san);
+        }
+        void onGameEnd(const PgnGame& game, const Board& /*board*/, std::string_view result, bool /*ok*/) override {
+            GameResult parsed = parseGameResult(result);
+            if (parsed == GameResult::UNKNOWN) parsed = parseGameResult(game.tag("Result"));
+            games.back().setResult(parsed);
+        }
+    };
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+
+    MappedFile file;
+    std::string generated;
+    std::string_view pgn;
+    if (!options.input.empty()) {
+        if (!file.open(options.input)) {
+            std::cerr << "sanbench: cannot map " << options.input << std::endl;
+            return 2;
+        }
+        file.adviseSequential();
+        pgn = file.view();
+    } else {
+        generated = buildSampleCorpus(5000);
+        pgn = generated;
+    }
+
+    // Parse: every token resolved against its position
+    auto begin = std::chrono::steady_clock::now();
+    PgnStats parsed = PgnReader::replayAll(pgn);
+    report("parse", parsed.moves, secondsSince(begin));
+    if (parsed.errors) {
+        std::cerr << "sanbench: " << parsed.errors << " games failed to replay" << std::endl;
+        return 1;
+    }
+
+    CorpusCollector corpus;
+    PgnReader::replayAll(pgn, &corpus);
+
+    // Print: every move formatted again from its position
+    Board board;
+    std::vector<Move> scratch;
+    scratch.reserve(256);
+    char san[Notation::MAX_SAN_LENGTH];
+    std::string buffer;
+    std::size_t printed = 0, mismatches = 0;
+    begin = std::chrono::steady_clock::now();
+    for (const GameRecord& game : corpus.games) {
+        if (game.getStartFEN().empty()) board.initializeBoard();
+        else board.fromFEN(game.getStartFEN());
+        for (std::uint16_t code : game.getMoves()) {
+            Move move = board.decodeMove(code);
+            std::string_view text(san, Notation::formatSAN(board, move, san, scratch));
+            std::string_view expected = normalize(corpus.tokens[printed], buffer);
+            if (text != expected && ++mismatches <= 5) {
+                std::cerr << "sanbench: printed " << text << " for " << expected << " in " << board.toFEN() << std::endl;
+            }
+            board.applyMove(move);
+            ++printed;
+        }
+    }
+    report("print", printed, secondsSince(begin));
+
+    // Export the games as PGN, then read the export back
+    begin = std::chrono::steady_clock::now();
+    PgnWriter writer;
+    if (!writer.open(options.exportPath)) {
+        std::cerr << "sanbench: cannot create " << options.exportPath << std::endl;
+        return 2;
+    }
+    bool exported = true;
+    for (const GameRecord& game : corpus.games) exported = writer.add(game, {{"Event", "sanbench"}}) && exported;
+    exported = writer.close() && exported;
+    report("export", printed, secondsSince(begin));
+
+    MappedFile exportFile;
+    PgnStats reread;
+    if (exportFile.open(options.exportPath)) reread = PgnReader::replayAll(exportFile.view());
+    bool roundTrip = exported && reread.errors == 0 && reread.games == parsed.games && reread.moves == parsed.moves;
+    if (!roundTrip) {
+        std::cerr << "sanbench: export round trip lost games or moves (" << reread.games << " games, "
+                  << reread.moves << " moves read back)" << std::endl;
+    }
+    if (mismatches) std::cerr << "sanbench: " << mismatches << " moves printed differently from the corpus" << std::endl;
+    return (mismatches == 0 && roundTrip) ? 0 : 1;
+}
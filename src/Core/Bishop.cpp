@@ -1,6 +1,5 @@
 #include "HardChess/Core/Bishop.h"
-#include "HardChess/Core/Board.h"
-#include <cmath>
+#include "HardChess/Core/MoveRules.h"
 
 namespace HardChess {
 
@@ -18,23 +17,7 @@ std::unique_ptr<Piece> Bishop::clone() const {
 }
 
 bool Bishop::isValidMove(Position start, Position end, const Board& board) const {
-    if (!end.isValid()) return false;
-    if (start == end) return false;
-
-    int dr = std::abs(start.row - end.row);
-    int dc = std::abs(start.col - end.col);
-
-    if (dr != dc) return false; // Must move diagonally
-
-    // Check path clear
-    if (!board.isPathClear(start, end)) return false;
-
-    std::unique_ptr<Piece> targetPiece = board.getPiece(end);
-    if (targetPiece && targetPiece->getColor() == this->color) {
-        return false; // Can't capture own piece
-    }
-
-    return true;
+    return MoveRules::isValidMove<PieceType::BISHOP>(color, start, end, board, hasMoved);
 }
 
 } // namespace HardChess
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "HardChess/Core/Board.h"
+#include "HardChess/Core/AttackTables.h"
 #include "HardChess/UI/ConsoleUI.h"
 #include "HardChess/Core/Pawn.h"
 #include "HardChess/Core/Rook.h"
@@ -6,38 +7,30 @@
 #include "HardChess/Core/Bishop.h"
 #include "HardChess/Core/Queen.h"
 #include "HardChess/Core/King.h"
+#include "HardChess/Util/Stats.h"
 #include <iostream>
 #include <algorithm>
 
 namespace HardChess
 {
 
-    Board::Board() : grid(8)
+    Board::Board()
     {
-        for (int i = 0; i < 8; ++i)
-        {
-            grid.clear();
-            grid.resize(8);
-            for (auto &row : grid)
-                row.resize(8);
-        }
         initializeBoard();
     }
 
     // Deep copy constructor
-    Board::Board(const Board &other) : grid(8)
+    Board::Board(const Board &other)
     {
+        int clones = 0;
         for (int i = 0; i < 8; ++i)
         {
-            grid.clear();
-            grid.resize(8);
-            for (auto &row : grid)
-                row.resize(8);
             for (int j = 0; j < 8; ++j)
             {
                 if (other.grid[i][j])
                 {
                     grid[i][j] = other.grid[i][j]->clone();
+                    ++clones;
                 }
                 else
                 {
@@ -47,6 +40,17 @@ namespace HardChess
         }
         whiteKingPos = other.whiteKingPos;
         blackKingPos = other.blackKingPos;
+        std::copy(&other.pieceLists[0][0], &other.pieceLists[0][0] + 14, &pieceLists[0][0]);
+        std::copy(other.listSlot, other.listSlot + 64, listSlot);
+        occupied = other.occupied;
+        positionKey = other.positionKey;
+        Stats::count(Stats::Counter::BOARD_COPIES);
+        Stats::count(Stats::Counter::PIECE_CLONES, clones);
+        sideToMove = other.sideToMove;
+        castlingRights = other.castlingRights;
+        enPassantSquare = other.enPassantSquare;
+        halfmoveClock = other.halfmoveClock;
+        fullmoveNumber = other.fullmoveNumber;
     }
 
     // Deep copy assignment
@@ -56,21 +60,15 @@ namespace HardChess
         {
             return *this;
         }
-        grid.clear();
-        grid.resize(8);
-        for (auto &row : grid)
-            row.resize(8);
+        int clones = 0;
         for (int i = 0; i < 8; ++i)
         {
-            grid.clear();
-            grid.resize(8);
-            for (auto &row : grid)
-                row.resize(8);
             for (int j = 0; j < 8; ++j)
             {
                 if (other.grid[i][j])
                 {
                     grid[i][j] = other.grid[i][j]->clone();
+                    ++clones;
                 }
                 else
                 {
@@ -80,6 +78,17 @@ namespace HardChess
         }
         whiteKingPos = other.whiteKingPos;
         blackKingPos = other.blackKingPos;
+        std::copy(&other.pieceLists[0][0], &other.pieceLists[0][0] + 14, &pieceLists[0][0]);
+        std::copy(other.listSlot, other.listSlot + 64, listSlot);
+        occupied = other.occupied;
+        positionKey = other.positionKey;
+        Stats::count(Stats::Counter::BOARD_COPIES);
+        Stats::count(Stats::Counter::PIECE_CLONES, clones);
+        sideToMove = other.sideToMove;
+        castlingRights = other.castlingRights;
+        enPassantSquare = other.enPassantSquare;
+        halfmoveClock = other.halfmoveClock;
+        fullmoveNumber = other.fullmoveNumber;
         return *this;
     }
 
@@ -128,15 +137,395 @@ namespace HardChess
         blackKingPos = Position(0, 4);
         grid[7][4] = std::make_unique<King>(Color::WHITE, Position(7, 4));
         whiteKingPos = Position(7, 4);
+
+        sideToMove = Color::WHITE;
+        castlingRights = ALL_CASTLING;
+        enPassantSquare = Position(-1, -1);
+        halfmoveClock = 0;
+        fullmoveNumber = 1;
+        rebuildPieceLists();
     }
 
-    Piece *Board::getPiecePtr(Position pos) const
+    void Board::rebuildPieceLists()
     {
-        if (!pos.isValid() || !grid[pos.row][pos.col])
+        for (auto &lists : pieceLists)
+            for (PieceList &list : lists)
+                list.count = 0;
+        occupied = 0;
+        positionKey = Zobrist::castlingKey(castlingRights);
+        if (sideToMove == Color::WHITE)
+            positionKey ^= Zobrist::key(Zobrist::TURN_OFFSET);
+        for (int square = 0; square < 64; ++square)
+        {
+            listSlot[square] = 0;
+            if (const Piece *piece = grid[square >> 3][square & 7].get())
+                addToPieceList(*piece, square);
+        }
+    }
+
+    std::unique_ptr<Piece> Board::createPiece(PieceType type, Color color, Position pos)
+    {
+        switch (type)
         {
+        case PieceType::PAWN:
+            return std::make_unique<Pawn>(color, pos);
+        case PieceType::ROOK:
+            return std::make_unique<Rook>(color, pos);
+        case PieceType::KNIGHT:
+            return std::make_unique<Knight>(color, pos);
+        case PieceType::BISHOP:
+            return std::make_unique<Bishop>(color, pos);
+        case PieceType::QUEEN:
+            return std::make_unique<Queen>(color, pos);
+        case PieceType::KING:
+            return std::make_unique<King>(color, pos);
+        default:
             return nullptr;
         }
-        return grid[pos.row][pos.col].get();
+    }
+
+    namespace
+    {
+        // FEN letters index the placement scratch array used while parsing.
+        // Uppercase is White, lowercase is Black, 0 is an empty square.
+        PieceType pieceTypeFromFEN(char symbol)
+        {
+            switch (symbol)
+            {
+            case 'P': case 'p': return PieceType::PAWN;
+            case 'R': case 'r': return PieceType::ROOK;
+            case 'N': case 'n': return PieceType::KNIGHT;
+            case 'B': case 'b': return PieceType::BISHOP;
+            case 'Q': case 'q': return PieceType::QUEEN;
+            case 'K': case 'k': return PieceType::KING;
+            default: return PieceType::NONE;
+            }
+        }
+
+        bool isWhiteSymbol(char symbol) { return symbol >= 'A' && symbol <= 'Z'; }
+
+        // Attack test on the raw placement, so validation can run before the board is modified
+        bool isAttackedInPlacement(const char (&cells)[8][8], int row, int col, bool byWhite)
+        {
+            auto at = [&](int r, int c) -> char {
+                return (r >= 0 && r < 8 && c >= 0 && c < 8) ? cells[r][c] : 0;
+            };
+            auto isAttacker = [&](char symbol, char whiteSymbol) {
+                return symbol != 0 && symbol == (byWhite ? whiteSymbol : static_cast<char>(whiteSymbol - 'A' + 'a'));
+            };
+
+            int pawnRow = byWhite ? row + 1 : row - 1; // White pawns attack towards row 0
+            if (isAttacker(at(pawnRow, col - 1), 'P') || isAttacker(at(pawnRow, col + 1), 'P'))
+                return true;
+
+            const AttackTables::SquareList &knights = AttackTables::KNIGHT_TARGETS[row * 8 + col];
+            for (int i = 0; i < knights.count; ++i)
+                if (isAttacker(cells[knights.squares[i] >> 3][knights.squares[i] & 7], 'N'))
+                    return true;
+
+            const auto &directions = AttackTables::DIRECTIONS;
+            for (int d = 0; d < 8; ++d)
+            {
+                bool straight = d < 4;
+                int r = row + directions[d][0];
+                int c = col + directions[d][1];
+                if (isAttacker(at(r, c), 'K'))
+                    return true;
+                while (r >= 0 && r < 8 && c >= 0 && c < 8)
+                {
+                    char symbol = cells[r][c];
+                    if (symbol)
+                    {
+                        if (isAttacker(symbol, 'Q') || isAttacker(symbol, straight ? 'R' : 'B'))
+                            return true;
+                        break;
+                    }
+                    r += directions[d][0];
+                    c += directions[d][1];
+                }
+            }
+            return false;
+        }
+
+        // Parses a non-negative decimal counter; rejects empty fields and overflow
+        bool parseCounter(std::string_view field, int maxValue, int &value)
+        {
+            if (field.empty() || field.size() > 6)
+                return false;
+            int result = 0;
+            for (char ch : field)
+            {
+                if (ch < '0' || ch > '9')
+                    return false;
+                result = result * 10 + (ch - '0');
+            }
+            if (result > maxValue)
+                return false;
+            value = result;
+            return true;
+        }
+
+        char *writeCounter(char *out, int value)
+        {
+            char digits[12];
+            int count = 0;
+            do
+            {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value > 0);
+            while (count > 0)
+                *out++ = digits[--count];
+            return out;
+        }
+    } // namespace
+
+    bool Board::fromFEN(std::string_view fen)
+    {
+        // Split into whitespace separated fields without copying
+        std::string_view fields[6];
+        int fieldCount = 0;
+        std::size_t i = 0;
+        while (i < fen.size())
+        {
+            while (i < fen.size() && (fen[i] == ' ' || fen[i] == '\t' || fen[i] == '\r' || fen[i] == '\n'))
+                ++i;
+            if (i == fen.size())
+                break;
+            if (fieldCount == 6)
+                return false; // Trailing garbage
+            std::size_t begin = i;
+            while (i < fen.size() && fen[i] != ' ' && fen[i] != '\t' && fen[i] != '\r' && fen[i] != '\n')
+                ++i;
+            fields[fieldCount++] = fen.substr(begin, i - begin);
+        }
+        // Move counters are optional so that EPD-style records load as well
+        if (fieldCount != 4 && fieldCount != 6)
+            return false;
+
+        // 1. Piece placement, rank 8 first (row 0 of the grid)
+        char cells[8][8] = {};
+        int pieceCount[2] = {0, 0};
+        int pawnCount[2] = {0, 0};
+        int kingCount[2] = {0, 0};
+        Position kings[2];
+        int row = 0, col = 0;
+        for (char ch : fields[0])
+        {
+            if (ch == '/')
+            {
+                if (col != 8 || row == 7)
+                    return false;
+                ++row;
+                col = 0;
+            }
+            else if (ch >= '1' && ch <= '8')
+            {
+                col += ch - '0';
+                if (col > 8)
+                    return false;
+            }
+            else
+            {
+                PieceType type = pieceTypeFromFEN(ch);
+                if (type == PieceType::NONE || col >= 8)
+                    return false;
+                int side = isWhiteSymbol(ch) ? 0 : 1;
+                if (type == PieceType::PAWN)
+                {
+                    if (row == 0 || row == 7)
+                        return false; // Pawns never stand on the back ranks
+                    ++pawnCount[side];
+                }
+                if (type == PieceType::KING)
+                {
+                    ++kingCount[side];
+                    kings[side] = Position(row, col);
+                }
+                ++pieceCount[side];
+                cells[row][col++] = ch;
+            }
+        }
+        if (row != 7 || col != 8)
+            return false;
+        for (int side = 0; side < 2; ++side)
+        {
+            if (kingCount[side] != 1 || pieceCount[side] > 16 || pawnCount[side] > 8)
+                return false;
+        }
+
+        // 2. Side to move
+        if (fields[1].size() != 1 || (fields[1][0] != 'w' && fields[1][0] != 'b'))
+            return false;
+        Color side = fields[1][0] == 'w' ? Color::WHITE : Color::BLACK;
+
+        // The side that just moved cannot have left its king attacked
+        int idle = side == Color::WHITE ? 1 : 0;
+        if (isAttackedInPlacement(cells, kings[idle].row, kings[idle].col, idle == 1))
+            return false;
+
+        // 3. Castling rights; each right needs its king and rook on their home squares
+        unsigned char rights = NO_CASTLING;
+        if (fields[2] != "-")
+        {
+            for (char ch : fields[2])
+            {
+                unsigned char flag;
+                switch (ch)
+                {
+                case 'K': flag = WHITE_KINGSIDE; break;
+                case 'Q': flag = WHITE_QUEENSIDE; break;
+                case 'k': flag = BLACK_KINGSIDE; break;
+                case 'q': flag = BLACK_QUEENSIDE; break;
+                default: return false;
+                }
+                if (rights & flag)
+                    return false;
+                rights |= flag;
+            }
+        }
+        if ((rights & (WHITE_KINGSIDE | WHITE_QUEENSIDE)) && cells[7][4] != 'K')
+            return false;
+        if ((rights & (BLACK_KINGSIDE | BLACK_QUEENSIDE)) && cells[0][4] != 'k')
+            return false;
+        if (((rights & WHITE_KINGSIDE) && cells[7][7] != 'R') || ((rights & WHITE_QUEENSIDE) && cells[7][0] != 'R') ||
+            ((rights & BLACK_KINGSIDE) && cells[0][7] != 'r') || ((rights & BLACK_QUEENSIDE) && cells[0][0] != 'r'))
+            return false;
+
+        // 4. En passant target: the square a pawn just skipped over
+        Position epSquare(-1, -1);
+        if (fields[3] != "-")
+        {
+            if (fields[3].size() != 2 || fields[3][0] < 'a' || fields[3][0] > 'h')
+                return false;
+            char expectedRank = side == Color::WHITE ? '6' : '3';
+            if (fields[3][1] != expectedRank)
+                return false;
+            epSquare = Position(7 - (fields[3][1] - '1'), fields[3][0] - 'a');
+            int pawnRow = side == Color::WHITE ? epSquare.row + 1 : epSquare.row - 1;
+            int originRow = side == Color::WHITE ? epSquare.row - 1 : epSquare.row + 1;
+            char pushedPawn = side == Color::WHITE ? 'p' : 'P';
+            if (cells[epSquare.row][epSquare.col] || cells[originRow][epSquare.col] ||
+                cells[pawnRow][epSquare.col] != pushedPawn)
+                return false;
+        }
+
+        // 5./6. Halfmove clock and fullmove number
+        int halfmoves = 0, fullmoves = 1;
+        if (fieldCount == 6)
+        {
+            if (!parseCounter(fields[4], 9999, halfmoves) || !parseCounter(fields[5], 99999, fullmoves) || fullmoves < 1)
+                return false;
+        }
+
+        // Record is valid: rebuild the board
+        for (int r = 0; r < 8; ++r)
+        {
+            for (int c = 0; c < 8; ++c)
+            {
+                char symbol = cells[r][c];
+                if (!symbol)
+                {
+                    grid[r][c].reset();
+                    continue;
+                }
+                Color color = isWhiteSymbol(symbol) ? Color::WHITE : Color::BLACK;
+                PieceType type = pieceTypeFromFEN(symbol);
+                grid[r][c] = createPiece(type, color, Position(r, c));
+
+                // FEN has no move history; derive hasMoved from what the record does say
+                bool moved = false;
+                if (type == PieceType::PAWN)
+                    moved = r != (color == Color::WHITE ? 6 : 1);
+                else if (type == PieceType::KING)
+                    moved = !(rights & (color == Color::WHITE ? (WHITE_KINGSIDE | WHITE_QUEENSIDE) : (BLACK_KINGSIDE | BLACK_QUEENSIDE)));
+                else if (type == PieceType::ROOK)
+                {
+                    unsigned char homeRight = NO_CASTLING;
+                    if (color == Color::WHITE && r == 7)
+                        homeRight = c == 7 ? WHITE_KINGSIDE : (c == 0 ? WHITE_QUEENSIDE : NO_CASTLING);
+                    else if (color == Color::BLACK && r == 0)
+                        homeRight = c == 7 ? BLACK_KINGSIDE : (c == 0 ? BLACK_QUEENSIDE : NO_CASTLING);
+                    moved = !(rights & homeRight);
+                }
+                grid[r][c]->setHasMoved(moved);
+            }
+        }
+        whiteKingPos = kings[0];
+        blackKingPos = kings[1];
+        sideToMove = side;
+        castlingRights = rights;
+        enPassantSquare = epSquare;
+        halfmoveClock = halfmoves;
+        fullmoveNumber = fullmoves;
+        rebuildPieceLists();
+        return true;
+    }
+
+    std::size_t Board::writeFEN(char *out) const
+    {
+        char *p = out;
+        for (int r = 0; r < 8; ++r)
+        {
+            int empty = 0;
+            for (int c = 0; c < 8; ++c)
+            {
+                const Piece *piece = grid[r][c].get();
+                if (!piece)
+                {
+                    ++empty;
+                    continue;
+                }
+                if (empty)
+                {
+                    *p++ = static_cast<char>('0' + empty);
+                    empty = 0;
+                }
+                *p++ = piece->getSymbol();
+            }
+            if (empty)
+                *p++ = static_cast<char>('0' + empty);
+            if (r != 7)
+                *p++ = '/';
+        }
+
+        *p++ = ' ';
+        *p++ = sideToMove == Color::BLACK ? 'b' : 'w';
+
+        *p++ = ' ';
+        if (castlingRights == NO_CASTLING)
+            *p++ = '-';
+        if (castlingRights & WHITE_KINGSIDE)
+            *p++ = 'K';
+        if (castlingRights & WHITE_QUEENSIDE)
+            *p++ = 'Q';
+        if (castlingRights & BLACK_KINGSIDE)
+            *p++ = 'k';
+        if (castlingRights & BLACK_QUEENSIDE)
+            *p++ = 'q';
+
+        *p++ = ' ';
+        if (enPassantSquare.isValid())
+        {
+            *p++ = static_cast<char>('a' + enPassantSquare.col);
+            *p++ = static_cast<char>('1' + (7 - enPassantSquare.row));
+        }
+        else
+        {
+            *p++ = '-';
+        }
+
+        *p++ = ' ';
+        p = writeCounter(p, halfmoveClock);
+        *p++ = ' ';
+        p = writeCounter(p, fullmoveNumber);
+        return static_cast<std::size_t>(p - out);
+    }
+
+    std::string Board::toFEN() const
+    {
+        char buffer[MAX_FEN_LENGTH];
+        return std::string(buffer, writeFEN(buffer));
     }
 
     std::unique_ptr<Piece> Board::getPiece(Position pos) const
@@ -145,6 +534,7 @@ namespace HardChess
         {
             return nullptr;
         }
+        Stats::count(Stats::Counter::PIECE_CLONES);
         return grid[pos.row][pos.col]->clone();
     }
 
@@ -152,9 +542,13 @@ namespace HardChess
     {
         if (!pos.isValid())
             return;
+        int square = AttackTables::squareOf(pos);
+        if (grid[pos.row][pos.col])
+            removeFromPieceList(*grid[pos.row][pos.col], square);
         grid[pos.row][pos.col] = std::move(piece);
         if (grid[pos.row][pos.col])
         {
+            addToPieceList(*grid[pos.row][pos.col], square);
             grid[pos.row][pos.col]->setPosition(pos);
             if (grid[pos.row][pos.col]->getType() == PieceType::KING)
             {
@@ -172,6 +566,7 @@ namespace HardChess
         {
             return nullptr;
         }
+        removeFromPieceList(*grid[pos.row][pos.col], AttackTables::squareOf(pos));
         return std::move(grid[pos.row][pos.col]);
     }
 
@@ -182,6 +577,10 @@ namespace HardChess
             return nullptr;
         }
 
+        if (grid[end.row][end.col])
+            removeFromPieceList(*grid[end.row][end.col], AttackTables::squareOf(end));
+        if (start != end)
+            moveInPieceList(*grid[start.row][start.col], AttackTables::squareOf(start), AttackTables::squareOf(end));
         std::unique_ptr<Piece> capturedPiece = std::move(grid[end.row][end.col]);
         grid[end.row][end.col] = std::move(grid[start.row][start.col]);
         // grid[start.row][start.col] is now nullptr implicitly by move
@@ -208,24 +607,13 @@ namespace HardChess
 
     bool Board::isPathClear(Position start, Position end) const
     {
-        int dr = (end.row > start.row) ? 1 : ((end.row < start.row) ? -1 : 0);
-        int dc = (end.col > start.col) ? 1 : ((end.col < start.col) ? -1 : 0);
-
-        int currentRow = start.row + dr;
-        int currentCol = start.col + dc;
-
-        while (currentRow != end.row || currentCol != end.col)
-        {
-            if (!Position(currentRow, currentCol).isValid())
-                return false;
-            if (grid[currentRow][currentCol])
-            {
-                return false;
-            }
-            currentRow += dr;
-            currentCol += dc;
-        }
-        return true;
+        if (!start.isValid() || !end.isValid())
+            return false;
+        int from = AttackTables::squareOf(start);
+        int to = AttackTables::squareOf(end);
+        if (from == to)
+            return true;
+        return AttackTables::LINE[from][to] && !(AttackTables::BETWEEN[from][to] & occupied);
     }
 
     Position Board::findKing(Color kingColor) const
@@ -237,25 +625,42 @@ namespace HardChess
     {
         if (!square.isValid())
             return false;
-        for (int r = 0; r < 8; ++r)
+
+        int pawnRow = square.row + (attackerColor == Color::WHITE ? 1 : -1);
+        for (int dc = -1; dc <= 1; dc += 2)
         {
-            for (int c = 0; c < 8; ++c)
-            {
-                Piece *p = getPiecePtr(Position(r, c));
-                if (p && p->getColor() == attackerColor)
-                {
-                    if (p->isValidMove(Position(r, c), square, *this))
-                    {
-                        return true;
-                    }
-                }
-            }
+            const Piece *p = getPiecePtr(Position(pawnRow, square.col + dc));
+            if (p && p->getColor() == attackerColor && p->getType() == PieceType::PAWN)
+                return true;
         }
+
+        // Only the attacker's live pieces are visited: each one is tested against the
+        // target with the geometry tables instead of walking rays over empty squares
+        int target = AttackTables::squareOf(square);
+        const PieceList *lists = pieceLists[colorIndex(attackerColor)];
+        for (int from : lists[static_cast<int>(PieceType::KNIGHT)])
+            if (AttackTables::KNIGHT_ATTACKS[target] & AttackTables::squareMask(from))
+                return true;
+        for (int from : lists[static_cast<int>(PieceType::KING)])
+            if (AttackTables::KING_ATTACKS[target] & AttackTables::squareMask(from))
+                return true;
+
+        auto clear = [&](int from) { return !(AttackTables::BETWEEN[from][target] & occupied); };
+        for (int from : lists[static_cast<int>(PieceType::ROOK)])
+            if (AttackTables::isStraight(from, target) && clear(from))
+                return true;
+        for (int from : lists[static_cast<int>(PieceType::BISHOP)])
+            if (AttackTables::isDiagonal(from, target) && clear(from))
+                return true;
+        for (int from : lists[static_cast<int>(PieceType::QUEEN)])
+            if (AttackTables::LINE[from][target] && clear(from))
+                return true;
         return false;
     }
 
     bool Board::isKingInCheck(Color kingColor) const
     {
+        Stats::count(Stats::Counter::KING_IN_CHECK);
         Position kingPos = findKing(kingColor);
         if (!kingPos.isValid())
             return true;
@@ -278,7 +683,13 @@ namespace HardChess
         recordPieceStatesForValidation(start, end);
 
         currentValidationState.capturedPiece = grid[end.row][end.col] ? grid[end.row][end.col]->clone() : nullptr;
+        if (currentValidationState.capturedPiece)
+            Stats::count(Stats::Counter::PIECE_CLONES);
 
+        if (grid[end.row][end.col])
+            removeFromPieceList(*grid[end.row][end.col], AttackTables::squareOf(end));
+        if (grid[start.row][start.col] && start != end)
+            moveInPieceList(*grid[start.row][start.col], AttackTables::squareOf(start), AttackTables::squareOf(end));
         std::unique_ptr<Piece> pieceToMove = std::move(grid[start.row][start.col]);
         std::unique_ptr<Piece> overwrittenPieceAtEnd = std::move(grid[end.row][end.col]);
         grid[end.row][end.col] = std::move(pieceToMove);
@@ -301,6 +712,10 @@ namespace HardChess
     void Board::revertValidationMove(Position start, Position end, std::unique_ptr<Piece> originalPieceAtEndFromTryMove)
     {
         std::unique_ptr<Piece> movedPiece = std::move(grid[end.row][end.col]);
+        if (movedPiece)
+            moveInPieceList(*movedPiece, AttackTables::squareOf(end), AttackTables::squareOf(start));
+        if (originalPieceAtEndFromTryMove)
+            addToPieceList(*originalPieceAtEndFromTryMove, AttackTables::squareOf(end));
         grid[start.row][start.col] = std::move(movedPiece);
         grid[end.row][end.col] = std::move(originalPieceAtEndFromTryMove);
 
@@ -339,24 +754,12 @@ namespace HardChess
             return false;
         }
 
-        std::unique_ptr<Piece> newPiece;
-        switch (promotionType)
+        if (promotionType != PieceType::QUEEN && promotionType != PieceType::ROOK &&
+            promotionType != PieceType::BISHOP && promotionType != PieceType::KNIGHT)
         {
-        case PieceType::QUEEN:
-            newPiece = std::make_unique<Queen>(color, pawnPos);
-            break;
-        case PieceType::ROOK:
-            newPiece = std::make_unique<Rook>(color, pawnPos);
-            break;
-        case PieceType::BISHOP:
-            newPiece = std::make_unique<Bishop>(color, pawnPos);
-            break;
-        case PieceType::KNIGHT:
-            newPiece = std::make_unique<Knight>(color, pawnPos);
-            break;
-        default:
             return false;
         }
+        std::unique_ptr<Piece> newPiece = createPiece(promotionType, color, pawnPos);
         newPiece->setHasMoved(true);
         setPiece(pawnPos, std::move(newPiece));
         return true;
@@ -1,12 +1,35 @@
 #include "HardChess/Core/Game.h"
 #include "HardChess/Core/Knight.h"
+#include "HardChess/Core/MoveRules.h"
+#include "HardChess/Core/Notation.h"
+#include "HardChess/Util/Allocators.h"
+#include "HardChess/Util/EventLog.h"
+#include "HardChess/Util/Stats.h"
 #include <iostream>
 #include <algorithm>
 
 namespace HardChess {
 
+    namespace {
+
+        void logEvent(EventLog::EventType type, std::uint32_t game, std::size_t ply, Color color,
+                      PieceType piece = PieceType::NONE, const Move* move = nullptr) {
+            EventLog::Event event;
+            event.type = type;
+            event.game = game;
+            event.ply = static_cast<std::uint16_t>(ply);
+            event.color = static_cast<std::uint8_t>(color);
+            event.piece = static_cast<std::uint8_t>(piece);
+            if (move) event.move = move->encode();
+            EventLog::record(event);
+        }
+
+    } // namespace
+
     Game::Game(Player* p1, Player* p2, ConsoleUI& consoleUi)
-        : player1(p1), player2(p2), currentPlayer(nullptr), ui(consoleUi), roundState(RoundState::ONGOING) {
+        : player1(p1), player2(p2), currentPlayer(nullptr), ui(consoleUi), roundState(RoundState::ONGOING),
+          book(nullptr), tablebase(nullptr), tablebaseWinner(nullptr), computerMoveTimeMs(1000), hintTimeMs(200), hintLines(3),
+          bookRandom(std::random_device{}()), id(EventLog::newGameId()) {
         // Board is default constructed and initializes itself
     }
 
@@ -14,31 +37,43 @@ namespace HardChess {
         board.initializeBoard(); // Reset board to starting positions
         currentPlayer = player1; // White always starts
         roundState = RoundState::ONGOING;
+        tablebaseWinner = nullptr;
+        history.clear();
+        positions.reset(board.getKey());
+        Arena::local().reset(); // Nothing round-local survives into the next round
         ui.displayMessage("Round started. " + currentPlayer->getName() + " (" + currentPlayer->getColorString() + ") to move.");
         ui.displayBoard(board, false); // Always show White's perspective at start
     }
 
-    Position Game::parsePosition(const std::string& s) const {
-        if (s.length() < 2) return Position(-1, -1);
-        char file = s[0];
-        char rank = s[1];
-
-        if (file < 'a' || file > 'h' || rank < '1' || rank > '8') {
-            return Position(-1, -1);
-        }
-        // Board: (0,0) is a8, (7,7) is h1
-        // Input: a1 ... h8
-        // 'a' maps to col 0, 'h' to col 7
-        // '1' maps to row 7, '8' to row 0
-        return Position(7 - (rank - '1'), file - 'a');
+    bool Game::startRoundFromFEN(std::string_view fen) {
+        if (!board.fromFEN(fen)) return false;
+        currentPlayer = board.getSideToMove() == Color::WHITE ? player1 : player2;
+        roundState = RoundState::ONGOING;
+        tablebaseWinner = nullptr;
+        history.clear();
+        history.setStartFEN(fen);
+        positions.reset(board.getKey());
+        Arena::local().reset();
+        return true;
     }
-    
+
     bool Game::makeMove(Position start, Position end, PieceType promotionType) {
         if (!start.isValid() || !end.isValid()) {
             ui.displayMessage("Invalid position format or out of bounds.");
             return false;
         }
 
+        const LegalMoveSet& legal = currentMoves();
+        bool needsPromotion = legal.requiresPromotion(start, end);
+        if (!needsPromotion || promotionType != PieceType::NONE) {
+            // A promotion suffix is ignored unless the move reaches the last rank
+            if (const Move* move = legal.find(start, end, promotionType)) {
+                executeMove(*move);
+                return true;
+            }
+        }
+
+        // Not a legal move: work out why, for the message
         Piece* pieceToMove = board.getPiecePtr(start);
         if (!pieceToMove) {
             ui.displayMessage("No piece at starting position " + ui.formatPosition(start) + ".");
@@ -56,136 +91,202 @@ namespace HardChess {
             ui.displayMessage("You cannot capture the king! The game should end before this is possible.");
             return false;
         }
-        
-        // Check if the piece-specific move is valid (ignoring self-check for now)
-        if (!pieceToMove->isValidMove(start, end, board)) {
+
+        if (needsPromotion) {
+            ui.displayMessage("Error: Pawn reached promotion rank but no promotion type specified.");
+            return false;
+        }
+
+        if (!MoveRules::isValidMove(*pieceToMove, start, end, board)) {
             ui.displayMessage("Piece at " + ui.formatPosition(start) + " cannot move to " + ui.formatPosition(end) + " according to its rules.");
             return false;
         }
 
-        // Simulate move to check for self-check
-        Board tempBoard = board; // Use copy constructor
-        std::unique_ptr<Piece> tempCaptured = tempBoard.movePiece(start, end); // Simulate on temp board
-        
-        if (tempBoard.isKingInCheck(currentPlayer->getColor())) {
-            ui.displayMessage("Invalid move: Your King would be in check.");
-            return false; // Move is illegal as it leaves King in check
+        ui.displayMessage("Invalid move: Your King would be in check.");
+        return false;
+    }
+
+    void Game::executeMove(const Move& move) {
+        // makeMove keeps side to move, castling and en passant state current for the engine
+        MoveUndo undo;
+        if (EventLog::isOpen()) {
+            const Piece* mover = board.getPiecePtr(move.from);
+            logEvent(EventLog::EventType::MOVE, id, history.size(), mover->getColor(), mover->getType(), &move);
+        }
+        board.makeMove(move, undo);
+        if (EventLog::isOpen()) {
+            if (undo.captured) {
+                logEvent(EventLog::EventType::CAPTURE, id, history.size(), undo.captured->getColor(),
+                         undo.captured->getType(), &move);
+            }
+            if (move.promotion != PieceType::NONE) {
+                logEvent(EventLog::EventType::PROMOTION, id, history.size(), board.getPiecePtr(move.to)->getColor(),
+                         move.promotion, &move);
+            }
         }
+        if (undo.captured) {
+            ui.displayMessage(undo.captured->getColorString() + " " + undo.captured->getName() + " captured at " + ui.formatPosition(move.to));
+        }
+        if (move.promotion != PieceType::NONE) {
+            ui.displayMessage("Pawn promoted at " + ui.formatPosition(move.to) + "!");
+        }
+        history.append(move);
+        positions.push(board.getKey());
+    }
 
-        // If all checks pass, make the move on the actual board
-        std::unique_ptr<Piece> capturedPiece = board.movePiece(start, end);
-        if (capturedPiece) {
-            ui.displayMessage(capturedPiece->getColorString() + " " + capturedPiece->getName() + " captured at " + ui.formatPosition(end));
+    void Game::playComputerTurn() {
+        Move move;
+        TbResult endgame;
+        std::string source;
+        if (tablebase && tablebase->bestMove(board, move, endgame)) {
+            source = "tablebase";
+        } else if (book && book->probe(board, bookRandom, move)) {
+            source = "book";
+        } else {
+            if (!search) search.reset(new Search());
+            SearchLimits limits;
+            limits.timeMs = computerMoveTimeMs;
+            SearchResult result = search->run(board, limits, &positions);
+            if (!result.hasMove) return; // Round end is detected before this can happen
+            move = result.bestMove;
+            source = "depth " + std::to_string(result.depth);
         }
+        ui.displayMessage(currentPlayer->getName() + " plays " + Notation::toSAN(board, move, notationScratch) + " (" +
+                          source + ").");
+        executeMove(move);
+    }
 
-        // Handle Pawn Promotion
-        if (pieceToMove->getType() == PieceType::PAWN) {
-            Color color = pieceToMove->getColor();
-            if ((color == Color::WHITE && end.row == 0) || (color == Color::BLACK && end.row == 7)) {
-                if (promotionType != PieceType::NONE) {
-                    board.promotePawn(end, promotionType);
-                    ui.displayMessage("Pawn promoted at " + ui.formatPosition(end) + "!");
-                } else {
-                    ui.displayMessage("Error: Pawn reached promotion rank but no promotion type specified.");
-                }
-            }
+    void Game::startHint() {
+        const LegalMoveSet& moves = currentMoves();
+        if (moves.size() == 1) {
+            ui.displayHint(Notation::toSAN(board, moves[0], notationScratch) + " (the only legal move)");
+            return;
         }
-        return true;
+        if (!hints) hints.reset(new HintSearch());
+        ui.displayMessage("Thinking for up to " + std::to_string(hintTimeMs) + " ms; you can enter a move meanwhile.");
+        const ConsoleUI& display = ui;
+        hints->start(board, positions, hintTimeMs, hintLines, [&display](const Hint& hint) { display.displayHint(hint.describe()); });
+    }
+
+    void Game::solveMate() {
+        if (!mateSolver) mateSolver.reset(new MateSolver());
+        ui.displayMessage("Looking for a forced mate...");
+        MateResult result = mateSolver->solve(board, mateLimits, &positions);
+        long long perSecond = result.seconds > 0 ? static_cast<long long>(result.nodes / result.seconds) : 0;
+        ui.displayMessage(result.describe(board) + " (" + std::to_string(result.nodes) + " nodes, " +
+                          std::to_string(perSecond) + " nodes/sec)");
     }
 
     void Game::playTurn() {
         if (isRoundOver()) return;
+        Stats::ScopedTimer turnTimer(Stats::Timer::TURN);
 
         ui.displayPlayerTurn(currentPlayer);
         
         bool moveMade = false;
+        if (currentPlayer->isComputer()) {
+            Stats::ScopedTimer computerTimer(Stats::Timer::COMPUTER_MOVE);
+            playComputerTurn();
+            moveMade = true;
+        }
         while(!moveMade) {
-            std::string moveStr = ui.getPlayerMove(*currentPlayer);
+            std::string moveStr;
+            {
+                Stats::ScopedTimer inputTimer(Stats::Timer::PLAYER_INPUT);
+                moveStr = ui.getPlayerMove(*currentPlayer);
+            }
+            if (moveStr == "exit") {
+                if (hints) hints->cancel();
+                roundState = RoundState::ABANDONED;
+                return;
+            }
+            if (moveStr == "stats") {
+                ui.displayStats(Stats::snapshot());
+                continue;
+            }
+            if (moveStr == "hint") {
+                startHint();
+                continue;
+            }
+            if (moveStr == "mate") {
+                if (hints) hints->cancel();
+                solveMate();
+                continue;
+            }
+            if (hints) hints->cancel(); // Whatever comes next, a pending hint is no longer wanted
 
-            // Prevent out_of_range on short input
-            if (moveStr.length() < 4) {
-                ui.displayMessage("Invalid input format for move. Try again (e.g., e2e4 or a7a8q).");
+            // Standard Algebraic Notation ("Nf3", "exd5", "O-O") first; coordinates otherwise
+            Move sanMove;
+            if (Notation::parseSAN(board, moveStr, currentMoves(), sanMove)) {
+                Stats::ScopedTimer validationTimer(Stats::Timer::MOVE_VALIDATION);
+                moveMade = makeMove(sanMove.from, sanMove.to, sanMove.promotion);
+                continue;
+            }
+            if (!moveStr.empty() && std::string("NBRQKO").find(moveStr[0]) != std::string::npos) {
+                ui.displayMessage("No legal move matches " + moveStr + ", or more than one does. Try again.");
                 continue;
             }
 
-            Position startPos = parsePosition(moveStr.substr(0, 2));
-            Position endPos = parsePosition(moveStr.substr(2, 2));
-            PieceType promotionTarget = PieceType::NONE;
-
-            if (moveStr.length() == 5) { // Potential promotion: e.g., e7e8q
-                char promotionChar = moveStr[4];
-                switch (promotionChar) {
-                    case 'q': promotionTarget = PieceType::QUEEN; break;
-                    case 'r': promotionTarget = PieceType::ROOK; break;
-                    case 'b': promotionTarget = PieceType::BISHOP; break;
-                    case 'n': promotionTarget = PieceType::KNIGHT; break;
-                    default: 
-                        ui.displayMessage("Invalid promotion piece: " + std::string(1, promotionChar) + ". Use q, r, b, or n.");
-                        continue;
-                }
+            Position startPos, endPos;
+            PieceType promotionTarget;
+            if (!Notation::parseCoordinate(moveStr, startPos, endPos, promotionTarget)) {
+                ui.displayMessage("Invalid input format for move. Try again (e.g., e2e4, Nf3, or a7a8q with q, r, b or n).");
+                continue;
             }
-            
+
             // Validate pawn promotion input necessity
-            Piece* p = board.getPiecePtr(startPos);
-            if (p && p->getType() == PieceType::PAWN) {
-                Color pieceColor = p->getColor();
-                bool isPromotionSquare = (pieceColor == Color::WHITE && endPos.row == 0) || (pieceColor == Color::BLACK && endPos.row == 7);
-                if (p->isValidMove(startPos, endPos, board) && isPromotionSquare && promotionTarget == PieceType::NONE) {
-                     ui.displayMessage("Pawn promotion required. Append q, r, b, or n to your move (e.g. " + moveStr.substr(0,4) + "q).");
-                     continue;
-                }
+            if (promotionTarget == PieceType::NONE && currentMoves().requiresPromotion(startPos, endPos)) {
+                ui.displayMessage("Pawn promotion required. Append q, r, b, or n to your move (e.g. " + moveStr.substr(0,4) + "q).");
+                continue;
             }
 
-            moveMade = makeMove(startPos, endPos, promotionTarget);
+            {
+                Stats::ScopedTimer validationTimer(Stats::Timer::MOVE_VALIDATION);
+                moveMade = makeMove(startPos, endPos, promotionTarget);
+            }
             if (!moveMade) {
                 ui.displayMessage("Please try your move again.");
             }
         }
 
-        // Flip board for the NEXT player (the one about to move)
-        Color nextColor = (currentPlayer == player1) ? player2->getColor() : player1->getColor();
-        ui.displayBoard(board, nextColor == Color::BLACK);
+        // Flip board for the NEXT player (the one about to move); against the computer the
+        // human's side stays at the bottom
+        Player* nextPlayer = (currentPlayer == player1) ? player2 : player1;
+        Player* viewer = nextPlayer->isComputer() ? currentPlayer : nextPlayer;
+        {
+            Stats::ScopedTimer displayTimer(Stats::Timer::BOARD_DISPLAY);
+            ui.displayBoard(board, viewer->getColor() == Color::BLACK);
+        }
 
-        checkForEndOfRound();
+        {
+            Stats::ScopedTimer endCheckTimer(Stats::Timer::END_OF_ROUND_CHECK);
+            checkForEndOfRound();
+        }
 
         if (!isRoundOver()) {
             switchPlayer();
-            if (board.isKingInCheck(currentPlayer->getColor())) {
+            if (currentMoves().inCheck()) {
+                logEvent(EventLog::EventType::CHECK, id, history.size(), currentPlayer->getColor());
                 ui.displayMessage(currentPlayer->getName() + "'s King is in check!");
             }
         }
     }
 
     bool Game::canPlayerMakeAnyLegalMove(Player* player) {
-        Color playerColor = player->getColor();
-        for (int r = 0; r < 8; ++r) {
-            for (int c = 0; c < 8; ++c) {
-                Position start(r, c);
-                Piece* piece = board.getPiecePtr(start);
-                if (piece && piece->getColor() == playerColor) {
-                    std::vector<Position> possibleMoves = piece->getPossibleMoves(start, board);
-                    for (const auto& end : possibleMoves) {
-                        // Prevent moves that would capture the king
-                        Piece* target = board.getPiecePtr(end);
-                        if (target && target->getType() == PieceType::KING) continue;
-
-                        // Simulate move to check if it resolves check or is legal
-                        Board tempBoard = board;
-                        tempBoard.movePiece(start, end); // Simulate on temp board
-                        if (!tempBoard.isKingInCheck(playerColor)) {
-                            return true; // Found a legal move
-                        }
-                    }
-                }
-            }
-        }
-        return false;
+        if (player->getColor() == board.getSideToMove()) return !currentMoves().empty();
+        // Asked about the side not to move: one generation on a copy with the turn passed
+        Board turnPassed(board);
+        turnPassed.setSideToMove(player->getColor());
+        LegalMoveSet moves;
+        moves.update(turnPassed);
+        return !moves.empty();
     }
 
     void Game::checkForEndOfRound() {
         Player* opponent = (currentPlayer == player1) ? player2 : player1;
-        bool opponentInCheck = board.isKingInCheck(opponent->getColor());
-        bool opponentHasLegalMoves = canPlayerMakeAnyLegalMove(opponent);
+        const LegalMoveSet& replies = currentMoves(); // The opponent is to move now
+        bool opponentInCheck = replies.inCheck();
+        bool opponentHasLegalMoves = !replies.empty();
 
         if (opponentInCheck && !opponentHasLegalMoves) {
             roundState = (currentPlayer->getColor() == Color::WHITE) ? RoundState::CHECKMATE_WHITE_WINS : RoundState::CHECKMATE_BLACK_WINS;
@@ -193,8 +294,36 @@ namespace HardChess {
         } else if (!opponentInCheck && !opponentHasLegalMoves) {
             roundState = RoundState::STALEMATE;
             ui.displayMessage("Stalemate! The round is a draw.");
+        } else if (board.isFiftyMoveDraw()) {
+            roundState = RoundState::DRAW;
+            ui.displayMessage("Fifty moves without a capture or pawn move. The round is drawn.");
+        } else if (positions.isThreefold(board.getHalfmoveClock())) {
+            roundState = RoundState::DRAW;
+            ui.displayMessage("The same position has occurred three times. The round is drawn.");
+        } else if (tablebase) {
+            TbResult result; // For the opponent, who is to move
+            if (tablebase->probe(board, result)) {
+                if (result.outcome == TbOutcome::DRAW) {
+                    roundState = RoundState::DRAW;
+                    ui.displayMessage("Tablebase: the position is a theoretical draw. The round is drawn.");
+                } else {
+                    Player* winner = result.outcome == TbOutcome::WIN ? opponent : currentPlayer;
+                    if (winner != tablebaseWinner) { // Once per verdict, not again as the count runs down
+                        tablebaseWinner = winner;
+                        ui.displayMessage("Tablebase: " + winner->getName() + " mates in " +
+                                          std::to_string((result.plies + 1) / 2) + ".");
+                    }
+                }
+            }
+        }
+
+        switch (roundState) {
+            case RoundState::CHECKMATE_WHITE_WINS: history.setResult(GameResult::WHITE_WINS); break;
+            case RoundState::CHECKMATE_BLACK_WINS: history.setResult(GameResult::BLACK_WINS); break;
+            case RoundState::STALEMATE:
+            case RoundState::DRAW: history.setResult(GameResult::DRAW); break;
+            default: break;
         }
-        // Other draw conditions (50-move, threefold repetition) not implemented
     }
 
     void Game::switchPlayer() {
@@ -0,0 +1,29 @@
+#include "HardChess/Core/GameRecord.h"
+
+namespace HardChess {
+
+    GameRecord::GameRecord() : result(GameResult::UNKNOWN) {}
+
+    void GameRecord::clear() {
+        moves.clear();
+        startFEN.clear();
+        result = GameResult::UNKNOWN;
+    }
+
+    GameResult parseGameResult(std::string_view token) {
+        if (token == "1-0") return GameResult::WHITE_WINS;
+        if (token == "0-1") return GameResult::BLACK_WINS;
+        if (token == "1/2-1/2") return GameResult::DRAW;
+        return GameResult::UNKNOWN;
+    }
+
+    const char* gameResultString(GameResult result) {
+        switch (result) {
+            case GameResult::WHITE_WINS: return "1-0";
+            case GameResult::BLACK_WINS: return "0-1";
+            case GameResult::DRAW: return "1/2-1/2";
+            default: return "*";
+        }
+    }
+
+} // namespace HardChess
@@ -0,0 +1,21 @@
+#include "HardChess/Core/GameState.h"
+
+GameState::GameState()
+    : currentPhase(GamePhase::MENU), roundNumber(1), isCheck(false), isCheckmate(false) {
+    gameHistory.reserve(256);
+}
+
+void GameState::addMove(const HardChess::Move& move, const std::string& description) {
+    gameHistory.append(move);
+    lastMoveDescription = description;
+}
+
+std::string GameState::getPhaseString() const {
+    switch (currentPhase) {
+        case GamePhase::MENU: return "Menu";
+        case GamePhase::PLAYING: return "Playing";
+        case GamePhase::GAME_OVER: return "Game Over";
+        case GamePhase::PAUSED: return "Paused";
+    }
+    return "Unknown";
+}
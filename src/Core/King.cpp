@@ -1,6 +1,5 @@
 #include "HardChess/Core/King.h"
-#include "HardChess/Core/Board.h"
-#include <cmath> // For abs
+#include "HardChess/Core/MoveRules.h"
 
 namespace HardChess {
 
@@ -17,31 +16,7 @@ namespace HardChess {
     }
 
     bool King::isValidMove(Position start, Position end, const Board& board) const {
-        if (!end.isValid()) return false;
-        if (start == end) return false;
-
-        std::unique_ptr<Piece> targetPiece = board.getPiece(end);
-        if (targetPiece && targetPiece->getColor() == this->color) {
-            return false;
-        }
-
-        int dr = std::abs(start.row - end.row);
-        int dc = std::abs(start.col - end.col);
-
-        if (dr <= 1 && dc <= 1) { // Moves one square in any direction
-            // The check for whether the king moves into check is typically handled
-            // by the Game logic calling Board::isSquareAttacked or similar.
-            // For this piece-specific isValidMove, we assume the square isn't attacked by self-check rule.
-            return true;
-        }
-        
-        // Castling logic would be here if implemented
-        // Example basic castling (needs Board methods like isSquareAttacked, hasRookMoved etc.):
-        // if (!this->hasMoved && dr == 0 && std::abs(dc) == 2) {
-        //     // Check path clear, not in/through/into check, rook hasn't moved
-        // }
-
-        return false;
+        return MoveRules::isValidMove<PieceType::KING>(color, start, end, board, hasMoved);
     }
 
 } // namespace HardChess
\ No newline at end of file
@@ -1,6 +1,5 @@
 #include "HardChess/Core/Knight.h"
-#include "HardChess/Core/Board.h"
-#include <cmath> // For abs
+#include "HardChess/Core/MoveRules.h"
 
 namespace HardChess {
 
@@ -17,19 +16,7 @@ namespace HardChess {
     }
 
     bool Knight::isValidMove(Position start, Position end, const Board& board) const {
-        if (!end.isValid()) return false;
-        if (start == end) return false;
-
-        std::unique_ptr<Piece> targetPiece = board.getPiece(end);
-        if (targetPiece && targetPiece->getColor() == this->color) {
-            return false;
-        }
-
-        int dr = std::abs(start.row - end.row);
-        int dc = std::abs(start.col - end.col);
-
-        // Standard knight move: 2 by 1 or 1 by 2
-        return (dr == 2 && dc == 1) || (dr == 1 && dc == 2);
+        return MoveRules::isValidMove<PieceType::KNIGHT>(color, start, end, board, hasMoved);
     }
 
 } // namespace HardChess
\ No newline at end of file
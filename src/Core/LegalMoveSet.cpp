@@ -0,0 +1,56 @@
+#include "HardChess/Core/LegalMoveSet.h"
+#include "HardChess/Util/Stats.h"
+#include <algorithm>
+
+namespace HardChess {
+
+    bool LegalMoveSet::update(Board& board) {
+        if (isFor(board)) {
+            Stats::count(Stats::Counter::MOVE_CACHE_HITS);
+            return false;
+        }
+        Stats::count(Stats::Counter::MOVE_CACHE_MISSES);
+
+        board.generateLegalMoves(generated);
+        count = 0;
+        origins = 0;
+        for (const Move& move : generated) {
+            if (count == MAX_MOVES) break;
+            entries[count++] = Entry{orderOf(move.from, move.to, (move.encode() >> 12) & 7u), move};
+            origins |= AttackTables::squareMask(squareIndex(move.from));
+        }
+        std::sort(entries, entries + count, [](const Entry& a, const Entry& b) { return a.order < b.order; });
+
+        key = board.getKey();
+        check = board.isKingInCheck(board.getSideToMove());
+        valid = true;
+        return true;
+    }
+
+    const LegalMoveSet::Entry* LegalMoveSet::firstBetween(Position from, Position to) const {
+        const Entry* end = entries + count;
+        if (!from.isValid() || !to.isValid() || !hasMovesFrom(from)) return end;
+        std::uint16_t order = orderOf(from, to, 0);
+        const Entry* first = std::lower_bound(entries, end, order, [](const Entry& entry, std::uint16_t value) {
+            return entry.order < value;
+        });
+        return first != end && (first->order >> 3) == (order >> 3) ? first : end;
+    }
+
+    const Move* LegalMoveSet::find(Position from, Position to, PieceType promotion) const {
+        const Entry* end = entries + count;
+        const Entry* entry = firstBetween(from, to);
+        if (entry == end) return nullptr;
+        if (entry->move.promotion == PieceType::NONE) return &entry->move; // The only move between the squares
+        for (; entry != end && (entry->order >> 3) == (orderOf(from, to, 0) >> 3); ++entry) {
+            if (entry->move.promotion == promotion) return &entry->move;
+        }
+        return nullptr;
+    }
+
+    bool LegalMoveSet::requiresPromotion(Position from, Position to) const {
+        const Entry* entry = firstBetween(from, to);
+        return entry != entries + count && entry->move.promotion != PieceType::NONE;
+    }
+
+} // namespace HardChess
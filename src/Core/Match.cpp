@@ -0,0 +1,171 @@
+#include "HardChess/Core/Match.h"
+#include "HardChess/Core/Notation.h"
+#include "HardChess/Engine/Tablebase.h"
+
+namespace HardChess {
+
+    namespace {
+
+        void logEvent(EventLog::EventType type, std::uint32_t game, int ply, Color color,
+                      PieceType piece = PieceType::NONE, const Move* move = nullptr) {
+            EventLog::Event event;
+            event.type = type;
+            event.game = game;
+            event.ply = static_cast<std::uint16_t>(ply);
+            event.color = static_cast<std::uint8_t>(color);
+            event.piece = static_cast<std::uint8_t>(piece);
+            if (move) event.move = move->encode();
+            EventLog::record(event);
+        }
+
+    } // namespace
+
+    Match::Match(const std::string& whiteName, const std::string& blackName, bool computerBlack)
+        : player1(whiteName, Color::WHITE), player2(blackName, Color::BLACK, computerBlack), tablebase(nullptr),
+          roundNumber(1), roundId(EventLog::newGameId()), ended(RoundEnd::NONE), over(false), winnerOfRound(nullptr) {
+        history.reset(position.getKey());
+        logRoundStart();
+    }
+
+    void Match::nextRound() {
+        if (over || ended == RoundEnd::NONE) return;
+        ++roundNumber;
+        roundId = EventLog::newGameId();
+        ended = RoundEnd::NONE;
+        winnerOfRound = nullptr;
+        position.initializeBoard();
+        history.reset(position.getKey());
+        legal.clear();
+        logRoundStart();
+    }
+
+    bool Match::parseMove(std::string_view text, Move& move) {
+        if (ended != RoundEnd::NONE) return false;
+        const LegalMoveSet& moves = legalMoves();
+        if (Notation::parseSAN(position, text, moves, move)) return true;
+        Position from, to;
+        PieceType promotion;
+        if (!Notation::parseCoordinate(text, from, to, promotion)) return false;
+        if (promotion == PieceType::NONE && moves.requiresPromotion(from, to)) return false;
+        const Move* found = moves.find(from, to, promotion);
+        if (!found) return false;
+        move = *found;
+        return true;
+    }
+
+    RoundEnd Match::play(const Move& move) {
+        Player* mover = position.getSideToMove() == Color::WHITE ? &player1 : &player2;
+        int ply = history.size() - 1;
+        if (EventLog::isOpen()) {
+            logEvent(EventLog::EventType::MOVE, roundId, ply, mover->getColor(), position.getPiecePtr(move.from)->getType(),
+                     &move);
+        }
+        MoveUndo undo;
+        position.makeMove(move, undo);
+        history.push(position.getKey());
+        if (EventLog::isOpen()) {
+            if (undo.captured) {
+                logEvent(EventLog::EventType::CAPTURE, roundId, ply, undo.captured->getColor(), undo.captured->getType(),
+                         &move);
+            }
+            if (move.promotion != PieceType::NONE) {
+                logEvent(EventLog::EventType::PROMOTION, roundId, ply, mover->getColor(), move.promotion, &move);
+            }
+        }
+
+        // The same order of checks as Game::checkForEndOfRound
+        const LegalMoveSet& replies = legalMoves();
+        if (replies.empty()) return finishRound(replies.inCheck() ? RoundEnd::CHECKMATE : RoundEnd::STALEMATE,
+                                                replies.inCheck() ? mover : nullptr);
+        if (position.isFiftyMoveDraw()) return finishRound(RoundEnd::FIFTY_MOVES, nullptr);
+        if (history.isThreefold(position.getHalfmoveClock())) return finishRound(RoundEnd::REPETITION, nullptr);
+        TbResult verdict;
+        if (tablebase && tablebase->probe(position, verdict) && verdict.outcome == TbOutcome::DRAW) {
+            return finishRound(RoundEnd::TABLEBASE_DRAW, nullptr);
+        }
+        if (replies.inCheck()) logEvent(EventLog::EventType::CHECK, roundId, ply + 1, position.getSideToMove());
+        return RoundEnd::NONE;
+    }
+
+    RoundEnd Match::resign() {
+        if (ended != RoundEnd::NONE) return ended;
+        return finishRound(RoundEnd::RESIGNATION, position.getSideToMove() == Color::WHITE ? &player2 : &player1);
+    }
+
+    RoundEnd Match::finishRound(RoundEnd end, Player* winner) {
+        ended = end;
+        winnerOfRound = winner;
+        if (winner) scoreRound(*winner, winner == &player1 ? player2 : player1);
+        over = isMatchOver(player1, player2);
+        if (EventLog::isOpen()) {
+            GameResult result = !winner ? GameResult::DRAW
+                                : winner == &player1 ? GameResult::WHITE_WINS : GameResult::BLACK_WINS;
+            logResult(EventLog::EventType::ROUND_RESULT, roundId, result, winner);
+            if (over) logResult(EventLog::EventType::MATCH_RESULT, 0, GameResult::UNKNOWN, matchWinner(player1, player2));
+        }
+        return end;
+    }
+
+    void Match::logRoundStart() {
+        EventLog::Event event;
+        event.type = EventLog::EventType::ROUND_START;
+        event.game = roundId;
+        event.values[0] = roundNumber;
+        EventLog::record(event);
+    }
+
+    // As main.cpp logs them: match-level events carry the round's id, or 0 for the match result
+    void Match::logResult(EventLog::EventType type, std::uint32_t game, GameResult result, const Player* winner) {
+        EventLog::Event event;
+        event.type = type;
+        event.game = game;
+        event.result = static_cast<std::uint8_t>(result);
+        event.color = static_cast<std::uint8_t>(winner ? winner->getColor() : Color::NONE);
+        event.values[0] = player1.getScore();
+        event.values[1] = player2.getScore();
+        EventLog::record(event);
+    }
+
+    void Match::scoreRound(Player& winner, Player& loser) {
+        winner.incrementScore();
+        loser.loseHeart();
+        if (loser.getHearts() == 0) {
+            while (winner.getScore() < ROUNDS_TO_WIN) winner.incrementScore();
+        }
+    }
+
+    bool Match::isMatchOver(const Player& white, const Player& black) {
+        return white.getScore() >= ROUNDS_TO_WIN || black.getScore() >= ROUNDS_TO_WIN || white.getHearts() == 0 ||
+               black.getHearts() == 0;
+    }
+
+    const Player* Match::matchWinner(const Player& white, const Player& black) {
+        if (white.getScore() >= ROUNDS_TO_WIN) return &white;
+        if (black.getScore() >= ROUNDS_TO_WIN) return &black;
+        if (white.getHearts() == 0 && black.getHearts() > 0) return &black;
+        if (black.getHearts() == 0 && white.getHearts() > 0) return &white;
+        return nullptr;
+    }
+
+    bool Match::computerToMove() const {
+        return ended == RoundEnd::NONE && player2.isComputer() && position.getSideToMove() == Color::BLACK;
+    }
+
+    const Player* Match::winner() const {
+        return matchWinner(player1, player2);
+    }
+
+    const char* Match::describe(RoundEnd end) {
+        switch (end) {
+            case RoundEnd::NONE: return "none";
+            case RoundEnd::CHECKMATE: return "checkmate";
+            case RoundEnd::STALEMATE: return "stalemate";
+            case RoundEnd::FIFTY_MOVES: return "fifty-moves";
+            case RoundEnd::REPETITION: return "repetition";
+            case RoundEnd::TABLEBASE_DRAW: return "tablebase-draw";
+            case RoundEnd::RESIGNATION: return "resignation";
+        }
+        return "none";
+    }
+
+} // namespace HardChess
@@ -0,0 +1,325 @@
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/AttackTables.h"
+#include "HardChess/Util/Stats.h"
+
+namespace HardChess
+{
+
+    namespace
+    {
+        Color opposite(Color color)
+        {
+            return color == Color::WHITE ? Color::BLACK : Color::WHITE;
+        }
+
+        bool isPiece(const Piece *piece, Color color, PieceType type)
+        {
+            return piece && piece->getColor() == color && piece->getType() == type;
+        }
+
+        void addPawnMoves(std::vector<Move> &moves, Position from, Position to, unsigned char flags, bool promotes)
+        {
+            if (promotes)
+            {
+                moves.emplace_back(from, to, PieceType::QUEEN, flags);
+                moves.emplace_back(from, to, PieceType::ROOK, flags);
+                moves.emplace_back(from, to, PieceType::BISHOP, flags);
+                moves.emplace_back(from, to, PieceType::KNIGHT, flags);
+            }
+            else
+            {
+                moves.emplace_back(from, to, PieceType::NONE, flags);
+            }
+        }
+
+        unsigned char rightsLostAt(Position square)
+        {
+            if (square == Position(7, 4))
+                return WHITE_KINGSIDE | WHITE_QUEENSIDE;
+            if (square == Position(0, 4))
+                return BLACK_KINGSIDE | BLACK_QUEENSIDE;
+            if (square == Position(7, 7))
+                return WHITE_KINGSIDE;
+            if (square == Position(7, 0))
+                return WHITE_QUEENSIDE;
+            if (square == Position(0, 7))
+                return BLACK_KINGSIDE;
+            if (square == Position(0, 0))
+                return BLACK_QUEENSIDE;
+            return NO_CASTLING;
+        }
+    } // namespace
+
+    void Board::generatePseudoLegalMoves(std::vector<Move> &moves) const
+    {
+        Color us = sideToMove;
+        Color them = opposite(us);
+
+        for (int type = static_cast<int>(PieceType::PAWN); type <= static_cast<int>(PieceType::KING); ++type)
+        {
+            for (int square : pieceLists[colorIndex(us)][type])
+            {
+                const Piece *piece = grid[square >> 3][square & 7].get();
+                Position from = squareAt(square);
+                int r = from.row;
+                int c = from.col;
+
+                switch (piece->getType())
+                {
+                case PieceType::PAWN:
+                {
+                    int forward = us == Color::WHITE ? -1 : 1;
+                    int startRow = us == Color::WHITE ? 6 : 1;
+                    int lastRow = us == Color::WHITE ? 0 : 7;
+                    Position one(r + forward, c);
+                    if (one.isValid() && !grid[one.row][one.col])
+                    {
+                        addPawnMoves(moves, from, one, MOVE_QUIET, one.row == lastRow);
+                        Position two(r + 2 * forward, c);
+                        if (r == startRow && !grid[two.row][two.col])
+                            moves.emplace_back(from, two, PieceType::NONE, MOVE_DOUBLE_PUSH);
+                    }
+                    for (int dc = -1; dc <= 1; dc += 2)
+                    {
+                        Position target(r + forward, c + dc);
+                        if (!target.isValid())
+                            continue;
+                        const Piece *victim = grid[target.row][target.col].get();
+                        if (victim && victim->getColor() == them)
+                            addPawnMoves(moves, from, target, MOVE_CAPTURE, target.row == lastRow);
+                        else if (!victim && target == enPassantSquare)
+                            moves.emplace_back(from, target, PieceType::NONE, MOVE_CAPTURE | MOVE_EN_PASSANT);
+                    }
+                    break;
+                }
+                case PieceType::KNIGHT:
+                case PieceType::KING:
+                {
+                    const AttackTables::SquareList &targets = piece->getType() == PieceType::KNIGHT
+                                                                  ? AttackTables::KNIGHT_TARGETS[squareIndex(from)]
+                                                                  : AttackTables::KING_TARGETS[squareIndex(from)];
+                    for (int i = 0; i < targets.count; ++i)
+                    {
+                        Position target = squareAt(targets.squares[i]);
+                        const Piece *victim = grid[target.row][target.col].get();
+                        if (!victim)
+                            moves.emplace_back(from, target);
+                        else if (victim->getColor() == them)
+                            moves.emplace_back(from, target, PieceType::NONE, MOVE_CAPTURE);
+                    }
+                    break;
+                }
+                case PieceType::ROOK:
+                case PieceType::BISHOP:
+                case PieceType::QUEEN:
+                {
+                    PieceType type = piece->getType();
+                    int first = type == PieceType::BISHOP ? AttackTables::STRAIGHT_DIRECTIONS : 0;
+                    int last = type == PieceType::ROOK ? AttackTables::STRAIGHT_DIRECTIONS : 8;
+                    for (int d = first; d < last; ++d)
+                    {
+                        const AttackTables::SquareList &ray = AttackTables::RAYS[squareIndex(from)][d];
+                        for (int i = 0; i < ray.count; ++i)
+                        {
+                            Position target = squareAt(ray.squares[i]);
+                            const Piece *victim = grid[target.row][target.col].get();
+                            if (victim)
+                            {
+                                if (victim->getColor() == them)
+                                    moves.emplace_back(from, target, PieceType::NONE, MOVE_CAPTURE);
+                                break;
+                            }
+                            moves.emplace_back(from, target);
+                        }
+                    }
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+        }
+
+        // Castling: rights imply king and rook are on their home squares
+        int homeRow = us == Color::WHITE ? 7 : 0;
+        unsigned char kingside = us == Color::WHITE ? WHITE_KINGSIDE : BLACK_KINGSIDE;
+        unsigned char queenside = us == Color::WHITE ? WHITE_QUEENSIDE : BLACK_QUEENSIDE;
+        Position kingHome(homeRow, 4);
+        if ((castlingRights & (kingside | queenside)) && isPiece(getPiecePtr(kingHome), us, PieceType::KING) &&
+            !isSquareAttacked(kingHome, them))
+        {
+            if ((castlingRights & kingside) && !grid[homeRow][5] && !grid[homeRow][6] &&
+                isPiece(getPiecePtr(Position(homeRow, 7)), us, PieceType::ROOK) &&
+                !isSquareAttacked(Position(homeRow, 5), them))
+            {
+                moves.emplace_back(kingHome, Position(homeRow, 6), PieceType::NONE, MOVE_CASTLE);
+            }
+            if ((castlingRights & queenside) && !grid[homeRow][3] && !grid[homeRow][2] && !grid[homeRow][1] &&
+                isPiece(getPiecePtr(Position(homeRow, 0)), us, PieceType::ROOK) &&
+                !isSquareAttacked(Position(homeRow, 3), them))
+            {
+                moves.emplace_back(kingHome, Position(homeRow, 2), PieceType::NONE, MOVE_CASTLE);
+            }
+        }
+    }
+
+    bool Board::isLegalMove(const Move &move)
+    {
+        Stats::count(Stats::Counter::LEGALITY_PROBES);
+        Color us = sideToMove;
+        MoveUndo undo;
+        makeMove(move, undo);
+        bool legal = !isSquareAttacked(findKing(us), opposite(us));
+        undoMove(move, undo);
+        return legal;
+    }
+
+    void Board::generateLegalMoves(std::vector<Move> &moves)
+    {
+        moves.clear();
+        generatePseudoLegalMoves(moves);
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < moves.size(); ++i)
+        {
+            if (isLegalMove(moves[i]))
+                moves[kept++] = moves[i];
+        }
+        moves.resize(kept);
+    }
+
+    void Board::makeMove(const Move &move, MoveUndo &undo)
+    {
+        Position from = move.from;
+        Position to = move.to;
+        Piece *mover = grid[from.row][from.col].get();
+
+        undo.castlingRights = castlingRights;
+        undo.enPassantSquare = enPassantSquare;
+        undo.halfmoveClock = halfmoveClock;
+        undo.moverHadMoved = mover->getHasMoved();
+        undo.capturedAt = move.isEnPassant() ? Position(from.row, to.col) : to;
+        undo.captured = std::move(grid[undo.capturedAt.row][undo.capturedAt.col]);
+        if (undo.captured)
+            removeFromPieceList(*undo.captured, squareIndex(undo.capturedAt));
+
+        bool isPawn = mover->getType() == PieceType::PAWN;
+        halfmoveClock = (isPawn || undo.captured) ? 0 : halfmoveClock + 1;
+        if (sideToMove == Color::BLACK)
+            ++fullmoveNumber;
+
+        moveInPieceList(*mover, squareIndex(from), squareIndex(to));
+        grid[to.row][to.col] = std::move(grid[from.row][from.col]);
+        mover->setPosition(to);
+        mover->setHasMoved(true);
+
+        if (mover->getType() == PieceType::KING)
+        {
+            (mover->getColor() == Color::WHITE ? whiteKingPos : blackKingPos) = to;
+            if (move.isCastle())
+            {
+                int rookFrom = to.col == 6 ? 7 : 0;
+                int rookTo = to.col == 6 ? 5 : 3;
+                moveInPieceList(*grid[to.row][rookFrom], to.row * 8 + rookFrom, to.row * 8 + rookTo);
+                grid[to.row][rookTo] = std::move(grid[to.row][rookFrom]);
+                grid[to.row][rookTo]->setPosition(Position(to.row, rookTo));
+                grid[to.row][rookTo]->setHasMoved(true);
+            }
+        }
+
+        if (move.promotion != PieceType::NONE)
+        {
+            undo.promotedPawn = std::move(grid[to.row][to.col]);
+            removeFromPieceList(*undo.promotedPawn, squareIndex(to));
+            grid[to.row][to.col] = createPiece(move.promotion, undo.promotedPawn->getColor(), to);
+            grid[to.row][to.col]->setHasMoved(true);
+            addToPieceList(*grid[to.row][to.col], squareIndex(to));
+        }
+
+        castlingRights &= static_cast<unsigned char>(~(rightsLostAt(from) | rightsLostAt(to)));
+        enPassantSquare = (move.flags & MOVE_DOUBLE_PUSH) ? Position((from.row + to.row) / 2, from.col) : Position(-1, -1);
+        sideToMove = opposite(sideToMove);
+        positionKey ^= Zobrist::castlingKey(castlingRights ^ undo.castlingRights) ^ Zobrist::key(Zobrist::TURN_OFFSET);
+    }
+
+    void Board::undoMove(const Move &move, MoveUndo &undo)
+    {
+        Position from = move.from;
+        Position to = move.to;
+        sideToMove = opposite(sideToMove);
+        if (sideToMove == Color::BLACK)
+            --fullmoveNumber;
+
+        if (undo.promotedPawn)
+        {
+            removeFromPieceList(*grid[to.row][to.col], squareIndex(to));
+            addToPieceList(*undo.promotedPawn, squareIndex(to));
+            grid[to.row][to.col] = std::move(undo.promotedPawn);
+        }
+
+        moveInPieceList(*grid[to.row][to.col], squareIndex(to), squareIndex(from));
+        grid[from.row][from.col] = std::move(grid[to.row][to.col]);
+        Piece *mover = grid[from.row][from.col].get();
+        mover->setPosition(from);
+        mover->setHasMoved(undo.moverHadMoved);
+
+        if (mover->getType() == PieceType::KING)
+        {
+            (mover->getColor() == Color::WHITE ? whiteKingPos : blackKingPos) = from;
+            if (move.isCastle())
+            {
+                int rookFrom = to.col == 6 ? 7 : 0;
+                int rookTo = to.col == 6 ? 5 : 3;
+                moveInPieceList(*grid[to.row][rookTo], to.row * 8 + rookTo, to.row * 8 + rookFrom);
+                grid[to.row][rookFrom] = std::move(grid[to.row][rookTo]);
+                grid[to.row][rookFrom]->setPosition(Position(to.row, rookFrom));
+                grid[to.row][rookFrom]->setHasMoved(false); // Castling required an unmoved rook
+            }
+        }
+
+        if (undo.captured)
+            addToPieceList(*undo.captured, squareIndex(undo.capturedAt));
+        grid[undo.capturedAt.row][undo.capturedAt.col] = std::move(undo.captured);
+
+        positionKey ^= Zobrist::castlingKey(castlingRights ^ undo.castlingRights) ^ Zobrist::key(Zobrist::TURN_OFFSET);
+        castlingRights = undo.castlingRights;
+        enPassantSquare = undo.enPassantSquare;
+        halfmoveClock = undo.halfmoveClock;
+    }
+
+    void Board::applyMove(const Move &move)
+    {
+        MoveUndo undo;
+        makeMove(move, undo);
+    }
+
+    Move Board::decodeMove(std::uint16_t code) const
+    {
+        static const PieceType promotions[8] = {PieceType::NONE, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK,
+                                                PieceType::QUEEN, PieceType::NONE, PieceType::NONE, PieceType::NONE};
+        return completeMove(squareAt((code >> 6) & 63), squareAt(code & 63), promotions[(code >> 12) & 7]);
+    }
+
+    Move Board::completeMove(Position from, Position to, PieceType promotion) const
+    {
+        Move move(from, to, promotion);
+
+        // Flags follow from what stands on the squares involved
+        const Piece *mover = getPiecePtr(move.from);
+        if (!mover)
+            return move;
+        if (grid[move.to.row][move.to.col])
+            move.flags |= MOVE_CAPTURE;
+        if (mover->getType() == PieceType::KING && move.from.col == 4 && (move.to.col == 6 || move.to.col == 2) &&
+            move.from.row == move.to.row)
+            move.flags |= MOVE_CASTLE;
+        if (mover->getType() == PieceType::PAWN)
+        {
+            if (move.from.col != move.to.col && !grid[move.to.row][move.to.col])
+                move.flags |= MOVE_CAPTURE | MOVE_EN_PASSANT;
+            if (move.from.row - move.to.row == 2 || move.to.row - move.from.row == 2)
+                move.flags |= MOVE_DOUBLE_PUSH;
+        }
+        return move;
+    }
+
+} // namespace HardChess
@@ -0,0 +1,252 @@
+#include "HardChess/Core/Notation.h"
+#include "HardChess/Core/AttackTables.h"
+#include "HardChess/Core/LegalMoveSet.h"
+
+namespace HardChess {
+
+    namespace Notation {
+
+        namespace {
+            PieceType pieceTypeFromLetter(char letter) {
+                switch (letter) {
+                    case 'N': return PieceType::KNIGHT;
+                    case 'B': return PieceType::BISHOP;
+                    case 'R': return PieceType::ROOK;
+                    case 'Q': return PieceType::QUEEN;
+                    case 'K': return PieceType::KING;
+                    default: return PieceType::NONE;
+                }
+            }
+
+            char pieceLetter(PieceType type) {
+                switch (type) {
+                    case PieceType::KNIGHT: return 'N';
+                    case PieceType::BISHOP: return 'B';
+                    case PieceType::ROOK: return 'R';
+                    case PieceType::QUEEN: return 'Q';
+                    case PieceType::KING: return 'K';
+                    default: return '?';
+                }
+            }
+
+            char fileLetter(Position square) { return static_cast<char>('a' + square.col); }
+            char rankDigit(Position square) { return static_cast<char>('1' + (7 - square.row)); }
+
+            // A piece of this type on from attacks to through the given occupancy
+            bool reaches(PieceType type, int from, int to, AttackTables::SquareMask occupied) {
+                switch (type) {
+                    case PieceType::KNIGHT: return (AttackTables::KNIGHT_ATTACKS[from] & AttackTables::squareMask(to)) != 0;
+                    case PieceType::BISHOP: if (!AttackTables::isDiagonal(from, to)) return false; break;
+                    case PieceType::ROOK: if (!AttackTables::isStraight(from, to)) return false; break;
+                    case PieceType::QUEEN: if (AttackTables::LINE[from][to] == 0) return false; break;
+                    default: return false;
+                }
+                return (AttackTables::BETWEEN[from][to] & occupied) == 0;
+            }
+
+            // Whether the side to move has any legal move, stopping at the first one found
+            bool hasLegalMove(Board& board, std::vector<Move>& scratch) {
+                scratch.clear();
+                board.generatePseudoLegalMoves(scratch);
+                for (const Move& reply : scratch) {
+                    if (board.isLegalMove(reply)) return true;
+                }
+                return false;
+            }
+
+            // A SAN token taken apart: what moves, where to, and the optional origin hints
+            struct SanToken {
+                PieceType piece = PieceType::PAWN;
+                PieceType promotion = PieceType::NONE;
+                int fromCol = -1, fromRow = -1;
+                Position to;
+                int castleCol = -1; // 6 or 2 for castling, -1 otherwise
+
+                bool matches(const Board& board, const Move& candidate) const {
+                    if (castleCol >= 0) return candidate.isCastle() && candidate.to.col == castleCol;
+                    if (candidate.to != to || candidate.promotion != promotion || candidate.isCastle()) return false;
+                    if (board.getPiecePtr(candidate.from)->getType() != piece) return false;
+                    if (fromCol >= 0 && candidate.from.col != fromCol) return false;
+                    return fromRow < 0 || candidate.from.row == fromRow;
+                }
+            };
+
+            bool tokenize(std::string_view san, SanToken& token) {
+                // Strip check/mate markers and annotation glyphs
+                while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' || san.back() == '?')) {
+                    san.remove_suffix(1);
+                }
+                if (san.empty()) return false;
+
+                if (san == "O-O" || san == "0-0") {
+                    token.castleCol = 6;
+                    return true;
+                }
+                if (san == "O-O-O" || san == "0-0-0") {
+                    token.castleCol = 2;
+                    return true;
+                }
+
+                std::size_t i = 0;
+                if (pieceTypeFromLetter(san[0]) != PieceType::NONE) {
+                    token.piece = pieceTypeFromLetter(san[0]);
+                    i = 1;
+                }
+
+                // Promotion suffix: "=Q" or a bare trailing piece letter on a pawn move
+                if (token.piece == PieceType::PAWN && san.size() >= 3) {
+                    PieceType suffix = pieceTypeFromLetter(san.back());
+                    if (suffix != PieceType::NONE && suffix != PieceType::KING) {
+                        token.promotion = suffix;
+                        san.remove_suffix(1);
+                        if (!san.empty() && san.back() == '=') san.remove_suffix(1);
+                    }
+                }
+
+                if (san.size() < i + 2 || !parseSquare(san.substr(san.size() - 2), token.to)) return false;
+                std::string_view middle = san.substr(i, san.size() - 2 - i);
+
+                // Disambiguation and capture marker: [file][rank][x]
+                if (!middle.empty() && (middle.back() == 'x' || middle.back() == ':')) middle.remove_suffix(1);
+                for (char ch : middle) {
+                    if (ch >= 'a' && ch <= 'h' && token.fromCol < 0) token.fromCol = ch - 'a';
+                    else if (ch >= '1' && ch <= '8' && token.fromRow < 0) token.fromRow = 7 - (ch - '1');
+                    else return false;
+                }
+                return true;
+            }
+        } // namespace
+
+        bool parseSquare(std::string_view text, Position& square) {
+            if (text.size() != 2 || text[0] < 'a' || text[0] > 'h' || text[1] < '1' || text[1] > '8') {
+                return false;
+            }
+            // Board: (0,0) is a8, (7,7) is h1
+            square = Position(7 - (text[1] - '1'), text[0] - 'a');
+            return true;
+        }
+
+        bool parseCoordinate(std::string_view text, Position& from, Position& to, PieceType& promotion) {
+            if (text.size() != 4 && text.size() != 5) return false;
+            if (!parseSquare(text.substr(0, 2), from) || !parseSquare(text.substr(2, 2), to)) return false;
+            promotion = PieceType::NONE;
+            if (text.size() == 5) {
+                switch (text[4]) {
+                    case 'q': promotion = PieceType::QUEEN; break;
+                    case 'r': promotion = PieceType::ROOK; break;
+                    case 'b': promotion = PieceType::BISHOP; break;
+                    case 'n': promotion = PieceType::KNIGHT; break;
+                    default: return false;
+                }
+            }
+            return true;
+        }
+
+        std::size_t formatCoordinate(const Move& move, char* out) {
+            out[0] = static_cast<char>('a' + move.from.col);
+            out[1] = static_cast<char>('1' + (7 - move.from.row));
+            out[2] = static_cast<char>('a' + move.to.col);
+            out[3] = static_cast<char>('1' + (7 - move.to.row));
+            switch (move.promotion) {
+                case PieceType::QUEEN: out[4] = 'q'; return 5;
+                case PieceType::ROOK: out[4] = 'r'; return 5;
+                case PieceType::BISHOP: out[4] = 'b'; return 5;
+                case PieceType::KNIGHT: out[4] = 'n'; return 5;
+                default: return 4;
+            }
+        }
+
+        std::string toCoordinate(const Move& move) {
+            char buffer[5];
+            return std::string(buffer, formatCoordinate(move, buffer));
+        }
+
+        bool parseSAN(Board& board, std::string_view san, Move& move, std::vector<Move>& scratch) {
+            SanToken token;
+            if (!tokenize(san, token)) return false;
+
+            scratch.clear();
+            board.generatePseudoLegalMoves(scratch);
+            bool found = false;
+            for (const Move& candidate : scratch) {
+                if (!token.matches(board, candidate) || !board.isLegalMove(candidate)) continue;
+                if (found) return false; // Ambiguous
+                move = candidate;
+                found = true;
+            }
+            return found;
+        }
+
+        bool parseSAN(const Board& board, std::string_view san, const LegalMoveSet& moves, Move& move) {
+            SanToken token;
+            if (!tokenize(san, token)) return false;
+
+            bool found = false;
+            for (int i = 0; i < moves.size(); ++i) {
+                if (!token.matches(board, moves[i])) continue;
+                if (found) return false; // Ambiguous
+                move = moves[i];
+                found = true;
+            }
+            return found;
+        }
+
+        std::size_t formatSAN(Board& board, const Move& move, char* out, std::vector<Move>& scratch) {
+            std::size_t length = 0;
+            const Piece* mover = board.getPiecePtr(move.from);
+            PieceType type = mover->getType();
+            bool capture = move.isEnPassant() || board.getPiecePtr(move.to) != nullptr;
+
+            if (move.isCastle()) {
+                const char* castle = move.to.col == 6 ? "O-O" : "O-O-O";
+                while (*castle) out[length++] = *castle++;
+            } else if (type == PieceType::PAWN) {
+                if (capture) {
+                    out[length++] = fileLetter(move.from);
+                    out[length++] = 'x';
+                }
+                out[length++] = fileLetter(move.to);
+                out[length++] = rankDigit(move.to);
+                if (move.promotion != PieceType::NONE) {
+                    out[length++] = '=';
+                    out[length++] = pieceLetter(move.promotion);
+                }
+            } else {
+                out[length++] = pieceLetter(type);
+                if (type != PieceType::KING) {
+                    // Other pieces of the same kind that can also reach the destination
+                    bool rival = false, sameFile = false, sameRank = false;
+                    int target = squareIndex(move.to);
+                    AttackTables::SquareMask occupied = board.occupiedSquares();
+                    for (std::uint8_t square : board.pieces(mover->getColor(), type)) {
+                        if (square == squareIndex(move.from) || !reaches(type, square, target, occupied)) continue;
+                        if (!board.isLegalMove(board.completeMove(squareAt(square), move.to))) continue;
+                        rival = true;
+                        sameFile = sameFile || square % 8 == move.from.col;
+                        sameRank = sameRank || square / 8 == move.from.row;
+                    }
+                    if (rival && (!sameFile || sameRank)) out[length++] = fileLetter(move.from);
+                    if (rival && sameFile) out[length++] = rankDigit(move.from);
+                }
+                if (capture) out[length++] = 'x';
+                out[length++] = fileLetter(move.to);
+                out[length++] = rankDigit(move.to);
+            }
+
+            MoveUndo undo;
+            board.makeMove(move, undo);
+            if (board.isKingInCheck(board.getSideToMove())) {
+                out[length++] = hasLegalMove(board, scratch) ? '+' : '#';
+            }
+            board.undoMove(move, undo);
+            return length;
+        }
+
+        std::string toSAN(Board& board, const Move& move, std::vector<Move>& scratch) {
+            char buffer[MAX_SAN_LENGTH];
+            return std::string(buffer, formatSAN(board, move, buffer, scratch));
+        }
+
+    } // namespace Notation
+
+} // namespace HardChess
@@ -1,5 +1,5 @@
 #include "HardChess/Core/Pawn.h"
-#include "HardChess/Core/Board.h" // For board.getPiece()
+#include "HardChess/Core/MoveRules.h"
 
 namespace HardChess {
 
@@ -16,38 +16,7 @@ namespace HardChess {
     }
 
     bool Pawn::isValidMove(Position start, Position end, const Board& board) const {
-        if (!end.isValid()) return false;
-        if (start == end) return false;
-
-        std::unique_ptr<Piece> targetPiece = board.getPiece(end);
-        if (targetPiece && targetPiece->getColor() == this->color) {
-            return false; // Cannot capture own piece
-        }
-
-        int forwardDirection = (this->color == Color::WHITE) ? -1 : 1; // White moves up, Black moves down
-
-        // Standard one-step forward
-        if (end.col == start.col && end.row == start.row + forwardDirection && !targetPiece) {
-            return true;
-        }
-
-        // Initial two-step forward
-        if (!this->hasMoved && end.col == start.col && end.row == start.row + 2 * forwardDirection && !targetPiece) {
-            // Check if path is clear
-            Position intermediate(start.row + forwardDirection, start.col);
-            if (!board.getPiece(intermediate)) {
-                return true;
-            }
-        }
-
-        // Capture
-        if (abs(end.col - start.col) == 1 && end.row == start.row + forwardDirection) {
-            if (targetPiece && targetPiece->getColor() != this->color) {
-                return true; // Diagonal capture of opponent's piece
-            }
-            // En Passant would be checked here if implemented
-        }
-        return false;
+        return MoveRules::isValidMove<PieceType::PAWN>(color, start, end, board, hasMoved);
     }
 
 } // namespace HardChess
\ No newline at end of file
@@ -1,14 +1,31 @@
 #include "HardChess/Core/Piece.h"
-#include "HardChess/Core/Board.h" // Required for Board reference in getPossibleMoves
+#include "HardChess/Core/MoveRules.h"
 
 namespace HardChess {
 
+    namespace {
+        using PiecePool = FixedPool<sizeof(Piece)>;
+    } // namespace
+
+    void* Piece::operator new(std::size_t size) {
+        return size <= PiecePool::BLOCK_SIZE ? PiecePool::allocate() : ::operator new(size);
+    }
+
+    void Piece::operator delete(void* block, std::size_t size) noexcept {
+        if (size <= PiecePool::BLOCK_SIZE) PiecePool::deallocate(block);
+        else ::operator delete(block);
+    }
+
+    AllocatorStats Piece::poolStats() {
+        return PiecePool::threadStats();
+    }
+
     std::vector<Position> Piece::getPossibleMoves(Position start, const Board& board) const {
         std::vector<Position> moves;
         for (int r = 0; r < 8; ++r) {
             for (int c = 0; c < 8; ++c) {
                 Position end(r, c);
-                if (isValidMove(start, end, board)) {
+                if (MoveRules::isValidMove(type, color, start, end, board, hasMoved)) {
                     moves.push_back(end);
                 }
             }
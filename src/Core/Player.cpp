@@ -2,8 +2,8 @@
 
 namespace HardChess {
 
-    Player::Player(const std::string& playerName, Color playerColor)
-        : name(playerName), color(playerColor), hearts(3), score(0) {}
+    Player::Player(const std::string& playerName, Color playerColor, bool isComputerPlayer)
+        : name(playerName), color(playerColor), hearts(3), score(0), computer(isComputerPlayer) {}
 
     void Player::loseHeart() {
         if (hearts > 0) {
@@ -40,4 +40,8 @@ namespace HardChess {
         return score;
     }
 
+    bool Player::isComputer() const {
+        return computer;
+    }
+
 } // namespace HardChess
\ No newline at end of file
@@ -1,6 +1,5 @@
 #include "HardChess/Core/Queen.h"
-#include "HardChess/Core/Board.h"
-#include <cmath> // For abs
+#include "HardChess/Core/MoveRules.h"
 
 namespace HardChess {
 
@@ -17,22 +16,7 @@ namespace HardChess {
     }
 
     bool Queen::isValidMove(Position start, Position end, const Board& board) const {
-        if (!end.isValid()) return false;
-        if (start == end) return false;
-
-        std::unique_ptr<Piece> targetPiece = board.getPiece(end);
-        if (targetPiece && targetPiece->getColor() == this->color) {
-            return false;
-        }
-
-        // Check if it's a rook-like move OR a bishop-like move
-        bool isRookMove = (start.row == end.row || start.col == end.col);
-        bool isBishopMove = (std::abs(start.row - end.row) == std::abs(start.col - end.col));
-
-        if (isRookMove || isBishopMove) {
-            return board.isPathClear(start, end);
-        }
-        return false;
+        return MoveRules::isValidMove<PieceType::QUEEN>(color, start, end, board, hasMoved);
     }
 
 } // namespace HardChess
\ No newline at end of file
@@ -1,5 +1,5 @@
 #include "HardChess/Core/Rook.h"
-#include "HardChess/Core/Board.h"
+#include "HardChess/Core/MoveRules.h"
 
 namespace HardChess {
 
@@ -16,18 +16,7 @@ namespace HardChess {
     }
 
     bool Rook::isValidMove(Position start, Position end, const Board& board) const {
-        if (!end.isValid()) return false;
-        if (start == end) return false;
-
-        std::unique_ptr<Piece> targetPiece = board.getPiece(end);
-        if (targetPiece && targetPiece->getColor() == this->color) {
-            return false;
-        }
-
-        if (start.row == end.row || start.col == end.col) { // Horizontal or vertical move
-            return board.isPathClear(start, end);
-        }
-        return false;
+        return MoveRules::isValidMove<PieceType::ROOK>(color, start, end, board, hasMoved);
     }
 
 } // namespace HardChess
\ No newline at end of file
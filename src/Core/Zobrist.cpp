@@ -0,0 +1,80 @@
+#include "HardChess/Core/Zobrist.h"
+#include "HardChess/Core/Board.h"
+#include <fstream>
+#include <sstream>
+
+namespace HardChess {
+
+    namespace Zobrist {
+
+        std::uint64_t hash(const Board& board) {
+            std::uint64_t h = 0;
+            for (int r = 0; r < 8; ++r) {
+                for (int c = 0; c < 8; ++c) {
+                    const Piece* piece = board.getPiecePtr(Position(r, c));
+                    if (piece) h ^= Detail::table.keys[pieceKeyIndex(piece->getType(), piece->getColor(), Position(r, c))];
+                }
+            }
+
+            unsigned char rights = board.getCastlingRights();
+            if (rights & WHITE_KINGSIDE) h ^= Detail::table.keys[CASTLING_OFFSET + 0];
+            if (rights & WHITE_QUEENSIDE) h ^= Detail::table.keys[CASTLING_OFFSET + 1];
+            if (rights & BLACK_KINGSIDE) h ^= Detail::table.keys[CASTLING_OFFSET + 2];
+            if (rights & BLACK_QUEENSIDE) h ^= Detail::table.keys[CASTLING_OFFSET + 3];
+
+            h ^= enPassantKey(board);
+            if (board.getSideToMove() == Color::WHITE) h ^= Detail::table.keys[TURN_OFFSET];
+            return h;
+        }
+
+        std::uint64_t enPassantKey(const Board& board) {
+            // Polyglot only hashes the en passant file when a pawn can actually capture there
+            Position ep = board.getEnPassantSquare();
+            if (!ep.isValid()) return 0;
+            Color us = board.getSideToMove();
+            int pawnRow = ep.row + (us == Color::WHITE ? 1 : -1);
+            for (int dc = -1; dc <= 1; dc += 2) {
+                const Piece* pawn = board.getPiecePtr(Position(pawnRow, ep.col + dc));
+                if (pawn && pawn->getType() == PieceType::PAWN && pawn->getColor() == us) {
+                    return Detail::table.keys[EN_PASSANT_OFFSET + ep.col];
+                }
+            }
+            return 0;
+        }
+
+        bool loadKeyTable(const std::string& path) {
+            std::ifstream in(path);
+            if (!in) return false;
+            std::stringstream content;
+            content << in.rdbuf();
+            std::string text = content.str();
+
+            std::uint64_t keys[KEY_COUNT];
+            int count = 0;
+            for (std::size_t i = 0; i + 2 < text.size() && count < KEY_COUNT; ++i) {
+                if (text[i] != '0' || (text[i + 1] != 'x' && text[i + 1] != 'X')) continue;
+                std::size_t end = i + 2;
+                std::uint64_t value = 0;
+                int digits = 0;
+                for (; end < text.size(); ++end) {
+                    char ch = text[end];
+                    int nibble;
+                    if (ch >= '0' && ch <= '9') nibble = ch - '0';
+                    else if (ch >= 'a' && ch <= 'f') nibble = ch - 'a' + 10;
+                    else if (ch >= 'A' && ch <= 'F') nibble = ch - 'A' + 10;
+                    else break;
+                    value = (value << 4) | static_cast<std::uint64_t>(nibble);
+                    ++digits;
+                }
+                if (digits == 0 || digits > 16) return false;
+                keys[count++] = value;
+                i = end;
+            }
+            if (count != KEY_COUNT) return false;
+            for (int k = 0; k < KEY_COUNT; ++k) Detail::table.keys[k] = keys[k];
+            return true;
+        }
+
+    } // namespace Zobrist
+
+} // namespace HardChess
@@ -0,0 +1,301 @@
+#include "HardChess/Engine/AnalysisCache.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace HardChess {
+
+    namespace {
+
+        const char cacheMagic[8] = {'H', 'C', 'A', 'C', 'A', 'C', 'H', 'E'};
+        constexpr std::uint32_t cacheVersion = 1;
+
+        struct CacheHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t recordSize;
+            std::uint64_t sortedCount;
+            std::uint64_t reserved[5];
+        };
+        static_assert(sizeof(CacheHeader) == sizeof(CachedAnalysis), "records stay aligned after the header");
+
+        std::uint32_t checksumOf(const CachedAnalysis& entry) {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&entry);
+            std::uint32_t hash = 2166136261u; // FNV-1a
+            for (std::size_t i = 0; i < offsetof(CachedAnalysis, checksum); ++i) {
+                hash ^= bytes[i];
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        bool validHeader(const CacheHeader& header) {
+            return std::memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) == 0 && header.version == cacheVersion &&
+                   header.recordSize == sizeof(CachedAnalysis);
+        }
+
+        // A mate score is exact whatever depth found it
+        bool deepEnough(const CachedAnalysis& entry, int minDepth) {
+            return entry.depth >= minDepth || entry.score > Search::MATE_BOUND || entry.score < -Search::MATE_BOUND;
+        }
+
+        // Of two results for one key, the deeper; the later one on a tie
+        bool better(const CachedAnalysis& candidate, const CachedAnalysis& current) {
+            return candidate.depth >= current.depth;
+        }
+
+        bool writeAll(int fd, const void* data, std::size_t size) {
+            const char* bytes = static_cast<const char*>(data);
+            while (size > 0) {
+                ssize_t written = ::write(fd, bytes, size);
+                if (written < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                bytes += written;
+                size -= static_cast<std::size_t>(written);
+            }
+            return true;
+        }
+
+        // Opens path and takes its exclusive lock, retrying if compact() renamed a new file
+        // into place between the open and the lock. -1 on failure.
+        int openLocked(const std::string& path, int flags) {
+            for (int attempt = 0; attempt < 100; ++attempt) {
+                int fd = ::open(path.c_str(), flags, 0644);
+                if (fd < 0) return -1;
+                if (flock(fd, LOCK_EX) != 0) {
+                    ::close(fd);
+                    return -1;
+                }
+                struct stat opened, current;
+                if (fstat(fd, &opened) == 0 && ::stat(path.c_str(), &current) == 0 && opened.st_ino == current.st_ino &&
+                    opened.st_dev == current.st_dev) {
+                    return fd;
+                }
+                ::close(fd); // Replaced meanwhile; the lock goes with the descriptor
+            }
+            return -1;
+        }
+
+        bool intact(const CachedAnalysis& entry) { return entry.checksum == checksumOf(entry); }
+
+        // Bytes of the file up to the end of its last whole record, setting sortedCount from
+        // the header; 0 if the file is not a cache
+        std::size_t wholeLength(const char* data, std::size_t size, std::size_t& sortedCount) {
+            if (size < sizeof(CacheHeader)) return 0;
+            CacheHeader header;
+            std::memcpy(&header, data, sizeof(header));
+            if (!validHeader(header)) return 0;
+            std::size_t records = (size - sizeof(header)) / sizeof(CachedAnalysis);
+            if (header.sortedCount > records) return 0;
+            sortedCount = static_cast<std::size_t>(header.sortedCount);
+            return sizeof(header) + records * sizeof(CachedAnalysis);
+        }
+
+        // Drops the partial record a writer that crashed mid-append may have left, so the
+        // next append starts on a record boundary. Called with the lock held.
+        bool trimPartialRecord(int fd) {
+            struct stat info;
+            if (fstat(fd, &info) != 0) return false;
+            off_t excess = (info.st_size - static_cast<off_t>(sizeof(CacheHeader))) % static_cast<off_t>(sizeof(CachedAnalysis));
+            return excess == 0 || ftruncate(fd, info.st_size - excess) == 0;
+        }
+
+    } // namespace
+
+    CachedAnalysis CachedAnalysis::from(std::uint64_t positionKey, const SearchResult& result) {
+        CachedAnalysis entry;
+        entry.key = positionKey;
+        entry.nodes = static_cast<std::uint64_t>(result.nodes);
+        entry.move = result.hasMove ? result.bestMove.encode() : 0;
+        entry.score = static_cast<std::int16_t>(std::max(-32767, std::min(32767, result.score)));
+        entry.depth = static_cast<std::uint8_t>(std::min(255, result.depth));
+        entry.hasMove = result.hasMove ? 1 : 0;
+        entry.pvLength = static_cast<std::uint8_t>(std::min<std::size_t>(result.pv.size(), MAX_PV));
+        for (int i = 0; i < entry.pvLength; ++i) entry.pv[i] = result.pv[i].encode();
+        return entry;
+    }
+
+    AnalysisCache::AnalysisCache() : records(nullptr), sortedCount(0), fd(-1), opened(false), hitCount(0), missCount(0) {}
+
+    AnalysisCache::~AnalysisCache() {
+        close();
+    }
+
+    bool AnalysisCache::open(const std::string& cachePath, bool writable) {
+        close();
+        path = cachePath;
+        hitCount.store(0, std::memory_order_relaxed);
+        missCount.store(0, std::memory_order_relaxed);
+
+        if (writable) {
+            fd = openLocked(path, O_RDWR | O_CREAT | O_APPEND);
+            if (fd < 0) return false;
+            struct stat info;
+            bool ok = fstat(fd, &info) == 0;
+            if (ok && info.st_size == 0) {
+                CacheHeader header = {};
+                std::memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+                header.version = cacheVersion;
+                header.recordSize = sizeof(CachedAnalysis);
+                ok = writeAll(fd, &header, sizeof(header));
+            } else if (ok) {
+                CacheHeader header;
+                ok = pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) && validHeader(header) &&
+                     trimPartialRecord(fd);
+            }
+            flock(fd, LOCK_UN);
+            if (!ok) {
+                ::close(fd);
+                fd = -1;
+                return false;
+            }
+        }
+
+        if (!file.open(path)) {
+            close();
+            return false;
+        }
+        std::size_t length = wholeLength(file.data(), file.size(), sortedCount);
+        if (length == 0) {
+            close();
+            return false;
+        }
+        records = reinterpret_cast<const CachedAnalysis*>(file.data() + sizeof(CacheHeader));
+        std::size_t count = (length - sizeof(CacheHeader)) / sizeof(CachedAnalysis);
+        for (std::size_t i = sortedCount; i < count; ++i) {
+            if (!intact(records[i])) continue; // Torn by a crash
+            auto slot = logged.find(records[i].key);
+            if (slot == logged.end()) logged.emplace(records[i].key, records[i]);
+            else if (better(records[i], slot->second)) slot->second = records[i];
+        }
+        opened = true;
+        return true;
+    }
+
+    bool AnalysisCache::close() {
+        bool ok = true;
+        if (opened) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ok = flushLocked();
+        }
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        file.close();
+        records = nullptr;
+        sortedCount = 0;
+        logged.clear();
+        pending.clear();
+        opened = false;
+        return ok;
+    }
+
+    bool AnalysisCache::find(std::uint64_t key, int minDepth, CachedAnalysis& out) {
+        bool found = false;
+        if (opened) {
+            const CachedAnalysis* end = records + sortedCount;
+            const CachedAnalysis* match = std::lower_bound(
+                records, end, key, [](const CachedAnalysis& entry, std::uint64_t value) { return entry.key < value; });
+            if (match != end && match->key == key && deepEnough(*match, minDepth)) {
+                out = *match;
+                found = true;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            auto slot = logged.find(key);
+            if (slot != logged.end() && deepEnough(slot->second, minDepth) && (!found || better(slot->second, out))) {
+                out = slot->second;
+                found = true;
+            }
+        }
+        (found ? hitCount : missCount).fetch_add(1, std::memory_order_relaxed);
+        return found;
+    }
+
+    void AnalysisCache::store(const CachedAnalysis& entry) {
+        if (!opened) return;
+        CachedAnalysis record = entry;
+        record.checksum = checksumOf(record);
+        std::lock_guard<std::mutex> lock(mutex);
+        auto slot = logged.find(record.key);
+        if (slot == logged.end()) logged.emplace(record.key, record);
+        else if (better(record, slot->second)) slot->second = record;
+        if (fd < 0) return; // Read-only: remembered for this process only
+        pending.push_back(record);
+        if (pending.size() >= FLUSH_RECORDS) flushLocked();
+    }
+
+    bool AnalysisCache::flush() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return flushLocked();
+    }
+
+    bool AnalysisCache::flushLocked() {
+        if (fd < 0 || pending.empty()) return true;
+        // compact() may have renamed a new file into place since the last append
+        struct stat opened, current;
+        if (fstat(fd, &opened) != 0 || ::stat(path.c_str(), &current) != 0 || opened.st_ino != current.st_ino) {
+            ::close(fd);
+            fd = openLocked(path, O_RDWR | O_APPEND);
+        } else if (flock(fd, LOCK_EX) != 0) {
+            return false;
+        }
+        if (fd < 0) return false;
+        bool ok = trimPartialRecord(fd) && writeAll(fd, pending.data(), pending.size() * sizeof(CachedAnalysis));
+        flock(fd, LOCK_UN);
+        pending.clear();
+        return ok;
+    }
+
+    bool AnalysisCache::compact(const std::string& cachePath, std::size_t& recordsBefore, std::size_t& recordsAfter) {
+        recordsBefore = recordsAfter = 0;
+        int fd = openLocked(cachePath, O_RDWR);
+        if (fd < 0) return false;
+        MappedFile current;
+        std::size_t sortedCount = 0;
+        std::size_t length = current.open(cachePath) ? wholeLength(current.data(), current.size(), sortedCount) : 0;
+        if (length == 0) {
+            ::close(fd);
+            return false;
+        }
+        const CachedAnalysis* all = reinterpret_cast<const CachedAnalysis*>(current.data() + sizeof(CacheHeader));
+        recordsBefore = (length - sizeof(CacheHeader)) / sizeof(CachedAnalysis);
+
+        // Sort positions, not records: equal keys keep file order, so later beats earlier on a tie
+        std::vector<std::uint32_t> order(recordsBefore);
+        for (std::size_t i = 0; i < recordsBefore; ++i) order[i] = static_cast<std::uint32_t>(i);
+        std::stable_sort(order.begin(), order.end(), [all](std::uint32_t a, std::uint32_t b) { return all[a].key < all[b].key; });
+        std::vector<CachedAnalysis> kept;
+        for (std::uint32_t i : order) {
+            if (!intact(all[i])) continue;
+            if (!kept.empty() && kept.back().key == all[i].key) {
+                if (better(all[i], kept.back())) kept.back() = all[i];
+            } else {
+                kept.push_back(all[i]);
+            }
+        }
+        recordsAfter = kept.size();
+
+        CacheHeader header = {};
+        std::memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+        header.version = cacheVersion;
+        header.recordSize = sizeof(CachedAnalysis);
+        header.sortedCount = kept.size();
+        std::string temporary = cachePath + ".compact";
+        int out = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        bool ok = out >= 0 && writeAll(out, &header, sizeof(header)) &&
+                  writeAll(out, kept.data(), kept.size() * sizeof(CachedAnalysis)) && fsync(out) == 0;
+        if (out >= 0) ok = ::close(out) == 0 && ok;
+        // The rename is the commit point: a crash before it leaves the old file untouched
+        ok = ok && std::rename(temporary.c_str(), cachePath.c_str()) == 0;
+        if (!ok) std::remove(temporary.c_str());
+        ::close(fd); // Releases the lock; writers waiting on the old file will notice the rename
+        return ok;
+    }
+
+} // namespace HardChess
@@ -0,0 +1,120 @@
+#include "HardChess/Engine/Evaluation.h"
+
+namespace HardChess {
+
+    namespace Evaluation {
+
+        namespace {
+            // Piece-square tables from White's point of view, indexed [row][col] with
+            // row 0 = rank 8 just like Board's grid. Black reads them mirrored.
+            const int pawnTable[8][8] = {
+                {  0,  0,  0,  0,  0,  0,  0,  0},
+                { 50, 50, 50, 50, 50, 50, 50, 50},
+                { 10, 10, 20, 30, 30, 20, 10, 10},
+                {  5,  5, 10, 25, 25, 10,  5,  5},
+                {  0,  0,  0, 20, 20,  0,  0,  0},
+                {  5, -5,-10,  0,  0,-10, -5,  5},
+                {  5, 10, 10,-20,-20, 10, 10,  5},
+                {  0,  0,  0,  0,  0,  0,  0,  0}};
+            const int knightTable[8][8] = {
+                {-50,-40,-30,-30,-30,-30,-40,-50},
+                {-40,-20,  0,  0,  0,  0,-20,-40},
+                {-30,  0, 10, 15, 15, 10,  0,-30},
+                {-30,  5, 15, 20, 20, 15,  5,-30},
+                {-30,  0, 15, 20, 20, 15,  0,-30},
+                {-30,  5, 10, 15, 15, 10,  5,-30},
+                {-40,-20,  0,  5,  5,  0,-20,-40},
+                {-50,-40,-30,-30,-30,-30,-40,-50}};
+            const int bishopTable[8][8] = {
+                {-20,-10,-10,-10,-10,-10,-10,-20},
+                {-10,  0,  0,  0,  0,  0,  0,-10},
+                {-10,  0,  5, 10, 10,  5,  0,-10},
+                {-10,  5,  5, 10, 10,  5,  5,-10},
+                {-10,  0, 10, 10, 10, 10,  0,-10},
+                {-10, 10, 10, 10, 10, 10, 10,-10},
+                {-10,  5,  0,  0,  0,  0,  5,-10},
+                {-20,-10,-10,-10,-10,-10,-10,-20}};
+            const int rookTable[8][8] = {
+                {  0,  0,  0,  0,  0,  0,  0,  0},
+                {  5, 10, 10, 10, 10, 10, 10,  5},
+                { -5,  0,  0,  0,  0,  0,  0, -5},
+                { -5,  0,  0,  0,  0,  0,  0, -5},
+                { -5,  0,  0,  0,  0,  0,  0, -5},
+                { -5,  0,  0,  0,  0,  0,  0, -5},
+                { -5,  0,  0,  0,  0,  0,  0, -5},
+                {  0,  0,  0,  5,  5,  0,  0,  0}};
+            const int queenTable[8][8] = {
+                {-20,-10,-10, -5, -5,-10,-10,-20},
+                {-10,  0,  0,  0,  0,  0,  0,-10},
+                {-10,  0,  5,  5,  5,  5,  0,-10},
+                { -5,  0,  5,  5,  5,  5,  0, -5},
+                {  0,  0,  5,  5,  5,  5,  0, -5},
+                {-10,  5,  5,  5,  5,  5,  0,-10},
+                {-10,  0,  5,  0,  0,  0,  0,-10},
+                {-20,-10,-10, -5, -5,-10,-10,-20}};
+            const int kingMiddlegameTable[8][8] = {
+                {-30,-40,-40,-50,-50,-40,-40,-30},
+                {-30,-40,-40,-50,-50,-40,-40,-30},
+                {-30,-40,-40,-50,-50,-40,-40,-30},
+                {-30,-40,-40,-50,-50,-40,-40,-30},
+                {-20,-30,-30,-40,-40,-30,-30,-20},
+                {-10,-20,-20,-20,-20,-20,-20,-10},
+                { 20, 20,  0,  0,  0,  0, 20, 20},
+                { 20, 30, 10,  0,  0, 10, 30, 20}};
+            const int kingEndgameTable[8][8] = {
+                {-50,-40,-30,-20,-20,-30,-40,-50},
+                {-30,-20,-10,  0,  0,-10,-20,-30},
+                {-30,-10, 20, 30, 30, 20,-10,-30},
+                {-30,-10, 30, 40, 40, 30,-10,-30},
+                {-30,-10, 30, 40, 40, 30,-10,-30},
+                {-30,-10, 20, 30, 30, 20,-10,-30},
+                {-30,-30,  0,  0,  0,  0,-30,-30},
+                {-50,-30,-30,-30,-30,-30,-30,-50}};
+
+            // Non-pawn material of both sides at the start of the game
+            constexpr int openingPhase = 2 * (2 * 320 + 2 * 330 + 2 * 500 + 900);
+        } // namespace
+
+        int evaluate(const Board& board) {
+            int score[2] = {0, 0};
+            int kingMiddlegame[2] = {0, 0};
+            int kingEndgame[2] = {0, 0};
+            int phase = 0;
+
+            for (int side = 0; side < 2; ++side) {
+                Color color = side == 0 ? Color::WHITE : Color::BLACK;
+                for (int t = static_cast<int>(PieceType::PAWN); t <= static_cast<int>(PieceType::KING); ++t) {
+                    PieceType type = static_cast<PieceType>(t);
+                    for (int square : board.pieces(color, type)) {
+                        int c = square & 7;
+                        int row = side == 0 ? square >> 3 : 7 - (square >> 3);
+                        int value = pieceValues[t];
+                        switch (type) {
+                            case PieceType::PAWN: value += pawnTable[row][c]; break;
+                            case PieceType::KNIGHT: value += knightTable[row][c]; break;
+                            case PieceType::BISHOP: value += bishopTable[row][c]; break;
+                            case PieceType::ROOK: value += rookTable[row][c]; break;
+                            case PieceType::QUEEN: value += queenTable[row][c]; break;
+                            case PieceType::KING:
+                                kingMiddlegame[side] = kingMiddlegameTable[row][c];
+                                kingEndgame[side] = kingEndgameTable[row][c];
+                                break;
+                            default: break;
+                        }
+                        if (type != PieceType::PAWN) phase += pieceValues[t];
+                        score[side] += value;
+                    }
+                }
+            }
+
+            if (phase > openingPhase) phase = openingPhase;
+            for (int side = 0; side < 2; ++side) {
+                score[side] += (kingMiddlegame[side] * phase + kingEndgame[side] * (openingPhase - phase)) / openingPhase;
+            }
+            int whiteScore = score[0] - score[1];
+            return board.getSideToMove() == Color::WHITE ? whiteScore : -whiteScore;
+        }
+
+    } // namespace Evaluation
+
+} // namespace HardChess
@@ -0,0 +1,86 @@
+#include "HardChess/Engine/HintSearch.h"
+#include "HardChess/Core/Notation.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace HardChess {
+
+    namespace {
+        // "+0.35" or "mate in 3"
+        std::string formatScore(int score) {
+            int mate = Search::mateInMoves(score);
+            char value[32];
+            if (mate != 0) {
+                std::snprintf(value, sizeof(value), "mate in %d", mate);
+            } else {
+                std::snprintf(value, sizeof(value), "%+.2f", score / 100.0);
+            }
+            return value;
+        }
+    } // namespace
+
+    std::string Hint::describe() const {
+        if (!hasMove) return "no legal move";
+        std::string text = san + " (" + formatScore(score);
+        text += ", depth " + std::to_string(depth) + ", " + std::to_string(nodes) + " nodes in " +
+                std::to_string(elapsedMs) + " ms)";
+        for (std::size_t i = 0; i < alternatives.size(); ++i) {
+            text += i == 0 ? "; also " : ", ";
+            text += alternatives[i].san + " (" + formatScore(alternatives[i].score) + ")";
+        }
+        return text;
+    }
+
+    HintSearch::HintSearch() : cancelled(false), finished(true) {}
+
+    HintSearch::~HintSearch() {
+        cancel();
+    }
+
+    void HintSearch::start(const Board& board, const RepetitionHistory& history, int timeMs, int lines,
+                           Callback onDone) {
+        cancel();
+        position = board;
+        positions = history;
+        search.clearStop(); // Before the worker starts, so a cancel() from now on is never lost
+        cancelled.store(false, std::memory_order_relaxed);
+        finished.store(false, std::memory_order_release);
+        worker = std::thread([this, timeMs, lines, onDone = std::move(onDone)] {
+            auto begin = std::chrono::steady_clock::now();
+            SearchLimits limits;
+            limits.timeMs = timeMs > 0 ? timeMs : 1;
+            limits.multiPv = lines;
+            SearchResult result = search.run(position, limits, &positions);
+
+            Hint hint;
+            hint.move = result.bestMove;
+            hint.score = result.score;
+            hint.depth = result.depth;
+            hint.nodes = result.nodes;
+            hint.hasMove = result.hasMove;
+            if (hint.hasMove) {
+                std::vector<Move> scratch;
+                hint.san = Notation::toSAN(position, hint.move, scratch);
+                for (std::size_t i = 1; i < result.lines.size(); ++i) {
+                    Hint::Candidate candidate;
+                    candidate.san = Notation::toSAN(position, result.lines[i].move, scratch);
+                    candidate.score = result.lines[i].score;
+                    hint.alternatives.push_back(candidate);
+                }
+            }
+            hint.elapsedMs = static_cast<int>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count());
+            if (!cancelled.load(std::memory_order_acquire)) onDone(hint);
+            finished.store(true, std::memory_order_release);
+        });
+    }
+
+    void HintSearch::cancel() {
+        if (!worker.joinable()) return;
+        cancelled.store(true, std::memory_order_release);
+        search.stop();
+        worker.join();
+    }
+
+} // namespace HardChess
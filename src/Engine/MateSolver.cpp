@@ -0,0 +1,386 @@
+#include "HardChess/Engine/MateSolver.h"
+#include "HardChess/Core/Notation.h"
+#include <algorithm>
+#include <chrono>
+
+namespace HardChess {
+
+    namespace {
+        // A proof or disproof number of this means the other one is 0; sums stop just
+        // short of it, since transpositions are counted once per path and can grow large
+        constexpr std::uint32_t INFINITE_NUMBER = 1u << 30;
+        // Disproofs that hold at any depth: stalemate, being mated
+        constexpr int EXACT_REMAINING = 255;
+
+        std::uint32_t add(std::uint32_t a, std::uint32_t b) {
+            return a >= INFINITE_NUMBER || b >= INFINITE_NUMBER ? INFINITE_NUMBER : std::min(INFINITE_NUMBER - 1, a + b);
+        }
+    } // namespace
+
+    std::string MateResult::describe(const Board& root) const {
+        if (status == MateStatus::NO_MATE) return "No forced mate";
+        if (status == MateStatus::UNKNOWN) return "No mate found in " + std::to_string(nodes) + " nodes";
+        Board board(root);
+        std::vector<Move> moves;
+        std::string text = "Mate in " + std::to_string(mateIn) + (shortest ? ":" : " (shorter mates not ruled out):");
+        for (const Move& move : line) {
+            text += " " + Notation::toSAN(board, move, moves);
+            board.applyMove(move);
+        }
+        return text;
+    }
+
+    MateSolver::MateSolver()
+        : mask(0), entries(0), collections(0), maxPly(0), nodes(0), nodeLimit(0), aborted(false),
+          stopRequested(false) {
+        for (int ply = 0; ply <= MAX_PLY; ++ply) children[ply].reserve(64);
+    }
+
+    void MateSolver::resize(std::size_t memoryMB) {
+        std::size_t wanted = memoryMB * 1024 * 1024 / sizeof(Entry);
+        std::size_t capacity = 1024;
+        while (capacity * 2 <= wanted) capacity *= 2;
+        if (table.size() != capacity) {
+            table.assign(capacity, Entry());
+        } else {
+            std::fill(table.begin(), table.end(), Entry());
+        }
+        mask = capacity - 1;
+        entries = 0;
+    }
+
+    const MateSolver::Entry* MateSolver::probe(std::uint64_t key) const {
+        for (std::size_t slot = key & mask;; slot = (slot + 1) & mask) {
+            const Entry& entry = table[slot];
+            if (!entry.used) return nullptr;
+            if (entry.key == key) return &entry;
+        }
+    }
+
+    void MateSolver::store(std::uint64_t key, std::uint32_t pn, std::uint32_t dn, std::uint16_t distance, int remaining,
+                           std::uint64_t work) {
+        std::size_t slot = key & mask;
+        while (table[slot].used && table[slot].key != key) slot = (slot + 1) & mask;
+        if (!table[slot].used) {
+            // Linear probing degrades long before the table is full
+            if (entries + 1 > table.size() / 4 * 3) {
+                collect();
+                slot = key & mask;
+                while (table[slot].used) slot = (slot + 1) & mask;
+            }
+            ++entries;
+            table[slot].key = key;
+            table[slot].work = 0;
+            table[slot].proof = NO_PROOF;
+            table[slot].disproof = 0;
+            table[slot].used = 1;
+        }
+        Entry& entry = table[slot];
+        entry.pn = pn;
+        entry.dn = dn;
+        if (pn == 0) entry.proof = std::min(entry.proof, distance);
+        if (dn == 0) entry.disproof = static_cast<std::uint8_t>(std::max<int>(entry.disproof, std::min(remaining, EXACT_REMAINING)));
+        entry.work = static_cast<std::uint32_t>(std::min<std::uint64_t>(0xFFFFFFFFu, entry.work + work));
+    }
+
+    // Halves the table: unresolved and disproven positions go first, cheapest to recompute
+    // first; proofs only if nothing else is left. The survivors are rehashed.
+    void MateSolver::collect() {
+        ++collections;
+        std::size_t keep = table.size() / 2;
+        std::vector<Entry> survivors;
+        survivors.reserve(entries);
+        std::vector<std::uint32_t> works;
+        for (const Entry& entry : table) {
+            if (!entry.used) continue;
+            survivors.push_back(entry);
+            if (entry.proof == NO_PROOF) works.push_back(entry.work);
+        }
+        std::size_t drop = survivors.size() > keep ? survivors.size() - keep : 0;
+        if (drop > 0 && drop <= works.size()) {
+            std::nth_element(works.begin(), works.begin() + (drop - 1), works.end());
+            std::uint32_t cutoff = works[drop - 1];
+            std::size_t dropped = 0;
+            auto end = std::remove_if(survivors.begin(), survivors.end(), [&](const Entry& entry) {
+                if (entry.proof != NO_PROOF || entry.work > cutoff || dropped == drop) return false;
+                ++dropped;
+                return true;
+            });
+            survivors.erase(end, survivors.end());
+        } else if (drop > 0) {
+            std::sort(survivors.begin(), survivors.end(),
+                      [](const Entry& a, const Entry& b) {
+                          return (a.proof == NO_PROOF) != (b.proof == NO_PROOF) ? a.proof < b.proof : a.work > b.work;
+                      });
+            survivors.resize(keep);
+        }
+        std::fill(table.begin(), table.end(), Entry());
+        for (const Entry& entry : survivors) {
+            std::size_t slot = entry.key & mask;
+            while (table[slot].used) slot = (slot + 1) & mask;
+            table[slot] = entry;
+        }
+        entries = survivors.size();
+    }
+
+    void MateSolver::value(const Child& child, int remaining, std::uint32_t& pn, std::uint32_t& dn,
+                           std::uint16_t& distance) const {
+        pn = child.pn;
+        dn = child.dn;
+        distance = child.distance;
+        if (child.fixed) return;
+        const Entry* entry = probe(child.key);
+        if (!entry) return;
+        if (entry->proof <= remaining) {
+            pn = 0;
+            dn = INFINITE_NUMBER;
+            distance = entry->proof;
+            return;
+        }
+        if (entry->disproof >= remaining) {
+            pn = INFINITE_NUMBER;
+            dn = 0;
+            return;
+        }
+        // Numbers left by a mate too long for this horizon, or by a disproof found with
+        // fewer plies to spare, say nothing here
+        if (entry->pn == 0 || entry->dn == 0) return;
+        pn = entry->pn;
+        dn = entry->dn;
+    }
+
+    bool MateSolver::expand(Board& board, int ply) {
+        std::vector<Child>& list = children[ply];
+        list.clear();
+        board.generateLegalMoves(scratch);
+        if (scratch.empty()) return false;
+        for (const Move& move : scratch) {
+            Child child;
+            child.move = move;
+            list.push_back(child);
+        }
+
+        bool orNode = ply % 2 == 0;
+        int remaining = maxPly - ply;
+        for (Child& child : list) {
+            MoveUndo undo;
+            board.makeMove(child.move, undo);
+            child.key = board.getKey();
+            child.distance = 0;
+            child.fixed = false;
+            bool check = board.isKingInCheck(board.getSideToMove());
+            history.push(child.key);
+            if (orNode && remaining == 1) {
+                // The horizon: only a mate on this move counts
+                child.fixed = true;
+                bool mate = check && (board.generateLegalMoves(scratch), scratch.empty());
+                child.pn = mate ? 0 : INFINITE_NUMBER;
+                child.dn = mate ? INFINITE_NUMBER : 0;
+                if (mate) store(child.key, 0, INFINITE_NUMBER, 0, EXACT_REMAINING, 1); // For the line
+            } else if (board.isFiftyMoveDraw() || history.isRepetition(board.getHalfmoveClock())) {
+                child.fixed = true;
+                child.pn = INFINITE_NUMBER;
+                child.dn = 0;
+            } else if (orNode) {
+                // Checks leave the defender fewest replies: try them first
+                child.pn = check ? 1 : 3;
+                child.dn = 1;
+            } else {
+                child.pn = 1;
+                child.dn = 1;
+            }
+            history.pop();
+            board.undoMove(child.move, undo);
+        }
+        return true;
+    }
+
+    void MateSolver::search(Board& board, int ply, std::uint32_t thresholdPn, std::uint32_t thresholdDn) {
+        ++nodes;
+        if ((nodeLimit > 0 && nodes >= nodeLimit) || ((nodes & 1023) == 0 && stopRequested.load(std::memory_order_relaxed))) {
+            aborted = true;
+        }
+        if (aborted) return;
+
+        long long startNodes = nodes;
+        bool orNode = ply % 2 == 0;
+        int remaining = maxPly - ply;
+        std::uint64_t key = board.getKey();
+        if (!expand(board, ply)) {
+            // Mated defender: proven; mated attacker or stalemate: disproven at any depth
+            bool mated = board.isKingInCheck(board.getSideToMove());
+            if (mated && !orNode) store(key, 0, INFINITE_NUMBER, 0, EXACT_REMAINING, 1);
+            else store(key, INFINITE_NUMBER, 0, 0, EXACT_REMAINING, 1);
+            return;
+        }
+
+        std::vector<Child>& list = children[ply];
+        while (true) {
+            // OR node (attacker to move): proved by any child, disproved by all.
+            // AND node (defender to move): the reverse.
+            std::uint32_t pn = orNode ? INFINITE_NUMBER : 0;
+            std::uint32_t dn = orNode ? 0 : INFINITE_NUMBER;
+            std::uint32_t second = INFINITE_NUMBER; // Runner-up's deciding number
+            std::uint32_t bestPn = 0, bestDn = 0;
+            std::uint16_t distance = orNode ? NO_PROOF : 0;
+            std::size_t best = 0;
+            for (std::size_t i = 0; i < list.size(); ++i) {
+                std::uint32_t childPn, childDn;
+                std::uint16_t childDistance;
+                value(list[i], remaining - 1, childPn, childDn, childDistance);
+                std::uint32_t deciding = orNode ? childPn : childDn;
+                std::uint32_t current = orNode ? pn : dn;
+                if (deciding < current) {
+                    second = current;
+                    best = i;
+                    bestPn = childPn;
+                    bestDn = childDn;
+                } else if (deciding < second) {
+                    second = deciding;
+                }
+                if (orNode) {
+                    pn = std::min(pn, childPn);
+                    dn = add(dn, childDn);
+                    if (childPn == 0) distance = std::min<std::uint16_t>(distance, childDistance);
+                } else {
+                    pn = add(pn, childPn);
+                    dn = std::min(dn, childDn);
+                    distance = std::max(distance, childDistance);
+                }
+            }
+            if (pn == 0) dn = INFINITE_NUMBER;
+            if (dn == 0) pn = INFINITE_NUMBER;
+            if (pn >= thresholdPn || dn >= thresholdDn || aborted) {
+                store(key, pn, dn, static_cast<std::uint16_t>(distance + 1), remaining,
+                      static_cast<std::uint64_t>(nodes - startNodes + 1));
+                return;
+            }
+
+            // The 1+epsilon trick: the best child may run until it is a quarter worse than
+            // the runner-up, not just one worse, or two children with close numbers hand
+            // the search back and forth after a handful of nodes each
+            std::uint32_t runnerUp = second >= INFINITE_NUMBER ? INFINITE_NUMBER : add(second, std::max(1u, second / 4));
+            std::uint32_t childPn, childDn;
+            if (orNode) {
+                childPn = std::min(thresholdPn, runnerUp);
+                childDn = thresholdDn >= INFINITE_NUMBER ? INFINITE_NUMBER : thresholdDn - dn + bestDn;
+            } else {
+                childDn = std::min(thresholdDn, runnerUp);
+                childPn = thresholdPn >= INFINITE_NUMBER ? INFINITE_NUMBER : thresholdPn - pn + bestPn;
+            }
+            const Move move = list[best].move;
+            MoveUndo undo;
+            board.makeMove(move, undo);
+            history.push(board.getKey());
+            search(board, ply + 1, childPn, childDn);
+            history.pop();
+            board.undoMove(move, undo);
+        }
+    }
+
+    // Follows the proofs: the quickest mate for the attacker, the longest defence. Stored
+    // proofs are only upper bounds on the plies to mate, so every defender reply is
+    // proven again at ever shorter horizons, as solve() does at the root, until its exact
+    // distance is known; a reply the shorter horizons left unproven is proven from scratch
+    // within the plies left. The defence shown is then the longest there is.
+    void MateSolver::extractLine(Board& board, int plies, std::vector<Move>& line) {
+        maxPly = plies;
+        nodeLimit = 0; // Each re-proof is bounded by the horizon, and the mate is already proven
+        aborted = false;
+        std::vector<Move> moves;
+        int pushed = 0;
+        for (int ply = 0; ply < plies && !aborted; ++ply) {
+            board.generateLegalMoves(moves);
+            bool orNode = ply % 2 == 0;
+            int remaining = plies - ply - 1; // Plies to mate the child may take
+            std::size_t chosen = moves.size();
+            int chosenDistance = 0;
+            for (std::size_t i = 0; i < moves.size(); ++i) {
+                MoveUndo undo;
+                board.makeMove(moves[i], undo);
+                const Entry* entry = probe(board.getKey());
+                int distance = entry ? entry->proof : NO_PROOF;
+                if (!orNode) {
+                    std::uint64_t key = board.getKey();
+                    history.push(key);
+                    for (int horizon = distance <= remaining ? distance - 2 : remaining; horizon >= 1 && !aborted;) {
+                        maxPly = ply + 1 + horizon;
+                        search(board, ply + 1, INFINITE_NUMBER, INFINITE_NUMBER);
+                        entry = probe(key);
+                        if (aborted || !entry || entry->pn != 0) break; // The last proof stands
+                        distance = entry->proof;
+                        horizon = distance - 2;
+                    }
+                    history.pop();
+                    maxPly = plies;
+                }
+                board.undoMove(moves[i], undo);
+                if (distance > remaining) {
+                    if (orNode) continue;
+                    chosen = moves.size(); // An unproven defence: no line can be shown past it
+                    break;
+                }
+                if (chosen == moves.size() || (orNode ? distance < chosenDistance : distance > chosenDistance)) {
+                    chosen = i;
+                    chosenDistance = distance;
+                }
+            }
+            if (chosen == moves.size()) break;
+            line.push_back(moves[chosen]);
+            board.applyMove(moves[chosen]);
+            history.push(board.getKey());
+            ++pushed;
+        }
+        while (pushed-- > 0) history.pop();
+    }
+
+    MateResult MateSolver::solve(Board& board, const MateLimits& limits, const RepetitionHistory* gameHistory) {
+        auto begin = std::chrono::steady_clock::now();
+        resize(limits.memoryMB > 0 ? limits.memoryMB : DEFAULT_MEMORY_MB);
+        int maxMoves = limits.maxMoves > 0 ? std::min(limits.maxMoves, MAX_MOVES) : DEFAULT_MAX_MOVES;
+        maxPly = 2 * maxMoves - 1;
+        nodes = 0;
+        nodeLimit = limits.nodes;
+        aborted = false;
+        collections = 0;
+        stopRequested.store(false, std::memory_order_relaxed);
+        if (gameHistory && gameHistory->size() > 0 && gameHistory->current() == board.getKey()) {
+            history = *gameHistory;
+        } else {
+            history.reset(board.getKey());
+        }
+
+        MateResult result;
+        std::uint64_t rootKey = board.getKey();
+        int provenPlies = 0; // Of the last horizon that held a mate
+        while (true) {
+            search(board, 0, INFINITE_NUMBER, INFINITE_NUMBER);
+            const Entry* root = probe(rootKey);
+            if (aborted || !root) break;
+            if (root->pn != 0) {
+                // No mate within this horizon: the last one found is the shortest
+                if (result.status == MateStatus::MATE) result.shortest = true;
+                else result.status = MateStatus::NO_MATE;
+                break;
+            }
+            result.status = MateStatus::MATE;
+            provenPlies = root->proof;
+            if (root->proof <= 1) {
+                result.shortest = true;
+                break;
+            }
+            maxPly = root->proof - 2; // Mates end on the attacker's move, so plies to mate are odd
+        }
+        if (result.status == MateStatus::MATE) {
+            Board line(board);
+            result.mateIn = (provenPlies + 1) / 2;
+            extractLine(line, provenPlies, result.line);
+        }
+        result.nodes = nodes;
+        result.tableEntries = entries;
+        result.collections = collections;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return result;
+    }
+
+} // namespace HardChess
@@ -0,0 +1,157 @@
+#include "HardChess/Engine/OpeningBook.h"
+#include "HardChess/Core/Zobrist.h"
+#include "HardChess/Util/Stats.h"
+#include <vector>
+
+namespace HardChess {
+
+    namespace {
+        std::uint64_t readBigEndian(const unsigned char* in, int bytes) {
+            std::uint64_t value = 0;
+            for (int i = 0; i < bytes; ++i) value = (value << 8) | in[i];
+            return value;
+        }
+
+        void writeBigEndian(std::uint64_t value, unsigned char* out, int bytes) {
+            for (int i = bytes - 1; i >= 0; --i) {
+                out[i] = static_cast<unsigned char>(value & 0xFF);
+                value >>= 8;
+            }
+        }
+
+        int promotionCode(PieceType type) {
+            switch (type) {
+                case PieceType::KNIGHT: return 1;
+                case PieceType::BISHOP: return 2;
+                case PieceType::ROOK: return 3;
+                case PieceType::QUEEN: return 4;
+                default: return 0;
+            }
+        }
+    } // namespace
+
+    OpeningBook::OpeningBook() : count(0) {}
+
+    bool OpeningBook::open(const std::string& path) {
+        close();
+        if (!file.open(path)) return false;
+        if (file.size() % ENTRY_SIZE != 0) {
+            file.close();
+            return false;
+        }
+        count = file.size() / ENTRY_SIZE;
+        return true;
+    }
+
+    void OpeningBook::close() {
+        file.close();
+        count = 0;
+    }
+
+    BookEntry OpeningBook::entryAt(std::size_t i) const {
+        return readEntry(reinterpret_cast<const unsigned char*>(file.data()) + i * ENTRY_SIZE);
+    }
+
+    std::size_t OpeningBook::find(std::uint64_t key, BookEntry* out, std::size_t maxEntries) const {
+        // Lower bound on the key; only the first 8 bytes of each entry are touched
+        const unsigned char* base = reinterpret_cast<const unsigned char*>(file.data());
+        std::size_t low = 0;
+        std::size_t high = count;
+        while (low < high) {
+            std::size_t mid = low + (high - low) / 2;
+            if (readBigEndian(base + mid * ENTRY_SIZE, 8) < key) low = mid + 1;
+            else high = mid;
+        }
+        std::size_t found = 0;
+        for (std::size_t i = low; i < count && found < maxEntries; ++i) {
+            BookEntry entry = entryAt(i);
+            if (entry.key != key) break;
+            out[found++] = entry;
+        }
+        return found;
+    }
+
+    bool OpeningBook::probe(Board& board, std::mt19937_64& rng, Move& move) const {
+        if (count == 0) return false;
+        Stats::count(Stats::Counter::BOOK_PROBES);
+        BookEntry entries[MAX_MOVES];
+        std::size_t found = find(Zobrist::hash(board), entries, MAX_MOVES);
+
+        Move candidates[MAX_MOVES];
+        std::uint32_t weights[MAX_MOVES];
+        std::size_t usable = 0;
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i < found; ++i) {
+            if (entries[i].weight == 0 || !decodeMove(entries[i].move, board, candidates[usable])) continue;
+            weights[usable] = entries[i].weight;
+            total += entries[i].weight;
+            ++usable;
+        }
+        if (usable == 0) return false;
+        Stats::count(Stats::Counter::BOOK_HITS);
+
+        std::uint64_t pick = std::uniform_int_distribution<std::uint64_t>(0, total - 1)(rng);
+        for (std::size_t i = 0; i < usable; ++i) {
+            if (pick < weights[i]) {
+                move = candidates[i];
+                return true;
+            }
+            pick -= weights[i];
+        }
+        move = candidates[usable - 1];
+        return true;
+    }
+
+    std::uint16_t OpeningBook::encodeMove(const Move& move) {
+        Position to = move.to;
+        if (move.isCastle()) to.col = to.col == 6 ? 7 : 0;
+        return static_cast<std::uint16_t>(to.col | ((7 - to.row) << 3) | (move.from.col << 6) |
+                                          ((7 - move.from.row) << 9) | (promotionCode(move.promotion) << 12));
+    }
+
+    bool OpeningBook::decodeMove(std::uint16_t code, Board& board, Move& move) {
+        static const PieceType promotions[8] = {PieceType::NONE, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK,
+                                                PieceType::QUEEN, PieceType::NONE, PieceType::NONE, PieceType::NONE};
+        Position to(7 - ((code >> 3) & 7), code & 7);
+        Position from(7 - ((code >> 9) & 7), (code >> 6) & 7);
+        PieceType promotion = promotions[(code >> 12) & 7];
+
+        const Piece* mover = board.getPiecePtr(from);
+        if (!mover || mover->getColor() != board.getSideToMove()) return false;
+        // King onto its own rook is polyglot's castling notation
+        const Piece* target = board.getPiecePtr(to);
+        if (mover->getType() == PieceType::KING && target && target->getColor() == mover->getColor() &&
+            target->getType() == PieceType::ROOK && from.row == to.row && from.col == 4) {
+            to.col = to.col == 7 ? 6 : 2;
+        }
+
+        std::vector<Move> pseudo;
+        pseudo.reserve(64);
+        board.generatePseudoLegalMoves(pseudo);
+        for (const Move& candidate : pseudo) {
+            if (candidate.from == from && candidate.to == to && candidate.promotion == promotion &&
+                board.isLegalMove(candidate)) {
+                move = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void OpeningBook::writeEntry(const BookEntry& entry, unsigned char* out) {
+        writeBigEndian(entry.key, out, 8);
+        writeBigEndian(entry.move, out + 8, 2);
+        writeBigEndian(entry.weight, out + 10, 2);
+        writeBigEndian(entry.learn, out + 12, 4);
+    }
+
+    BookEntry OpeningBook::readEntry(const unsigned char* in) {
+        BookEntry entry;
+        entry.key = readBigEndian(in, 8);
+        entry.move = static_cast<std::uint16_t>(readBigEndian(in + 8, 2));
+        entry.weight = static_cast<std::uint16_t>(readBigEndian(in + 10, 2));
+        entry.learn = static_cast<std::uint32_t>(readBigEndian(in + 12, 4));
+        return entry;
+    }
+
+} // namespace HardChess
@@ -0,0 +1,336 @@
+#include "HardChess/Engine/Search.h"
+#include "HardChess/Engine/Evaluation.h"
+#include "HardChess/Util/Stats.h"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace HardChess {
+
+    namespace {
+        Color opposite(Color color) {
+            return color == Color::WHITE ? Color::BLACK : Color::WHITE;
+        }
+
+        constexpr int INFINITE_SCORE = Search::MATE_SCORE + 1;
+    } // namespace
+
+    Search::Search()
+        : hashMoves(std::size_t(1) << HASH_MOVE_BITS, HashMove{0, 0, 0, 0}), generation(0), nodes(0), aborted(false),
+          stopRequested(false), scratch(nullptr) {
+        for (int ply = 0; ply <= MAX_PLY; ++ply) {
+            moveLists[ply].reserve(128);
+            orderScores[ply] = nullptr;
+            pvLength[ply] = 0;
+        }
+        previousPv.reserve(MAX_PLY + 1);
+    }
+
+    int Search::mateInMoves(int score) {
+        if (score > MATE_BOUND) return (MATE_SCORE - score + 1) / 2;
+        if (score < -MATE_BOUND) return -((MATE_SCORE + score) / 2);
+        return 0;
+    }
+
+    SearchResult Search::run(Board& board, const SearchLimits& searchLimits, const RepetitionHistory* gameHistory) {
+        limits = searchLimits;
+        scratch = &Arena::local();
+        Arena::Scope searchScope(*scratch);
+        nodes = 0;
+        aborted = false;
+        previousPv.clear();
+        if (++generation == 0) {
+            // Wrapped: entries stored 256 searches ago would pass for this search's
+            std::fill(hashMoves.begin(), hashMoves.end(), HashMove{0, 0, 0, 0});
+            generation = 1;
+        }
+        if (gameHistory && gameHistory->size() > 0 && gameHistory->current() == board.getKey()) {
+            history = *gameHistory;
+        } else {
+            history.reset(board.getKey());
+        }
+        if (limits.timeMs > 0) {
+            deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(limits.timeMs);
+        }
+
+        SearchResult result;
+        std::vector<Move>& legalMoves = moveLists[0];
+        board.generateLegalMoves(legalMoves);
+        if (legalMoves.empty()) {
+            result.score = board.isKingInCheck(board.getSideToMove()) ? -MATE_SCORE : 0;
+            return result;
+        }
+        // Something sensible to return even if the first iteration is interrupted
+        result.bestMove = legalMoves[0];
+        result.hasMove = true;
+
+        // The first iteration takes the root moves in the usual move order; later ones sort
+        // them by score
+        orderMoves(board, 0);
+        rootMoves.resize(legalMoves.size());
+        for (std::size_t i = 0; i < legalMoves.size(); ++i) {
+            pickNext(0, i);
+            RootMove& root = rootMoves[i];
+            root.move = legalMoves[i];
+            root.score = root.iterationScore = -INFINITE_SCORE;
+            root.depth = 0;
+            root.nodes = 0;
+            root.pv.clear();
+            root.iterationPv.clear();
+            // Room for any PV up front, or lines swapped between the two would keep growing
+            root.pv.reserve(MAX_PLY + 1);
+            root.iterationPv.reserve(MAX_PLY + 1);
+        }
+        int lines = std::max(1, std::min(limits.multiPv, static_cast<int>(rootMoves.size())));
+        bestScores.reserve(static_cast<std::size_t>(lines) + 1); // Holds one score past the top K
+
+        int maxDepth = limits.depth > 0 ? limits.depth : MAX_PLY - 1;
+        for (int depth = 1; depth <= maxDepth; ++depth) {
+            searchRoot(board, depth, lines);
+            if (aborted) break;
+
+            result.score = rootMoves[0].score;
+            result.depth = depth;
+            result.bestMove = rootMoves[0].move;
+
+            // Forced mates within the horizon will not change with more depth
+            bool settled = true;
+            for (int i = 0; i < lines; ++i) {
+                settled = settled && (rootMoves[i].score > MATE_BOUND || rootMoves[i].score < -MATE_BOUND);
+            }
+            if (settled) break;
+        }
+        if (result.depth > 0) {
+            // Copied out once: the returned vectors are all this search allocates
+            result.pv = rootMoves[0].pv;
+            result.lines.resize(static_cast<std::size_t>(lines));
+            for (int i = 0; i < lines; ++i) {
+                SearchLine& line = result.lines[i];
+                line.move = rootMoves[i].move;
+                line.score = rootMoves[i].score;
+                line.depth = rootMoves[i].depth;
+                line.nodes = rootMoves[i].nodes;
+                line.pv = rootMoves[i].pv;
+            }
+        }
+        result.nodes = nodes;
+        Stats::count(Stats::Counter::SEARCH_NODES, static_cast<std::uint64_t>(nodes));
+        return result;
+    }
+
+    bool Search::shouldStop() {
+        if (aborted) return true;
+        if ((nodes & 1023) != 0) return false;
+        if (stopRequested.load(std::memory_order_relaxed) || (limits.nodes > 0 && nodes >= limits.nodes) ||
+            (limits.timeMs > 0 && std::chrono::steady_clock::now() >= deadline)) {
+            aborted = true;
+        }
+        return aborted;
+    }
+
+    std::uint16_t Search::probeHashMove(std::uint64_t key) const {
+        const HashMove& entry = hashMoves[key & ((std::size_t(1) << HASH_MOVE_BITS) - 1)];
+        return entry.generation == generation && entry.check == static_cast<std::uint32_t>(key >> 32) ? entry.move : 0;
+    }
+
+    void Search::storeHashMove(std::uint64_t key, const Move& move, int depth) {
+        HashMove& entry = hashMoves[key & ((std::size_t(1) << HASH_MOVE_BITS) - 1)];
+        std::uint32_t check = static_cast<std::uint32_t>(key >> 32);
+        // Another position's deeper result from this search is worth more for ordering
+        if (entry.generation == generation && entry.check != check && entry.depth > depth) return;
+        entry.check = check;
+        entry.move = move.encode();
+        entry.generation = generation;
+        entry.depth = static_cast<std::uint8_t>(std::max(0, std::min(255, depth)));
+    }
+
+    void Search::searchRoot(Board& board, int depth, int lines) {
+        int iteration = depth;
+        ++nodes;
+        if (shouldStop()) return;
+        if (board.isKingInCheck(board.getSideToMove())) ++depth; // Check extension, as in negamax
+
+        bestScores.clear();
+        for (RootMove& root : rootMoves) {
+            // A move has to beat the K-th best score so far to make the top K; below it,
+            // failing low is all that needs showing
+            int alpha = static_cast<int>(bestScores.size()) < lines ? -INFINITE_SCORE : bestScores[lines - 1];
+            previousPv = root.pv.empty() ? rootMoves[0].pv : root.pv;
+
+            long long before = nodes;
+            MoveUndo undo;
+            board.makeMove(root.move, undo);
+            history.push(board.getKey());
+            int score = -negamax(board, depth - 1, -INFINITE_SCORE, -alpha, 1);
+            history.pop();
+            board.undoMove(root.move, undo);
+            root.nodes += nodes - before;
+            if (aborted) return;
+
+            root.iterationScore = score;
+            root.iterationPv.clear();
+            if (score > alpha) {
+                root.iterationPv.push_back(root.move);
+                root.iterationPv.insert(root.iterationPv.end(), pvTable[1], pvTable[1] + pvLength[1]);
+                bestScores.insert(std::upper_bound(bestScores.begin(), bestScores.end(), score, std::greater<int>()),
+                                  score);
+                if (static_cast<int>(bestScores.size()) > lines) bestScores.pop_back();
+            }
+        }
+
+        // Complete: commit the iteration. Failing low leaves a move's last exact line in
+        // place to guide the next iteration, under a score that ranks it below the top K.
+        for (RootMove& root : rootMoves) {
+            root.score = root.iterationScore;
+            if (!root.iterationPv.empty()) {
+                root.pv.swap(root.iterationPv);
+                root.depth = iteration;
+            }
+        }
+        // Stable, best first, and in place: std::stable_sort would take a buffer from the
+        // heap every iteration. The moves arrive nearly sorted from the last iteration.
+        for (auto next = rootMoves.begin() + 1; next < rootMoves.end(); ++next) {
+            auto slot = std::upper_bound(rootMoves.begin(), next, *next,
+                                         [](const RootMove& a, const RootMove& b) { return a.score > b.score; });
+            std::rotate(slot, next, next + 1);
+        }
+    }
+
+    void Search::orderMoves(const Board& board, int ply, std::uint16_t hashMove) {
+        const std::vector<Move>& moves = moveLists[ply];
+        int* scores = orderScores[ply] = scratch->allocateArray<int>(moves.size());
+        bool hasPvMove = ply < static_cast<int>(previousPv.size());
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            const Move& move = moves[i];
+            int score = 0;
+            if (hasPvMove && move == previousPv[ply]) {
+                score = 1000000;
+            } else if (hashMove != 0 && move.encode() == hashMove) {
+                score = 900000;
+            } else if (move.isCapture()) {
+                // Most valuable victim, least valuable attacker
+                const Piece* victim = board.getPiecePtr(move.to);
+                int victimValue = victim ? Evaluation::pieceValues[static_cast<int>(victim->getType())] : 100;
+                int attackerValue = Evaluation::pieceValues[static_cast<int>(board.getPiecePtr(move.from)->getType())];
+                score = 100000 + victimValue * 10 - attackerValue / 10;
+            }
+            if (move.promotion != PieceType::NONE) {
+                score += 50000 + Evaluation::pieceValues[static_cast<int>(move.promotion)];
+            }
+            scores[i] = score;
+        }
+    }
+
+    void Search::pickNext(int ply, std::size_t index) {
+        std::vector<Move>& moves = moveLists[ply];
+        int* scores = orderScores[ply];
+        std::size_t best = index;
+        for (std::size_t i = index + 1; i < moves.size(); ++i) {
+            if (scores[i] > scores[best]) best = i;
+        }
+        if (best != index) {
+            std::swap(moves[index], moves[best]);
+            std::swap(scores[index], scores[best]);
+        }
+    }
+
+    int Search::negamax(Board& board, int depth, int alpha, int beta, int ply) {
+        pvLength[ply] = 0;
+        if (ply > 0 && (board.isFiftyMoveDraw() || history.isRepetition(board.getHalfmoveClock()))) return 0;
+        Color us = board.getSideToMove();
+        bool inCheck = board.isKingInCheck(us);
+        if (inCheck && ply < MAX_PLY / 2) ++depth; // Check extension
+
+        if (depth <= 0 || ply >= MAX_PLY) return quiescence(board, alpha, beta, ply);
+
+        ++nodes;
+        if (shouldStop()) return 0;
+
+        std::vector<Move>& moves = moveLists[ply];
+        moves.clear();
+        board.generatePseudoLegalMoves(moves);
+        Arena::Scope nodeScope(*scratch);
+        std::uint64_t key = board.getKey();
+        orderMoves(board, ply, probeHashMove(key));
+
+        int legalMoves = 0;
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            pickNext(ply, i);
+            Move move = moves[i];
+            MoveUndo undo;
+            board.makeMove(move, undo);
+            if (board.isSquareAttacked(board.findKing(us), opposite(us))) {
+                board.undoMove(move, undo);
+                continue;
+            }
+            ++legalMoves;
+            history.push(board.getKey());
+            int score = -negamax(board, depth - 1, -beta, -alpha, ply + 1);
+            history.pop();
+            board.undoMove(move, undo);
+            if (aborted) return 0;
+
+            if (score > alpha) {
+                alpha = score;
+                pvTable[ply][0] = move;
+                for (int j = 0; j < pvLength[ply + 1]; ++j) pvTable[ply][j + 1] = pvTable[ply + 1][j];
+                pvLength[ply] = pvLength[ply + 1] + 1;
+                if (alpha >= beta) break;
+            }
+        }
+
+        if (legalMoves == 0) {
+            return inCheck ? -MATE_SCORE + ply : 0;
+        }
+        if (pvLength[ply] > 0) storeHashMove(key, pvTable[ply][0], depth);
+        return alpha;
+    }
+
+    int Search::quiescence(Board& board, int alpha, int beta, int ply) {
+        pvLength[ply] = 0;
+        ++nodes;
+        if (shouldStop()) return 0;
+
+        int standPat = Evaluation::evaluate(board);
+        if (ply >= MAX_PLY) return standPat;
+        if (standPat >= beta) return standPat;
+        if (standPat > alpha) alpha = standPat;
+
+        Color us = board.getSideToMove();
+        std::vector<Move>& moves = moveLists[ply];
+        moves.clear();
+        board.generatePseudoLegalMoves(moves);
+        // Only captures and promotions are searched past the horizon
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            if (moves[i].isCapture() || moves[i].promotion != PieceType::NONE) moves[kept++] = moves[i];
+        }
+        moves.resize(kept);
+        Arena::Scope nodeScope(*scratch);
+        orderMoves(board, ply);
+
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            pickNext(ply, i);
+            Move move = moves[i];
+            MoveUndo undo;
+            board.makeMove(move, undo);
+            if (board.isSquareAttacked(board.findKing(us), opposite(us))) {
+                board.undoMove(move, undo);
+                continue;
+            }
+            int score = -quiescence(board, -beta, -alpha, ply + 1);
+            board.undoMove(move, undo);
+            if (aborted) return 0;
+
+            if (score > alpha) {
+                alpha = score;
+                pvTable[ply][0] = move;
+                for (int j = 0; j < pvLength[ply + 1]; ++j) pvTable[ply][j + 1] = pvTable[ply + 1][j];
+                pvLength[ply] = pvLength[ply + 1] + 1;
+                if (alpha >= beta) break;
+            }
+        }
+        return alpha;
+    }
+
+} // namespace HardChess
@@ -0,0 +1,451 @@
+#include "HardChess/Engine/Tablebase.h"
+#include "HardChess/IO/BufferedWriter.h"
+#include "HardChess/Util/Stats.h"
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+
+namespace HardChess {
+
+    namespace {
+        const char tableMagic[4] = {'H', 'C', 'T', 'B'};
+
+        struct TableHeader {
+            char magic[4];
+            std::uint32_t version;
+            char name[16];
+            std::uint64_t entryCount;
+        };
+        static_assert(sizeof(TableHeader) == Tablebase::HEADER_SIZE, "table header layout");
+
+        // Order within a side: Q, R, B, N, P
+        int strength(PieceType type) {
+            switch (type) {
+                case PieceType::QUEEN: return 5;
+                case PieceType::ROOK: return 4;
+                case PieceType::BISHOP: return 3;
+                case PieceType::KNIGHT: return 2;
+                case PieceType::PAWN: return 1;
+                default: return 0;
+            }
+        }
+
+        char letter(PieceType type) {
+            switch (type) {
+                case PieceType::QUEEN: return 'Q';
+                case PieceType::ROOK: return 'R';
+                case PieceType::BISHOP: return 'B';
+                case PieceType::KNIGHT: return 'N';
+                case PieceType::PAWN: return 'P';
+                default: return 'K';
+            }
+        }
+
+        // Positive if side a (strongest-first list) outweighs side b
+        int compareSides(const PieceType* a, int countA, const PieceType* b, int countB) {
+            for (int i = 0; i < countA && i < countB; ++i) {
+                if (strength(a[i]) != strength(b[i])) return strength(a[i]) - strength(b[i]);
+            }
+            return countA - countB;
+        }
+
+        void sortStrongestFirst(PieceType* types, int* squares, int count) {
+            for (int i = 1; i < count; ++i) {
+                for (int j = i; j > 0 && strength(types[j]) > strength(types[j - 1]); --j) {
+                    std::swap(types[j], types[j - 1]);
+                    if (squares) std::swap(squares[j], squares[j - 1]);
+                }
+            }
+        }
+
+        // White king slots: the a1-d1-d4 triangle for pawnless tables, files a-d otherwise.
+        // Built at compile time, so no static initializer runs and none can run late.
+        struct KingSlots {
+            int triangle[64] = {};
+            int triangleSquare[10] = {};
+            int half[64] = {};
+            int halfSquare[32] = {};
+
+            constexpr KingSlots() {
+                int slot = 0;
+                for (int sq = 0; sq < 64; ++sq) {
+                    int file = sq & 7;
+                    int rank = sq >> 3;
+                    triangle[sq] = -1;
+                    half[sq] = file < 4 ? rank * 4 + file : -1;
+                    if (file < 4) halfSquare[rank * 4 + file] = sq;
+                }
+                for (int rank = 0; rank < 4; ++rank) {
+                    for (int file = rank; file < 4; ++file) {
+                        triangle[rank * 8 + file] = slot;
+                        triangleSquare[slot++] = rank * 8 + file;
+                    }
+                }
+            }
+        };
+
+        constexpr KingSlots kingSlots;
+
+        int transposed(int sq) {
+            return ((sq & 7) << 3) | (sq >> 3);
+        }
+
+        // Identical pieces of one side are ordered by square so each position has one index
+        void orderIdenticalPieces(TbPosition& position) {
+            for (int i = 3; i < position.men; ++i) {
+                for (int j = i; j > 2 && position.types[j] == position.types[j - 1] &&
+                                position.colors[j] == position.colors[j - 1] && position.squares[j] < position.squares[j - 1];
+                     --j) {
+                    std::swap(position.squares[j], position.squares[j - 1]);
+                }
+            }
+        }
+
+        bool validHeader(const char* data, std::size_t size, TbMaterial& material) {
+            if (size < sizeof(TableHeader)) return false;
+            TableHeader header;
+            std::memcpy(&header, data, sizeof(header));
+            if (std::memcmp(header.magic, tableMagic, sizeof(tableMagic)) != 0 || header.version != Tablebase::VERSION) {
+                return false;
+            }
+            std::size_t nameLength = strnlen(header.name, sizeof(header.name));
+            if (!TbMaterial::parse(std::string_view(header.name, nameLength), material) || !material.isCanonical()) {
+                return false;
+            }
+            return header.entryCount == material.entryCount() && size == sizeof(TableHeader) + header.entryCount;
+        }
+    } // namespace
+
+    bool TbMaterial::parse(std::string_view name, TbMaterial& material) {
+        material = TbMaterial();
+        std::size_t split = name.find('v');
+        if (split == std::string_view::npos) return false;
+        std::string_view sides[2] = {name.substr(0, split), name.substr(split + 1)};
+        for (int s = 0; s < 2; ++s) {
+            if (sides[s].empty() || sides[s][0] != 'K' || sides[s].size() > 4) return false;
+            for (std::size_t i = 1; i < sides[s].size(); ++i) {
+                PieceType type;
+                switch (sides[s][i]) {
+                    case 'Q': type = PieceType::QUEEN; break;
+                    case 'R': type = PieceType::ROOK; break;
+                    case 'B': type = PieceType::BISHOP; break;
+                    case 'N': type = PieceType::KNIGHT; break;
+                    case 'P': type = PieceType::PAWN; break;
+                    default: return false;
+                }
+                material.pieces[s][material.counts[s]++] = type;
+            }
+            sortStrongestFirst(material.pieces[s], nullptr, material.counts[s]);
+        }
+        return material.men() <= Tablebase::MAX_MEN;
+    }
+
+    std::string TbMaterial::name() const {
+        std::string text = "K";
+        for (int i = 0; i < counts[0]; ++i) text += letter(pieces[0][i]);
+        text += "vK";
+        for (int i = 0; i < counts[1]; ++i) text += letter(pieces[1][i]);
+        return text;
+    }
+
+    std::uint32_t TbMaterial::key() const {
+        std::uint32_t value = 0;
+        for (int s = 0; s < 2; ++s) {
+            for (int i = 0; i < counts[s]; ++i) value += 1u << (s * 10 + (strength(pieces[s][i]) - 1) * 2);
+        }
+        return value;
+    }
+
+    bool TbMaterial::hasPawns() const {
+        for (int s = 0; s < 2; ++s) {
+            for (int i = 0; i < counts[s]; ++i) {
+                if (pieces[s][i] == PieceType::PAWN) return true;
+            }
+        }
+        return false;
+    }
+
+    bool TbMaterial::isCanonical() const {
+        return compareSides(pieces[0], counts[0], pieces[1], counts[1]) >= 0;
+    }
+
+    TbMaterial TbMaterial::canonical() const {
+        TbMaterial result = *this;
+        sortStrongestFirst(result.pieces[0], nullptr, result.counts[0]);
+        sortStrongestFirst(result.pieces[1], nullptr, result.counts[1]);
+        if (!result.isCanonical()) {
+            std::swap(result.pieces[0], result.pieces[1]);
+            std::swap(result.counts[0], result.counts[1]);
+        }
+        return result;
+    }
+
+    std::size_t TbMaterial::entryCount() const {
+        std::size_t count = hasPawns() ? 32 : 10;
+        for (int i = 1; i < men(); ++i) count *= 64;
+        return count * 2;
+    }
+
+    TbMaterial TbPosition::material() const {
+        TbMaterial material;
+        for (int i = 0; i < men; ++i) {
+            if (types[i] == PieceType::KING) continue;
+            int side = colors[i] == Color::WHITE ? 0 : 1;
+            material.pieces[side][material.counts[side]++] = types[i];
+        }
+        sortStrongestFirst(material.pieces[0], nullptr, material.counts[0]);
+        sortStrongestFirst(material.pieces[1], nullptr, material.counts[1]);
+        return material;
+    }
+
+    bool TbPosition::fromBoard(const Board& board, TbPosition& position) {
+        if (board.getCastlingRights() != NO_CASTLING) return false;
+        position.men = 0;
+        int kings = 0;
+        for (int r = 0; r < 8; ++r) {
+            for (int c = 0; c < 8; ++c) {
+                const Piece* piece = board.getPiecePtr(Position(r, c));
+                if (!piece) continue;
+                if (position.men == Tablebase::MAX_MEN) return false;
+                position.types[position.men] = piece->getType();
+                position.colors[position.men] = piece->getColor();
+                position.squares[position.men] = (7 - r) * 8 + c;
+                ++position.men;
+                if (piece->getType() == PieceType::KING) ++kings;
+            }
+        }
+        if (kings != 2) return false;
+        position.sideToMove = board.getSideToMove();
+
+        // Tables do not know about en passant; only a capturable en passant square matters
+        Position ep = board.getEnPassantSquare();
+        if (ep.isValid()) {
+            int pawnRow = ep.row + (position.sideToMove == Color::WHITE ? 1 : -1);
+            for (int dc = -1; dc <= 1; dc += 2) {
+                const Piece* pawn = board.getPiecePtr(Position(pawnRow, ep.col + dc));
+                if (pawn && pawn->getType() == PieceType::PAWN && pawn->getColor() == position.sideToMove) return false;
+            }
+        }
+        return true;
+    }
+
+    Tablebase::Tablebase() : largestTable(0) {}
+
+    bool Tablebase::load(const std::string& path) {
+        std::unique_ptr<Table> table(new Table());
+        if (!table->file.open(path) || !validHeader(table->file.data(), table->file.size(), table->material)) {
+            return false;
+        }
+        std::uint32_t key = table->material.key();
+        if (byKey.count(key)) return true; // Already loaded from another file
+        table->values = reinterpret_cast<const std::uint8_t*>(table->file.data()) + HEADER_SIZE;
+        table->count = table->file.size() - HEADER_SIZE;
+        if (table->material.men() > largestTable) largestTable = table->material.men();
+        byKey[key] = table.get();
+        tables.push_back(std::move(table));
+        return true;
+    }
+
+    bool Tablebase::open(const std::string& directory) {
+        DIR* dir = opendir(directory.c_str());
+        if (!dir) return false;
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.size() > 5 && name.compare(name.size() - 5, 5, ".hctb") == 0) load(directory + "/" + name);
+        }
+        closedir(dir);
+        return !tables.empty();
+    }
+
+    bool Tablebase::lookup(const TbPosition& position, std::uint8_t& value) const {
+        if (position.men == 2) {
+            value = TbValue::DRAW; // Bare kings
+            return true;
+        }
+        TbPosition canonical = position;
+        canonicalize(canonical);
+        auto found = byKey.find(canonical.material().key());
+        if (found == byKey.end()) return false;
+        value = found->second->values[index(canonical)];
+        return value != TbValue::INVALID;
+    }
+
+    bool Tablebase::probe(const Board& board, TbResult& result) const {
+        TbPosition position;
+        std::uint8_t value;
+        Stats::count(Stats::Counter::TABLEBASE_PROBES);
+        if (!TbPosition::fromBoard(board, position) || !lookup(position, value)) return false;
+        Stats::count(Stats::Counter::TABLEBASE_HITS);
+        if (TbValue::isDecisive(value)) {
+            result.outcome = TbValue::isWin(value) ? TbOutcome::WIN : TbOutcome::LOSS;
+            result.plies = TbValue::plies(value);
+        } else {
+            result.outcome = TbOutcome::DRAW;
+            result.plies = 0;
+        }
+        return true;
+    }
+
+    bool Tablebase::bestMove(Board& board, Move& move, TbResult& result) const {
+        if (!probe(board, result)) return false;
+        std::vector<Move> moves;
+        board.generateLegalMoves(moves);
+
+        // Rank children from the mover's point of view: faster wins, then draws, then slower losses
+        int bestRank = -1000;
+        for (const Move& candidate : moves) {
+            MoveUndo undo;
+            board.makeMove(candidate, undo);
+            TbResult child;
+            bool known = probe(board, child);
+            board.undoMove(candidate, undo);
+            if (!known) return false; // A table the line depends on is missing
+            int rank;
+            if (child.outcome == TbOutcome::LOSS) rank = 500 - child.plies;
+            else if (child.outcome == TbOutcome::DRAW) rank = 0;
+            else rank = child.plies - 500;
+            if (rank > bestRank) {
+                bestRank = rank;
+                move = candidate;
+            }
+        }
+        return !moves.empty();
+    }
+
+    void Tablebase::canonicalize(TbPosition& position) {
+        PieceType types[2][3];
+        int squares[2][3];
+        int counts[2] = {0, 0};
+        int kings[2] = {0, 0};
+        for (int i = 0; i < position.men; ++i) {
+            int side = position.colors[i] == Color::WHITE ? 0 : 1;
+            if (position.types[i] == PieceType::KING) {
+                kings[side] = position.squares[i];
+            } else {
+                types[side][counts[side]] = position.types[i];
+                squares[side][counts[side]++] = position.squares[i];
+            }
+        }
+        sortStrongestFirst(types[0], squares[0], counts[0]);
+        sortStrongestFirst(types[1], squares[1], counts[1]);
+
+        // Stronger side plays White: swap colors and mirror the ranks
+        int white = 0;
+        int flip = 0;
+        if (compareSides(types[0], counts[0], types[1], counts[1]) < 0) {
+            white = 1;
+            flip = 56;
+            position.sideToMove = position.sideToMove == Color::WHITE ? Color::BLACK : Color::WHITE;
+        }
+        int black = 1 - white;
+
+        int n = 0;
+        position.types[n] = PieceType::KING;
+        position.colors[n] = Color::WHITE;
+        position.squares[n++] = kings[white] ^ flip;
+        position.types[n] = PieceType::KING;
+        position.colors[n] = Color::BLACK;
+        position.squares[n++] = kings[black] ^ flip;
+        for (int i = 0; i < counts[white]; ++i) {
+            position.types[n] = types[white][i];
+            position.colors[n] = Color::WHITE;
+            position.squares[n++] = squares[white][i] ^ flip;
+        }
+        for (int i = 0; i < counts[black]; ++i) {
+            position.types[n] = types[black][i];
+            position.colors[n] = Color::BLACK;
+            position.squares[n++] = squares[black][i] ^ flip;
+        }
+
+        // Symmetry: bring the White king to files a-d, then (no pawns) ranks 1-4 and below the diagonal
+        bool pawns = false;
+        for (int i = 2; i < n; ++i) pawns = pawns || position.types[i] == PieceType::PAWN;
+        int king = position.squares[0];
+        bool mirrorFiles = (king & 7) > 3;
+        bool mirrorRanks = !pawns && (king >> 3) > 3;
+        if (mirrorFiles) king ^= 7;
+        if (mirrorRanks) king ^= 56;
+        bool transpose = !pawns && (king >> 3) > (king & 7);
+        for (int i = 0; i < n; ++i) {
+            int sq = position.squares[i];
+            if (mirrorFiles) sq ^= 7;
+            if (mirrorRanks) sq ^= 56;
+            if (transpose) sq = transposed(sq);
+            position.squares[i] = sq;
+        }
+        orderIdenticalPieces(position);
+
+        // A king on the diagonal leaves the transposition open: take the smaller of the two
+        if (!pawns && (king >> 3) == (king & 7)) {
+            TbPosition other = position;
+            for (int i = 1; i < n; ++i) other.squares[i] = transposed(other.squares[i]);
+            orderIdenticalPieces(other);
+            if (std::lexicographical_compare(other.squares + 1, other.squares + n, position.squares + 1, position.squares + n)) {
+                position = other;
+            }
+        }
+    }
+
+    std::size_t Tablebase::index(const TbPosition& position) {
+        bool pawns = false;
+        for (int i = 2; i < position.men; ++i) pawns = pawns || position.types[i] == PieceType::PAWN;
+        std::size_t value = static_cast<std::size_t>(pawns ? kingSlots.half[position.squares[0]]
+                                                           : kingSlots.triangle[position.squares[0]]);
+        for (int i = 1; i < position.men; ++i) value = value * 64 + static_cast<std::size_t>(position.squares[i]);
+        return value * 2 + (position.sideToMove == Color::WHITE ? 0 : 1);
+    }
+
+    void Tablebase::decode(const TbMaterial& material, std::size_t index, TbPosition& position) {
+        position.men = material.men();
+        position.sideToMove = (index & 1) ? Color::BLACK : Color::WHITE;
+        index >>= 1;
+        int n = 0;
+        position.types[n] = PieceType::KING;
+        position.colors[n++] = Color::WHITE;
+        position.types[n] = PieceType::KING;
+        position.colors[n++] = Color::BLACK;
+        for (int s = 0; s < 2; ++s) {
+            for (int i = 0; i < material.counts[s]; ++i) {
+                position.types[n] = material.pieces[s][i];
+                position.colors[n++] = s == 0 ? Color::WHITE : Color::BLACK;
+            }
+        }
+        for (int i = position.men - 1; i >= 1; --i) {
+            position.squares[i] = static_cast<int>(index & 63);
+            index >>= 6;
+        }
+        position.squares[0] = material.hasPawns() ? kingSlots.halfSquare[index] : kingSlots.triangleSquare[index];
+    }
+
+    std::string Tablebase::fileName(const TbMaterial& material) {
+        return material.name() + ".hctb";
+    }
+
+    bool Tablebase::writeTable(const std::string& path, const TbMaterial& material, const std::uint8_t* values,
+                               std::size_t count) {
+        TableHeader header = {};
+        std::memcpy(header.magic, tableMagic, sizeof(tableMagic));
+        header.version = VERSION;
+        std::string name = material.name();
+        std::memcpy(header.name, name.data(), std::min(name.size(), sizeof(header.name)));
+        header.entryCount = count;
+
+        BufferedWriter out;
+        if (!out.open(path)) return false;
+        out.write(&header, sizeof(header));
+        out.write(values, count);
+        return out.close();
+    }
+
+    bool Tablebase::readTable(const std::string& path, const TbMaterial& material, std::vector<std::uint8_t>& values) {
+        MappedFile file;
+        TbMaterial stored;
+        if (!file.open(path) || !validHeader(file.data(), file.size(), stored) || stored.key() != material.key()) {
+            return false;
+        }
+        const std::uint8_t* begin = reinterpret_cast<const std::uint8_t*>(file.data()) + HEADER_SIZE;
+        values.assign(begin, begin + (file.size() - HEADER_SIZE));
+        return true;
+    }
+
+} // namespace HardChess
@@ -0,0 +1,458 @@
+#include "HardChess/Engine/TablebaseGenerator.h"
+#include "HardChess/Util/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace HardChess {
+
+    namespace {
+        const int kingSteps[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+        const int knightSteps[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+        const int rookDirections[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+        const int bishopDirections[4][2] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+        const PieceType promotions[4] = {PieceType::QUEEN, PieceType::ROOK, PieceType::BISHOP, PieceType::KNIGHT};
+
+        Color opposite(Color color) {
+            return color == Color::WHITE ? Color::BLACK : Color::WHITE;
+        }
+
+        // Squares here are a1 = 0 .. h8 = 63: rank = sq >> 3, file = sq & 7
+        bool onBoard(int rank, int file) {
+            return rank >= 0 && rank < 8 && file >= 0 && file < 8;
+        }
+
+        struct Occupancy {
+            int piece[64]; // Index into TbPosition, -1 if empty
+
+            explicit Occupancy(const TbPosition& position) {
+                std::fill(piece, piece + 64, -1);
+                for (int i = 0; i < position.men; ++i) piece[position.squares[i]] = i;
+            }
+        };
+
+        bool attacks(const TbPosition& position, const Occupancy& occupancy, int i, int target) {
+            int from = position.squares[i];
+            int dr = (target >> 3) - (from >> 3);
+            int df = (target & 7) - (from & 7);
+            int adr = dr < 0 ? -dr : dr;
+            int adf = df < 0 ? -df : df;
+            switch (position.types[i]) {
+                case PieceType::KING: return adr <= 1 && adf <= 1 && (adr | adf) != 0;
+                case PieceType::KNIGHT: return (adr == 1 && adf == 2) || (adr == 2 && adf == 1);
+                case PieceType::PAWN: return adf == 1 && dr == (position.colors[i] == Color::WHITE ? 1 : -1);
+                default: break;
+            }
+            bool straight = dr == 0 || df == 0;
+            bool diagonal = adr == adf;
+            if ((dr | df) == 0 || (!straight && !diagonal)) return false;
+            if (straight && position.types[i] == PieceType::BISHOP) return false;
+            if (diagonal && position.types[i] == PieceType::ROOK) return false;
+            int stepRank = (dr > 0) - (dr < 0);
+            int stepFile = (df > 0) - (df < 0);
+            for (int sq = from + stepRank * 8 + stepFile; sq != target; sq += stepRank * 8 + stepFile) {
+                if (occupancy.piece[sq] >= 0) return false;
+            }
+            return true;
+        }
+
+        bool kingAttacked(const TbPosition& position, const Occupancy& occupancy, Color side) {
+            int king = position.squares[position.colors[0] == side ? 0 : 1];
+            for (int i = 0; i < position.men; ++i) {
+                if (position.colors[i] != side && attacks(position, occupancy, i, king)) return true;
+            }
+            return false;
+        }
+
+        // Calls visit(child, converts) for every legal move; converts is true for captures
+        // and promotions, which leave the table. Stops early when visit returns false.
+        template <typename Visit>
+        int forEachChild(const TbPosition& position, Visit&& visit) {
+            Occupancy occupancy(position);
+            Color us = position.sideToMove;
+            int legal = 0;
+
+            auto tryMove = [&](int i, int to, PieceType promotion) -> bool {
+                TbPosition child = position;
+                int victim = occupancy.piece[to];
+                child.squares[i] = to;
+                if (promotion != PieceType::NONE) child.types[i] = promotion;
+                if (victim >= 0) {
+                    for (int k = victim; k + 1 < child.men; ++k) {
+                        child.types[k] = child.types[k + 1];
+                        child.colors[k] = child.colors[k + 1];
+                        child.squares[k] = child.squares[k + 1];
+                    }
+                    --child.men;
+                }
+                child.sideToMove = opposite(us);
+                Occupancy childOccupancy(child);
+                if (kingAttacked(child, childOccupancy, us)) return true;
+                ++legal;
+                return visit(child, victim >= 0 || promotion != PieceType::NONE);
+            };
+
+            for (int i = 0; i < position.men; ++i) {
+                if (position.colors[i] != us) continue;
+                int from = position.squares[i];
+                int rank = from >> 3;
+                int file = from & 7;
+                PieceType type = position.types[i];
+
+                if (type == PieceType::PAWN) {
+                    int forward = us == Color::WHITE ? 1 : -1;
+                    int lastRank = us == Color::WHITE ? 7 : 0;
+                    int startRank = us == Color::WHITE ? 1 : 6;
+                    int one = from + forward * 8;
+                    bool promotes = (one >> 3) == lastRank;
+                    if (occupancy.piece[one] < 0) {
+                        if (promotes) {
+                            for (PieceType promotion : promotions) {
+                                if (!tryMove(i, one, promotion)) return legal;
+                            }
+                        } else {
+                            if (!tryMove(i, one, PieceType::NONE)) return legal;
+                            int two = one + forward * 8;
+                            if (rank == startRank && occupancy.piece[two] < 0 && !tryMove(i, two, PieceType::NONE)) {
+                                return legal;
+                            }
+                        }
+                    }
+                    for (int df = -1; df <= 1; df += 2) {
+                        if (!onBoard(rank + forward, file + df)) continue;
+                        int to = one + df;
+                        int victim = occupancy.piece[to];
+                        if (victim < 0 || position.colors[victim] == us) continue;
+                        if (promotes) {
+                            for (PieceType promotion : promotions) {
+                                if (!tryMove(i, to, promotion)) return legal;
+                            }
+                        } else if (!tryMove(i, to, PieceType::NONE)) {
+                            return legal;
+                        }
+                    }
+                    continue;
+                }
+
+                if (type == PieceType::KING || type == PieceType::KNIGHT) {
+                    const int(*steps)[2] = type == PieceType::KING ? kingSteps : knightSteps;
+                    for (int s = 0; s < 8; ++s) {
+                        if (!onBoard(rank + steps[s][0], file + steps[s][1])) continue;
+                        int to = from + steps[s][0] * 8 + steps[s][1];
+                        int victim = occupancy.piece[to];
+                        if (victim >= 0 && (position.colors[victim] == us || position.types[victim] == PieceType::KING)) continue;
+                        if (!tryMove(i, to, PieceType::NONE)) return legal;
+                    }
+                    continue;
+                }
+
+                for (int d = 0; d < 8; ++d) {
+                    bool straight = d < 4;
+                    if ((straight && type == PieceType::BISHOP) || (!straight && type == PieceType::ROOK)) continue;
+                    const int* dir = straight ? rookDirections[d] : bishopDirections[d - 4];
+                    for (int r = rank + dir[0], f = file + dir[1]; onBoard(r, f); r += dir[0], f += dir[1]) {
+                        int to = r * 8 + f;
+                        int victim = occupancy.piece[to];
+                        if (victim >= 0) {
+                            if (position.colors[victim] != us && position.types[victim] != PieceType::KING &&
+                                !tryMove(i, to, PieceType::NONE)) {
+                                return legal;
+                            }
+                            break;
+                        }
+                        if (!tryMove(i, to, PieceType::NONE)) return legal;
+                    }
+                }
+            }
+            return legal;
+        }
+
+        // Calls visit(parent) for every legal position whose side to move could reach this
+        // one with a move that stays in the table (no capture, no promotion)
+        template <typename Visit>
+        void forEachParent(const TbPosition& position, Visit&& visit) {
+            Occupancy occupancy(position);
+            Color mover = opposite(position.sideToMove);
+
+            auto tryUnmove = [&](int i, int from) {
+                TbPosition parent = position;
+                parent.squares[i] = from;
+                parent.sideToMove = mover;
+                Occupancy parentOccupancy(parent);
+                if (!kingAttacked(parent, parentOccupancy, position.sideToMove)) visit(parent);
+            };
+
+            for (int i = 0; i < position.men; ++i) {
+                if (position.colors[i] != mover) continue;
+                int to = position.squares[i];
+                int rank = to >> 3;
+                int file = to & 7;
+                PieceType type = position.types[i];
+
+                if (type == PieceType::PAWN) {
+                    int back = mover == Color::WHITE ? -1 : 1;
+                    int startRank = mover == Color::WHITE ? 1 : 6;
+                    int one = to + back * 8;
+                    if ((one >> 3) == (mover == Color::WHITE ? 0 : 7) || occupancy.piece[one] >= 0) continue;
+                    tryUnmove(i, one);
+                    int two = one + back * 8;
+                    if ((two >> 3) == startRank && occupancy.piece[two] < 0) tryUnmove(i, two);
+                    continue;
+                }
+
+                if (type == PieceType::KING || type == PieceType::KNIGHT) {
+                    const int(*steps)[2] = type == PieceType::KING ? kingSteps : knightSteps;
+                    for (int s = 0; s < 8; ++s) {
+                        if (!onBoard(rank + steps[s][0], file + steps[s][1])) continue;
+                        int from = to + steps[s][0] * 8 + steps[s][1];
+                        if (occupancy.piece[from] < 0) tryUnmove(i, from);
+                    }
+                    continue;
+                }
+
+                for (int d = 0; d < 8; ++d) {
+                    bool straight = d < 4;
+                    if ((straight && type == PieceType::BISHOP) || (!straight && type == PieceType::ROOK)) continue;
+                    const int* dir = straight ? rookDirections[d] : bishopDirections[d - 4];
+                    for (int r = rank + dir[0], f = file + dir[1]; onBoard(r, f); r += dir[0], f += dir[1]) {
+                        int from = r * 8 + f;
+                        if (occupancy.piece[from] >= 0) break;
+                        tryUnmove(i, from);
+                    }
+                }
+            }
+        }
+
+        bool isLegalPosition(const TbPosition& position) {
+            Occupancy occupancy(position);
+            for (int i = 0; i < position.men; ++i) {
+                if (occupancy.piece[position.squares[i]] != i) return false; // Two men on one square
+                int rank = position.squares[i] >> 3;
+                if (position.types[i] == PieceType::PAWN && (rank == 0 || rank == 7)) return false;
+            }
+            return !kingAttacked(position, occupancy, opposite(position.sideToMove));
+        }
+
+        // Tables this one converts into through captures and promotions
+        std::vector<TbMaterial> conversions(const TbMaterial& material) {
+            std::vector<TbMaterial> result;
+            auto add = [&result](const TbMaterial& candidate) {
+                if (candidate.men() <= 2) return; // Bare kings need no table
+                TbMaterial canonical = candidate.canonical();
+                for (const TbMaterial& existing : result) {
+                    if (existing.key() == canonical.key()) return;
+                }
+                result.push_back(canonical);
+            };
+            for (int s = 0; s < 2; ++s) {
+                for (int i = 0; i < material.counts[s]; ++i) {
+                    TbMaterial captured = material;
+                    for (int k = i; k + 1 < captured.counts[s]; ++k) captured.pieces[s][k] = captured.pieces[s][k + 1];
+                    --captured.counts[s];
+                    add(captured);
+                    if (material.pieces[s][i] != PieceType::PAWN) continue;
+                    for (PieceType promotion : promotions) {
+                        TbMaterial promoted = material;
+                        promoted.pieces[s][i] = promotion;
+                        add(promoted);
+                    }
+                }
+            }
+            return result;
+        }
+
+        // Splits [0, count) over threads; body(begin, end, worker)
+        template <typename Body>
+        void parallelFor(std::size_t count, unsigned threads, Body&& body) {
+            if (threads <= 1 || count < 4096) {
+                body(std::size_t(0), count, 0u);
+                return;
+            }
+            std::vector<std::thread> workers;
+            std::size_t chunk = (count + threads - 1) / threads;
+            for (unsigned t = 0; t < threads; ++t) {
+                std::size_t begin = std::min(count, t * chunk);
+                std::size_t end = std::min(count, begin + chunk);
+                workers.emplace_back([&body, begin, end, t]() { body(begin, end, t); });
+            }
+            for (std::thread& worker : workers) worker.join();
+        }
+    } // namespace
+
+    TablebaseGenerator::TablebaseGenerator(const std::string& outputDirectory, unsigned threadCount)
+        : directory(outputDirectory), threads(threadCount ? threadCount : ThreadPool::defaultThreadCount()) {}
+
+    bool TablebaseGenerator::generate(const TbMaterial& requested, std::vector<TbGenerationReport>& reports) {
+        TbMaterial material = requested.canonical();
+        if (material.men() <= 2 || material.men() > Tablebase::MAX_MEN) return false;
+        if (tables.count(material.key())) return true;
+        for (const TbMaterial& dependency : conversions(material)) {
+            if (!generate(dependency, reports)) return false;
+        }
+
+        TbGenerationReport report;
+        report.name = material.name();
+        report.entries = material.entryCount();
+        std::string path = directory + "/" + Tablebase::fileName(material);
+        auto begin = std::chrono::steady_clock::now();
+        if (Tablebase::readTable(path, material, tables[material.key()])) {
+            report.loaded = true;
+        } else if (!build(material, report) ||
+                   !Tablebase::writeTable(path, material, tables[material.key()].data(), report.entries)) {
+            return false;
+        }
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        report.bytes = Tablebase::HEADER_SIZE + report.entries;
+
+        for (std::uint8_t value : tables[material.key()]) {
+            if (value == TbValue::INVALID) continue;
+            ++report.legal;
+            if (TbValue::isWin(value)) ++report.wins;
+            else if (TbValue::isLoss(value)) ++report.losses;
+            else ++report.draws;
+            if (TbValue::isDecisive(value)) report.longestMate = std::max(report.longestMate, TbValue::plies(value));
+        }
+        reports.push_back(report);
+        return true;
+    }
+
+    bool TablebaseGenerator::build(const TbMaterial& material, TbGenerationReport& report) {
+        std::vector<std::uint8_t>& values = tables[material.key()];
+        values.assign(report.entries, TbValue::UNKNOWN);
+        std::uint32_t selfKey = material.key();
+
+        int longestConversion = 0;
+        for (const TbMaterial& dependency : conversions(material)) {
+            for (std::uint8_t value : tables[dependency.key()]) {
+                if (TbValue::isDecisive(value)) longestConversion = std::max(longestConversion, TbValue::plies(value));
+            }
+        }
+        std::unordered_map<std::uint32_t, const std::uint8_t*> lookup;
+        for (const auto& table : tables) lookup[table.first] = table.second.data();
+
+        auto childValue = [&](TbPosition child) -> std::uint8_t {
+            if (child.men == 2) return TbValue::DRAW;
+            Tablebase::canonicalize(child);
+            std::uint32_t key = child.material().key();
+            const std::uint8_t* table = key == selfKey ? values.data() : lookup.find(key)->second;
+            return table[Tablebase::index(child)];
+        };
+
+        // buckets[d]: positions decided at d plies to mate (possibly proposed more than once)
+        std::vector<std::vector<std::uint32_t>> buckets(TbValue::MAX_PLIES + 1);
+        std::vector<std::vector<std::vector<std::uint32_t>>> pending(
+            threads, std::vector<std::vector<std::uint32_t>>(TbValue::MAX_PLIES + 1));
+        auto mergePending = [&]() {
+            for (auto& local : pending) {
+                for (int d = 0; d <= TbValue::MAX_PLIES; ++d) {
+                    buckets[d].insert(buckets[d].end(), local[d].begin(), local[d].end());
+                    local[d].clear();
+                }
+            }
+        };
+
+        // Pass 1: legality, mates and stalemates, and the outcomes reachable by conversion
+        parallelFor(values.size(), threads, [&](std::size_t begin, std::size_t end, unsigned worker) {
+            std::vector<std::vector<std::uint32_t>>& local = pending[worker];
+            for (std::size_t i = begin; i < end; ++i) {
+                TbPosition position;
+                Tablebase::decode(material, i, position);
+                TbPosition canonical = position;
+                Tablebase::canonicalize(canonical);
+                if (Tablebase::index(canonical) != i || !isLegalPosition(position)) {
+                    values[i] = TbValue::INVALID; // Illegal, or stored under a symmetric index
+                    continue;
+                }
+                int bestLoss = -1;   // Fewest plies among conversions that leave the opponent lost
+                int slowestWin = -1; // Most plies among conversions that leave the opponent winning
+                bool allConvertedWins = true;
+                bool staysInTable = false;
+                int legal = forEachChild(position, [&](const TbPosition& child, bool converts) {
+                    if (!converts) {
+                        staysInTable = true;
+                        allConvertedWins = false;
+                        return true;
+                    }
+                    std::uint8_t value = childValue(child);
+                    if (TbValue::isLoss(value)) {
+                        int plies = TbValue::plies(value);
+                        if (bestLoss < 0 || plies < bestLoss) bestLoss = plies;
+                    }
+                    if (TbValue::isWin(value)) slowestWin = std::max(slowestWin, TbValue::plies(value));
+                    else allConvertedWins = false;
+                    return true;
+                });
+                if (legal == 0) {
+                    Occupancy occupancy(position);
+                    if (kingAttacked(position, occupancy, position.sideToMove)) local[0].push_back(static_cast<std::uint32_t>(i));
+                    else values[i] = TbValue::DRAW;
+                    continue;
+                }
+                if (bestLoss >= 0 && bestLoss + 1 <= TbValue::MAX_PLIES) local[bestLoss + 1].push_back(static_cast<std::uint32_t>(i));
+                if (!staysInTable && allConvertedWins && slowestWin + 1 <= TbValue::MAX_PLIES) {
+                    local[slowestWin + 1].push_back(static_cast<std::uint32_t>(i));
+                }
+            }
+        });
+        mergePending();
+
+        // Pass 2: resolve in order of distance to mate
+        std::vector<std::uint32_t> fresh;
+        for (int d = 0; d <= TbValue::MAX_PLIES; ++d) {
+            fresh.clear();
+            for (std::uint32_t i : buckets[d]) {
+                if (values[i] != TbValue::UNKNOWN) continue;
+                values[i] = TbValue::fromPlies(d);
+                fresh.push_back(i);
+            }
+            std::vector<std::uint32_t>().swap(buckets[d]);
+            if (fresh.empty()) {
+                if (d > longestConversion + 1) {
+                    bool more = false;
+                    for (int later = d + 1; later <= TbValue::MAX_PLIES && !more; ++later) more = !buckets[later].empty();
+                    if (!more) break;
+                }
+                continue;
+            }
+
+            // Values are only read here; new decisions are queued for later plies
+            bool lost = (d & 1) == 0;
+            parallelFor(fresh.size(), threads, [&](std::size_t begin, std::size_t end, unsigned worker) {
+                std::vector<std::vector<std::uint32_t>>& local = pending[worker];
+                for (std::size_t k = begin; k < end; ++k) {
+                    TbPosition position;
+                    Tablebase::decode(material, fresh[k], position);
+                    forEachParent(position, [&](TbPosition parent) {
+                        Tablebase::canonicalize(parent);
+                        std::uint32_t p = static_cast<std::uint32_t>(Tablebase::index(parent));
+                        if (values[p] != TbValue::UNKNOWN) return;
+                        if (lost) {
+                            if (d + 1 <= TbValue::MAX_PLIES) local[d + 1].push_back(p);
+                            return;
+                        }
+                        // The parent is lost once every move leads to a win for the opponent
+                        int slowest = 0;
+                        bool allWins = true;
+                        forEachChild(parent, [&](const TbPosition& child, bool /*converts*/) {
+                            std::uint8_t value = childValue(child);
+                            if (!TbValue::isWin(value)) {
+                                allWins = false;
+                                return false;
+                            }
+                            slowest = std::max(slowest, TbValue::plies(value));
+                            return true;
+                        });
+                        if (allWins && slowest + 1 <= TbValue::MAX_PLIES) local[slowest + 1].push_back(p);
+                    });
+                }
+            });
+            mergePending();
+        }
+
+        for (std::uint8_t& value : values) {
+            if (value == TbValue::UNKNOWN) value = TbValue::DRAW;
+        }
+        return true;
+    }
+
+} // namespace HardChess
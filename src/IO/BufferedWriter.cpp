@@ -0,0 +1,76 @@
+#include "HardChess/IO/BufferedWriter.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace HardChess {
+
+    BufferedWriter::BufferedWriter(std::size_t bufferSize)
+        : fd(-1), ownsFd(false), buffer(bufferSize), used(0), failed(false) {}
+
+    BufferedWriter::~BufferedWriter() {
+        close();
+    }
+
+    bool BufferedWriter::open(const std::string& path, bool append) {
+        close();
+        failed = false;
+        if (path.empty() || path == "-") {
+            fd = STDOUT_FILENO;
+            ownsFd = false;
+            return true;
+        }
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0644);
+        ownsFd = fd >= 0;
+        failed = fd < 0;
+        return fd >= 0;
+    }
+
+    bool BufferedWriter::close() {
+        if (fd < 0) return !failed;
+        flush();
+        if (ownsFd && ::close(fd) != 0) failed = true;
+        fd = -1;
+        ownsFd = false;
+        return !failed;
+    }
+
+    bool BufferedWriter::flush() {
+        std::size_t written = 0;
+        while (written < used && fd >= 0) {
+            ssize_t n = ::write(fd, buffer.data() + written, used - written);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                failed = true;
+                break;
+            }
+            written += static_cast<std::size_t>(n);
+        }
+        used = 0;
+        return !failed;
+    }
+
+    void BufferedWriter::write(const void* data, std::size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        if (size >= buffer.size()) {
+            // Large records bypass the buffer after flushing what precedes them
+            flush();
+            while (size > 0 && fd >= 0) {
+                ssize_t n = ::write(fd, bytes, size);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    failed = true;
+                    return;
+                }
+                bytes += n;
+                size -= static_cast<std::size_t>(n);
+            }
+            return;
+        }
+        if (used + size > buffer.size()) flush();
+        std::memcpy(buffer.data() + used, bytes, size);
+        used += size;
+    }
+
+} // namespace HardChess
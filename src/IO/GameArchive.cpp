@@ -0,0 +1,142 @@
+#include "HardChess/IO/GameArchive.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace HardChess {
+
+    namespace {
+        const char archiveMagic[4] = {'H', 'C', 'G', 'A'};
+        constexpr std::uint32_t archiveVersion = 2;
+        constexpr std::size_t maxFENLength = 255;
+    } // namespace
+
+    GameArchiveWriter::GameArchiveWriter() : games(0), position(0), isOpen(false) {}
+
+    GameArchiveWriter::~GameArchiveWriter() {
+        if (isOpen) close();
+    }
+
+    bool GameArchiveWriter::open(const std::string& archivePath) {
+        path = archivePath;
+        offsets.clear();
+        games = 0;
+        if (!out.open(path)) return false;
+        // Placeholder header; the real one is written once the index position is known
+        GameArchiveHeader header = {};
+        out.write(&header, sizeof(header));
+        position = sizeof(header);
+        isOpen = true;
+        return true;
+    }
+
+    bool GameArchiveWriter::add(const GameRecord& record) {
+        const std::string& fen = record.getStartFEN();
+        if (!isOpen || record.size() > 0xFFFF || fen.size() > maxFENLength) return false;
+
+        if (games++ % gameArchiveIndexStride == 0) offsets.push_back(position);
+        unsigned char gameHeader[4 + maxFENLength + 1];
+        std::size_t headerBytes = 0;
+        std::uint32_t head = static_cast<std::uint32_t>(record.size()) << 3 | (fen.empty() ? 0u : 4u) |
+                             static_cast<std::uint32_t>(record.getResult());
+        do {
+            gameHeader[headerBytes++] = static_cast<unsigned char>((head & 0x7F) | (head > 0x7F ? 0x80 : 0));
+            head >>= 7;
+        } while (head);
+        if (!fen.empty()) {
+            gameHeader[headerBytes++] = static_cast<unsigned char>(fen.size());
+            std::memcpy(gameHeader + headerBytes, fen.data(), fen.size());
+            headerBytes += fen.size();
+        }
+        if (headerBytes % 2) gameHeader[headerBytes++] = '\0'; // Keep the move array 2-byte aligned
+        out.write(gameHeader, headerBytes);
+        MoveCodeView moves = record.getMoves();
+        if (!moves.empty()) out.write(moves.codes, moves.size() * sizeof(std::uint16_t));
+        position += headerBytes + moves.size() * sizeof(std::uint16_t);
+        return out.ok();
+    }
+
+    bool GameArchiveWriter::close() {
+        if (!isOpen) return false;
+        isOpen = false;
+        while (position % 8) {
+            out.put('\0');
+            ++position;
+        }
+        GameArchiveHeader header;
+        std::memcpy(header.magic, archiveMagic, sizeof(archiveMagic));
+        header.version = archiveVersion;
+        header.gameCount = games;
+        header.indexOffset = position;
+        header.reserved = 0;
+        out.write(offsets.data(), offsets.size() * sizeof(std::uint64_t));
+        if (!out.close()) return false;
+
+        int fd = ::open(path.c_str(), O_WRONLY);
+        if (fd < 0) return false;
+        bool ok = pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+        ok = (::close(fd) == 0) && ok;
+        return ok;
+    }
+
+    GameArchive::GameArchive() : index(nullptr), count(0) {}
+
+    bool GameArchive::open(const std::string& archivePath) {
+        index = nullptr;
+        count = 0;
+        if (!file.open(archivePath) || file.size() < sizeof(GameArchiveHeader)) return false;
+
+        GameArchiveHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, archiveMagic, sizeof(archiveMagic)) != 0 || header.version != archiveVersion ||
+            header.indexOffset % 8 != 0 || header.indexOffset > file.size() ||
+            (header.gameCount + gameArchiveIndexStride - 1) / gameArchiveIndexStride >
+                (file.size() - header.indexOffset) / sizeof(std::uint64_t)) {
+            file.close();
+            return false;
+        }
+        index = reinterpret_cast<const std::uint64_t*>(file.data() + header.indexOffset);
+        count = header.gameCount;
+        return true;
+    }
+
+    bool GameArchive::game(std::size_t i, ArchivedGame& out) const {
+        if (i >= count) return false;
+        std::uint64_t offset = index[i / gameArchiveIndexStride];
+        for (std::size_t skip = i % gameArchiveIndexStride; skip > 0; --skip) {
+            if (!gameAt(offset, out, offset)) return false;
+        }
+        return gameAt(offset, out, offset);
+    }
+
+    bool GameArchive::gameAt(std::uint64_t offset, ArchivedGame& out, std::uint64_t& next) const {
+        if (offset >= file.size() || offset % 2) return false;
+
+        const unsigned char* base = reinterpret_cast<const unsigned char*>(file.data() + offset);
+        std::size_t available = file.size() - offset;
+        std::uint32_t head = 0;
+        std::size_t at = 0;
+        for (int shift = 0;; shift += 7) {
+            if (at >= available || shift > 14) return false; // Truncated, or longer than 65535 plies needs
+            head |= static_cast<std::uint32_t>(base[at] & 0x7F) << shift;
+            if (!(base[at++] & 0x80)) break;
+        }
+        std::size_t fenLength = 0;
+        if (head & 4) {
+            if (at >= available) return false;
+            fenLength = base[at++];
+        }
+        std::size_t fenAt = at;
+        at += fenLength + ((at + fenLength) % 2);
+        std::size_t moveCount = head >> 3;
+        if (at > available || moveCount > (available - at) / 2) return false;
+
+        out.result = static_cast<GameResult>(head & 3);
+        out.startFEN = std::string_view(reinterpret_cast<const char*>(base + fenAt), fenLength);
+        out.moves.codes = reinterpret_cast<const std::uint16_t*>(base + at);
+        out.moves.count = moveCount;
+        next = offset + at + moveCount * 2;
+        return true;
+    }
+
+} // namespace HardChess
@@ -0,0 +1,75 @@
+#include "HardChess/IO/LineReader.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace HardChess {
+
+    LineReader::LineReader(std::size_t bufferSize)
+        : fd(-1), ownsFd(false), buffer(bufferSize), begin(0), end(0), atEof(false) {}
+
+    LineReader::~LineReader() {
+        if (ownsFd && fd >= 0) ::close(fd);
+    }
+
+    bool LineReader::open(const std::string& path) {
+        if (ownsFd && fd >= 0) ::close(fd);
+        begin = end = 0;
+        atEof = false;
+        if (path.empty() || path == "-") {
+            fd = STDIN_FILENO;
+            ownsFd = false;
+            return true;
+        }
+        fd = ::open(path.c_str(), O_RDONLY);
+        ownsFd = fd >= 0;
+        return fd >= 0;
+    }
+
+    bool LineReader::fill() {
+        // Slide the unread tail to the front, growing only for a line longer than the buffer
+        if (begin > 0) {
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+        if (end == buffer.size()) buffer.resize(buffer.size() * 2);
+
+        ssize_t got;
+        do {
+            got = ::read(fd, buffer.data() + end, buffer.size() - end);
+        } while (got < 0 && errno == EINTR);
+        if (got <= 0) {
+            atEof = true;
+            return false;
+        }
+        end += static_cast<std::size_t>(got);
+        return true;
+    }
+
+    bool LineReader::next(std::string_view& line) {
+        if (fd < 0) return false;
+        std::size_t scanFrom = begin;
+        while (true) {
+            const char* newline = static_cast<const char*>(std::memchr(buffer.data() + scanFrom, '\n', end - scanFrom));
+            if (newline) {
+                std::size_t length = static_cast<std::size_t>(newline - (buffer.data() + begin));
+                line = std::string_view(buffer.data() + begin, length);
+                begin += length + 1;
+                break;
+            }
+            std::size_t scanned = end - begin;
+            if (atEof || !fill()) {
+                if (begin == end) return false;
+                line = std::string_view(buffer.data() + begin, end - begin); // Last line without newline
+                begin = end;
+                break;
+            }
+            scanFrom = begin + scanned; // Only scan what fill() appended
+        }
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        return true;
+    }
+
+} // namespace HardChess
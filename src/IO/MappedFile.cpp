@@ -0,0 +1,77 @@
+#include "HardChess/IO/MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace HardChess {
+
+    MappedFile::MappedFile() : mapping(nullptr), length(0), opened(false) {}
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : mapping(other.mapping), length(other.length), opened(other.opened) {
+        other.mapping = nullptr;
+        other.length = 0;
+        other.opened = false;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            std::swap(mapping, other.mapping);
+            std::swap(length, other.length);
+            std::swap(opened, other.opened);
+        }
+        return *this;
+    }
+
+    bool MappedFile::open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        length = static_cast<std::size_t>(info.st_size);
+        if (length == 0) {
+            // mmap rejects empty ranges; an empty file is simply an empty view
+            ::close(fd);
+            opened = true;
+            return true;
+        }
+
+        void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // The mapping keeps its own reference to the file
+        if (address == MAP_FAILED) {
+            length = 0;
+            return false;
+        }
+        mapping = static_cast<const char*>(address);
+        opened = true;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (mapping) {
+            munmap(const_cast<char*>(mapping), length);
+        }
+        mapping = nullptr;
+        length = 0;
+        opened = false;
+    }
+
+    void MappedFile::adviseSequential() const {
+        if (mapping) {
+            madvise(const_cast<char*>(mapping), length, MADV_SEQUENTIAL);
+        }
+    }
+
+} // namespace HardChess
@@ -0,0 +1,281 @@
+#include "HardChess/IO/PgnReader.h"
+#include "HardChess/Core/Notation.h"
+#include <algorithm>
+#include <cctype>
+#include <utility>
+#include <thread>
+
+namespace HardChess {
+
+    namespace {
+        bool isSpace(char ch) {
+            return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+        }
+
+        bool isResultToken(std::string_view token) {
+            return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+        }
+
+        // Skips a {comment}, ;comment or (variation) starting at text[i]; returns the index after it
+        std::size_t skipAnnotation(std::string_view text, std::size_t i) {
+            if (text[i] == '{') {
+                std::size_t end = text.find('}', i + 1);
+                return end == std::string_view::npos ? text.size() : end + 1;
+            }
+            if (text[i] == ';') {
+                std::size_t end = text.find('\n', i + 1);
+                return end == std::string_view::npos ? text.size() : end + 1;
+            }
+            // Variations nest and may contain comments of their own
+            int depth = 0;
+            while (i < text.size()) {
+                char ch = text[i];
+                if (ch == '{' || ch == ';') {
+                    i = skipAnnotation(text, i);
+                    continue;
+                }
+                if (ch == '(') ++depth;
+                if (ch == ')' && --depth == 0) return i + 1;
+                ++i;
+            }
+            return text.size();
+        }
+
+        // Whether text[pos] opens a tag pair line: '[', a tag name, spaces and a '"'
+        bool opensTagPair(std::string_view text, std::size_t pos) {
+            std::size_t i = pos + 1;
+            while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_')) ++i;
+            if (i == pos + 1) return false;
+            std::size_t name = i;
+            while (i < text.size() && (text[i] == ' ' || text[i] == '\t')) ++i;
+            return i > name && i < text.size() && text[i] == '"';
+        }
+
+        // Whether pos lies inside a {comment} begun after begin: comments do not nest, so
+        // that is when the nearest brace before pos opens one. A brace inside a ;comment
+        // or a tag value can only make this say yes, which costs a cut, never a game.
+        bool insideBraceComment(std::string_view text, std::size_t begin, std::size_t pos) {
+            while (pos > begin) {
+                char ch = text[--pos];
+                if (ch == '}') return false;
+                if (ch == '{') return true;
+            }
+            return false;
+        }
+    } // namespace
+
+    std::string_view PgnGame::tag(std::string_view name) const {
+        std::size_t i = 0;
+        while (i < tagSection.size()) {
+            std::size_t lineEnd = tagSection.find('\n', i);
+            if (lineEnd == std::string_view::npos) lineEnd = tagSection.size();
+            std::string_view line = tagSection.substr(i, lineEnd - i);
+            i = lineEnd + 1;
+
+            if (line.size() < name.size() + 2 || line[0] != '[' || line.compare(1, name.size(), name) != 0 ||
+                !isSpace(line[name.size() + 1])) {
+                continue;
+            }
+            std::size_t open = line.find('"', name.size() + 1);
+            std::size_t close = line.rfind('"');
+            if (open == std::string_view::npos || close <= open) return std::string_view();
+            return line.substr(open + 1, close - open - 1);
+        }
+        return std::string_view();
+    }
+
+    PgnRecordBuilder::PgnRecordBuilder(std::function<void(const GameRecord&)> recordSink)
+        : sink(std::move(recordSink)) {
+        record.reserve(256);
+    }
+
+    void PgnRecordBuilder::onGameStart(const PgnGame& game, const Board& /*board*/) {
+        record.clear();
+        std::string_view fen = game.tag("FEN");
+        if (!fen.empty()) record.setStartFEN(fen);
+    }
+
+    void PgnRecordBuilder::onMove(const Board& /*board*/, const Move& move, std::string_view /*san*/) {
+        record.append(move);
+    }
+
+    void PgnRecordBuilder::onGameEnd(const PgnGame& game, const Board& /*board*/, std::string_view result, bool ok) {
+        if (!ok) return;
+        GameResult parsed = parseGameResult(result);
+        if (parsed == GameResult::UNKNOWN) parsed = parseGameResult(game.tag("Result"));
+        record.setResult(parsed);
+        sink(record);
+    }
+
+    PgnReader::PgnReader(std::string_view pgnText) : text(pgnText), offset(0) {}
+
+    bool PgnReader::nextGame(PgnGame& game) {
+        // Skip blank lines and '%' escape lines between games
+        while (offset < text.size()) {
+            if (isSpace(text[offset])) {
+                ++offset;
+            } else if (text[offset] == '%' && (offset == 0 || text[offset - 1] == '\n')) {
+                std::size_t end = text.find('\n', offset);
+                offset = end == std::string_view::npos ? text.size() : end + 1;
+            } else {
+                break;
+            }
+        }
+        if (offset >= text.size()) return false;
+
+        // Tag pair section: consecutive lines starting with '['
+        std::size_t tagsBegin = offset;
+        while (offset < text.size() && text[offset] == '[') {
+            std::size_t end = text.find('\n', offset);
+            offset = end == std::string_view::npos ? text.size() : end + 1;
+            while (offset < text.size() && (text[offset] == ' ' || text[offset] == '\t' || text[offset] == '\r')) ++offset;
+        }
+        game.tagSection = text.substr(tagsBegin, offset - tagsBegin);
+
+        // Movetext runs until a '[' opens a line outside a comment, or the end of input
+        std::size_t movesBegin = offset;
+        while (offset < text.size()) {
+            char ch = text[offset];
+            if (ch == '{' || ch == ';') {
+                offset = skipAnnotation(text, offset);
+                continue;
+            }
+            if (ch == '[' && offset > movesBegin && text[offset - 1] == '\n') break;
+            ++offset;
+        }
+        game.movetext = text.substr(movesBegin, offset - movesBegin);
+        return true;
+    }
+
+    bool PgnReader::replayGame(const PgnGame& game, Board& board, std::vector<Move>& scratch,
+                               PgnVisitor* visitor, PgnStats& stats) {
+        ++stats.games;
+        std::string_view fen = game.tag("FEN");
+        if (fen.empty()) {
+            board.initializeBoard();
+        } else if (!board.fromFEN(fen)) {
+            ++stats.errors;
+            if (visitor) visitor->onGameEnd(game, board, std::string_view(), false);
+            return false;
+        }
+        if (visitor) visitor->onGameStart(game, board);
+
+        std::string_view movetext = game.movetext;
+        std::string_view result;
+        std::size_t i = 0;
+        while (i < movetext.size()) {
+            char ch = movetext[i];
+            if (isSpace(ch) || ch == '.') {
+                ++i;
+                continue;
+            }
+            if (ch == '{' || ch == ';' || ch == '(') {
+                i = skipAnnotation(movetext, i);
+                continue;
+            }
+
+            std::size_t begin = i;
+            if (ch == '$') { // Numeric annotation glyph
+                ++i;
+                while (i < movetext.size() && movetext[i] >= '0' && movetext[i] <= '9') ++i;
+                continue;
+            }
+            while (i < movetext.size() && !isSpace(movetext[i]) && movetext[i] != '{' && movetext[i] != ';' &&
+                   movetext[i] != '(' && movetext[i] != ')' && movetext[i] != '$') {
+                ++i;
+            }
+            std::string_view token = movetext.substr(begin, i - begin);
+
+            if (isResultToken(token)) {
+                result = token;
+                break;
+            }
+            if (ch >= '0' && ch <= '9' && token != "0-0" && token != "0-0-0") {
+                // Move number, possibly glued to the move ("12.e4" or "12...Nf6")
+                std::size_t digits = 0;
+                while (digits < token.size() && token[digits] >= '0' && token[digits] <= '9') ++digits;
+                if (digits < token.size() && token[digits] != '.') {
+                    ++stats.errors;
+                    if (visitor) visitor->onGameEnd(game, board, result, false);
+                    return false;
+                }
+                i = begin + digits;
+                continue;
+            }
+
+            Move move;
+            if (!Notation::parseSAN(board, token, move, scratch)) {
+                ++stats.errors;
+                if (visitor) visitor->onGameEnd(game, board, result, false);
+                return false;
+            }
+            if (visitor) visitor->onMove(board, move, token);
+            board.applyMove(move);
+            ++stats.moves;
+        }
+
+        if (visitor) visitor->onGameEnd(game, board, result, true);
+        return true;
+    }
+
+    PgnStats PgnReader::replayAll(std::string_view text, PgnVisitor* visitor) {
+        PgnStats stats;
+        PgnReader reader(text);
+        PgnGame game;
+        Board board;
+        std::vector<Move> scratch;
+        scratch.reserve(256);
+        while (reader.nextGame(game)) {
+            replayGame(game, board, scratch, visitor, stats);
+        }
+        return stats;
+    }
+
+    std::vector<std::string_view> PgnReader::splitAtGameBoundaries(std::string_view text, unsigned parts) {
+        std::vector<std::string_view> slices;
+        if (parts == 0) parts = 1;
+        std::size_t begin = 0;
+        for (unsigned k = 1; k < parts && begin < text.size(); ++k) {
+            std::size_t target = std::max(begin, text.size() / parts * k);
+            // A game starts at a tag pair that opens the line right after a blank line, outside
+            // any comment: a "[%clk ...]" line or a quoted game inside {...} is not a boundary
+            std::size_t cut = std::string_view::npos;
+            for (std::size_t pos = text.find("\n[", target); pos != std::string_view::npos; pos = text.find("\n[", pos + 1)) {
+                std::size_t prev = pos;
+                while (prev > 0 && (text[prev - 1] == '\r' || text[prev - 1] == ' ' || text[prev - 1] == '\t')) --prev;
+                if (prev > 0 && text[prev - 1] == '\n' && opensTagPair(text, pos + 1) &&
+                    !insideBraceComment(text, begin, pos)) {
+                    cut = pos + 1;
+                    break;
+                }
+            }
+            if (cut == std::string_view::npos) break;
+            slices.push_back(text.substr(begin, cut - begin));
+            begin = cut;
+        }
+        if (begin < text.size()) slices.push_back(text.substr(begin));
+        return slices;
+    }
+
+    PgnStats PgnReader::replayParallel(std::string_view text, unsigned threads, const std::vector<PgnVisitor*>& visitors) {
+        if (threads <= 1) return replayAll(text, visitors.empty() ? nullptr : visitors[0]);
+
+        std::vector<std::string_view> slices = splitAtGameBoundaries(text, threads);
+        std::vector<PgnStats> results(slices.size());
+        std::vector<std::thread> workers;
+        workers.reserve(slices.size());
+        for (std::size_t t = 0; t < slices.size(); ++t) {
+            PgnVisitor* visitor = t < visitors.size() ? visitors[t] : nullptr;
+            workers.emplace_back([&results, &slices, t, visitor]() {
+                results[t] = replayAll(slices[t], visitor);
+            });
+        }
+        PgnStats total;
+        for (std::size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+            total += results[t];
+        }
+        return total;
+    }
+
+} // namespace HardChess
@@ -0,0 +1,99 @@
+#include "HardChess/IO/PgnWriter.h"
+#include "HardChess/Core/Notation.h"
+#include <cstdio>
+
+namespace HardChess {
+
+    namespace {
+        constexpr std::size_t maxLineLength = 79; // PGN export format keeps lines below 80 columns
+    } // namespace
+
+    PgnWriter::PgnWriter() : lineStart(0), games(0), writing(false) {
+        scratch.reserve(256);
+        text.reserve(4096);
+    }
+
+    PgnWriter::~PgnWriter() {
+        if (writing) close();
+    }
+
+    bool PgnWriter::open(const std::string& path, bool append) {
+        games = 0;
+        writing = out.open(path, append);
+        return writing;
+    }
+
+    bool PgnWriter::close() {
+        if (!writing) return false;
+        writing = false;
+        return out.close();
+    }
+
+    void PgnWriter::writeTag(std::string_view name, std::string_view value) {
+        text += '[';
+        text.append(name.data(), name.size());
+        text += " \"";
+        for (char ch : value) {
+            if (ch == '"' || ch == '\\') text += '\\';
+            text += ch;
+        }
+        text += "\"]\n";
+    }
+
+    void PgnWriter::writeToken(std::string_view token) {
+        std::size_t lineLength = text.size() - lineStart;
+        if (lineLength > 0 && lineLength + 1 + token.size() > maxLineLength) {
+            text += '\n';
+            lineStart = text.size();
+        } else if (lineLength > 0) {
+            text += ' ';
+        }
+        text.append(token.data(), token.size());
+    }
+
+    bool PgnWriter::add(const GameRecord& record, const std::vector<PgnTag>& tags) {
+        if (!writing) return false;
+        const std::string& fen = record.getStartFEN();
+        if (fen.empty()) {
+            board.initializeBoard();
+        } else if (!board.fromFEN(fen)) {
+            return false;
+        }
+
+        text.clear();
+        for (const PgnTag& tag : tags) writeTag(tag.name, tag.value);
+        const char* result = gameResultString(record.getResult());
+        writeTag("Result", result);
+        if (!fen.empty()) {
+            writeTag("SetUp", "1");
+            writeTag("FEN", fen);
+        }
+        text += '\n';
+        lineStart = text.size();
+
+        char san[Notation::MAX_SAN_LENGTH];
+        bool first = true;
+        for (std::uint16_t code : record.getMoves()) {
+            Move move = board.decodeMove(code);
+            const Piece* mover = board.getPiecePtr(move.from);
+            if (!mover || mover->getColor() != board.getSideToMove()) return false;
+
+            bool white = board.getSideToMove() == Color::WHITE;
+            if (white || first) {
+                char number[16];
+                int length = std::snprintf(number, sizeof(number), white ? "%d." : "%d...", board.getFullmoveNumber());
+                writeToken(std::string_view(number, static_cast<std::size_t>(length)));
+            }
+            writeToken(std::string_view(san, Notation::formatSAN(board, move, san, scratch)));
+            board.applyMove(move);
+            first = false;
+        }
+        writeToken(result);
+        text += "\n\n";
+
+        out.write(text);
+        ++games;
+        return out.ok();
+    }
+
+} // namespace HardChess
@@ -0,0 +1,643 @@
+#include "HardChess/IO/Png.h"
+#include "HardChess/IO/MappedFile.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+
+namespace HardChess {
+
+    namespace {
+
+        const std::uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+        std::array<std::uint32_t, 256> makeCrcTable() {
+            std::array<std::uint32_t, 256> table = {};
+            for (std::uint32_t n = 0; n < 256; ++n) {
+                std::uint32_t c = n;
+                for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                table[n] = c;
+            }
+            return table;
+        }
+
+        std::uint32_t crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0) {
+            static const std::array<std::uint32_t, 256> table = makeCrcTable();
+            crc = ~crc;
+            for (std::size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            return ~crc;
+        }
+
+        std::uint32_t adler32(const std::uint8_t* data, std::size_t size) {
+            std::uint32_t a = 1, b = 0;
+            while (size > 0) {
+                std::size_t run = std::min<std::size_t>(size, 5552); // Largest run that cannot overflow b
+                for (std::size_t i = 0; i < run; ++i) {
+                    a += data[i];
+                    b += a;
+                }
+                a %= 65521;
+                b %= 65521;
+                data += run;
+                size -= run;
+            }
+            return b << 16 | a;
+        }
+
+        std::uint32_t readBigEndian(const std::uint8_t* p) {
+            return std::uint32_t(p[0]) << 24 | std::uint32_t(p[1]) << 16 | std::uint32_t(p[2]) << 8 | p[3];
+        }
+
+        void appendBigEndian(std::vector<std::uint8_t>& out, std::uint32_t value) {
+            out.push_back(static_cast<std::uint8_t>(value >> 24));
+            out.push_back(static_cast<std::uint8_t>(value >> 16));
+            out.push_back(static_cast<std::uint8_t>(value >> 8));
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        // Appends one chunk: length, type, data and the CRC of type and data
+        void appendChunk(std::vector<std::uint8_t>& out, const char* type, const std::uint8_t* data, std::size_t size,
+                         const std::uint8_t* prefix = nullptr, std::size_t prefixSize = 0) {
+            appendBigEndian(out, static_cast<std::uint32_t>(prefixSize + size));
+            std::size_t crcBegin = out.size();
+            out.insert(out.end(), type, type + 4);
+            if (prefixSize) out.insert(out.end(), prefix, prefix + prefixSize);
+            out.insert(out.end(), data, data + size);
+            appendBigEndian(out, crc32(out.data() + crcBegin, out.size() - crcBegin));
+        }
+
+        // --- Inflate (RFC 1951) ---
+
+        const std::uint16_t lengthBase[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                              31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        const std::uint8_t lengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                              2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        const std::uint16_t distanceBase[30] = {1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                                                193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+        const std::uint8_t distanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                                6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+        // LSB-first bit reader; reading past the end yields zeros and is flagged
+        class BitReader {
+          public:
+            BitReader(const std::uint8_t* data, std::size_t size) : p(data), end(data + size), bits(0), count(0), padding(0) {}
+
+            void refill() {
+                while (count <= 56) {
+                    std::uint64_t byte = 0;
+                    if (p < end) byte = *p++;
+                    else ++padding;
+                    bits |= byte << count;
+                    count += 8;
+                }
+            }
+            std::uint32_t peek(int n) const { return static_cast<std::uint32_t>(bits & ((std::uint64_t(1) << n) - 1)); }
+            void consume(int n) {
+                bits >>= n;
+                count -= n;
+            }
+            std::uint32_t read(int n) {
+                refill();
+                std::uint32_t value = peek(n);
+                consume(n);
+                return value;
+            }
+            void alignToByte() { consume(count % 8); }
+            bool overrun() const { return padding * 8 > count; } // Consumed bits that were never in the input
+
+          private:
+            const std::uint8_t* p;
+            const std::uint8_t* end;
+            std::uint64_t bits;
+            int count;
+            int padding;
+        };
+
+        // Canonical Huffman decoding through one table indexed by the next maxLength bits.
+        // Entries hold symbol << 4 | code length; 0 marks an unused code.
+        class HuffmanTable {
+          public:
+            bool build(const std::uint8_t* lengths, int symbols) {
+                int counts[16] = {};
+                maxLength = 0;
+                for (int s = 0; s < symbols; ++s) {
+                    ++counts[lengths[s]];
+                    maxLength = std::max<int>(maxLength, lengths[s]);
+                }
+                counts[0] = 0;
+                if (maxLength == 0) maxLength = 1; // An unused distance code set is allowed
+                int next[16] = {};
+                int code = 0;
+                for (int length = 1; length <= 15; ++length) {
+                    code = (code + counts[length - 1]) << 1;
+                    next[length] = code;
+                    if (counts[length] > (1 << length) - code) return false; // Over-subscribed
+                }
+                table.assign(std::size_t(1) << maxLength, 0);
+                for (int s = 0; s < symbols; ++s) {
+                    int length = lengths[s];
+                    if (length == 0) continue;
+                    int reversed = 0;
+                    for (int bit = 0, c = next[length]++; bit < length; ++bit) reversed |= ((c >> bit) & 1) << (length - 1 - bit);
+                    for (std::size_t i = static_cast<std::size_t>(reversed); i < table.size(); i += std::size_t(1) << length) {
+                        table[i] = static_cast<std::uint16_t>(s << 4 | length);
+                    }
+                }
+                return true;
+            }
+
+            int decode(BitReader& in) const {
+                in.refill();
+                std::uint16_t entry = table[in.peek(maxLength)];
+                if ((entry & 15) == 0) return -1;
+                in.consume(entry & 15);
+                return entry >> 4;
+            }
+
+          private:
+            std::vector<std::uint16_t> table;
+            int maxLength = 0;
+        };
+
+        // Inflates a zlib stream into exactly out.size() bytes
+        bool inflate(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out) {
+            if (size < 2 || (data[0] & 0x0F) != 8 || ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20)) return false;
+            BitReader in(data + 2, size - 2);
+            std::uint8_t* target = out.data();
+            std::size_t written = 0;
+            const std::size_t limit = out.size();
+            HuffmanTable literals, distances;
+            bool last = false;
+
+            while (!last) {
+                last = in.read(1) != 0;
+                std::uint32_t type = in.read(2);
+                if (type == 0) {
+                    in.alignToByte();
+                    std::uint32_t length = in.read(16);
+                    if ((in.read(16) ^ 0xFFFF) != length || written + length > limit) return false;
+                    for (std::uint32_t i = 0; i < length; ++i) target[written++] = static_cast<std::uint8_t>(in.read(8));
+                    continue;
+                }
+                if (type == 1) {
+                    std::uint8_t lengths[288 + 32];
+                    std::fill(lengths, lengths + 144, 8);
+                    std::fill(lengths + 144, lengths + 256, 9);
+                    std::fill(lengths + 256, lengths + 280, 7);
+                    std::fill(lengths + 280, lengths + 288, 8);
+                    std::fill(lengths + 288, lengths + 320, 5);
+                    literals.build(lengths, 288);
+                    distances.build(lengths + 288, 30);
+                } else if (type == 2) {
+                    static const std::uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+                    int literalCount = static_cast<int>(in.read(5)) + 257;
+                    int distanceCount = static_cast<int>(in.read(5)) + 1;
+                    int codeCount = static_cast<int>(in.read(4)) + 4;
+                    std::uint8_t codeLengths[19] = {};
+                    for (int i = 0; i < codeCount; ++i) codeLengths[order[i]] = static_cast<std::uint8_t>(in.read(3));
+                    HuffmanTable codeTable;
+                    if (!codeTable.build(codeLengths, 19)) return false;
+
+                    std::uint8_t lengths[288 + 32] = {};
+                    int total = literalCount + distanceCount;
+                    for (int i = 0; i < total;) {
+                        int symbol = codeTable.decode(in);
+                        if (symbol < 0) return false;
+                        if (symbol < 16) {
+                            lengths[i++] = static_cast<std::uint8_t>(symbol);
+                            continue;
+                        }
+                        int repeat = 0;
+                        std::uint8_t value = 0;
+                        if (symbol == 16) {
+                            if (i == 0) return false;
+                            value = lengths[i - 1];
+                            repeat = 3 + static_cast<int>(in.read(2));
+                        } else if (symbol == 17) {
+                            repeat = 3 + static_cast<int>(in.read(3));
+                        } else {
+                            repeat = 11 + static_cast<int>(in.read(7));
+                        }
+                        if (i + repeat > total) return false;
+                        while (repeat--) lengths[i++] = value;
+                    }
+                    if (!literals.build(lengths, literalCount) || !distances.build(lengths + literalCount, distanceCount)) {
+                        return false;
+                    }
+                } else {
+                    return false;
+                }
+
+                for (;;) {
+                    int symbol = literals.decode(in);
+                    if (symbol < 0) return false;
+                    if (symbol < 256) {
+                        if (written == limit) return false;
+                        target[written++] = static_cast<std::uint8_t>(symbol);
+                        continue;
+                    }
+                    if (symbol == 256) break;
+                    symbol -= 257;
+                    if (symbol >= 29) return false;
+                    std::size_t length = lengthBase[symbol] + in.read(lengthExtra[symbol]);
+                    int distanceSymbol = distances.decode(in);
+                    if (distanceSymbol < 0 || distanceSymbol >= 30) return false;
+                    std::size_t distance = distanceBase[distanceSymbol] + in.read(distanceExtra[distanceSymbol]);
+                    if (distance > written || written + length > limit) return false;
+                    const std::uint8_t* from = target + written - distance;
+                    std::uint8_t* to = target + written;
+                    for (std::size_t i = 0; i < length; ++i) to[i] = from[i]; // Overlapping copies repeat a run
+                    written += length;
+                }
+                if (in.overrun()) return false;
+            }
+            return written == limit && !in.overrun();
+        }
+
+        std::uint8_t paeth(int a, int b, int c) {
+            int p = a + b - c;
+            int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+            if (pa <= pb && pa <= pc) return static_cast<std::uint8_t>(a);
+            return static_cast<std::uint8_t>(pb <= pc ? b : c);
+        }
+
+        // Reverses the per-row filters in place; rows keep their leading filter byte
+        bool unfilter(std::uint8_t* raw, int height, std::size_t stride, int bpp) {
+            const std::uint8_t* above = nullptr;
+            for (int y = 0; y < height; ++y) {
+                std::uint8_t* row = raw + y * (stride + 1);
+                std::uint8_t filter = row[0];
+                std::uint8_t* px = row + 1;
+                for (std::size_t x = 0; x < stride; ++x) {
+                    int left = x >= static_cast<std::size_t>(bpp) ? px[x - bpp] : 0;
+                    int up = above ? above[x] : 0;
+                    int upLeft = above && x >= static_cast<std::size_t>(bpp) ? above[x - bpp] : 0;
+                    switch (filter) {
+                        case 0: break;
+                        case 1: px[x] = static_cast<std::uint8_t>(px[x] + left); break;
+                        case 2: px[x] = static_cast<std::uint8_t>(px[x] + up); break;
+                        case 3: px[x] = static_cast<std::uint8_t>(px[x] + ((left + up) >> 1)); break;
+                        case 4: px[x] = static_cast<std::uint8_t>(px[x] + paeth(left, up, upLeft)); break;
+                        default: return false;
+                    }
+                }
+                above = px;
+            }
+            return true;
+        }
+
+        // --- Deflate with fixed Huffman codes ---
+
+        constexpr int windowBits = 15;
+        constexpr int windowSize = 1 << windowBits;
+        constexpr int hashBits = 15;
+        constexpr int maxChain = 16;
+        constexpr int minMatch = 3;
+        constexpr int maxMatch = 258;
+
+        // LSB-first bit writer into a buffer sized for the worst case up front
+        class BitWriter {
+          public:
+            explicit BitWriter(std::uint8_t* target) : out(target), bits(0), count(0) {}
+            void put(std::uint32_t value, int n) {
+                bits |= std::uint64_t(value) << count;
+                count += n;
+                if (count >= 32) {
+                    for (int i = 0; i < 4; ++i) *out++ = static_cast<std::uint8_t>(bits >> (8 * i));
+                    bits >>= 32;
+                    count -= 32;
+                }
+            }
+            std::uint8_t* finish() {
+                for (; count > 0; count -= 8, bits >>= 8) *out++ = static_cast<std::uint8_t>(bits);
+                count = 0;
+                return out;
+            }
+
+          private:
+            std::uint8_t* out;
+            std::uint64_t bits;
+            int count;
+        };
+
+        // Length of the common prefix of a and b, up to limit, compared eight bytes at a time
+        int matchLength(const std::uint8_t* a, const std::uint8_t* b, int limit) {
+            int length = 0;
+            while (length + 8 <= limit) {
+                std::uint64_t x, y;
+                std::memcpy(&x, a + length, 8);
+                std::memcpy(&y, b + length, 8);
+                if (x != y) return length + __builtin_ctzll(x ^ y) / 8; // Little-endian byte order
+                length += 8;
+            }
+            while (length < limit && a[length] == b[length]) ++length;
+            return length;
+        }
+
+        std::uint32_t reverseBits(std::uint32_t code, int length) {
+            std::uint32_t reversed = 0;
+            for (int i = 0; i < length; ++i) reversed |= ((code >> i) & 1) << (length - 1 - i);
+            return reversed;
+        }
+
+        // Fixed literal/length codes, already bit-reversed for the LSB-first writer
+        struct FixedCodes {
+            std::uint16_t code[288];
+            std::uint8_t length[288];
+            std::uint8_t lengthSymbol[maxMatch + 1]; // Match length -> index into lengthBase
+            FixedCodes() {
+                for (int s = 0; s < 288; ++s) {
+                    if (s < 144) length[s] = 8, code[s] = static_cast<std::uint16_t>(reverseBits(0x30 + s, 8));
+                    else if (s < 256) length[s] = 9, code[s] = static_cast<std::uint16_t>(reverseBits(0x190 + s - 144, 9));
+                    else if (s < 280) length[s] = 7, code[s] = static_cast<std::uint16_t>(reverseBits(s - 256, 7));
+                    else length[s] = 8, code[s] = static_cast<std::uint16_t>(reverseBits(0xC0 + s - 280, 8));
+                }
+                for (int symbol = 0, matchLength = minMatch; matchLength <= maxMatch; ++matchLength) {
+                    while (symbol < 28 && lengthBase[symbol + 1] <= matchLength) ++symbol;
+                    lengthSymbol[matchLength] = static_cast<std::uint8_t>(symbol);
+                }
+            }
+        };
+
+        const FixedCodes& fixedCodes() {
+            static const FixedCodes codes;
+            return codes;
+        }
+
+        int distanceSymbolOf(int distance) {
+            return static_cast<int>(std::upper_bound(distanceBase, distanceBase + 30, distance) - distanceBase) - 1;
+        }
+
+        std::uint32_t hash3(const std::uint8_t* p) {
+            return ((std::uint32_t(p[0]) << 16 | std::uint32_t(p[1]) << 8 | p[2]) * 2654435761u) >> (32 - hashBits);
+        }
+
+    } // namespace
+
+    namespace Png {
+
+        bool decode(const std::uint8_t* data, std::size_t size, Image& image) {
+            if (size < 8 + 25 || std::memcmp(data, signature, 8) != 0) return false;
+            std::size_t offset = 8;
+            std::uint32_t width = 0, height = 0;
+            int colorType = -1;
+            std::vector<std::uint8_t> idat;
+            std::uint8_t palette[256][4];
+            int paletteSize = 0;
+            for (int i = 0; i < 256; ++i) palette[i][0] = palette[i][1] = palette[i][2] = 0, palette[i][3] = 255;
+
+            while (offset + 12 <= size) {
+                std::uint32_t length = readBigEndian(data + offset);
+                const std::uint8_t* type = data + offset + 4;
+                const std::uint8_t* body = data + offset + 8;
+                if (length > size - offset - 12) return false;
+                if (std::memcmp(type, "IHDR", 4) == 0) {
+                    if (length != 13) return false;
+                    width = readBigEndian(body);
+                    height = readBigEndian(body + 4);
+                    int bitDepth = body[8];
+                    colorType = body[9];
+                    bool interlaced = body[12] != 0;
+                    if (bitDepth != 8 || interlaced || body[10] != 0 || body[11] != 0) return false;
+                    if (width == 0 || height == 0 || width > 16384 || height > 16384) return false;
+                } else if (std::memcmp(type, "PLTE", 4) == 0) {
+                    paletteSize = static_cast<int>(std::min<std::uint32_t>(length / 3, 256));
+                    for (int i = 0; i < paletteSize; ++i) std::memcpy(palette[i], body + 3 * i, 3);
+                } else if (std::memcmp(type, "tRNS", 4) == 0) {
+                    if (colorType == 3) {
+                        for (std::uint32_t i = 0; i < length && i < 256; ++i) palette[i][3] = body[i];
+                    }
+                } else if (std::memcmp(type, "IDAT", 4) == 0) {
+                    idat.insert(idat.end(), body, body + length);
+                } else if (std::memcmp(type, "IEND", 4) == 0) {
+                    break;
+                }
+                offset += 12 + length;
+            }
+
+            int channels = 0;
+            switch (colorType) {
+                case 0: channels = 1; break;
+                case 2: channels = 3; break;
+                case 3: channels = 1; break;
+                case 4: channels = 2; break;
+                case 6: channels = 4; break;
+                default: return false;
+            }
+            if (colorType == 3 && paletteSize == 0) return false;
+
+            std::size_t stride = static_cast<std::size_t>(width) * channels;
+            std::vector<std::uint8_t> raw(height * (stride + 1));
+            if (!inflate(idat.data(), idat.size(), raw) || !unfilter(raw.data(), static_cast<int>(height), stride, channels)) {
+                return false;
+            }
+
+            image.width = static_cast<int>(width);
+            image.height = static_cast<int>(height);
+            image.pixels.resize(static_cast<std::size_t>(width) * height * 4);
+            for (std::uint32_t y = 0; y < height; ++y) {
+                const std::uint8_t* src = raw.data() + y * (stride + 1) + 1;
+                std::uint8_t* dst = image.pixels.data() + static_cast<std::size_t>(y) * width * 4;
+                if (colorType == 6) {
+                    std::memcpy(dst, src, stride);
+                    continue;
+                }
+                for (std::uint32_t x = 0; x < width; ++x, dst += 4) {
+                    switch (colorType) {
+                        case 0: dst[0] = dst[1] = dst[2] = src[x]; dst[3] = 255; break;
+                        case 2: std::memcpy(dst, src + 3 * x, 3); dst[3] = 255; break;
+                        case 3: std::memcpy(dst, palette[src[x]], 4); break;
+                        case 4: dst[0] = dst[1] = dst[2] = src[2 * x]; dst[3] = src[2 * x + 1]; break;
+                    }
+                }
+            }
+            return true;
+        }
+
+        bool load(const std::string& path, Image& image) {
+            MappedFile file;
+            if (!file.open(path)) return false;
+            return decode(reinterpret_cast<const std::uint8_t*>(file.data()), file.size(), image);
+        }
+
+    } // namespace Png
+
+    PngEncoder::PngEncoder()
+        : width(0), height(0), channels(0), delayMs(0), sequence(0), firstFrame(true),
+          head(std::size_t(1) << hashBits), previous(windowSize) {}
+
+    void PngEncoder::filterRows(const std::uint8_t* pixels) {
+        const std::size_t stride = static_cast<std::size_t>(width) * channels;
+        const std::size_t bpp = static_cast<std::size_t>(channels);
+        filtered.resize(height * (stride + 1));
+        for (int y = 0; y < height; ++y) {
+            const std::uint8_t* row = pixels + y * stride;
+            std::uint8_t* out = filtered.data() + y * (stride + 1);
+            std::uint8_t* residuals = out + 1;
+
+            // Sub leaves zeros along flat runs, Up leaves zeros where a row repeats the
+            // one above; keep whichever has the smaller sum of residuals
+            unsigned long subCost = 0;
+            for (std::size_t x = 0; x < stride; ++x) {
+                std::uint8_t sub = static_cast<std::uint8_t>(row[x] - (x >= bpp ? row[x - bpp] : 0));
+                residuals[x] = sub;
+                subCost += static_cast<unsigned>(std::abs(static_cast<std::int8_t>(sub)));
+            }
+            out[0] = 1;
+            if (y == 0) continue;
+
+            const std::uint8_t* above = row - stride;
+            unsigned long upCost = 0;
+            for (std::size_t x = 0; x < stride; ++x) {
+                upCost += static_cast<unsigned>(std::abs(static_cast<std::int8_t>(row[x] - above[x])));
+            }
+            if (upCost < subCost) {
+                out[0] = 2;
+                for (std::size_t x = 0; x < stride; ++x) residuals[x] = static_cast<std::uint8_t>(row[x] - above[x]);
+            }
+        }
+    }
+
+    void PngEncoder::compress() {
+        const FixedCodes& codes = fixedCodes();
+        // Fixed codes spend at most 9 bits on a literal; add room for the header, trailer and block bits
+        compressed.resize(filtered.size() + filtered.size() / 8 + 16);
+        compressed[0] = 0x78; // Deflate, 32 KiB window
+        compressed[1] = 0x01;
+        BitWriter out(compressed.data() + 2);
+        out.put(1, 1); // Final block
+        out.put(1, 2); // Fixed Huffman codes
+
+        std::fill(head.begin(), head.end(), -1);
+        const std::uint8_t* data = filtered.data();
+        const int size = static_cast<int>(filtered.size());
+        int pos = 0;
+        auto insert = [&](int at) {
+            std::uint32_t h = hash3(data + at);
+            previous[at & (windowSize - 1)] = head[h];
+            head[h] = at;
+        };
+
+        while (pos < size) {
+            int bestLength = 0, bestDistance = 0;
+            if (pos + minMatch <= size) {
+                int limit = std::min(maxMatch, size - pos);
+                int candidate = head[hash3(data + pos)];
+                for (int chain = 0; candidate >= 0 && pos - candidate <= windowSize - 1 && chain < maxChain; ++chain) {
+                    if (data[candidate + bestLength] == data[pos + bestLength]) {
+                        int length = matchLength(data + candidate, data + pos, limit);
+                        if (length > bestLength) {
+                            bestLength = length;
+                            bestDistance = pos - candidate;
+                            if (length == limit) break;
+                        }
+                    }
+                    int next = previous[candidate & (windowSize - 1)];
+                    if (next >= candidate) break; // Slot reused by a newer position
+                    candidate = next;
+                }
+            }
+
+            if (bestLength >= minMatch) {
+                int symbol = codes.lengthSymbol[bestLength];
+                out.put(codes.code[257 + symbol], codes.length[257 + symbol]);
+                if (lengthExtra[symbol]) out.put(bestLength - lengthBase[symbol], lengthExtra[symbol]);
+                int distanceSymbol = distanceSymbolOf(bestDistance);
+                out.put(reverseBits(distanceSymbol, 5), 5);
+                if (distanceExtra[distanceSymbol]) out.put(bestDistance - distanceBase[distanceSymbol], distanceExtra[distanceSymbol]);
+                int end = pos + bestLength;
+                for (; pos < end; ++pos) {
+                    if (pos + minMatch <= size) insert(pos);
+                }
+            } else {
+                out.put(codes.code[data[pos]], codes.length[data[pos]]);
+                if (pos + minMatch <= size) insert(pos);
+                ++pos;
+            }
+        }
+        out.put(codes.code[256], codes.length[256]);
+        compressed.resize(static_cast<std::size_t>(out.finish() - compressed.data()));
+        std::uint32_t checksum = adler32(filtered.data(), filtered.size());
+        appendBigEndian(compressed, checksum);
+    }
+
+    void PngEncoder::writeHeader(std::vector<std::uint8_t>& out) {
+        out.insert(out.end(), signature, signature + 8);
+        std::uint8_t header[13];
+        std::uint8_t* p = header;
+        for (std::uint32_t value : {static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height)}) {
+            *p++ = static_cast<std::uint8_t>(value >> 24);
+            *p++ = static_cast<std::uint8_t>(value >> 16);
+            *p++ = static_cast<std::uint8_t>(value >> 8);
+            *p++ = static_cast<std::uint8_t>(value);
+        }
+        header[8] = 8;                           // Bit depth
+        header[9] = channels == 4 ? 6 : 2;       // RGBA or RGB
+        header[10] = header[11] = header[12] = 0; // Deflate, adaptive filtering, no interlace
+        appendChunk(out, "IHDR", header, sizeof(header));
+    }
+
+    void PngEncoder::encode(const std::uint8_t* pixels, int imageWidth, int imageHeight, int imageChannels,
+                            std::vector<std::uint8_t>& out) {
+        width = imageWidth;
+        height = imageHeight;
+        channels = imageChannels;
+        out.clear();
+        writeHeader(out);
+        filterRows(pixels);
+        compress();
+        appendChunk(out, "IDAT", compressed.data(), compressed.size());
+        appendChunk(out, "IEND", nullptr, 0);
+    }
+
+    void PngEncoder::beginAnimation(int imageWidth, int imageHeight, int imageChannels, int frames, int frameDelayMs,
+                                    int loops, std::vector<std::uint8_t>& out) {
+        width = imageWidth;
+        height = imageHeight;
+        channels = imageChannels;
+        delayMs = frameDelayMs;
+        sequence = 0;
+        firstFrame = true;
+        out.clear();
+        writeHeader(out);
+        std::vector<std::uint8_t> control;
+        appendBigEndian(control, static_cast<std::uint32_t>(frames));
+        appendBigEndian(control, static_cast<std::uint32_t>(loops));
+        appendChunk(out, "acTL", control.data(), control.size());
+    }
+
+    void PngEncoder::addFrame(const std::uint8_t* pixels, std::vector<std::uint8_t>& out) {
+        std::uint8_t control[26] = {};
+        std::uint32_t fields[5] = {sequence++, static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height), 0, 0};
+        for (int i = 0; i < 5; ++i) {
+            control[4 * i] = static_cast<std::uint8_t>(fields[i] >> 24);
+            control[4 * i + 1] = static_cast<std::uint8_t>(fields[i] >> 16);
+            control[4 * i + 2] = static_cast<std::uint8_t>(fields[i] >> 8);
+            control[4 * i + 3] = static_cast<std::uint8_t>(fields[i]);
+        }
+        control[20] = static_cast<std::uint8_t>(delayMs >> 8); // Delay numerator
+        control[21] = static_cast<std::uint8_t>(delayMs);
+        control[22] = 1000 >> 8; // Denominator: milliseconds
+        control[23] = 1000 & 0xFF;
+        control[24] = 0; // Dispose: none
+        control[25] = 0; // Blend: source
+        appendChunk(out, "fcTL", control, sizeof(control));
+
+        filterRows(pixels);
+        compress();
+        if (firstFrame) {
+            appendChunk(out, "IDAT", compressed.data(), compressed.size()); // The default image is frame 0
+            firstFrame = false;
+        } else {
+            std::uint8_t number[4] = {static_cast<std::uint8_t>(sequence >> 24), static_cast<std::uint8_t>(sequence >> 16),
+                                      static_cast<std::uint8_t>(sequence >> 8), static_cast<std::uint8_t>(sequence)};
+            ++sequence;
+            appendChunk(out, "fdAT", compressed.data(), compressed.size(), number, sizeof(number));
+        }
+    }
+
+    void PngEncoder::endAnimation(std::vector<std::uint8_t>& out) {
+        appendChunk(out, "IEND", nullptr, 0);
+    }
+
+} // namespace HardChess
@@ -0,0 +1,179 @@
+#include "HardChess/IO/PositionIndex.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace HardChess {
+
+    namespace {
+        const char indexMagic[8] = {'H', 'C', 'P', 'I', 'N', 'D', 'E', 'X'};
+        constexpr std::uint32_t indexVersion = 1;
+
+        void putVarint(std::vector<unsigned char>& out, std::uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<unsigned char>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<unsigned char>(value));
+        }
+
+        // false if the varint runs past end
+        bool getVarint(const unsigned char*& in, const unsigned char* end, std::uint64_t& value) {
+            value = 0;
+            for (int shift = 0; in < end && shift < 64; shift += 7) {
+                unsigned char byte = *in++;
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        }
+    } // namespace
+
+    PositionIndexWriter::PositionIndexWriter()
+        : position(0), previousKey(0), positionCount(0), entryCount(0), isOpen(false) {}
+
+    PositionIndexWriter::~PositionIndexWriter() {
+        if (isOpen) close(0);
+    }
+
+    bool PositionIndexWriter::open(const std::string& indexPath) {
+        path = indexPath;
+        firstKeys.clear();
+        offsets.clear();
+        block.clear();
+        positionCount = 0;
+        entryCount = 0;
+        if (!out.open(path)) return false;
+        // Placeholder header; the real one is written once the tables' positions are known
+        PositionIndexHeader header = {};
+        out.write(&header, sizeof(header));
+        position = sizeof(header);
+        isOpen = true;
+        return true;
+    }
+
+    void PositionIndexWriter::flushBlock() {
+        if (block.empty()) return;
+        out.write(block.data(), block.size());
+        position += block.size();
+        block.clear();
+    }
+
+    void PositionIndexWriter::add(const PositionIndexEntry& entry) {
+        if (!isOpen) return;
+        bool newPosition = entryCount == 0 || entry.key != previousKey;
+        if (newPosition) {
+            ++positionCount;
+            if (block.size() >= BLOCK_BYTES) flushBlock();
+            if (block.empty()) {
+                firstKeys.push_back(entry.key);
+                offsets.push_back(position);
+                previousKey = entry.key;
+            }
+        }
+        putVarint(block, entry.key - previousKey);
+        putVarint(block, entry.move);
+        putVarint(block, entry.whiteWins);
+        putVarint(block, entry.draws);
+        putVarint(block, entry.blackWins);
+        previousKey = entry.key;
+        ++entryCount;
+    }
+
+    bool PositionIndexWriter::close(std::uint64_t gameCount) {
+        if (!isOpen) return false;
+        isOpen = false;
+        flushBlock();
+        while (position % 8) {
+            out.put('\0');
+            ++position;
+        }
+        PositionIndexHeader header;
+        std::memcpy(header.magic, indexMagic, sizeof(indexMagic));
+        header.version = indexVersion;
+        header.blockCount = static_cast<std::uint32_t>(firstKeys.size());
+        header.positionCount = positionCount;
+        header.entryCount = entryCount;
+        header.gameCount = gameCount;
+        header.keysOffset = position;
+        header.offsetsOffset = position + firstKeys.size() * sizeof(std::uint64_t);
+        header.reserved = 0;
+        offsets.push_back(position); // End of the last block
+        out.write(firstKeys.data(), firstKeys.size() * sizeof(std::uint64_t));
+        out.write(offsets.data(), offsets.size() * sizeof(std::uint64_t));
+        if (!out.close()) return false;
+
+        int fd = ::open(path.c_str(), O_WRONLY);
+        if (fd < 0) return false;
+        bool ok = pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+        ok = (::close(fd) == 0) && ok;
+        return ok;
+    }
+
+    PositionIndex::PositionIndex() : firstKeys(nullptr), offsets(nullptr), header() {}
+
+    bool PositionIndex::open(const std::string& indexPath) {
+        firstKeys = nullptr;
+        offsets = nullptr;
+        header = PositionIndexHeader();
+        if (!file.open(indexPath) || file.size() < sizeof(PositionIndexHeader)) return false;
+
+        PositionIndexHeader candidate;
+        std::memcpy(&candidate, file.data(), sizeof(candidate));
+        std::uint64_t tableBytes = static_cast<std::uint64_t>(candidate.blockCount) * sizeof(std::uint64_t);
+        if (std::memcmp(candidate.magic, indexMagic, sizeof(indexMagic)) != 0 || candidate.version != indexVersion ||
+            candidate.keysOffset % 8 != 0 || candidate.offsetsOffset != candidate.keysOffset + tableBytes ||
+            candidate.offsetsOffset > file.size() ||
+            file.size() - candidate.offsetsOffset < tableBytes + sizeof(std::uint64_t)) {
+            file.close();
+            return false;
+        }
+        header = candidate;
+        firstKeys = reinterpret_cast<const std::uint64_t*>(file.data() + header.keysOffset);
+        offsets = reinterpret_cast<const std::uint64_t*>(file.data() + header.offsetsOffset);
+        return true;
+    }
+
+    std::size_t PositionIndex::find(std::uint64_t key, ExplorerCounts& total, ExplorerMove* moves,
+                                    std::size_t maxMoves) const {
+        total = ExplorerCounts();
+        if (!firstKeys || header.blockCount == 0) return 0;
+        // The block holding key, if any, is the last one starting at or before it
+        const std::uint64_t* after = std::upper_bound(firstKeys, firstKeys + header.blockCount, key);
+        if (after == firstKeys) return 0;
+        std::size_t blockIndex = static_cast<std::size_t>(after - firstKeys) - 1;
+        std::uint64_t begin = offsets[blockIndex];
+        std::uint64_t end = offsets[blockIndex + 1];
+        if (begin > end || end > header.keysOffset) return 0; // Corrupt offsets
+
+        const unsigned char* in = reinterpret_cast<const unsigned char*>(file.data()) + begin;
+        const unsigned char* stop = reinterpret_cast<const unsigned char*>(file.data()) + end;
+        std::uint64_t entryKey = firstKeys[blockIndex];
+        std::size_t found = 0;
+        while (in < stop) {
+            std::uint64_t delta, move, white, draws, black;
+            if (!getVarint(in, stop, delta) || !getVarint(in, stop, move) || !getVarint(in, stop, white) ||
+                !getVarint(in, stop, draws) || !getVarint(in, stop, black)) {
+                break;
+            }
+            entryKey += delta;
+            if (entryKey > key) break;
+            if (entryKey < key) continue;
+            total.whiteWins += white;
+            total.draws += draws;
+            total.blackWins += black;
+            if (move == 0) continue; // Games that ended here
+            if (found < maxMoves) {
+                ExplorerMove& out = moves[found];
+                out.move = static_cast<std::uint16_t>(move);
+                out.counts.whiteWins = white;
+                out.counts.draws = draws;
+                out.counts.blackWins = black;
+            }
+            ++found;
+        }
+        return found;
+    }
+
+} // namespace HardChess
@@ -0,0 +1,152 @@
+#include "HardChess/IO/TrainingData.h"
+#include "HardChess/Core/Move.h"
+#include "HardChess/Core/Piece.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace HardChess {
+
+    namespace {
+        const char trainingMagic[8] = {'H', 'C', 'T', 'R', 'D', 'A', 'T', 'A'};
+        constexpr std::uint32_t trainingVersion = 1;
+
+        // FEN letters indexed by nibble: PieceType, plus 8 for Black
+        const char pieceLetters[17] = "?PRNBQK??prnbqk?";
+
+        char* writeNumber(char* out, unsigned value) {
+            char digits[10];
+            int count = 0;
+            do {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value);
+            while (count) *out++ = digits[--count];
+            return out;
+        }
+    } // namespace
+
+    PackedPosition PackedPosition::pack(const Board& board, int score, int result) {
+        PackedPosition record;
+        record.occupancy = board.occupiedSquares();
+        int slot = 0;
+        for (std::uint64_t rest = record.occupancy; rest; rest &= rest - 1) {
+            int square = __builtin_ctzll(rest);
+            const Piece* piece = board.getPiecePtr(squareAt(square));
+            unsigned nibble = static_cast<unsigned>(piece->getType()) | (piece->getColor() == Color::BLACK ? 8u : 0u);
+            record.pieces[slot / 2] |= static_cast<std::uint8_t>(nibble << (4 * (slot % 2)));
+            ++slot;
+        }
+        record.score = static_cast<std::int16_t>(std::max(-32767, std::min(32767, score)));
+        record.result = static_cast<std::int8_t>(result);
+        record.flags = static_cast<std::uint8_t>((board.getSideToMove() == Color::BLACK ? 1 : 0) |
+                                                 (board.getCastlingRights() << 1));
+        Position enPassant = board.getEnPassantSquare();
+        record.enPassant = enPassant.isValid() ? static_cast<std::uint8_t>(squareIndex(enPassant)) : NO_SQUARE;
+        record.halfmoveClock = static_cast<std::uint8_t>(std::min(255, board.getHalfmoveClock()));
+        record.fullmoveNumber = static_cast<std::uint16_t>(std::min(65535, board.getFullmoveNumber()));
+        return record;
+    }
+
+    std::size_t PackedPosition::writeFEN(char* out) const {
+        char* at = out;
+        int slot = 0;
+        for (int row = 0; row < 8; ++row) {
+            int empty = 0;
+            for (int col = 0; col < 8; ++col) {
+                int square = row * 8 + col;
+                if (!(occupancy >> square & 1)) {
+                    ++empty;
+                    continue;
+                }
+                if (empty) *at++ = static_cast<char>('0' + empty);
+                empty = 0;
+                *at++ = pieceLetters[(pieces[slot / 2] >> (4 * (slot % 2))) & 15];
+                ++slot;
+            }
+            if (empty) *at++ = static_cast<char>('0' + empty);
+            if (row < 7) *at++ = '/';
+        }
+        *at++ = ' ';
+        *at++ = whiteToMove() ? 'w' : 'b';
+        *at++ = ' ';
+        unsigned castling = (flags >> 1) & ALL_CASTLING;
+        if (!castling) *at++ = '-';
+        if (castling & WHITE_KINGSIDE) *at++ = 'K';
+        if (castling & WHITE_QUEENSIDE) *at++ = 'Q';
+        if (castling & BLACK_KINGSIDE) *at++ = 'k';
+        if (castling & BLACK_QUEENSIDE) *at++ = 'q';
+        *at++ = ' ';
+        if (enPassant < NO_SQUARE) {
+            *at++ = static_cast<char>('a' + enPassant % 8);
+            *at++ = static_cast<char>('8' - enPassant / 8);
+        } else {
+            *at++ = '-';
+        }
+        *at++ = ' ';
+        at = writeNumber(at, halfmoveClock);
+        *at++ = ' ';
+        at = writeNumber(at, fullmoveNumber);
+        return static_cast<std::size_t>(at - out);
+    }
+
+    TrainingDataWriter::TrainingDataWriter() : count(0), seed(0), isOpen(false) {}
+
+    TrainingDataWriter::~TrainingDataWriter() {
+        if (isOpen) close();
+    }
+
+    bool TrainingDataWriter::open(const std::string& shardPath, std::uint64_t shardSeed) {
+        path = shardPath;
+        count = 0;
+        seed = shardSeed;
+        if (!out.open(path)) return false;
+        // Placeholder header; the real one is written once the record count is known
+        TrainingDataHeader header = {};
+        out.write(&header, sizeof(header));
+        isOpen = true;
+        return true;
+    }
+
+    bool TrainingDataWriter::close() {
+        if (!isOpen) return false;
+        isOpen = false;
+        TrainingDataHeader header;
+        std::memcpy(header.magic, trainingMagic, sizeof(trainingMagic));
+        header.version = trainingVersion;
+        header.recordSize = sizeof(PackedPosition);
+        header.recordCount = count;
+        header.seed = seed;
+        if (!out.close()) return false;
+
+        int fd = ::open(path.c_str(), O_WRONLY);
+        if (fd < 0) return false;
+        bool ok = pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+        ok = (::close(fd) == 0) && ok;
+        return ok;
+    }
+
+    TrainingDataReader::TrainingDataReader() : records(nullptr), count(0), cursor(0), shardSeed(0) {}
+
+    bool TrainingDataReader::open(const std::string& shardPath) {
+        records = nullptr;
+        count = cursor = shardSeed = 0;
+        if (!file.open(shardPath) || file.size() < sizeof(TrainingDataHeader)) return false;
+
+        TrainingDataHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, trainingMagic, sizeof(trainingMagic)) != 0 || header.version != trainingVersion ||
+            header.recordSize != sizeof(PackedPosition) ||
+            header.recordCount > (file.size() - sizeof(header)) / sizeof(PackedPosition)) {
+            file.close();
+            return false;
+        }
+        file.adviseSequential();
+        records = reinterpret_cast<const PackedPosition*>(file.data() + sizeof(header));
+        count = header.recordCount;
+        shardSeed = header.seed;
+        return true;
+    }
+
+} // namespace HardChess
@@ -0,0 +1,495 @@
+#include "HardChess/Net/MatchServer.h"
+#include "HardChess/Core/Match.h"
+#include "HardChess/Core/Notation.h"
+#include "HardChess/Engine/OpeningBook.h"
+#include "HardChess/Engine/Tablebase.h"
+#include "HardChess/Net/Poller.h"
+#include "HardChess/Net/Socket.h"
+#include "HardChess/Util/ThreadPool.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace HardChess {
+
+    namespace {
+        constexpr std::size_t MAX_LINE = 1024;          // A longer unterminated request closes the session
+        constexpr std::size_t MAX_PENDING = 1 << 20;    // Unread output beyond this drops the session
+        constexpr std::size_t MAX_NAME = 32;
+        constexpr std::size_t ENGINE_QUEUE = 1 << 20;   // At most one job per session is ever queued
+
+        double cpuSeconds() {
+            rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+            return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+                   (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+        }
+
+        std::string scoreLine(const Match& match) {
+            return " score " + std::to_string(match.white().getScore()) + " " + std::to_string(match.black().getScore()) +
+                   " hearts " + std::to_string(match.white().getHearts()) + " " +
+                   std::to_string(match.black().getHearts());
+        }
+    } // namespace
+
+    struct MatchServer::EngineReply {
+        int fd;
+        std::uint64_t serial;
+        Move move;
+        std::string source; // "tablebase", "book" or "depth=N"; empty if no move was found
+        long long micros;
+    };
+
+    struct MatchServer::Session {
+        int fd = -1;
+        std::uint64_t serial = 0; // Tells a reply meant for this session from one for an earlier user of fd
+        std::string input;
+        std::string output;
+        std::size_t sent = 0;       // Bytes of output already written
+        bool watchingWrites = false;
+        bool thinking = false;      // An engine move is on the pool
+        bool closing = false;       // Close once output is written
+        bool dead = false;          // Close now
+        std::unique_ptr<Match> match;
+        std::vector<Move> scratch;  // For SAN
+        // Set when the session closes, so that its queued engine job is skipped
+        std::shared_ptr<std::atomic<bool>> closed = std::make_shared<std::atomic<bool>>(false);
+    };
+
+    struct MatchServer::Loop {
+        Poller poller;
+        int wakeRead = -1;
+        int wakeWrite = -1;
+        std::mutex mutex;                  // Guards arrivals and replies
+        std::vector<int> arrivals;         // Accepted descriptors handed over by the first loop
+        std::vector<EngineReply> replies;  // Finished engine moves for sessions of this loop
+        std::unordered_map<int, std::unique_ptr<Session>> sessions;
+        std::vector<Poller::Event> events;
+        std::thread thread;
+
+        ~Loop() {
+            if (wakeRead >= 0) ::close(wakeRead);
+            if (wakeWrite >= 0) ::close(wakeWrite);
+        }
+
+        void wake() {
+            char byte = 1;
+            if (wakeWrite >= 0 && ::write(wakeWrite, &byte, 1) < 0) {
+                // A full pipe already has a wakeup pending
+            }
+        }
+    };
+
+    MatchServer::MatchServer(const ServerOptions& options)
+        : options(options), listenFd(-1), stopRead(-1), stopWrite(-1), stopping(false), acceptPaused(false), nextLoop(0), nextSerial(1),
+          sessionsOpen(0), matchesStarted(0), movesPlayed(0), engineMoves(0), engineMicros(0) {}
+
+    MatchServer::~MatchServer() {
+        stop();
+        engines.reset(); // Finishes queued jobs while their loops still exist
+        if (stopRead >= 0) ::close(stopRead);
+        if (stopWrite >= 0) ::close(stopWrite);
+        if (listenFd >= 0) {
+            ::close(listenFd);
+            if (options.address.compare(0, 5, "unix:") == 0) ::unlink(options.address.c_str() + 5);
+        }
+    }
+
+    bool MatchServer::listen(std::string& error) {
+        listenFd = Socket::listenOn(options.address, error);
+        if (listenFd < 0) return false;
+        unsigned count = std::max(1u, options.loops);
+        for (unsigned i = 0; i < count; ++i) {
+            std::unique_ptr<Loop> loop(new Loop());
+            int pipeFds[2];
+            if (!loop->poller.open() || ::pipe(pipeFds) != 0) {
+                error = "cannot set up event loop";
+                return false;
+            }
+            loop->wakeRead = pipeFds[0];
+            loop->wakeWrite = pipeFds[1];
+            Socket::setNonBlocking(loop->wakeRead);
+            Socket::setNonBlocking(loop->wakeWrite);
+            loop->poller.add(loop->wakeRead);
+            loops.push_back(std::move(loop));
+        }
+        int stopFds[2];
+        if (::pipe(stopFds) != 0) {
+            error = "cannot set up event loop";
+            return false;
+        }
+        stopRead = stopFds[0];
+        stopWrite = stopFds[1];
+        Socket::setNonBlocking(stopWrite); // A signal handler must never block on it
+        loops[0]->poller.add(stopRead);
+        loops[0]->poller.add(listenFd);
+        engines.reset(new ThreadPool(options.engineThreads, ENGINE_QUEUE));
+        started = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    void MatchServer::run() {
+        std::signal(SIGPIPE, SIG_IGN); // A vanished client shows up as a write error instead
+        for (std::size_t i = 1; i < loops.size(); ++i) {
+            Loop* loop = loops[i].get();
+            loop->thread = std::thread([this, loop]() { serve(*loop); });
+        }
+        if (!loops.empty()) serve(*loops[0]);
+        for (std::size_t i = 1; i < loops.size(); ++i) loops[i]->thread.join();
+    }
+
+    void MatchServer::stop() {
+        stopping.store(true);
+        for (const std::unique_ptr<Loop>& loop : loops) loop->wake();
+    }
+
+    void MatchServer::serve(Loop& loop) {
+        while (!stopping.load(std::memory_order_relaxed)) {
+            if (!loop.poller.wait(loop.events, -1)) break;
+            for (const Poller::Event& event : loop.events) {
+                if (event.fd == listenFd) {
+                    acceptAll();
+                } else if (event.fd == loop.wakeRead) {
+                    drainWake(loop);
+                } else if (event.fd == stopRead) {
+                    stop();
+                } else {
+                    auto found = loop.sessions.find(event.fd);
+                    if (found == loop.sessions.end()) continue;
+                    Session& session = *found->second;
+                    if (event.readable || event.hangup) readFrom(loop, session);
+                    settle(loop, session);
+                }
+            }
+        }
+        for (auto& entry : loop.sessions) ::close(entry.first);
+        sessionsOpen -= static_cast<long long>(loop.sessions.size());
+        loop.sessions.clear();
+    }
+
+    void MatchServer::acceptAll() {
+        while (true) {
+            int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                if (errno == EINTR) continue;
+                if ((errno == EMFILE || errno == ENFILE) && !acceptPaused.load()) {
+                    // The listen socket would stay readable and spin this loop, so stop
+                    // watching it until a session closes; new clients wait in the backlog.
+                    // One more try covers a session that closed before the flag was up.
+                    acceptPaused.store(true);
+                    loops[0]->poller.remove(listenFd);
+                    continue;
+                }
+                return; // Drained, or still out of descriptors
+            }
+            resumeAccepting();
+            Socket::setNonBlocking(fd);
+            Socket::setNoDelay(fd);
+            Loop& target = *loops[nextLoop++ % loops.size()];
+            if (&target == loops[0].get()) {
+                adopt(target, fd);
+            } else {
+                {
+                    std::lock_guard<std::mutex> lock(target.mutex);
+                    target.arrivals.push_back(fd);
+                }
+                target.wake();
+            }
+        }
+    }
+
+    void MatchServer::resumeAccepting() {
+        if (acceptPaused.exchange(false)) loops[0]->poller.add(listenFd);
+    }
+
+    void MatchServer::adopt(Loop& loop, int fd) {
+        if (!loop.poller.add(fd)) {
+            ::close(fd);
+            return;
+        }
+        std::unique_ptr<Session> created(new Session());
+        created->fd = fd;
+        created->serial = nextSerial++;
+        Session& session = *created;
+        loop.sessions[fd] = std::move(created);
+        ++sessionsOpen;
+        send(session, "hello hardchess 1");
+        settle(loop, session);
+    }
+
+    void MatchServer::drainWake(Loop& loop) {
+        char buffer[256];
+        while (::read(loop.wakeRead, buffer, sizeof(buffer)) > 0) {}
+        std::vector<int> arrivals;
+        std::vector<EngineReply> replies;
+        {
+            std::lock_guard<std::mutex> lock(loop.mutex);
+            arrivals.swap(loop.arrivals);
+            replies.swap(loop.replies);
+        }
+        for (int fd : arrivals) adopt(loop, fd);
+        for (const EngineReply& reply : replies) engineReplied(loop, reply);
+        if (&loop == loops[0].get()) resumeAccepting(); // Woken by a session closing elsewhere
+    }
+
+    void MatchServer::readFrom(Loop& loop, Session& session) {
+        char buffer[4096];
+        bool ended = false;
+        while (true) {
+            ssize_t count = ::read(session.fd, buffer, sizeof(buffer));
+            if (count > 0) {
+                session.input.append(buffer, static_cast<std::size_t>(count));
+                if (static_cast<std::size_t>(count) < sizeof(buffer)) break;
+                continue;
+            }
+            if (count < 0 && errno == EINTR) continue;
+            if (count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) ended = true;
+            break;
+        }
+        std::size_t start = 0;
+        std::size_t newline;
+        while (!session.closing && (newline = session.input.find('\n', start)) != std::string::npos) {
+            std::string line = session.input.substr(start, newline - start);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            start = newline + 1;
+            handleLine(loop, session, line);
+        }
+        session.input.erase(0, start);
+        if (session.input.size() > MAX_LINE) {
+            send(session, "error line too long");
+            session.closing = true;
+        }
+        if (ended) session.closing = true; // Answer what was asked, then hang up
+    }
+
+    void MatchServer::send(Session& session, const std::string& line) {
+        session.output += line;
+        session.output += '\n';
+    }
+
+    void MatchServer::flush(Loop& loop, Session& session) {
+        while (session.sent < session.output.size()) {
+            ssize_t count = ::write(session.fd, session.output.data() + session.sent, session.output.size() - session.sent);
+            if (count > 0) {
+                session.sent += static_cast<std::size_t>(count);
+                continue;
+            }
+            if (count < 0 && errno == EINTR) continue;
+            if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                if (session.output.size() - session.sent > MAX_PENDING) {
+                    session.dead = true; // The client stopped reading
+                } else if (!session.watchingWrites) {
+                    session.watchingWrites = loop.poller.modify(session.fd, true);
+                }
+                return;
+            }
+            session.dead = true;
+            return;
+        }
+        session.output.clear();
+        session.sent = 0;
+        if (session.watchingWrites) {
+            loop.poller.modify(session.fd, false);
+            session.watchingWrites = false;
+        }
+    }
+
+    void MatchServer::settle(Loop& loop, Session& session) {
+        if (!session.dead && session.sent < session.output.size()) flush(loop, session);
+        if (session.dead || (session.closing && session.output.empty())) closeSession(loop, session.fd);
+    }
+
+    void MatchServer::closeSession(Loop& loop, int fd) {
+        loop.poller.remove(fd);
+        ::close(fd);
+        auto found = loop.sessions.find(fd);
+        if (found != loop.sessions.end()) found->second->closed->store(true);
+        loop.sessions.erase(fd); // A pending engine reply finds no session and is dropped
+        --sessionsOpen;
+        if (acceptPaused.load()) {
+            if (&loop == loops[0].get()) resumeAccepting();
+            else loops[0]->wake();
+        }
+    }
+
+    void MatchServer::handleLine(Loop& loop, Session& session, const std::string& line) {
+        std::istringstream in(line);
+        std::string command;
+        in >> command;
+        if (command.empty()) return;
+        if (command == "ping") {
+            send(session, "pong");
+        } else if (command == "stats") {
+            send(session, statsLine());
+        } else if (command == "quit") {
+            send(session, "bye");
+            session.closing = true;
+        } else if (command == "match") {
+            std::string white, black;
+            in >> white >> black;
+            if (black.empty()) {
+                send(session, "error usage: match WHITE BLACK|computer");
+            } else if (white.size() > MAX_NAME || black.size() > MAX_NAME) {
+                send(session, "error names are limited to " + std::to_string(MAX_NAME) + " characters");
+            } else if (session.thinking) {
+                send(session, "error the engine is thinking");
+            } else {
+                startMatch(session, white, black);
+            }
+        } else if (!session.match) {
+            send(session, "error no match; start one with: match WHITE BLACK|computer");
+        } else if (command == "board") {
+            send(session, "board " + session.match->board().toFEN());
+        } else if (command == "moves") {
+            std::string reply = "moves";
+            if (!session.match->isRoundOver()) {
+                const LegalMoveSet& moves = session.match->legalMoves();
+                for (int i = 0; i < moves.size(); ++i) reply += " " + Notation::toCoordinate(moves[i]);
+            }
+            send(session, reply);
+        } else if (command == "move" || command == "resign") {
+            Match& match = *session.match;
+            if (match.isOver()) {
+                send(session, "error the match is over; start another with: match WHITE BLACK|computer");
+            } else if (session.thinking || match.computerToMove()) {
+                send(session, "error not your turn");
+            } else if (command == "resign") {
+                reportRoundEnd(session, match.resign());
+            } else {
+                std::string text;
+                in >> text;
+                playMove(loop, session, text);
+            }
+        } else {
+            send(session, "error unknown command " + command);
+        }
+    }
+
+    void MatchServer::startMatch(Session& session, const std::string& white, const std::string& black) {
+        bool computer = black == "computer";
+        session.match.reset(new Match(white, computer ? "HardChess" : black, computer));
+        session.match->setTablebase(options.tablebase);
+        ++matchesStarted;
+        send(session, "ok match " + white + " " + session.match->black().getName() + " rounds " +
+                          std::to_string(Match::ROUNDS_TO_WIN) + " hearts " +
+                          std::to_string(session.match->white().getHearts()));
+        send(session, "round 1 start");
+    }
+
+    void MatchServer::playMove(Loop& loop, Session& session, const std::string& text) {
+        Match& match = *session.match;
+        Move move;
+        if (text.empty() || !match.parseMove(text, move)) {
+            send(session, "error illegal move " + text);
+            return;
+        }
+        std::string san = Notation::toSAN(match.board(), move, session.scratch);
+        RoundEnd end = match.play(move);
+        ++movesPlayed;
+        send(session, "played " + Notation::toCoordinate(move) + " " + san);
+        if (end != RoundEnd::NONE) {
+            reportRoundEnd(session, end);
+        } else if (match.computerToMove()) {
+            askEngine(loop, session);
+        }
+    }
+
+    void MatchServer::reportRoundEnd(Session& session, RoundEnd end) {
+        Match& match = *session.match;
+        const Player* winner = match.roundWinner();
+        const char* result = !winner ? "1/2-1/2" : winner == &match.white() ? "1-0" : "0-1";
+        send(session, "round " + std::to_string(match.round()) + " end " + result + " " + Match::describe(end) +
+                          scoreLine(match));
+        if (match.isOver()) {
+            const Player* champion = match.winner();
+            send(session, std::string("match end ") +
+                              (!champion ? "draw" : champion == &match.white() ? "white" : "black") + scoreLine(match));
+        } else {
+            match.nextRound();
+            send(session, "round " + std::to_string(match.round()) + " start");
+        }
+    }
+
+    void MatchServer::askEngine(Loop& loop, Session& session) {
+        session.thinking = true;
+        Loop* owner = &loop;
+        int fd = session.fd;
+        std::uint64_t serial = session.serial;
+        Board board = session.match->board();
+        RepetitionHistory history = session.match->positions();
+        std::shared_ptr<std::atomic<bool>> closed = session.closed;
+        engines->submit([this, owner, fd, serial, board, history, closed]() mutable {
+            // Each pool thread keeps its own search tables from move to move
+            thread_local std::unique_ptr<Search> search;
+            thread_local std::mt19937_64 bookRandom(std::random_device{}());
+            EngineReply reply{fd, serial, Move(), std::string(), 0};
+            if (!stopping.load(std::memory_order_relaxed) && !closed->load(std::memory_order_relaxed)) {
+                auto begin = std::chrono::steady_clock::now();
+                TbResult endgame;
+                if (options.tablebase && options.tablebase->bestMove(board, reply.move, endgame)) {
+                    reply.source = "tablebase";
+                } else if (options.book && options.book->probe(board, bookRandom, reply.move)) {
+                    reply.source = "book";
+                } else {
+                    if (!search) search.reset(new Search());
+                    SearchResult result = search->run(board, options.engineLimits, &history);
+                    if (result.hasMove) {
+                        reply.move = result.bestMove;
+                        reply.source = "depth=" + std::to_string(result.depth);
+                    }
+                }
+                reply.micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - begin).count();
+            }
+            {
+                std::lock_guard<std::mutex> lock(owner->mutex);
+                owner->replies.push_back(std::move(reply));
+            }
+            owner->wake();
+        });
+    }
+
+    void MatchServer::engineReplied(Loop& loop, const EngineReply& reply) {
+        auto found = loop.sessions.find(reply.fd);
+        if (found == loop.sessions.end() || found->second->serial != reply.serial) return;
+        Session& session = *found->second;
+        session.thinking = false;
+        if (reply.source.empty()) {
+            if (!stopping.load()) send(session, "error the engine found no move");
+        } else {
+            // The client cannot move or restart while the engine thinks, so the position is
+            // still the one the move was computed for
+            Match& match = *session.match;
+            std::string san = Notation::toSAN(match.board(), reply.move, session.scratch);
+            RoundEnd end = match.play(reply.move);
+            ++engineMoves;
+            engineMicros += reply.micros;
+            send(session, "engine " + Notation::toCoordinate(reply.move) + " " + san + " " + reply.source);
+            if (end != RoundEnd::NONE) reportRoundEnd(session, end);
+        }
+        settle(loop, session);
+    }
+
+    std::string MatchServer::statsLine() const {
+        double uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        long long computed = engineMoves.load();
+        std::ostringstream out;
+        out.setf(std::ios::fixed);
+        out.precision(3);
+        out << "stats sessions=" << sessionsOpen.load() << " matches=" << matchesStarted.load()
+            << " moves=" << movesPlayed.load() << " engine-moves=" << computed
+            << " engine-ms=" << (computed ? engineMicros.load() / 1000.0 / computed : 0.0)
+            << " cpu-seconds=" << cpuSeconds() << " uptime-seconds=" << uptime << " loops=" << loops.size()
+            << " engine-threads=" << (engines ? engines->size() : 0);
+        return out.str();
+    }
+
+} // namespace HardChess
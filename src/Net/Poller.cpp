@@ -0,0 +1,123 @@
+#include "HardChess/Net/Poller.h"
+#include <cerrno>
+#include <cstdint>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+namespace HardChess {
+
+    Poller::Poller() : handle(-1) {}
+
+    Poller::~Poller() {
+        if (handle >= 0) ::close(handle);
+    }
+
+#ifdef __linux__
+
+    namespace {
+        constexpr int maxEvents = 256;
+
+        std::uint32_t interest(bool wantWrite) {
+            return EPOLLIN | EPOLLRDHUP | (wantWrite ? EPOLLOUT : 0u);
+        }
+    } // namespace
+
+    bool Poller::open() {
+        handle = epoll_create1(EPOLL_CLOEXEC);
+        buffer.resize(sizeof(epoll_event) * maxEvents);
+        return handle >= 0;
+    }
+
+    bool Poller::add(int fd, bool wantWrite) {
+        epoll_event event = {};
+        event.events = interest(wantWrite);
+        event.data.fd = fd;
+        return epoll_ctl(handle, EPOLL_CTL_ADD, fd, &event) == 0;
+    }
+
+    bool Poller::modify(int fd, bool wantWrite) {
+        epoll_event event = {};
+        event.events = interest(wantWrite);
+        event.data.fd = fd;
+        return epoll_ctl(handle, EPOLL_CTL_MOD, fd, &event) == 0;
+    }
+
+    void Poller::remove(int fd) {
+        epoll_ctl(handle, EPOLL_CTL_DEL, fd, nullptr);
+    }
+
+    bool Poller::wait(std::vector<Event>& events, int timeoutMs) {
+        events.clear();
+        epoll_event* ready = reinterpret_cast<epoll_event*>(buffer.data());
+        int count = epoll_wait(handle, ready, maxEvents, timeoutMs);
+        if (count < 0) return errno == EINTR;
+        for (int i = 0; i < count; ++i) {
+            std::uint32_t flags = ready[i].events;
+            events.push_back({ready[i].data.fd, (flags & EPOLLIN) != 0, (flags & EPOLLOUT) != 0,
+                              (flags & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) != 0});
+        }
+        return true;
+    }
+
+#else
+
+    bool Poller::open() {
+        return true;
+    }
+
+    bool Poller::add(int fd, bool wantWrite) {
+        watched.push_back(fd);
+        writeInterest.push_back(wantWrite);
+        return true;
+    }
+
+    bool Poller::modify(int fd, bool wantWrite) {
+        for (std::size_t i = 0; i < watched.size(); ++i) {
+            if (watched[i] == fd) {
+                writeInterest[i] = wantWrite;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Poller::remove(int fd) {
+        for (std::size_t i = 0; i < watched.size(); ++i) {
+            if (watched[i] == fd) {
+                watched[i] = watched.back();
+                writeInterest[i] = writeInterest.back();
+                watched.pop_back();
+                writeInterest.pop_back();
+                return;
+            }
+        }
+    }
+
+    bool Poller::wait(std::vector<Event>& events, int timeoutMs) {
+        events.clear();
+        buffer.resize(sizeof(pollfd) * watched.size());
+        pollfd* records = reinterpret_cast<pollfd*>(buffer.data());
+        for (std::size_t i = 0; i < watched.size(); ++i) {
+            records[i].fd = watched[i];
+            records[i].events = static_cast<short>(POLLIN | (writeInterest[i] ? POLLOUT : 0));
+            records[i].revents = 0;
+        }
+        int count = ::poll(records, static_cast<nfds_t>(watched.size()), timeoutMs);
+        if (count < 0) return errno == EINTR;
+        for (std::size_t i = 0; i < watched.size() && count > 0; ++i) {
+            short flags = records[i].revents;
+            if (!flags) continue;
+            --count;
+            events.push_back({records[i].fd, (flags & POLLIN) != 0, (flags & POLLOUT) != 0,
+                              (flags & (POLLERR | POLLHUP | POLLNVAL)) != 0});
+        }
+        return true;
+    }
+
+#endif
+
+} // namespace HardChess
@@ -0,0 +1,118 @@
+#include "HardChess/Net/Socket.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace HardChess {
+
+    namespace Socket {
+
+        namespace {
+
+            // The sockaddr for address, or false with error set
+            bool resolve(const std::string& address, sockaddr_storage& storage, socklen_t& length, std::string& error) {
+                std::memset(&storage, 0, sizeof(storage));
+                if (address.compare(0, 5, "unix:") == 0) {
+                    sockaddr_un* local = reinterpret_cast<sockaddr_un*>(&storage);
+                    std::string path = address.substr(5);
+                    if (path.empty() || path.size() >= sizeof(local->sun_path)) {
+                        error = "bad Unix socket path in " + address;
+                        return false;
+                    }
+                    local->sun_family = AF_UNIX;
+                    std::memcpy(local->sun_path, path.c_str(), path.size() + 1);
+                    length = static_cast<socklen_t>(sizeof(sockaddr_un));
+                    return true;
+                }
+                std::size_t colon = address.rfind(':');
+                std::string host = colon == std::string::npos ? "127.0.0.1" : address.substr(0, colon);
+                std::string port = colon == std::string::npos ? address : address.substr(colon + 1);
+                if (host.empty()) host = "127.0.0.1";
+                char* end = nullptr;
+                long number = std::strtol(port.c_str(), &end, 10);
+                sockaddr_in* inet = reinterpret_cast<sockaddr_in*>(&storage);
+                if (port.empty() || *end != '\0' || number <= 0 || number > 65535 ||
+                    inet_pton(AF_INET, host.c_str(), &inet->sin_addr) != 1) {
+                    error = "bad address " + address + " (use PORT, HOST:PORT or unix:PATH)";
+                    return false;
+                }
+                inet->sin_family = AF_INET;
+                inet->sin_port = htons(static_cast<std::uint16_t>(number));
+                length = static_cast<socklen_t>(sizeof(sockaddr_in));
+                return true;
+            }
+
+            int fail(int fd, const std::string& what, const std::string& address, std::string& error) {
+                error = what + " " + address + ": " + std::strerror(errno);
+                if (fd >= 0) ::close(fd);
+                return -1;
+            }
+
+        } // namespace
+
+        int listenOn(const std::string& address, std::string& error) {
+            sockaddr_storage storage;
+            socklen_t length;
+            if (!resolve(address, storage, length, error)) return -1;
+            int fd = ::socket(storage.ss_family, SOCK_STREAM, 0);
+            if (fd < 0) return fail(fd, "cannot create socket for", address, error);
+            if (storage.ss_family == AF_UNIX) {
+                ::unlink(reinterpret_cast<sockaddr_un*>(&storage)->sun_path);
+            } else {
+                int on = 1;
+                setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+            }
+            if (::bind(fd, reinterpret_cast<sockaddr*>(&storage), length) != 0) {
+                return fail(fd, "cannot bind", address, error);
+            }
+            if (::listen(fd, SOMAXCONN) != 0) return fail(fd, "cannot listen on", address, error);
+            if (!setNonBlocking(fd)) return fail(fd, "cannot configure", address, error);
+            return fd;
+        }
+
+        int connectTo(const std::string& address, std::string& error) {
+            sockaddr_storage storage;
+            socklen_t length;
+            if (!resolve(address, storage, length, error)) return -1;
+            int fd = ::socket(storage.ss_family, SOCK_STREAM, 0);
+            if (fd < 0) return fail(fd, "cannot create socket for", address, error);
+            if (::connect(fd, reinterpret_cast<sockaddr*>(&storage), length) != 0) {
+                return fail(fd, "cannot connect to", address, error);
+            }
+            if (storage.ss_family == AF_INET) setNoDelay(fd);
+            return fd;
+        }
+
+        bool setNonBlocking(int fd) {
+            int flags = fcntl(fd, F_GETFL, 0);
+            return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+        }
+
+        void setNoDelay(int fd) {
+            int on = 1; // One short line per message: do not hold it back for more
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+
+        long raiseDescriptorLimit() {
+            rlimit limit;
+            if (getrlimit(RLIMIT_NOFILE, &limit) != 0) return -1;
+            if (limit.rlim_cur < limit.rlim_max) {
+                limit.rlim_cur = limit.rlim_max;
+                setrlimit(RLIMIT_NOFILE, &limit);
+                getrlimit(RLIMIT_NOFILE, &limit);
+            }
+            return static_cast<long>(limit.rlim_cur);
+        }
+
+    } // namespace Socket
+
+} // namespace HardChess
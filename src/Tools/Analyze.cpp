@@ -0,0 +1,301 @@
+// Batch position analysis.
+//
+// Usage: analyze [options] [input]
+//   input            FEN or EPD records, one per line ("-" or omitted: stdin)
+//   -o FILE          Output file (default: stdout)
+//   --depth N        Search depth per position (default 5 when no other limit is set)
+//   --nodes N        Node budget per position
+//   --movetime MS    Time budget per position
+//   --multipv K      Report the best K moves, each with its own score and PV (default 1)
+//   --threads N      Worker threads (default: all cores)
+//   --window N       Positions allowed in flight ahead of the writer (default: 64 per thread)
+//   --cache FILE     Persistent analysis cache: positions already searched to the requested
+//                    depth (any depth under --nodes/--movetime) are answered from it, and
+//                    new results are appended; created if missing
+//   --cache-readonly Consult the cache without adding to it
+//   --compact        Compact the cache (one sorted record per position) after the run
+//
+// Each input line produces one output line, in input order, as an EPD record:
+//   <position> bm e2e4; ce 35; acd 6; acn 120345; pv e2e4 e7e5 g1f3; id "...";
+// With --multipv the runners-up follow as numbered operations, best first:
+//   ... pv e2e4 e7e5; bm2 d2d4; ce2 30; pv2 d2d4 d7d5; bm3 g1f3; ce3 28; pv3 g1f3 d7d5;
+// Blank and '#' lines are copied through so outputs stay line-aligned with inputs.
+// Input is streamed through a fixed buffer and output through a buffered writer;
+// a bounded reorder window keeps memory flat regardless of input length. Several
+// analyze processes can share one cache file; the cache hit rate goes to stderr.
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/LegalMoveSet.h"
+#include "HardChess/Core/Notation.h"
+#include "HardChess/Engine/AnalysisCache.h"
+#include "HardChess/Engine/Search.h"
+#include "HardChess/IO/BufferedWriter.h"
+#include "HardChess/IO/LineReader.h"
+#include "HardChess/Util/ReorderBuffer.h"
+#include "HardChess/Util/ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace HardChess;
+
+namespace {
+
+    struct Options {
+        std::string input = "-";
+        std::string output = "-";
+        SearchLimits limits;
+        unsigned threads = 0;
+        std::size_t window = 0;
+        std::string cachePath;
+        bool cacheReadOnly = false;
+        bool compact = false;
+    };
+
+    void usage() {
+        std::cerr << "usage: analyze [-o FILE] [--depth N] [--nodes N] [--movetime MS] [--multipv K] [--threads N]"
+                     " [--window N]"
+                     " [--cache FILE [--cache-readonly] [--compact]] [input]"
+                  << std::endl;
+        std::exit(2);
+    }
+
+    bool isCounter(std::string_view field) {
+        if (field.empty()) return false;
+        for (char ch : field) {
+            if (ch < '0' || ch > '9') return false;
+        }
+        return true;
+    }
+
+    // Splits an EPD/FEN line into the position part and the operations that follow it
+    void splitRecord(std::string_view line, std::string_view& position, std::string_view& operations) {
+        std::size_t fieldEnds[6] = {};
+        std::size_t fieldBegins[6] = {};
+        int fields = 0;
+        std::size_t i = 0;
+        while (fields < 6) {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) ++i;
+            if (i >= line.size()) break;
+            fieldBegins[fields] = i;
+            while (i < line.size() && line[i] != ' ' && line[i] != '\t') ++i;
+            fieldEnds[fields++] = i;
+        }
+        std::size_t positionEnd = fields >= 4 ? fieldEnds[3] : line.size();
+        // Full FEN: the two move counters follow the four EPD fields
+        if (fields == 6 &&
+            isCounter(line.substr(fieldBegins[4], fieldEnds[4] - fieldBegins[4])) &&
+            isCounter(line.substr(fieldBegins[5], fieldEnds[5] - fieldBegins[5]))) {
+            positionEnd = fieldEnds[5];
+        }
+        position = line.substr(0, positionEnd);
+        operations = line.substr(positionEnd);
+    }
+
+    // The EPD "id" operation, including its quotes, if present
+    std::string_view findId(std::string_view operations) {
+        std::size_t at = operations.find("id \"");
+        if (at == std::string_view::npos) return std::string_view();
+        std::size_t close = operations.find('"', at + 4);
+        if (close == std::string_view::npos) return std::string_view();
+        return operations.substr(at, close - at + 1);
+    }
+
+    std::atomic<long long> totalNodes(0);
+
+    // Move from its 16-bit encoding, without the flags only a board can supply
+    Move moveFromCode(std::uint16_t code) {
+        static const PieceType promotions[8] = {PieceType::NONE,  PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK,
+                                                PieceType::QUEEN, PieceType::NONE,   PieceType::NONE,   PieceType::NONE};
+        return Move(squareAt((code >> 6) & 63), squareAt(code & 63), promotions[(code >> 12) & 7]);
+    }
+
+    // A cached result for board, unless its best move is not legal here (a key collision)
+    bool fromCache(AnalysisCache& cache, Board& board, const SearchLimits& limits, SearchResult& result) {
+        CachedAnalysis entry;
+        if (!cache.find(board.getKey(), limits.depth > 0 ? limits.depth : 1, entry)) return false;
+        result.hasMove = entry.hasMove != 0;
+        if (result.hasMove) {
+            LegalMoveSet legal;
+            legal.update(board);
+            Move best = moveFromCode(entry.move);
+            const Move* match = legal.find(best.from, best.to, best.promotion);
+            if (!match) return false;
+            result.bestMove = *match;
+        }
+        result.score = entry.score;
+        result.depth = entry.depth;
+        result.nodes = static_cast<long long>(entry.nodes);
+        result.pv.clear();
+        for (int i = 0; i < entry.pvLength; ++i) result.pv.push_back(moveFromCode(entry.pv[i]));
+        return true;
+    }
+
+    std::string analyzeLine(const std::string& line, const SearchLimits& limits, AnalysisCache* cache) {
+        std::string_view text(line);
+        if (text.empty() || text[0] == '#') return line;
+
+        std::string_view position, operations;
+        splitRecord(text, position, operations);
+
+        thread_local Board board;
+        thread_local Search search;
+        std::string out(position);
+        if (!board.fromFEN(position)) {
+            out += " error \"invalid position\";";
+            return out;
+        }
+
+        SearchResult result;
+        // The cache holds one line per position, so multi-PV only adds to it
+        if (!cache || limits.multiPv > 1 || !fromCache(*cache, board, limits, result)) {
+            result = search.run(board, limits);
+            totalNodes.fetch_add(result.nodes, std::memory_order_relaxed);
+            if (cache && result.depth > 0) cache->store(CachedAnalysis::from(board.getKey(), result));
+        }
+
+        char move[5];
+        if (result.hasMove) {
+            out += " bm ";
+            out.append(move, Notation::formatCoordinate(result.bestMove, move));
+            out += ";";
+        }
+        out += " ce " + std::to_string(result.score) + ";";
+        int mate = Search::mateInMoves(result.score);
+        if (mate != 0) out += " dm " + std::to_string(mate) + ";";
+        out += " acd " + std::to_string(result.depth) + "; acn " + std::to_string(result.nodes) + ";";
+        if (!result.pv.empty()) {
+            out += " pv";
+            for (const Move& pvMove : result.pv) {
+                out += ' ';
+                out.append(move, Notation::formatCoordinate(pvMove, move));
+            }
+            out += ";";
+        }
+        for (std::size_t i = 1; i < result.lines.size(); ++i) {
+            const SearchLine& line = result.lines[i];
+            std::string number = std::to_string(i + 1);
+            out += " bm" + number + " ";
+            out.append(move, Notation::formatCoordinate(line.move, move));
+            out += "; ce" + number + " " + std::to_string(line.score) + "; pv" + number;
+            for (const Move& pvMove : line.pv) {
+                out += ' ';
+                out.append(move, Notation::formatCoordinate(pvMove, move));
+            }
+            out += ";";
+        }
+        std::string_view id = findId(operations);
+        if (!id.empty()) {
+            out += ' ';
+            out.append(id.data(), id.size());
+            out += ';';
+        }
+        return out;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) usage();
+            return argv[++i];
+        };
+        if (arg == "-o" || arg == "--output") options.output = value();
+        else if (arg == "--depth") options.limits.depth = std::atoi(value());
+        else if (arg == "--nodes") options.limits.nodes = std::atoll(value());
+        else if (arg == "--movetime") options.limits.timeMs = std::atoi(value());
+        else if (arg == "--multipv") options.limits.multiPv = std::atoi(value());
+        else if (arg == "--threads") options.threads = static_cast<unsigned>(std::atoi(value()));
+        else if (arg == "--window") options.window = static_cast<std::size_t>(std::atoll(value()));
+        else if (arg == "--cache") options.cachePath = value();
+        else if (arg == "--cache-readonly") options.cacheReadOnly = true;
+        else if (arg == "--compact") options.compact = true;
+        else if (arg == "-h" || arg == "--help") usage();
+        else if (arg.size() > 1 && arg[0] == '-') usage();
+        else options.input = arg;
+    }
+    if (options.limits.depth <= 0 && options.limits.nodes <= 0 && options.limits.timeMs <= 0) {
+        options.limits.depth = 5;
+    }
+    if ((options.cacheReadOnly || options.compact) && options.cachePath.empty()) usage();
+    if (options.threads == 0) options.threads = ThreadPool::defaultThreadCount();
+    if (options.window == 0) options.window = static_cast<std::size_t>(options.threads) * 64;
+
+    LineReader reader;
+    if (!reader.open(options.input)) {
+        std::cerr << "analyze: cannot open " << options.input << std::endl;
+        return 2;
+    }
+    BufferedWriter writer;
+    if (!writer.open(options.output)) {
+        std::cerr << "analyze: cannot create " << options.output << std::endl;
+        return 2;
+    }
+    AnalysisCache cache;
+    if (!options.cachePath.empty() && !cache.open(options.cachePath, !options.cacheReadOnly)) {
+        std::cerr << "analyze: cannot open analysis cache " << options.cachePath << std::endl;
+        return 2;
+    }
+    AnalysisCache* sharedCache = cache.isOpen() ? &cache : nullptr;
+
+    auto begin = std::chrono::steady_clock::now();
+    ReorderBuffer<std::string> ordered(options.window);
+    std::size_t count = 0;
+    {
+        ThreadPool pool(options.threads, options.window);
+        std::thread writerThread([&]() {
+            std::string record;
+            while (ordered.take(record)) {
+                writer.write(record);
+                writer.put('\n');
+            }
+        });
+
+        std::string_view line;
+        const SearchLimits limits = options.limits;
+        while (reader.next(line)) {
+            std::size_t index = count++;
+            ordered.admit(index); // Backpressure: never more than `window` lines in flight
+            pool.submit([&ordered, index, text = std::string(line), limits, sharedCache]() {
+                ordered.put(index, analyzeLine(text, limits, sharedCache));
+            });
+        }
+        ordered.close(count);
+        writerThread.join();
+    }
+    bool written = writer.close();
+    std::uint64_t hits = cache.hits(), misses = cache.misses();
+    if (cache.isOpen() && !cache.close()) {
+        std::cerr << "analyze: failed writing analysis cache " << options.cachePath << std::endl;
+        written = false;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if (seconds <= 0) seconds = 1e-9;
+    std::cerr << "analyze: positions=" << count << " seconds=" << seconds
+              << " positions/sec=" << static_cast<long long>(count / seconds)
+              << " nodes/sec=" << static_cast<long long>(totalNodes.load() / seconds);
+    if (!options.cachePath.empty()) {
+        std::cerr << " cache_hits=" << hits << " cache_misses=" << misses
+                  << " hit_rate=" << (hits + misses ? 100.0 * hits / (hits + misses) : 0.0) << "%";
+    }
+    std::cerr << std::endl;
+
+    if (options.compact) {
+        std::size_t before = 0, after = 0;
+        if (!AnalysisCache::compact(options.cachePath, before, after)) {
+            std::cerr << "analyze: cannot compact " << options.cachePath << std::endl;
+            return 1;
+        }
+        std::cerr << "analyze: compacted " << options.cachePath << " from " << before << " to " << after << " records"
+                  << std::endl;
+    }
+    return written ? 0 : 1;
+}
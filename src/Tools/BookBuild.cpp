@@ -0,0 +1,266 @@
+// Builds a polyglot opening book from PGN files and game archives.
+//
+// Usage: bookbuild [options] -o book.bin input...
+//   input            .pgn or .hcga files
+//   -o FILE          Output book
+//   --max-ply N      Only positions within the first N plies (default 24)
+//   --min-weight N   Drop moves whose accumulated score is below N (default 1)
+//   --memory MB      Sort buffer budget (default 256); larger corpora spill to disk
+//   --tmp DIR        Directory for sort runs (default: output directory)
+//   --keys FILE      Hash key table to use instead of the built-in one (see Zobrist.h)
+//
+// Every (position, move) seen scores 2 for a win of the side that played it, 1 for a
+// draw or unknown result and 0 for a loss. Entries are sorted with a bounded-memory
+// external merge sort, equal pairs are merged, and each position's weights are scaled
+// to fit 16 bits.
+
+#include "HardChess/Core/Zobrist.h"
+#include "HardChess/Engine/OpeningBook.h"
+#include "HardChess/IO/BufferedWriter.h"
+#include "HardChess/IO/GameArchive.h"
+#include "HardChess/IO/MappedFile.h"
+#include "HardChess/IO/PgnReader.h"
+#include "HardChess/Util/ExternalSort.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    struct Options {
+        std::vector<std::string> inputs;
+        std::string output;
+        std::string tempDirectory;
+        std::string keyFile;
+        int maxPly = 24;
+        std::uint64_t minWeight = 1;
+        std::size_t memoryBytes = std::size_t(256) << 20;
+    };
+
+    // One observation of a move; sorted by key, then move
+    struct Sample {
+        std::uint64_t key;
+        std::uint16_t move;
+        std::uint16_t points;
+        std::uint32_t padding;
+    };
+
+    struct SampleLess {
+        bool operator()(const Sample& a, const Sample& b) const {
+            return a.key != b.key ? a.key < b.key : a.move < b.move;
+        }
+    };
+
+    using SampleSorter = ExternalSorter<Sample, SampleLess>;
+
+    void usage() {
+        std::cerr << "usage: bookbuild [--max-ply N] [--min-weight N] [--memory MB] [--tmp DIR] [--keys FILE] -o book.bin input..."
+                  << std::endl;
+        std::exit(2);
+    }
+
+    bool endsWith(const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    std::uint16_t pointsFor(GameResult result, Color mover) {
+        if (result == GameResult::WHITE_WINS) return mover == Color::WHITE ? 2 : 0;
+        if (result == GameResult::BLACK_WINS) return mover == Color::BLACK ? 2 : 0;
+        return 1;
+    }
+
+    void addSample(SampleSorter& sorter, const Board& board, const Move& move, GameResult result, bool& ok) {
+        Sample sample;
+        sample.key = Zobrist::hash(board);
+        sample.move = OpeningBook::encodeMove(move);
+        sample.points = pointsFor(result, board.getSideToMove());
+        sample.padding = 0;
+        if (!sorter.add(sample)) ok = false;
+    }
+
+    // Collects the opening moves of each replayed game and emits them once the result is known
+    class PgnSampler : public PgnVisitor {
+      private:
+        SampleSorter& sorter;
+        int maxPly;
+        Board start;
+        std::vector<Move> moves;
+
+      public:
+        std::size_t samples = 0;
+        bool ok = true;
+
+        PgnSampler(SampleSorter& s, int plies) : sorter(s), maxPly(plies) {}
+
+        void onGameStart(const PgnGame& /*game*/, const Board& board) override {
+            start = board;
+            moves.clear();
+        }
+
+        void onMove(const Board& /*board*/, const Move& move, std::string_view /*san*/) override {
+            if (static_cast<int>(moves.size()) < maxPly) moves.push_back(move);
+        }
+
+        void onGameEnd(const PgnGame& game, const Board& /*board*/, std::string_view result, bool replayed) override {
+            if (!replayed) return;
+            GameResult parsed = parseGameResult(result);
+            if (parsed == GameResult::UNKNOWN) parsed = parseGameResult(game.tag("Result"));
+            for (const Move& move : moves) {
+                addSample(sorter, start, move, parsed, ok);
+                start.applyMove(move);
+                ++samples;
+            }
+        }
+    };
+
+    bool samplePgn(const std::string& path, SampleSorter& sorter, int maxPly, std::size_t& games, std::size_t& samples) {
+        MappedFile pgn;
+        if (!pgn.open(path)) return false;
+        pgn.adviseSequential();
+        PgnSampler sampler(sorter, maxPly);
+        PgnStats stats = PgnReader::replayAll(pgn.view(), &sampler);
+        games += stats.games - stats.errors;
+        samples += sampler.samples;
+        if (stats.errors > 0) std::cerr << "bookbuild: " << path << ": " << stats.errors << " games skipped" << std::endl;
+        return sampler.ok;
+    }
+
+    bool sampleArchive(const std::string& path, SampleSorter& sorter, int maxPly, std::size_t& games, std::size_t& samples) {
+        GameArchive archive;
+        if (!archive.open(path)) return false;
+        Board board;
+        bool ok = true;
+        for (std::size_t i = 0; i < archive.size(); ++i) {
+            ArchivedGame game;
+            if (!archive.game(i, game)) return false;
+            if (game.startFEN.empty()) board.initializeBoard();
+            else if (!board.fromFEN(game.startFEN)) continue;
+            std::size_t plies = std::min<std::size_t>(game.moves.size(), static_cast<std::size_t>(maxPly));
+            for (std::size_t ply = 0; ply < plies; ++ply) {
+                Move move = board.decodeMove(game.moves[ply]);
+                addSample(sorter, board, move, game.result, ok);
+                board.applyMove(move);
+                ++samples;
+            }
+            ++games;
+        }
+        return ok;
+    }
+
+    // Merges equal (key, move) samples and writes each position's moves with scaled weights
+    class BookEmitter {
+      private:
+        BufferedWriter& out;
+        std::uint64_t minWeight;
+        std::uint64_t currentKey = 0;
+        std::vector<std::pair<std::uint16_t, std::uint64_t>> moves; // Moves of the current key
+
+        void flushPosition() {
+            std::uint64_t maxWeight = 0;
+            for (const auto& entry : moves) maxWeight = std::max(maxWeight, entry.second);
+            for (const auto& entry : moves) {
+                if (entry.second < minWeight) continue;
+                BookEntry book;
+                book.key = currentKey;
+                book.move = entry.first;
+                book.weight = static_cast<std::uint16_t>(maxWeight > 0xFFFF ? entry.second * 0xFFFF / maxWeight : entry.second);
+                if (book.weight == 0) continue;
+                unsigned char bytes[OpeningBook::ENTRY_SIZE];
+                OpeningBook::writeEntry(book, bytes);
+                out.write(bytes, sizeof(bytes));
+                ++entries;
+            }
+            if (!moves.empty()) ++positions;
+            moves.clear();
+        }
+
+      public:
+        std::size_t entries = 0;
+        std::size_t positions = 0;
+
+        BookEmitter(BufferedWriter& writer, std::uint64_t minimum) : out(writer), minWeight(minimum) {}
+
+        void operator()(const Sample& sample) {
+            if (!moves.empty() && sample.key != currentKey) flushPosition();
+            currentKey = sample.key;
+            if (!moves.empty() && moves.back().first == sample.move) moves.back().second += sample.points;
+            else moves.emplace_back(sample.move, sample.points);
+        }
+
+        void finish() { flushPosition(); }
+    };
+
+    Options parseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) usage();
+                return argv[++i];
+            };
+            if (arg == "-o") options.output = value();
+            else if (arg == "--max-ply") options.maxPly = std::atoi(value().c_str());
+            else if (arg == "--min-weight") options.minWeight = std::strtoull(value().c_str(), nullptr, 10);
+            else if (arg == "--memory") options.memoryBytes = std::strtoull(value().c_str(), nullptr, 10) << 20;
+            else if (arg == "--tmp") options.tempDirectory = value();
+            else if (arg == "--keys") options.keyFile = value();
+            else if (!arg.empty() && arg[0] == '-') usage();
+            else options.inputs.push_back(arg);
+        }
+        if (options.output.empty() || options.inputs.empty() || options.maxPly <= 0) usage();
+        if (options.tempDirectory.empty()) {
+            std::size_t slash = options.output.rfind('/');
+            options.tempDirectory = slash == std::string::npos ? "." : options.output.substr(0, slash);
+        }
+        return options;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options = parseOptions(argc, argv);
+    if (!options.keyFile.empty() && !Zobrist::loadKeyTable(options.keyFile)) {
+        std::cerr << "bookbuild: cannot load key table " << options.keyFile << std::endl;
+        return 2;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    SampleSorter sorter(options.memoryBytes, options.tempDirectory);
+    std::size_t games = 0;
+    std::size_t samples = 0;
+    for (const std::string& input : options.inputs) {
+        bool ok = endsWith(input, ".hcga") ? sampleArchive(input, sorter, options.maxPly, games, samples)
+                                           : samplePgn(input, sorter, options.maxPly, games, samples);
+        if (!ok) {
+            std::cerr << "bookbuild: failed reading " << input << std::endl;
+            return 1;
+        }
+    }
+
+    BufferedWriter out;
+    if (!out.open(options.output)) {
+        std::cerr << "bookbuild: cannot create " << options.output << std::endl;
+        return 2;
+    }
+    BookEmitter emitter(out, options.minWeight);
+    if (!sorter.finish([&](const Sample& sample) { emitter(sample); })) {
+        std::cerr << "bookbuild: sort failed" << std::endl;
+        return 1;
+    }
+    emitter.finish();
+    if (!out.close()) {
+        std::cerr << "bookbuild: failed writing " << options.output << std::endl;
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "games=" << games << " samples=" << samples << " runs=" << sorter.runCount()
+              << " positions=" << emitter.positions << " entries=" << emitter.entries
+              << " bytes=" << emitter.entries * OpeningBook::ENTRY_SIZE << " seconds=" << seconds << std::endl;
+    return 0;
+}
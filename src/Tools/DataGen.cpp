@@ -0,0 +1,250 @@
+// Generates evaluator training data from fast self-play games.
+//
+// Usage: datagen [options]
+//   -o PREFIX          Output shards PREFIX-000.hctd, PREFIX-001.hctd, ... (default "datagen")
+//   --games N          Games to play in total (default 1000)
+//   --shards N         Output shards (default: one per thread)
+//   --threads N        Worker threads (default: all cores)
+//   --depth N          Search depth per move (default 4)
+//   --nodes N          Node budget per move instead of a depth
+//   --random-plies N   Uniformly random opening plies, for variety (default 8)
+//   --max-plies N      Games still running after N plies are scored as draws (default 400)
+//   --seed N           Base seed (default 1)
+//   --report SEC       Progress interval on stderr, 0 for none (default 5)
+//
+// Each shard plays its share of the games with its own generator, seeded from the base
+// seed and the shard number, and writes them through its own buffered writer, so a
+// shard's contents depend only on --seed, --games, --shards and the search limit; never
+// on the thread count or scheduling. Every searched position is recorded as a 32-byte
+// PackedPosition (see TrainingData.h) labelled with the search score and, once the game
+// ends, its result. Positions in check, positions whose best move captures or promotes,
+// and mate scores are left out: they say little about the static evaluation. After the
+// run every shard is streamed back through TrainingDataReader to check the counts and
+// time the reader.
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/RepetitionHistory.h"
+#include "HardChess/Engine/Search.h"
+#include "HardChess/IO/TrainingData.h"
+#include "HardChess/Util/ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    struct Options {
+        std::string prefix = "datagen";
+        std::uint64_t games = 1000;
+        unsigned shards = 0;
+        unsigned threads = 0;
+        SearchLimits limits;
+        int randomPlies = 8;
+        int maxPlies = 400;
+        std::uint64_t seed = 1;
+        int reportSeconds = 5;
+    };
+
+    struct Progress {
+        std::atomic<std::uint64_t> games{0};
+        std::atomic<std::uint64_t> positions{0};
+        std::atomic<unsigned> shardsDone{0};
+        std::atomic<bool> failed{false};
+    };
+
+    void usage() {
+        std::cerr << "usage: datagen [-o PREFIX] [--games N] [--shards N] [--threads N] [--depth N] [--nodes N]"
+                     " [--random-plies N] [--max-plies N] [--seed N] [--report SEC]"
+                  << std::endl;
+        std::exit(2);
+    }
+
+    // splitmix64: spreads consecutive shard numbers over unrelated seeds
+    std::uint64_t shardSeed(std::uint64_t base, unsigned shard) {
+        std::uint64_t z = base + 0x9E3779B97F4A7C15ull * (shard + 1);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    std::string shardPath(const std::string& prefix, unsigned shard) {
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), "-%03u.hctd", shard);
+        return prefix + suffix;
+    }
+
+    // True when neither side can ever mate: bare kings, or a lone minor piece
+    bool deadDrawn(const Board& board) {
+        int men = __builtin_popcountll(board.occupiedSquares());
+        if (men == 2) return true;
+        if (men != 3) return false;
+        for (Color color : {Color::WHITE, Color::BLACK}) {
+            if (board.pieces(color, PieceType::KNIGHT).count || board.pieces(color, PieceType::BISHOP).count) return true;
+        }
+        return false;
+    }
+
+    // Plays one game and appends its recorded positions to records; returns the number of
+    // positions added
+    std::size_t playGame(Board& board, RepetitionHistory& history, Search& search, std::mt19937_64& rng,
+                         const Options& options, std::vector<Move>& moves, std::vector<PackedPosition>& records) {
+        board.initializeBoard();
+        history.reset(board.getKey());
+        std::size_t first = records.size();
+        int whiteResult = 0; // 1 White won, -1 Black won, 0 drawn
+        for (int ply = 0;; ++ply) {
+            board.generateLegalMoves(moves);
+            Color mover = board.getSideToMove();
+            bool inCheck = board.isKingInCheck(mover);
+            if (moves.empty()) {
+                if (inCheck) whiteResult = mover == Color::WHITE ? -1 : 1;
+                break;
+            }
+            if (board.isFiftyMoveDraw() || history.isThreefold(board.getHalfmoveClock()) || deadDrawn(board) ||
+                ply >= options.maxPlies) {
+                break;
+            }
+
+            Move move;
+            if (ply < options.randomPlies) {
+                move = moves[std::uniform_int_distribution<std::size_t>(0, moves.size() - 1)(rng)];
+            } else {
+                SearchResult result = search.run(board, options.limits, &history);
+                move = result.bestMove;
+                bool quiet = !move.isCapture() && move.promotion == PieceType::NONE;
+                if (!inCheck && quiet && Search::mateInMoves(result.score) == 0) {
+                    records.push_back(PackedPosition::pack(board, result.score, 0));
+                }
+            }
+            board.applyMove(move);
+            history.push(board.getKey());
+        }
+        // The result is only known now; store it from each record's side to move
+        for (std::size_t i = first; i < records.size(); ++i) {
+            records[i].result = static_cast<std::int8_t>(records[i].whiteToMove() ? whiteResult : -whiteResult);
+        }
+        return records.size() - first;
+    }
+
+    void generateShard(unsigned shard, std::uint64_t games, const Options& options, Progress& progress) {
+        std::uint64_t seed = shardSeed(options.seed, shard);
+        TrainingDataWriter writer;
+        if (!writer.open(shardPath(options.prefix, shard), seed)) {
+            progress.failed = true;
+            progress.shardsDone.fetch_add(1);
+            return;
+        }
+        std::mt19937_64 rng(seed);
+        auto search = std::make_unique<Search>(); // Fresh per shard: no state carried in from other shards
+        Board board;
+        RepetitionHistory history;
+        std::vector<Move> moves;
+        std::vector<PackedPosition> records; // One game's, reused
+        for (std::uint64_t game = 0; game < games; ++game) {
+            records.clear();
+            std::size_t added = playGame(board, history, *search, rng, options, moves, records);
+            for (const PackedPosition& record : records) writer.add(record);
+            progress.positions.fetch_add(added, std::memory_order_relaxed);
+            progress.games.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (!writer.close()) progress.failed = true;
+        progress.shardsDone.fetch_add(1);
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) usage();
+            return argv[++i];
+        };
+        if (arg == "-o") options.prefix = value();
+        else if (arg == "--games") options.games = std::strtoull(value(), nullptr, 10);
+        else if (arg == "--shards") options.shards = static_cast<unsigned>(std::atoi(value()));
+        else if (arg == "--threads") options.threads = static_cast<unsigned>(std::atoi(value()));
+        else if (arg == "--depth") options.limits.depth = std::atoi(value());
+        else if (arg == "--nodes") options.limits.nodes = std::atoll(value());
+        else if (arg == "--random-plies") options.randomPlies = std::atoi(value());
+        else if (arg == "--max-plies") options.maxPlies = std::atoi(value());
+        else if (arg == "--seed") options.seed = std::strtoull(value(), nullptr, 10);
+        else if (arg == "--report") options.reportSeconds = std::atoi(value());
+        else usage();
+    }
+    // Time limits would make the output depend on machine load, so only depth and nodes
+    if (options.limits.depth <= 0 && options.limits.nodes <= 0) options.limits.depth = 4;
+    if (options.threads == 0) options.threads = ThreadPool::defaultThreadCount();
+    if (options.shards == 0) options.shards = options.threads;
+    if (options.games == 0 || options.randomPlies < 0 || options.maxPlies <= 0) usage();
+
+    Progress progress;
+    auto begin = std::chrono::steady_clock::now();
+    auto elapsed = [&]() {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return seconds > 0 ? seconds : 1e-9;
+    };
+    {
+        ThreadPool pool(options.threads, options.shards);
+        for (unsigned shard = 0; shard < options.shards; ++shard) {
+            std::uint64_t games = options.games / options.shards + (shard < options.games % options.shards ? 1 : 0);
+            pool.submit([shard, games, &options, &progress]() { generateShard(shard, games, options, progress); });
+        }
+        auto nextReport = std::chrono::steady_clock::now() + std::chrono::seconds(options.reportSeconds);
+        while (progress.shardsDone.load() < options.shards) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (options.reportSeconds > 0 && std::chrono::steady_clock::now() >= nextReport) {
+                nextReport += std::chrono::seconds(options.reportSeconds);
+                std::uint64_t positions = progress.positions.load();
+                std::cerr << "datagen: games=" << progress.games.load() << "/" << options.games
+                          << " positions=" << positions
+                          << " positions/sec=" << static_cast<long long>(positions / elapsed()) << std::endl;
+            }
+        }
+    }
+    double seconds = elapsed();
+    if (progress.failed) {
+        std::cerr << "datagen: failed writing shards " << options.prefix << "-*.hctd" << std::endl;
+        return 1;
+    }
+    std::uint64_t positions = progress.positions.load();
+    std::cout << "games=" << progress.games.load() << " positions=" << positions << " shards=" << options.shards
+              << " seconds=" << seconds << " positions/sec=" << static_cast<long long>(positions / seconds) << std::endl;
+
+    // Stream everything back: checks the counts and measures the reader
+    auto readBegin = std::chrono::steady_clock::now();
+    std::uint64_t read = 0;
+    long long scoreSum = 0;
+    for (unsigned shard = 0; shard < options.shards; ++shard) {
+        TrainingDataReader reader;
+        if (!reader.open(shardPath(options.prefix, shard))) {
+            std::cerr << "datagen: cannot read " << shardPath(options.prefix, shard) << std::endl;
+            return 1;
+        }
+        const PackedPosition* record;
+        while (reader.next(record)) {
+            scoreSum += record->score;
+            ++read;
+        }
+    }
+    double readSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - readBegin).count();
+    if (readSeconds <= 0) readSeconds = 1e-9;
+    std::cout << "read records=" << read << " seconds=" << readSeconds
+              << " records/sec=" << static_cast<long long>(read / readSeconds)
+              << " mean_score=" << (read ? static_cast<double>(scoreSum) / read : 0.0) << std::endl;
+    if (read != positions) {
+        std::cerr << "datagen: read back " << read << " records, expected " << positions << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Opening-explorer queries against an index built by indexbuild.
+//
+// Usage: explore [options] index.hcpi [fen...]
+//   fen              Positions to look up (default: FEN lines from stdin)
+//   --moves N        Moves listed per position, most played first (default 10)
+//   --repeat N       Lookups timed per position (default 1000)
+//
+// Prints how often each position was reached, its White/draw/Black split and the moves
+// played from it, followed by the mean lookup time. The index is mapped, not loaded,
+// so the first lookups of a cold index include page faults; --repeat shows the warm
+// cost.
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/Core/LegalMoveSet.h"
+#include "HardChess/Core/Notation.h"
+#include "HardChess/IO/LineReader.h"
+#include "HardChess/IO/PositionIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    struct Options {
+        std::string indexPath;
+        std::vector<std::string> positions;
+        std::size_t moves = 10;
+        int repeat = 1000;
+    };
+
+    void usage() {
+        std::cerr << "usage: explore [--moves N] [--repeat N] index.hcpi [fen...]" << std::endl;
+        std::exit(2);
+    }
+
+    std::string split(const ExplorerCounts& counts) {
+        char text[96];
+        double games = static_cast<double>(std::max<std::uint64_t>(counts.games(), 1));
+        std::snprintf(text, sizeof(text), "white %.1f%% draw %.1f%% black %.1f%%", 100.0 * counts.whiteWins / games,
+                      100.0 * counts.draws / games, 100.0 * counts.blackWins / games);
+        return text;
+    }
+
+    // Returns the lookup time in microseconds
+    double explore(const PositionIndex& index, const Options& options, const std::string& fen,
+                   std::vector<ExplorerMove>& moves, std::vector<Move>& scratch) {
+        Board board;
+        if (!board.fromFEN(fen)) {
+            std::cout << fen << "\n  invalid FEN" << std::endl;
+            return -1;
+        }
+        std::uint64_t key = board.getKey();
+        ExplorerCounts total;
+        std::size_t found = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < options.repeat; ++i) found = index.find(key, total, moves.data(), moves.size());
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() /
+                        options.repeat;
+
+        std::cout << fen << "\n  games " << total.games() << ": " << split(total) << std::endl;
+        std::size_t listed = std::min(found, moves.size());
+        std::sort(moves.begin(), moves.begin() + listed,
+                  [](const ExplorerMove& a, const ExplorerMove& b) { return a.counts.games() > b.counts.games(); });
+        LegalMoveSet legal;
+        legal.update(board);
+        for (std::size_t i = 0; i < listed && i < options.moves; ++i) {
+            Move move = board.decodeMove(moves[i].move);
+            // A hash collision can list a move that is not legal here
+            const Move* match = legal.find(move.from, move.to, move.promotion);
+            std::string name = match ? Notation::toSAN(board, *match, scratch) : Notation::toCoordinate(move) + "?";
+            char line[64];
+            std::snprintf(line, sizeof(line), "  %-8s %10llu  ", name.c_str(),
+                          static_cast<unsigned long long>(moves[i].counts.games()));
+            std::cout << line << split(moves[i].counts) << std::endl;
+        }
+        std::cout << "  lookup_us=" << micros << std::endl;
+        return micros;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) usage();
+            return argv[++i];
+        };
+        if (arg == "--moves") options.moves = static_cast<std::size_t>(std::atoi(value()));
+        else if (arg == "--repeat") options.repeat = std::atoi(value());
+        else if (arg == "-h" || arg == "--help") usage();
+        else if (arg.size() > 1 && arg[0] == '-') usage();
+        else if (options.indexPath.empty()) options.indexPath = arg;
+        else options.positions.push_back(arg);
+    }
+    if (options.indexPath.empty() || options.repeat <= 0) usage();
+
+    PositionIndex index;
+    if (!index.open(options.indexPath)) {
+        std::cerr << "explore: " << options.indexPath << " is not a position index" << std::endl;
+        return 2;
+    }
+    std::cerr << "explore: " << index.games() << " games, " << index.positions() << " positions, " << index.entries()
+              << " entries in " << index.blocks() << " blocks (" << index.bytes() / 1024 << " KB)" << std::endl;
+
+    std::vector<ExplorerMove> moves(256); // More moves than any position has
+    std::vector<Move> scratch;
+    double totalMicros = 0;
+    int queries = 0;
+    auto query = [&](const std::string& fen) {
+        double micros = explore(index, options, fen, moves, scratch);
+        if (micros < 0) return;
+        totalMicros += micros;
+        ++queries;
+    };
+    if (!options.positions.empty()) {
+        for (const std::string& fen : options.positions) query(fen);
+    } else {
+        LineReader reader;
+        if (!reader.open("-")) return 2;
+        std::string_view line;
+        while (reader.next(line)) {
+            if (!line.empty() && line[0] != '#') query(std::string(line));
+        }
+    }
+    if (queries > 0) std::cerr << "explore: queries=" << queries << " mean lookup_us=" << totalMicros / queries << std::endl;
+    return 0;
+}
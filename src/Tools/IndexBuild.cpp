@@ -0,0 +1,412 @@
+// Builds an opening-explorer position index from PGN files and game archives.
+//
+// Usage: indexbuild [options] -o index.hcpi input...
+//   input            .pgn or .hcga files
+//   -o FILE          Output index
+//   --max-ply N      Index positions within the first N plies, 0 for all (default 40)
+//   --threads N      Worker threads (default: all cores)
+//   --memory MB      Sort buffer budget shared by the workers (default 256)
+//   --tmp DIR        Directory for sort runs and shard files (default: output directory)
+//   --keys FILE      Hash key table to use instead of the built-in one (see Zobrist.h)
+//
+// Every input is cut into shards (PGN files at game boundaries, archives by game
+// number), one per thread. A worker replays its shard's games, external-sorts one
+// (position, move, result) sample per ply within its share of the memory budget, and
+// writes the merged counts to a sorted shard file. The shard files are then merged into
+// the block-compressed index (see PositionIndex.h). Memory stays bounded however large
+// the corpus; a game's last position is counted under move 0.
+
+#include "HardChess/Core/Zobrist.h"
+#include "HardChess/IO/BufferedWriter.h"
+#include "HardChess/IO/GameArchive.h"
+#include "HardChess/IO/MappedFile.h"
+#include "HardChess/IO/PgnReader.h"
+#include "HardChess/IO/PositionIndex.h"
+#include "HardChess/Util/ExternalSort.h"
+#include "HardChess/Util/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    struct Options {
+        std::vector<std::string> inputs;
+        std::string output;
+        std::string tempDirectory;
+        std::string keyFile;
+        int maxPly = 40;
+        unsigned threads = 0;
+        std::size_t memoryBytes = std::size_t(256) << 20;
+    };
+
+    // One position seen in one game; sorted by key, then move
+    struct Sample {
+        std::uint64_t key;
+        std::uint16_t move;   // 0 when the game ended in this position
+        std::uint8_t result;  // GameResult
+        std::uint8_t padding1;
+        std::uint32_t padding2;
+    };
+
+    struct SampleLess {
+        bool operator()(const Sample& a, const Sample& b) const {
+            return a.key != b.key ? a.key < b.key : a.move < b.move;
+        }
+    };
+
+    using SampleSorter = ExternalSorter<Sample, SampleLess>;
+
+    // A slice of one input: a PGN text range or a range of archive games
+    struct Shard {
+        std::string_view pgn;
+        const GameArchive* archive = nullptr;
+        std::size_t firstGame = 0;
+        std::size_t endGame = 0;
+    };
+
+    struct ShardResult {
+        std::string path; // Sorted PositionIndexEntry records
+        std::size_t games = 0;
+        std::size_t samples = 0;
+        std::size_t errors = 0;
+        std::size_t runs = 0;
+        bool ok = false;
+    };
+
+    void usage() {
+        std::cerr << "usage: indexbuild [--max-ply N] [--threads N] [--memory MB] [--tmp DIR] [--keys FILE] -o index.hcpi input..."
+                  << std::endl;
+        std::exit(2);
+    }
+
+    bool endsWith(const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    void addCount(PositionIndexEntry& entry, GameResult result) {
+        std::uint32_t& count = result == GameResult::WHITE_WINS ? entry.whiteWins
+                               : result == GameResult::BLACK_WINS ? entry.blackWins
+                                                                  : entry.draws;
+        if (count < 0xFFFFFFFFu) ++count; // Saturates rather than wraps
+    }
+
+    void addEntry(PositionIndexEntry& into, const PositionIndexEntry& from) {
+        auto saturatingAdd = [](std::uint32_t a, std::uint32_t b) {
+            return a > 0xFFFFFFFFu - b ? 0xFFFFFFFFu : a + b;
+        };
+        into.whiteWins = saturatingAdd(into.whiteWins, from.whiteWins);
+        into.draws = saturatingAdd(into.draws, from.draws);
+        into.blackWins = saturatingAdd(into.blackWins, from.blackWins);
+    }
+
+    // Feeds the sorter one game at a time, once the game's result is known
+    class GameSampler {
+      private:
+        SampleSorter& sorter;
+        int maxPly;
+        std::vector<Sample> game; // Samples of the game being read
+
+      public:
+        std::size_t samples = 0;
+        bool ok = true;
+
+        GameSampler(SampleSorter& s, int plies) : sorter(s), maxPly(plies) {}
+
+        void begin() { game.clear(); }
+
+        void position(const Board& board, std::uint16_t move) {
+            if (maxPly > 0 && static_cast<int>(game.size()) >= maxPly) return;
+            Sample sample;
+            sample.key = board.getKey();
+            sample.move = move;
+            sample.result = 0;
+            sample.padding1 = 0;
+            sample.padding2 = 0;
+            game.push_back(sample);
+        }
+
+        void end(GameResult result) {
+            for (Sample& sample : game) {
+                sample.result = static_cast<std::uint8_t>(result);
+                if (!sorter.add(sample)) ok = false;
+            }
+            samples += game.size();
+        }
+    };
+
+    class PgnSampler : public PgnVisitor {
+      private:
+        GameSampler& sampler;
+
+      public:
+        explicit PgnSampler(GameSampler& s) : sampler(s) {}
+
+        void onGameStart(const PgnGame& /*game*/, const Board& /*board*/) override { sampler.begin(); }
+
+        void onMove(const Board& board, const Move& move, std::string_view /*san*/) override {
+            sampler.position(board, move.encode());
+        }
+
+        void onGameEnd(const PgnGame& game, const Board& board, std::string_view result, bool replayed) override {
+            if (!replayed) return;
+            GameResult parsed = parseGameResult(result);
+            if (parsed == GameResult::UNKNOWN) parsed = parseGameResult(game.tag("Result"));
+            sampler.position(board, 0);
+            sampler.end(parsed);
+        }
+    };
+
+    bool createTemp(const std::string& directory, std::string& path) {
+        path = directory + "/hardchess-shard-XXXXXX";
+        int fd = mkstemp(&path[0]);
+        if (fd < 0) return false;
+        ::close(fd);
+        return true;
+    }
+
+    void buildShard(const Shard& shard, const Options& options, std::size_t memoryBytes, ShardResult& result) {
+        SampleSorter sorter(memoryBytes, options.tempDirectory);
+        GameSampler sampler(sorter, options.maxPly);
+        if (shard.archive) {
+            Board board;
+            for (std::size_t i = shard.firstGame; i < shard.endGame; ++i) {
+                ArchivedGame game;
+                if (!shard.archive->game(i, game)) return;
+                if (game.startFEN.empty()) board.initializeBoard();
+                else if (!board.fromFEN(game.startFEN)) {
+                    ++result.errors;
+                    continue;
+                }
+                sampler.begin();
+                for (std::size_t ply = 0; ply < game.moves.size(); ++ply) {
+                    Move move = board.decodeMove(game.moves[ply]);
+                    sampler.position(board, move.encode());
+                    board.applyMove(move);
+                }
+                sampler.position(board, 0);
+                sampler.end(game.result);
+                ++result.games;
+            }
+        } else {
+            PgnSampler visitor(sampler);
+            PgnStats stats = PgnReader::replayAll(shard.pgn, &visitor);
+            result.games += stats.games - stats.errors;
+            result.errors += stats.errors;
+        }
+        result.samples = sampler.samples;
+        if (!sampler.ok || !createTemp(options.tempDirectory, result.path)) return;
+
+        BufferedWriter out(1 << 16);
+        if (!out.open(result.path)) return;
+        PositionIndexEntry current = {};
+        bool pending = false;
+        bool sorted = sorter.finish([&](const Sample& sample) {
+            if (pending && (sample.key != current.key || sample.move != current.move)) {
+                out.write(&current, sizeof(current));
+                pending = false;
+            }
+            if (!pending) {
+                current = PositionIndexEntry();
+                current.key = sample.key;
+                current.move = sample.move;
+                pending = true;
+            }
+            addCount(current, static_cast<GameResult>(sample.result));
+        });
+        if (pending) out.write(&current, sizeof(current));
+        result.runs = sorter.runCount();
+        result.ok = out.close() && sorted;
+    }
+
+    // Sequential reader over one shard file
+    struct ShardReader {
+        std::FILE* file = nullptr;
+        std::vector<PositionIndexEntry> block;
+        std::size_t position = 0;
+        std::size_t filled = 0;
+
+        bool next(PositionIndexEntry& entry) {
+            if (position == filled) {
+                filled = std::fread(block.data(), sizeof(PositionIndexEntry), block.size(), file);
+                position = 0;
+                if (filled == 0) return false;
+            }
+            entry = block[position++];
+            return true;
+        }
+    };
+
+    // K-way merge of the shard files into the index, adding up equal (key, move) pairs
+    bool mergeShards(const std::vector<ShardResult>& shards, std::size_t memoryBytes, PositionIndexWriter& writer) {
+        std::vector<ShardReader> readers(shards.size());
+        std::size_t blockEntries = std::max<std::size_t>(memoryBytes / sizeof(PositionIndexEntry) / std::max<std::size_t>(shards.size(), 1), 256);
+        bool ok = true;
+        for (std::size_t i = 0; i < shards.size(); ++i) {
+            readers[i].file = std::fopen(shards[i].path.c_str(), "rb");
+            if (!readers[i].file) ok = false;
+            else readers[i].block.resize(blockEntries);
+        }
+
+        struct Head {
+            PositionIndexEntry entry;
+            std::size_t shard;
+        };
+        auto after = [](const Head& a, const Head& b) {
+            return a.entry.key != b.entry.key ? a.entry.key > b.entry.key : a.entry.move > b.entry.move;
+        };
+        std::priority_queue<Head, std::vector<Head>, decltype(after)> heads(after);
+        for (std::size_t i = 0; ok && i < readers.size(); ++i) {
+            Head head;
+            head.shard = i;
+            if (readers[i].next(head.entry)) heads.push(head);
+        }
+        PositionIndexEntry current = {};
+        bool pending = false;
+        while (ok && !heads.empty()) {
+            Head head = heads.top();
+            heads.pop();
+            if (pending && head.entry.key == current.key && head.entry.move == current.move) {
+                addEntry(current, head.entry);
+            } else {
+                if (pending) writer.add(current);
+                current = head.entry;
+                pending = true;
+            }
+            if (readers[head.shard].next(head.entry)) heads.push(head);
+        }
+        if (ok && pending) writer.add(current);
+        for (ShardReader& reader : readers) {
+            if (reader.file) std::fclose(reader.file);
+        }
+        return ok;
+    }
+
+    Options parseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) usage();
+                return argv[++i];
+            };
+            if (arg == "-o") options.output = value();
+            else if (arg == "--max-ply") options.maxPly = std::atoi(value().c_str());
+            else if (arg == "--threads") options.threads = static_cast<unsigned>(std::atoi(value().c_str()));
+            else if (arg == "--memory") options.memoryBytes = std::strtoull(value().c_str(), nullptr, 10) << 20;
+            else if (arg == "--tmp") options.tempDirectory = value();
+            else if (arg == "--keys") options.keyFile = value();
+            else if (!arg.empty() && arg[0] == '-') usage();
+            else options.inputs.push_back(arg);
+        }
+        if (options.output.empty() || options.inputs.empty() || options.maxPly < 0) usage();
+        if (options.threads == 0) options.threads = ThreadPool::defaultThreadCount();
+        if (options.tempDirectory.empty()) {
+            std::size_t slash = options.output.rfind('/');
+            options.tempDirectory = slash == std::string::npos ? "." : options.output.substr(0, slash);
+        }
+        return options;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options = parseOptions(argc, argv);
+    if (!options.keyFile.empty() && !Zobrist::loadKeyTable(options.keyFile)) {
+        std::cerr << "indexbuild: cannot load key table " << options.keyFile << std::endl;
+        return 2;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    // Inputs stay mapped until every shard is built
+    std::vector<std::unique_ptr<MappedFile>> pgnFiles;
+    std::vector<std::unique_ptr<GameArchive>> archives;
+    std::vector<Shard> shards;
+    for (const std::string& input : options.inputs) {
+        if (endsWith(input, ".hcga")) {
+            archives.emplace_back(new GameArchive());
+            if (!archives.back()->open(input)) {
+                std::cerr << "indexbuild: cannot open archive " << input << std::endl;
+                return 2;
+            }
+            std::size_t games = archives.back()->size();
+            for (unsigned part = 0; part < options.threads; ++part) {
+                Shard shard;
+                shard.archive = archives.back().get();
+                shard.firstGame = games * part / options.threads;
+                shard.endGame = games * (part + 1) / options.threads;
+                if (shard.endGame > shard.firstGame) shards.push_back(shard);
+            }
+        } else {
+            pgnFiles.emplace_back(new MappedFile());
+            if (!pgnFiles.back()->open(input)) {
+                std::cerr << "indexbuild: cannot map " << input << std::endl;
+                return 2;
+            }
+            for (std::string_view slice : PgnReader::splitAtGameBoundaries(pgnFiles.back()->view(), options.threads)) {
+                Shard shard;
+                shard.pgn = slice;
+                shards.push_back(shard);
+            }
+        }
+    }
+
+    // At most `threads` shards are sorting at once, each within its share of the budget
+    std::vector<ShardResult> results(shards.size());
+    std::size_t shardMemory = options.memoryBytes / options.threads;
+    {
+        ThreadPool pool(options.threads);
+        for (std::size_t i = 0; i < shards.size(); ++i) {
+            pool.submit([&, i]() { buildShard(shards[i], options, shardMemory, results[i]); });
+        }
+        pool.waitIdle();
+    }
+    double shardSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    std::size_t games = 0, samples = 0, errors = 0, runs = 0;
+    bool shardsOk = true;
+    for (const ShardResult& result : results) {
+        games += result.games;
+        samples += result.samples;
+        errors += result.errors;
+        runs += result.runs;
+        shardsOk = shardsOk && result.ok;
+    }
+
+    PositionIndexWriter writer;
+    bool ok = shardsOk && writer.open(options.output);
+    if (!shardsOk) std::cerr << "indexbuild: failed building shards" << std::endl;
+    else if (!ok) std::cerr << "indexbuild: cannot create " << options.output << std::endl;
+    if (ok && !mergeShards(results, options.memoryBytes, writer)) {
+        std::cerr << "indexbuild: cannot read shard files" << std::endl;
+        ok = false;
+    }
+    if (ok && !writer.close(games)) {
+        std::cerr << "indexbuild: failed writing " << options.output << std::endl;
+        ok = false;
+    }
+    for (const ShardResult& result : results) {
+        if (!result.path.empty()) std::remove(result.path.c_str());
+    }
+    if (!ok) return 1;
+    if (errors > 0) std::cerr << "indexbuild: " << errors << " games skipped" << std::endl;
+
+    PositionIndex index;
+    index.open(options.output);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "games=" << games << " samples=" << samples << " shards=" << shards.size() << " runs=" << runs
+              << " positions=" << writer.positions() << " entries=" << writer.entries() << " blocks=" << index.blocks()
+              << " bytes=" << index.bytes() << " bytes/entry="
+              << (writer.entries() ? static_cast<double>(index.bytes()) / writer.entries() : 0.0)
+              << " shard_seconds=" << shardSeconds << " seconds=" << seconds << std::endl;
+    return 0;
+}
@@ -0,0 +1,368 @@
+// Drives a match server (HardChess --serve) with many concurrent sessions and reports
+// move latency and how many sessions one server core carries.
+//
+// Usage: loadgen [ADDR] [options]
+//   ADDR               Server address as given to --serve (default 7070)
+//   --sessions N       Sessions playing the computer at once (default 100)
+//   --idle N           Extra sessions that connect and then stay silent (default 0)
+//   --moves N          Moves each playing session makes; finished matches are restarted
+//                      until then (default 20)
+//   --seed N           Move choice seed (default 1)
+//   --timeout SEC      Give up, and fail, after SEC seconds (default 300)
+//   --tb DIR           The tables the server was given with --tb, so that tablebase draws
+//                      end rounds here too
+//
+// Every playing session starts "match loadN computer" and answers each engine move with
+// a uniformly random legal move, following the match in its own Match so that it knows
+// when a round ends and can check the server's round reports against it. A
+// move's latency runs from sending it to the reply that hands the move back: the engine's
+// move, or the end of the round. The server's CPU time before and after the run (from its
+// stats command) gives the cores it kept busy; sessions per core is the playing sessions
+// divided by that. Exits non-zero on any error reply, lost session or timeout.
+
+#include "HardChess/Core/Match.h"
+#include "HardChess/Core/Notation.h"
+#include "HardChess/Engine/Tablebase.h"
+#include "HardChess/Net/Poller.h"
+#include "HardChess/Net/Socket.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string address = "7070";
+        int sessions = 100;
+        int idle = 0;
+        int moves = 20;
+        std::uint64_t seed = 1;
+        int timeoutSeconds = 300;
+        const Tablebase* tablebase = nullptr;
+    };
+
+    struct Client {
+        int fd = -1;
+        int id = 0;
+        bool playing = false;      // False for an idle session
+        std::string input;
+        std::string output;
+        std::size_t sent = 0;
+        bool watchingWrites = false;
+        std::unique_ptr<Match> match;
+        int movesLeft = 0;
+        bool waiting = false;      // A move is out and its reply has not come back
+        Clock::time_point sentAt;
+        bool done = false;
+    };
+
+    void usage() {
+        std::cerr << "usage: loadgen [ADDR] [--sessions N] [--idle N] [--moves N] [--seed N] [--timeout SEC] [--tb DIR]"
+                  << std::endl;
+        std::exit(2);
+    }
+
+    // One line from a blocking connection
+    bool readLine(int fd, std::string& line) {
+        line.clear();
+        char c;
+        while (::read(fd, &c, 1) == 1) {
+            if (c == '\n') return true;
+            line += c;
+        }
+        return false;
+    }
+
+    // One request and its one-line answer over a blocking connection
+    bool ask(int fd, const std::string& request, std::string& answer) {
+        std::string line = request + "\n";
+        if (::write(fd, line.data(), line.size()) != static_cast<ssize_t>(line.size())) return false;
+        return readLine(fd, answer);
+    }
+
+    double statValue(const std::string& stats, const std::string& key) {
+        std::size_t at = stats.find(" " + key + "=");
+        return at == std::string::npos ? 0 : std::atof(stats.c_str() + at + key.size() + 2);
+    }
+
+    class LoadGenerator {
+      public:
+        LoadGenerator(const Options& options) : options(options), random(options.seed), errors(0), lost(0) {}
+
+        bool connectAll() {
+            std::string error;
+            if (!poller.open()) {
+                std::cerr << "loadgen: cannot create poller" << std::endl;
+                return false;
+            }
+            for (int i = 0; i < options.sessions + options.idle; ++i) {
+                int fd = Socket::connectTo(options.address, error);
+                if (fd < 0) {
+                    std::cerr << "loadgen: session " << i << ": " << error << std::endl;
+                    return false;
+                }
+                Socket::setNonBlocking(fd);
+                Client& client = clients[fd];
+                client.fd = fd;
+                client.id = i;
+                client.playing = i < options.sessions;
+                client.movesLeft = options.moves;
+                client.done = !client.playing;
+                poller.add(fd);
+            }
+            return true;
+        }
+
+        // Until every playing session has made its moves; false on timeout or poll failure
+        bool run() {
+            Clock::time_point deadline = Clock::now() + std::chrono::seconds(options.timeoutSeconds);
+            int finished = 0;
+            std::vector<Poller::Event> events;
+            while (finished < options.sessions) {
+                int left = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count());
+                if (left <= 0) {
+                    std::cerr << "loadgen: timed out with " << options.sessions - finished << " sessions unfinished" << std::endl;
+                    return false;
+                }
+                if (!poller.wait(events, std::min(left, 1000))) return false;
+                for (const Poller::Event& event : events) {
+                    auto found = clients.find(event.fd);
+                    if (found == clients.end()) continue;
+                    Client& client = found->second;
+                    bool wasDone = client.done;
+                    if (event.readable || event.hangup) receive(client);
+                    flush(client);
+                    if (!wasDone && client.done) ++finished;
+                }
+            }
+            return true;
+        }
+
+        void closeAll() {
+            for (auto& entry : clients) ::close(entry.first);
+            clients.clear();
+        }
+
+        std::vector<double> latencies; // Microseconds, one per move
+        long long errorCount() const { return errors; }
+        long long lostCount() const { return lost; }
+
+      private:
+        Options options;
+        Poller poller;
+        std::unordered_map<int, Client> clients;
+        std::mt19937_64 random;
+        long long errors;
+        long long lost;
+
+        void send(Client& client, const std::string& line) {
+            client.output += line;
+            client.output += '\n';
+        }
+
+        void flush(Client& client) {
+            while (client.sent < client.output.size()) {
+                ssize_t count = ::write(client.fd, client.output.data() + client.sent, client.output.size() - client.sent);
+                if (count > 0) {
+                    client.sent += static_cast<std::size_t>(count);
+                } else if (count < 0 && errno == EINTR) {
+                    continue;
+                } else {
+                    if (!client.watchingWrites) client.watchingWrites = poller.modify(client.fd, true);
+                    return;
+                }
+            }
+            client.output.clear();
+            client.sent = 0;
+            if (client.watchingWrites) client.watchingWrites = !poller.modify(client.fd, false);
+        }
+
+        void receive(Client& client) {
+            char buffer[4096];
+            while (true) {
+                ssize_t count = ::read(client.fd, buffer, sizeof(buffer));
+                if (count > 0) {
+                    client.input.append(buffer, static_cast<std::size_t>(count));
+                    continue;
+                }
+                if (count < 0 && errno == EINTR) continue;
+                if (count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    poller.remove(client.fd);
+                    if (!client.done) {
+                        ++lost;
+                        client.done = true;
+                    }
+                }
+                break;
+            }
+            std::size_t start = 0;
+            std::size_t newline;
+            while ((newline = client.input.find('\n', start)) != std::string::npos) {
+                handle(client, client.input.substr(start, newline - start));
+                start = newline + 1;
+            }
+            client.input.erase(0, start);
+        }
+
+        void handle(Client& client, const std::string& line) {
+            if (!client.playing) return; // Idle sessions only swallow the greeting
+            if (line.compare(0, 6, "error ") == 0) {
+                fail(client, line);
+            } else if (line == "hello hardchess 1") {
+                startMatch(client);
+            } else if (!client.match) {
+                return; // "ok match"
+            } else if (line.compare(0, 6, "round ") == 0 && line.compare(line.size() - 6, 6, " start") == 0) {
+                if (client.match->isRoundOver()) client.match->nextRound();
+                move(client);
+            } else if (line.compare(0, 6, "round ") == 0) {
+                if (!client.match->isRoundOver()) fail(client, "round ended early: " + line);
+                replied(client); // Unless the engine's move ended it, this answers the client's move
+            } else if (line.compare(0, 7, "played ") == 0 || line.compare(0, 7, "engine ") == 0) {
+                std::string coordinate = line.substr(7, line.find(' ', 7) - 7);
+                Move played;
+                if (!client.match->parseMove(coordinate, played)) {
+                    fail(client, "unexpected " + line);
+                    return;
+                }
+                RoundEnd end = client.match->play(played);
+                if (line[0] == 'e') {
+                    replied(client);
+                    if (end == RoundEnd::NONE) move(client);
+                }
+            } else if (line.compare(0, 10, "match end ") == 0) {
+                if (client.movesLeft > 0) startMatch(client);
+                else client.done = true;
+            }
+        }
+
+        void fail(Client& client, const std::string& what) {
+            if (++errors <= 5) std::cerr << "loadgen: session " << client.id << ": " << what << std::endl;
+        }
+
+        void startMatch(Client& client) {
+            std::string name = "load" + std::to_string(client.id);
+            client.match.reset(new Match(name, "HardChess", true));
+            client.match->setTablebase(options.tablebase);
+            send(client, "match " + name + " computer");
+        }
+
+        void replied(Client& client) {
+            if (!client.waiting) return;
+            client.waiting = false;
+            latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - client.sentAt).count());
+        }
+
+        // A random legal move for White, unless the session has made all of its moves
+        void move(Client& client) {
+            if (client.movesLeft <= 0) {
+                client.done = true;
+                return;
+            }
+            const LegalMoveSet& legal = client.match->legalMoves();
+            std::uniform_int_distribution<int> pick(0, legal.size() - 1);
+            send(client, "move " + Notation::toCoordinate(legal[pick(random)]));
+            --client.movesLeft;
+            client.waiting = true;
+            client.sentAt = Clock::now();
+        }
+    };
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    Tablebase tablebase;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) usage();
+            return argv[++i];
+        };
+        if (arg == "--sessions") options.sessions = std::atoi(value());
+        else if (arg == "--idle") options.idle = std::atoi(value());
+        else if (arg == "--moves") options.moves = std::atoi(value());
+        else if (arg == "--seed") options.seed = std::strtoull(value(), nullptr, 10);
+        else if (arg == "--timeout") options.timeoutSeconds = std::atoi(value());
+        else if (arg == "--tb") {
+            const char* directory = value();
+            if (!tablebase.open(directory)) {
+                std::cerr << "loadgen: no tables in " << directory << std::endl;
+                return 2;
+            }
+            options.tablebase = &tablebase;
+        }
+        else if (!arg.empty() && arg[0] != '-') options.address = arg;
+        else usage();
+    }
+    if (options.sessions <= 0 || options.idle < 0 || options.moves <= 0 || options.timeoutSeconds <= 0) usage();
+    std::signal(SIGPIPE, SIG_IGN);
+    long descriptors = Socket::raiseDescriptorLimit();
+    if (descriptors > 0 && options.sessions + options.idle + 16 > descriptors) {
+        std::cerr << "loadgen: " << options.sessions + options.idle << " sessions need more than the " << descriptors
+                  << " descriptors allowed" << std::endl;
+        return 2;
+    }
+
+    // A separate control connection reads the server's counters around the run
+    std::string error, before, after;
+    int control = Socket::connectTo(options.address, error);
+    if (control < 0) {
+        std::cerr << "loadgen: " << error << std::endl;
+        return 1;
+    }
+    std::string greeting;
+    if (!readLine(control, greeting) || !ask(control, "stats", before)) {
+        std::cerr << "loadgen: no answer from " << options.address << std::endl;
+        return 1;
+    }
+
+    LoadGenerator generator(options);
+    auto begin = Clock::now();
+    if (!generator.connectAll()) return 1;
+    bool completed = generator.run();
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    if (!ask(control, "stats", after)) after.clear();
+    generator.closeAll();
+    ::close(control);
+
+    std::vector<double>& latencies = generator.latencies;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        if (latencies.empty()) return 0.0;
+        return latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(p * latencies.size()))];
+    };
+    std::cout << "sessions=" << options.sessions << " idle=" << options.idle << " moves=" << latencies.size()
+              << " seconds=" << seconds << " moves/sec=" << static_cast<long long>(latencies.size() / seconds)
+              << std::endl;
+    std::cout << "latency_us p50=" << static_cast<long long>(percentile(0.50))
+              << " p99=" << static_cast<long long>(percentile(0.99))
+              << " max=" << static_cast<long long>(latencies.empty() ? 0 : latencies.back()) << std::endl;
+    if (!after.empty()) {
+        double cpu = statValue(after, "cpu-seconds") - statValue(before, "cpu-seconds");
+        double busyCores = cpu / seconds;
+        std::cout << "server cpu_seconds=" << cpu << " busy_cores=" << busyCores
+                  << " sessions/core=" << static_cast<long long>(busyCores > 0 ? options.sessions / busyCores : 0)
+                  << " engine_ms=" << statValue(after, "engine-ms") << " open_sessions=" << statValue(after, "sessions")
+                  << std::endl;
+    }
+    if (!completed || generator.errorCount() > 0 || generator.lostCount() > 0) {
+        std::cerr << "loadgen: " << generator.errorCount() << " errors, " << generator.lostCount() << " sessions lost"
+                  << (completed ? "" : ", run incomplete") << std::endl;
+        return 1;
+    }
+    return 0;
+}
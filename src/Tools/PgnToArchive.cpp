@@ -0,0 +1,50 @@
+// Converts a PGN file into a binary game archive (.hcga).
+//
+// Usage: pgn2hcga input.pgn output.hcga
+//
+// Games that fail to replay are skipped and counted; the archive index keeps the
+// remaining games in input order. Only moves, results and start positions are kept: PGN
+// tags, comments and variations are dropped (see GameArchive.h).
+
+#include "HardChess/IO/GameArchive.h"
+#include "HardChess/IO/MappedFile.h"
+#include "HardChess/IO/PgnReader.h"
+#include <iostream>
+
+using namespace HardChess;
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: pgn2hcga input.pgn output.hcga" << std::endl;
+        return 2;
+    }
+    MappedFile pgn;
+    if (!pgn.open(argv[1])) {
+        std::cerr << "pgn2hcga: cannot map " << argv[1] << std::endl;
+        return 2;
+    }
+    pgn.adviseSequential();
+
+    GameArchiveWriter writer;
+    if (!writer.open(argv[2])) {
+        std::cerr << "pgn2hcga: cannot create " << argv[2] << std::endl;
+        return 2;
+    }
+    std::size_t rejected = 0;
+    PgnRecordBuilder builder([&](const GameRecord& record) {
+        if (!writer.add(record)) ++rejected;
+    });
+    PgnStats stats = PgnReader::replayAll(pgn.view(), &builder);
+    std::size_t stored = writer.gameCount();
+    if (!writer.close()) {
+        std::cerr << "pgn2hcga: failed writing " << argv[2] << std::endl;
+        return 1;
+    }
+
+    GameArchive archive;
+    archive.open(argv[2]);
+    std::cout << "games=" << stats.games << " stored=" << stored << " replay-errors=" << stats.errors
+              << " rejected=" << rejected << " pgn-bytes=" << pgn.size() << " archive-bytes=" << archive.bytes()
+              << std::endl;
+    return 0;
+}
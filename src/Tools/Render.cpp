@@ -0,0 +1,253 @@
+// Headless board diagrams and game animations from the bundled piece textures.
+//
+// Usage: render [options] input
+//   input            FEN or EPD records, one diagram per line; or a .pgn file, one
+//                    animated PNG per game with a frame per position
+//   -o DIR           Output directory, which must exist (default: current directory)
+//   --size PX        Square size in pixels (default 64)
+//   --textures DIR   Piece textures (default: include/assets/textures)
+//   --threads N      Worker threads (default: all cores)
+//   --flip           Draw the board from Black's side
+//   --frames         For games, write one PNG per position instead of an animation
+//   --delay MS       Animation frame delay (default 800)
+//
+// Files are named position-000001.png after the input record, game-000001.png after the
+// game, or game-000001-000.png for each position of a game with --frames. Textures are
+// decoded once into a sprite atlas; every worker thread keeps its own board, frame,
+// encoder and file buffers, and the bounded task queue holds back the reader, so memory
+// stays flat however long the input is. Reports images/sec and peak memory on stderr.
+
+#include "HardChess/Core/Board.h"
+#include "HardChess/IO/BufferedWriter.h"
+#include "HardChess/IO/LineReader.h"
+#include "HardChess/IO/MappedFile.h"
+#include "HardChess/IO/Png.h"
+#include "HardChess/IO/PgnReader.h"
+#include "HardChess/UI/BoardRenderer.h"
+#include "HardChess/Util/ThreadPool.h"
+#include <sys/resource.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace HardChess;
+
+namespace {
+
+    struct Options {
+        std::string input;
+        std::string outputDir = ".";
+        std::string textureDir = "include/assets/textures";
+        int squareSize = 64;
+        unsigned threads = 0;
+        bool flip = false;
+        bool frames = false;
+        int delayMs = 800;
+    };
+
+    void usage() {
+        std::cerr << "usage: render [-o DIR] [--size PX] [--textures DIR] [--threads N] [--flip] [--frames] [--delay MS] input"
+                  << std::endl;
+        std::exit(2);
+    }
+
+    std::atomic<long long> imagesWritten(0);
+    std::atomic<long long> bytesWritten(0);
+    std::atomic<long long> failures(0);
+
+    // What one worker thread reuses from image to image
+    struct Workspace {
+        Board board;
+        std::vector<std::uint8_t> frame;
+        std::vector<std::uint8_t> png;
+        PngEncoder encoder;
+        BufferedWriter file{1 << 16};
+    };
+
+    Workspace& workspace() {
+        thread_local Workspace local;
+        return local;
+    }
+
+    std::string numbered(const std::string& dir, const char* prefix, std::size_t index, int ply = -1) {
+        char name[64];
+        if (ply < 0) std::snprintf(name, sizeof(name), "/%s-%06zu.png", prefix, index);
+        else std::snprintf(name, sizeof(name), "/%s-%06zu-%03d.png", prefix, index, ply);
+        return dir + name;
+    }
+
+    void writeFile(Workspace& work, const std::string& path, const std::vector<std::uint8_t>& bytes) {
+        if (!work.file.open(path)) {
+            failures.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        work.file.write(bytes.data(), bytes.size());
+        if (!work.file.close()) failures.fetch_add(1, std::memory_order_relaxed);
+        bytesWritten.fetch_add(static_cast<long long>(bytes.size()), std::memory_order_relaxed);
+    }
+
+    // The position part of a FEN or EPD line: four fields, plus the move counters if present
+    std::string_view positionOf(std::string_view line) {
+        std::size_t end = 0;
+        int fields = 0;
+        std::size_t fourthEnd = line.size();
+        while (fields < 6) {
+            while (end < line.size() && (line[end] == ' ' || line[end] == '\t')) ++end;
+            if (end >= line.size()) break;
+            std::size_t begin = end;
+            while (end < line.size() && line[end] != ' ' && line[end] != '\t') ++end;
+            ++fields;
+            if (fields == 4) fourthEnd = end;
+            if (fields > 4 && (line[begin] < '0' || line[begin] > '9')) return line.substr(0, fourthEnd);
+        }
+        return fields == 6 ? line.substr(0, end) : line.substr(0, fourthEnd);
+    }
+
+    void renderPosition(const BoardRenderer& renderer, const Options& options, std::size_t index, const std::string& fen) {
+        Workspace& work = workspace();
+        if (!work.board.fromFEN(positionOf(fen))) {
+            failures.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        renderer.render(work.board, nullptr, work.frame);
+        work.encoder.encode(work.frame.data(), renderer.width(), renderer.height(), BoardRenderer::CHANNELS, work.png);
+        writeFile(work, numbered(options.outputDir, "position", index), work.png);
+        imagesWritten.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void renderGame(const BoardRenderer& renderer, const Options& options, std::size_t index, const GameRecord& game) {
+        Workspace& work = workspace();
+        if (game.getStartFEN().empty()) work.board.initializeBoard();
+        else if (!work.board.fromFEN(game.getStartFEN())) {
+            failures.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        int frameCount = static_cast<int>(game.size()) + 1;
+        if (!options.frames) {
+            work.encoder.beginAnimation(renderer.width(), renderer.height(), BoardRenderer::CHANNELS, frameCount,
+                                        options.delayMs, 0, work.png);
+        }
+        const Move* lastMove = nullptr;
+        Move move;
+        MoveCodeView codes = game.getMoves();
+        for (int ply = 0; ply < frameCount; ++ply) {
+            if (ply > 0) {
+                move = work.board.decodeMove(codes[ply - 1]);
+                work.board.applyMove(move);
+                lastMove = &move;
+            }
+            renderer.render(work.board, lastMove, work.frame);
+            if (options.frames) {
+                work.encoder.encode(work.frame.data(), renderer.width(), renderer.height(), BoardRenderer::CHANNELS, work.png);
+                writeFile(work, numbered(options.outputDir, "game", index, ply), work.png);
+            } else {
+                work.encoder.addFrame(work.frame.data(), work.png);
+            }
+            imagesWritten.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (!options.frames) {
+            work.encoder.endAnimation(work.png);
+            writeFile(work, numbered(options.outputDir, "game", index), work.png);
+        }
+    }
+
+    bool endsWith(const std::string& text, const char* suffix) {
+        std::string tail(suffix);
+        return text.size() >= tail.size() && text.compare(text.size() - tail.size(), tail.size(), tail) == 0;
+    }
+
+    double peakResidentMegabytes() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return usage.ru_maxrss / (1024.0 * 1024.0); // Bytes on macOS
+#else
+        return usage.ru_maxrss / 1024.0; // Kilobytes on Linux
+#endif
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) usage();
+            return argv[++i];
+        };
+        if (arg == "-o" || arg == "--output") options.outputDir = value();
+        else if (arg == "--size") options.squareSize = std::atoi(value());
+        else if (arg == "--textures") options.textureDir = value();
+        else if (arg == "--threads") options.threads = static_cast<unsigned>(std::atoi(value()));
+        else if (arg == "--flip") options.flip = true;
+        else if (arg == "--frames") options.frames = true;
+        else if (arg == "--delay") options.delayMs = std::atoi(value());
+        else if (arg == "-h" || arg == "--help") usage();
+        else if (arg.size() > 1 && arg[0] == '-') usage();
+        else options.input = arg;
+    }
+    if (options.input.empty() || options.squareSize <= 0 || options.squareSize > 512) usage();
+    if (options.threads == 0) options.threads = ThreadPool::defaultThreadCount();
+
+    ThreadPool pool(options.threads);
+    auto begin = std::chrono::steady_clock::now();
+    SpriteAtlas atlas;
+    if (!atlas.load(options.textureDir, options.squareSize, &pool)) {
+        std::cerr << "render: " << atlas.error() << std::endl;
+        return 2;
+    }
+    double atlasSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    double atlasMegabytes = peakResidentMegabytes();
+
+    RenderStyle style;
+    style.flip = options.flip;
+    const BoardRenderer renderer(atlas, style);
+
+    begin = std::chrono::steady_clock::now();
+    std::size_t jobs = 0;
+    if (endsWith(options.input, ".pgn")) {
+        MappedFile file;
+        if (!file.open(options.input)) {
+            std::cerr << "render: cannot map " << options.input << std::endl;
+            return 2;
+        }
+        file.adviseSequential();
+        // Games are replayed here, on the reading thread, and rendered by the pool
+        PgnRecordBuilder builder([&](const GameRecord& record) {
+            std::size_t index = ++jobs;
+            pool.submit([&renderer, &options, index, record]() { renderGame(renderer, options, index, record); });
+        });
+        PgnStats stats = PgnReader::replayAll(file.view(), &builder);
+        failures.fetch_add(static_cast<long long>(stats.errors), std::memory_order_relaxed);
+    } else {
+        LineReader reader;
+        if (!reader.open(options.input)) {
+            std::cerr << "render: cannot open " << options.input << std::endl;
+            return 2;
+        }
+        std::string_view line;
+        while (reader.next(line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::size_t index = ++jobs;
+            pool.submit([&renderer, &options, index, fen = std::string(line)]() {
+                renderPosition(renderer, options, index, fen);
+            });
+        }
+    }
+    pool.waitIdle();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if (seconds <= 0) seconds = 1e-9;
+    std::cerr << "render: atlas " << options.squareSize << "px in " << atlasSeconds << " s, images=" << imagesWritten.load()
+              << " files_kb=" << bytesWritten.load() / 1024 << " seconds=" << seconds
+              << " images/sec=" << static_cast<long long>(imagesWritten.load() / seconds)
+              << " peak_rss_mb=" << atlasMegabytes << " -> " << peakResidentMegabytes()
+              << " failures=" << failures.load() << std::endl;
+    return failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#include "HardChess/UI/BoardRenderer.h"
+#include "HardChess/IO/Png.h"
+#include "HardChess/Util/ThreadPool.h"
+#include <algorithm>
+#include <mutex>
+
+namespace HardChess {
+
+    namespace {
+
+        const char* const colorNames[2] = {"white", "black"};
+        const char* const typeNames[6] = {"pawn", "rook", "knight", "bishop", "queen", "king"};
+
+        // The bundled textures are not named consistently ("White_knight.png" next to
+        // "white_rook.png"), so try both spellings of the first letter
+        bool loadTexture(const std::string& dir, int slot, Png::Image& image) {
+            std::string name = std::string(colorNames[slot / 6]) + "_" + typeNames[slot % 6] + ".png";
+            std::string prefix = dir.empty() || dir.back() == '/' ? dir : dir + "/";
+            if (Png::load(prefix + name, image)) return true;
+            name[0] = static_cast<char>(name[0] - 'a' + 'A');
+            return Png::load(prefix + name, image);
+        }
+
+        // Box-filters an RGBA image down to size x size, premultiplying by alpha so the
+        // transparent surroundings do not darken the piece's edges
+        void scaleToSprite(const Png::Image& image, int size, std::uint8_t* sprite) {
+            for (int dy = 0; dy < size; ++dy) {
+                int y0 = static_cast<int>(static_cast<long long>(dy) * image.height / size);
+                int y1 = std::max(y0 + 1, static_cast<int>(static_cast<long long>(dy + 1) * image.height / size));
+                for (int dx = 0; dx < size; ++dx) {
+                    int x0 = static_cast<int>(static_cast<long long>(dx) * image.width / size);
+                    int x1 = std::max(x0 + 1, static_cast<int>(static_cast<long long>(dx + 1) * image.width / size));
+                    std::uint64_t red = 0, green = 0, blue = 0, alpha = 0;
+                    for (int y = y0; y < y1; ++y) {
+                        const std::uint8_t* px = image.pixels.data() + (static_cast<std::size_t>(y) * image.width + x0) * 4;
+                        for (int x = x0; x < x1; ++x, px += 4) {
+                            red += px[0] * px[3];
+                            green += px[1] * px[3];
+                            blue += px[2] * px[3];
+                            alpha += px[3];
+                        }
+                    }
+                    std::uint64_t samples = static_cast<std::uint64_t>(y1 - y0) * (x1 - x0);
+                    std::uint8_t* out = sprite + (static_cast<std::size_t>(dy) * size + dx) * 4;
+                    out[0] = static_cast<std::uint8_t>((red / 255 + samples / 2) / samples);
+                    out[1] = static_cast<std::uint8_t>((green / 255 + samples / 2) / samples);
+                    out[2] = static_cast<std::uint8_t>((blue / 255 + samples / 2) / samples);
+                    out[3] = static_cast<std::uint8_t>((alpha + samples / 2) / samples);
+                }
+            }
+        }
+
+    } // namespace
+
+    SpriteAtlas::SpriteAtlas() : size(0) {}
+
+    bool SpriteAtlas::load(const std::string& textureDir, int squareSize, ThreadPool* pool) {
+        if (squareSize <= 0) {
+            failure = "square size must be positive";
+            return false;
+        }
+        size = squareSize;
+        std::size_t spriteBytes = static_cast<std::size_t>(size) * size * 4;
+        pixels.assign(12 * spriteBytes, 0);
+        failure.clear();
+
+        std::mutex errorMutex;
+        auto loadSlot = [&](int slot) {
+            Png::Image image; // Full-size texture, released as soon as it is scaled
+            if (!loadTexture(textureDir, slot, image)) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                failure = "cannot decode " + std::string(colorNames[slot / 6]) + "_" + typeNames[slot % 6] + ".png in " + textureDir;
+                return;
+            }
+            scaleToSprite(image, size, pixels.data() + slot * spriteBytes);
+        };
+        if (pool) {
+            for (int slot = 0; slot < 12; ++slot) pool->submit([&loadSlot, slot]() { loadSlot(slot); });
+            pool->waitIdle();
+        } else {
+            for (int slot = 0; slot < 12; ++slot) loadSlot(slot);
+        }
+        return failure.empty();
+    }
+
+    const std::uint8_t* SpriteAtlas::sprite(Color color, PieceType type) const {
+        if (type == PieceType::NONE || color == Color::NONE || pixels.empty()) return nullptr;
+        return pixels.data() + static_cast<std::size_t>(slotOf(color, type)) * size * size * 4;
+    }
+
+    BoardRenderer::BoardRenderer(const SpriteAtlas& spriteAtlas, const RenderStyle& renderStyle)
+        : atlas(spriteAtlas), style(renderStyle) {}
+
+    void BoardRenderer::render(const Board& board, const Move* lastMove, std::vector<std::uint8_t>& frame) const {
+        const int square = atlas.squareSize();
+        const std::size_t stride = static_cast<std::size_t>(width()) * CHANNELS;
+        frame.resize(stride * height());
+
+        for (int screenRow = 0; screenRow < 8; ++screenRow) {
+            for (int screenCol = 0; screenCol < 8; ++screenCol) {
+                Position pos = style.flip ? Position(7 - screenRow, 7 - screenCol) : Position(screenRow, screenCol);
+                bool light = (pos.row + pos.col) % 2 == 0;
+                bool highlighted = lastMove && (lastMove->from == pos || lastMove->to == pos);
+                const std::uint8_t* background = highlighted ? (light ? style.lightHighlight : style.darkHighlight)
+                                                             : (light ? style.light : style.dark);
+                const Piece* piece = board.getPiecePtr(pos);
+                const std::uint8_t* sprite = piece ? atlas.sprite(piece->getColor(), piece->getType()) : nullptr;
+
+                std::uint8_t* origin = frame.data() + static_cast<std::size_t>(screenRow) * square * stride +
+                                       static_cast<std::size_t>(screenCol) * square * CHANNELS;
+                for (int y = 0; y < square; ++y) {
+                    std::uint8_t* out = origin + y * stride;
+                    if (!sprite) {
+                        for (int x = 0; x < square; ++x, out += CHANNELS) {
+                            out[0] = background[0];
+                            out[1] = background[1];
+                            out[2] = background[2];
+                        }
+                        continue;
+                    }
+                    // Premultiplied "over": sprite + background * (1 - alpha)
+                    const std::uint8_t* px = sprite + static_cast<std::size_t>(y) * square * 4;
+                    for (int x = 0; x < square; ++x, out += CHANNELS, px += 4) {
+                        unsigned keep = 255u - px[3];
+                        out[0] = static_cast<std::uint8_t>(std::min(255u, px[0] + (background[0] * keep + 127) / 255));
+                        out[1] = static_cast<std::uint8_t>(std::min(255u, px[1] + (background[1] * keep + 127) / 255));
+                        out[2] = static_cast<std::uint8_t>(std::min(255u, px[2] + (background[2] * keep + 127) / 255));
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace HardChess
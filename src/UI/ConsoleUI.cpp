@@ -1,28 +1,97 @@
 #include "HardChess/UI/ConsoleUI.h"
 #include "HardChess/Core/Board.h"
 #include "HardChess/Core/Player.h"
+#include "HardChess/Util/Stats.h"
 #include <iostream>
 #include <limits>
+#include <mutex>
 
 namespace HardChess
 {
 
+    namespace
+    {
+        // Terminal layout of a drawn board (1-based): file labels, a border, the eight
+        // ranks from FIRST_RANK_LINE on, a border and the file labels again. Screen column
+        // j of a rank sits at terminal column FIRST_SQUARE_COLUMN + 2j. In ANSI_DIFF mode
+        // output scrolls from SCROLL_TOP_LINE down, leaving a blank line under the board.
+        constexpr int FIRST_RANK_LINE = 3;
+        constexpr int FIRST_SQUARE_COLUMN = 5;
+        constexpr int BOARD_LINES = 12;
+        constexpr int SCROLL_TOP_LINE = BOARD_LINES + 2;
+        constexpr std::size_t FRAME_CAPACITY = 1024; // A full board with escapes is about 300 bytes
+
+        char squareSymbol(const Board &board, int row, int col)
+        {
+            const Piece *piece = board.getPiecePtr(Position(row, col));
+            if (piece)
+                return piece->getSymbol();
+            return (row + col) % 2 == 0 ? '.' : ' ';
+        }
+
+        void appendNumber(std::string &out, int value)
+        {
+            if (value >= 10)
+                out += static_cast<char>('0' + value / 10);
+            out += static_cast<char>('0' + value % 10);
+        }
+    }
+
+    ConsoleUI::ConsoleUI()
+        : renderMode(RenderMode::PLAIN), boardOnScreen(false), shownFlip(false)
+    {
+        frame.reserve(FRAME_CAPACITY);
+    }
+
+    ConsoleUI::~ConsoleUI()
+    {
+        std::lock_guard<std::mutex> lock(output);
+        releaseTerminal();
+    }
+
+    void ConsoleUI::setRenderMode(RenderMode mode)
+    {
+        std::lock_guard<std::mutex> lock(output);
+        if (mode != RenderMode::ANSI_DIFF)
+            releaseTerminal();
+        renderMode = mode;
+    }
+
+    bool ConsoleUI::parseRenderMode(std::string_view name, RenderMode &mode)
+    {
+        if (name == "plain")
+            mode = RenderMode::PLAIN;
+        else if (name == "ansi")
+            mode = RenderMode::ANSI_DIFF;
+        else if (name == "quiet")
+            mode = RenderMode::QUIET;
+        else
+            return false;
+        return true;
+    }
+
     int ConsoleUI::displayMainMenu() const
     {
-        std::cout << "==============================" << std::endl;
-        std::cout << "      HARD CHESS MAIN MENU    " << std::endl;
-        std::cout << "==============================" << std::endl;
-        std::cout << "1. Start Game" << std::endl;
-        std::cout << "2. Help & Rules" << std::endl;
-        std::cout << "3. Exit" << std::endl;
-        std::cout << "Enter your choice (1-3): ";
+        {
+            std::lock_guard<std::mutex> lock(output);
+            std::cout << "==============================" << std::endl;
+            std::cout << "      HARD CHESS MAIN MENU    " << std::endl;
+            std::cout << "==============================" << std::endl;
+            std::cout << "1. Start Game" << std::endl;
+            std::cout << "2. Help & Rules" << std::endl;
+            std::cout << "3. Exit" << std::endl;
+            std::cout << "Enter your choice (1-3): " << std::flush;
+        }
         int choice;
         std::cin >> choice;
         while (std::cin.fail() || choice < 1 || choice > 3)
         {
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "Invalid input. Enter 1, 2, or 3: ";
+            {
+                std::lock_guard<std::mutex> lock(output);
+                std::cout << "Invalid input. Enter 1, 2, or 3: " << std::flush;
+            }
             std::cin >> choice;
         }
         return choice;
@@ -30,102 +99,198 @@ namespace HardChess
 
     void ConsoleUI::displayHelpAndRules() const
     {
+        std::lock_guard<std::mutex> lock(output);
         std::cout << "\n--- Help & Rules ---\n";
         std::cout << "Standard chess rules apply.\n";
-        std::cout << "- Enter moves in algebraic notation (e.g., e2e4).\n";
+        std::cout << "- Enter moves as squares (e.g., e2e4, a7a8q) or in standard algebraic notation (e.g., Nf3, exd5, O-O, e8=Q).\n";
         std::cout << "- For pawn promotion, append q, r, b, or n (e.g., a7a8q).\n";
         std::cout << "- Type 'exit' at any move prompt to quit the game.\n";
-        std::cout << "- The game ends with checkmate or stalemate.\n";
+        std::cout << "- Type 'hint' at any move prompt for a suggested move; keep typing while it thinks.\n";
+        std::cout << "- Type 'mate' at any move prompt to look for a forced mate and its line.\n";
+        std::cout << "- Type 'stats' at any move prompt to see engine counters and timings.\n";
+        std::cout << "- A round ends with checkmate, stalemate, threefold repetition or the fifty-move rule.\n";
         std::cout << "---------------------\n\n";
     }
 
-    void ConsoleUI::displayBoard(const Board &board, bool /*flip*/) const
+    void ConsoleUI::displayBoard(const Board &board, bool flip) const
     {
-        std::cout << std::endl;
-
-        int startRow = 0;
-        int endRow = 8;
-        int stepRow = 1;
+        std::lock_guard<std::mutex> lock(output);
+        if (renderMode == RenderMode::QUIET)
+            return;
 
-        int startCol = 0;
-        int endCol = 8;
-        int stepCol = 1;
-
-        // Print column labels
-        std::cout << "    ";
-        for (int c = startCol; c != endCol; c += stepCol)
+        frame.clear();
+        if (renderMode == RenderMode::PLAIN)
         {
-            std::cout << static_cast<char>('a' + c) << " ";
+            frame += '\n';
+            formatFullBoard(board, flip);
+            frame += '\n';
         }
-        std::cout << std::endl;
-
-        std::cout << "  +-----------------+" << std::endl;
-        for (int r = startRow; r != endRow; r += stepRow)
+        else if (!boardOnScreen)
         {
-            int rowLabel = 8 - r;
-            std::cout << rowLabel << " | ";
-            for (int c = startCol; c != endCol; c += stepCol)
+            // Clear the screen, draw at the top, then keep all other output scrolling below
+            frame += "\x1b[2J\x1b[H";
+            formatFullBoard(board, flip);
+            frame += "\x1b[";
+            appendNumber(frame, SCROLL_TOP_LINE);
+            frame += "r\x1b[";
+            appendNumber(frame, SCROLL_TOP_LINE);
+            frame += ";1H";
+            boardOnScreen = true;
+        }
+        else if (flip != shownFlip)
+        {
+            // Every cell and label moves, so redraw the whole board in place
+            frame += "\x1b" "7\x1b[H";
+            formatFullBoard(board, flip);
+            frame += "\x1b" "8";
+        }
+        else
+        {
+            // Rewrite only the cells whose symbol changed, then put the cursor back
+            int first = flip ? 7 : 0;
+            int step = flip ? -1 : 1;
+            bool changed = false;
+            for (int i = 0, r = first; i < 8; ++i, r += step)
             {
-                Piece *piece = board.getPiecePtr(Position(r, c));
-                if (piece)
-                {
-                    std::cout << piece->getSymbol() << " ";
-                }
-                else
+                for (int j = 0, c = first; j < 8; ++j, c += step)
                 {
-                    std::cout << ((r + c) % 2 == 0 ? "." : " ") << " ";
+                    char symbol = squareSymbol(board, r, c);
+                    if (shownSquares[i * 8 + j] == symbol)
+                        continue;
+                    if (!changed)
+                        frame += "\x1b" "7";
+                    changed = true;
+                    shownSquares[i * 8 + j] = symbol;
+                    frame += "\x1b[";
+                    appendNumber(frame, FIRST_RANK_LINE + i);
+                    frame += ';';
+                    appendNumber(frame, FIRST_SQUARE_COLUMN + 2 * j);
+                    frame += 'H';
+                    frame += symbol;
                 }
             }
-            std::cout << "| " << rowLabel << std::endl;
+            if (changed)
+                frame += "\x1b" "8";
         }
-        std::cout << "  +-----------------+" << std::endl;
+        shownFlip = flip;
+
+        std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+        std::cout.flush();
+    }
+
+    void ConsoleUI::formatFullBoard(const Board &board, bool flip) const
+    {
+        // Screen row and column i show board row and column i, or 7 - i when flipped
+        int first = flip ? 7 : 0;
+        int step = flip ? -1 : 1;
+        auto appendFileLabels = [&]()
+        {
+            frame += "    ";
+            for (int j = 0, c = first; j < 8; ++j, c += step)
+            {
+                frame += static_cast<char>('a' + c);
+                frame += ' ';
+            }
+            frame += '\n';
+        };
 
-        // Print column labels again
-        std::cout << "    ";
-        for (int c = startCol; c != endCol; c += stepCol)
+        appendFileLabels();
+        frame += "  +-----------------+\n";
+        for (int i = 0, r = first; i < 8; ++i, r += step)
         {
-            std::cout << static_cast<char>('a' + c) << " ";
+            char rankLabel = static_cast<char>('8' - r);
+            frame += rankLabel;
+            frame += " | ";
+            for (int j = 0, c = first; j < 8; ++j, c += step)
+            {
+                char symbol = squareSymbol(board, r, c);
+                shownSquares[i * 8 + j] = symbol;
+                frame += symbol;
+                frame += ' ';
+            }
+            frame += "| ";
+            frame += rankLabel;
+            frame += '\n';
         }
-        std::cout << std::endl
-                  << std::endl;
+        frame += "  +-----------------+\n";
+        appendFileLabels();
+    }
+
+    void ConsoleUI::releaseTerminal() const
+    {
+        if (!boardOnScreen)
+            return;
+        // Full-screen scrolling again, with the cursor on the bottom line
+        std::cout << "\x1b[r\x1b[999;1H" << std::flush;
+        boardOnScreen = false;
     }
 
     void ConsoleUI::displayPlayerStats(const Player &player1, const Player &player2) const
     {
-        std::cout << "--- Player Stats ---" << std::endl;
-        std::cout << player1.getName() << " (White): Hearts=" << player1.getHearts() << ", Score=" << player1.getScore() << std::endl;
-        std::cout << player2.getName() << " (Black): Hearts=" << player2.getHearts() << ", Score=" << player2.getScore() << std::endl;
-        std::cout << "--------------------" << std::endl;
+        std::lock_guard<std::mutex> lock(output);
+        std::cout << "--- Player Stats ---\n";
+        std::cout << player1.getName() << " (White): Hearts=" << player1.getHearts() << ", Score=" << player1.getScore() << '\n';
+        std::cout << player2.getName() << " (Black): Hearts=" << player2.getHearts() << ", Score=" << player2.getScore() << '\n';
+        std::cout << "--------------------\n";
     }
 
     void ConsoleUI::displayPlayerTurn(const Player *currentPlayer) const
     {
-        if (currentPlayer)
+        std::lock_guard<std::mutex> lock(output);
+        if (currentPlayer && renderMode != RenderMode::QUIET)
         {
-            std::cout << "--- " << currentPlayer->getName() << "'s Turn (" << currentPlayer->getColorString() << ") ---" << std::endl;
+            std::cout << "--- " << currentPlayer->getName() << "'s Turn (" << currentPlayer->getColorString() << ") ---\n";
         }
     }
 
     void ConsoleUI::displayMessage(const std::string &message) const
     {
-        std::cout << "[INFO] " << message << std::endl;
+        std::lock_guard<std::mutex> lock(output);
+        std::cout << "[INFO] " << message << '\n'; // Flushed before the next prompt reads input
+    }
+
+    void ConsoleUI::displayStats(const Stats::Snapshot &snapshot) const
+    {
+        std::lock_guard<std::mutex> lock(output);
+        std::cout << "--- Engine statistics (this match) ---\n";
+        Stats::writeText(std::cout, snapshot);
+        std::cout << std::flush;
+    }
+
+    void ConsoleUI::displayHint(const std::string &hint) const
+    {
+        std::lock_guard<std::mutex> lock(output);
+        // The prompt is already on screen, so start a fresh line and flush right away
+        std::cout << "\n[HINT] " << hint << '\n' << std::flush;
     }
 
     std::string ConsoleUI::getPlayerMove(const Player &player) const
     {
         std::string moveStr;
-        std::cout << player.getName() << ", enter your move (e.g., e2e4 or a7a8q for promotion, or type 'exit' to quit): ";
+        {
+            // Never held while waiting for input, or a finished hint could not be shown
+            std::lock_guard<std::mutex> lock(output);
+            std::cout << player.getName() << ", enter your move (e.g., e2e4, Nf3 or a7a8q for promotion, 'hint' for a suggestion, 'mate' to look for a forced mate, 'stats' for engine statistics, or 'exit' to quit): " << std::flush;
+        }
         std::cin >> moveStr;
         if (std::cin.fail())
         {
+            if (std::cin.eof())
+            {
+                std::lock_guard<std::mutex> lock(output);
+                releaseTerminal();
+                return "exit"; // Input has ended; nothing more will be typed
+            }
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
             return "";
         }
-        if (moveStr == "exit" || moveStr == "quit")
+        if (moveStr == "quit")
+            moveStr = "exit";
+        if (moveStr == "exit")
         {
-            std::cout << "[INFO] Exiting the game. Goodbye!" << std::endl;
-            exit(0);
+            std::lock_guard<std::mutex> lock(output);
+            releaseTerminal(); // The caller winds the match down with plain output
         }
         return moveStr;
     }
@@ -133,7 +298,10 @@ namespace HardChess
     std::string ConsoleUI::promptForPieceSelection(const std::string &promptMessage) const
     {
         std::string posStr;
-        std::cout << promptMessage;
+        {
+            std::lock_guard<std::mutex> lock(output);
+            std::cout << promptMessage << std::flush;
+        }
         std::cin >> posStr;
         if (std::cin.fail())
         {
@@ -146,18 +314,20 @@ namespace HardChess
 
     void ConsoleUI::displayRoundResult(Player *winner) const
     {
+        std::lock_guard<std::mutex> lock(output);
         if (winner)
         {
             std::cout << ">>> Round Over! Winner: " << winner->getName() << " (" << winner->getColorString() << ") <<<" << std::endl;
         }
         else
         {
-            std::cout << ">>> Round Over! It's a draw (Stalemate). <<<" << std::endl;
+            std::cout << ">>> Round Over! It's a draw. <<<" << std::endl;
         }
     }
 
-    void ConsoleUI::displayMatchResult(Player *winner) const
+    void ConsoleUI::displayMatchResult(const Player *winner) const
     {
+        std::lock_guard<std::mutex> lock(output);
         std::cout << "\n=========================" << std::endl;
         if (winner)
         {
@@ -182,8 +352,11 @@ namespace HardChess
 
     PieceType ConsoleUI::promptPawnPromotionChoice(const Player &player) const
     {
-        std::cout << player.getName() << ", your pawn can be promoted!" << std::endl;
-        std::cout << "Choose piece to promote to (q=Queen, r=Rook, b=Bishop, n=Knight): ";
+        {
+            std::lock_guard<std::mutex> lock(output);
+            std::cout << player.getName() << ", your pawn can be promoted!" << std::endl;
+            std::cout << "Choose piece to promote to (q=Queen, r=Rook, b=Bishop, n=Knight): " << std::flush;
+        }
         char choiceChar;
         while (true)
         {
@@ -200,7 +373,10 @@ namespace HardChess
             case 'n':
                 return PieceType::KNIGHT;
             default:
-                std::cout << "Invalid choice. Enter q, r, b, or n: ";
+            {
+                std::lock_guard<std::mutex> lock(output);
+                std::cout << "Invalid choice. Enter q, r, b, or n: " << std::flush;
+            }
             }
         }
     }
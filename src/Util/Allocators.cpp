@@ -0,0 +1,63 @@
+#include "HardChess/Util/Allocators.h"
+
+namespace HardChess {
+
+    Arena::Arena(std::size_t chunkBytes) : chunkBytes(chunkBytes), current(0), offset(0) {}
+
+    Arena::~Arena() {
+        for (Chunk& chunk : chunks) ::operator delete(chunk.data);
+    }
+
+    void* Arena::allocateSlow(std::size_t bytes, std::size_t alignment) {
+        // Move on to the next chunk that fits, reusing chunks from before a rewind
+        std::size_t needed = bytes + alignment;
+        std::size_t usedBefore = current < chunks.size() ? chunks[current].usedBefore + offset : 0;
+        std::size_t next = current < chunks.size() ? current + 1 : 0;
+        while (next < chunks.size() && chunks[next].size < needed) ++next;
+        if (next == chunks.size()) {
+            std::size_t size = needed > chunkBytes ? needed : chunkBytes;
+            chunks.push_back(Chunk{static_cast<char*>(::operator new(size)), size, 0});
+            ++counters.systemAllocations;
+            counters.systemBytes += size;
+            Stats::count(Stats::Counter::HEAP_FALLBACKS);
+        }
+        // Chunks skipped over stay empty until the next rewind
+        chunks[next].usedBefore = usedBefore;
+        current = next;
+        offset = 0;
+        return allocate(bytes, alignment);
+    }
+
+    void Arena::rewind(Marker marker) {
+        current = marker.chunk;
+        offset = marker.offset;
+        ++counters.releases;
+    }
+
+    void Arena::reset() {
+        current = 0;
+        offset = 0;
+        ++counters.resets;
+    }
+
+    std::size_t Arena::bytesInUse() const {
+        return current < chunks.size() ? chunks[current].usedBefore + offset : 0;
+    }
+
+    Arena& Arena::local() {
+        Stats::local(); // Created before the arena, so it outlives it
+        thread_local Arena arena;
+        return arena;
+    }
+
+    void writeAllocatorStats(std::ostream& out, const char* name, const AllocatorStats& stats) {
+        out << name << " requests=" << stats.requests << " releases=" << stats.releases
+            << " requested-bytes=" << stats.requestedBytes << " system-allocations=" << stats.systemAllocations
+            << " system-bytes=" << stats.systemBytes;
+        if (stats.highWaterBytes > 0 || stats.resets > 0) {
+            out << " high-water-bytes=" << stats.highWaterBytes << " resets=" << stats.resets;
+        }
+        out << '\n';
+    }
+
+} // namespace HardChess
@@ -0,0 +1,294 @@
+#include "HardChess/Util/EventLog.h"
+#include "HardChess/IO/BufferedWriter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace HardChess {
+    namespace EventLog {
+
+        namespace detail {
+            std::atomic<bool> active(false);
+        }
+
+        namespace {
+
+            const char* const typeNames[static_cast<int>(EventType::COUNT)] = {
+                "round_start", "move", "capture", "promotion", "check", "round_result", "match_result", "dropped",
+            };
+            const char* const colorNames[3] = {"none", "white", "black"};
+            const char* const pieceNames[7] = {"none", "pawn", "rook", "knight", "bishop", "queen", "king"};
+            const char* const resultNames[4] = {"*", "1-0", "0-1", "1/2-1/2"};
+
+            // Single producer (the owning thread), single consumer (the writer). head and
+            // tail only grow; the slot of position p is p & mask.
+            struct Ring {
+                std::unique_ptr<Event[]> slots;
+                std::uint64_t mask;
+                std::uint32_t index;
+                std::atomic<bool> owned{true};
+                alignas(64) std::atomic<std::uint64_t> head{0};    // Written by the owner
+                std::atomic<std::uint64_t> dropped{0};             // Written by the owner
+                alignas(64) std::atomic<std::uint64_t> tail{0};    // Written by the writer
+                std::uint64_t headAtOpen = 0;                      // The rest belongs to the writer
+                std::uint64_t droppedAtOpen = 0;
+                std::uint64_t droppedReported = 0;
+
+                Ring(std::size_t capacity, std::uint32_t ringIndex)
+                    : slots(new Event[capacity]), mask(capacity - 1), index(ringIndex) {}
+            };
+
+            struct Log {
+                std::mutex mutex; // Guards rings and ringCapacity; taken once per thread, not per event
+                std::vector<Ring*> rings; // Never freed: an exited thread's ring passes to a new thread
+                std::size_t ringCapacity = 4096;
+
+                std::mutex control; // Serializes open() and close()
+                std::thread writer;
+                std::atomic<bool> stopping{false};
+                std::atomic<std::int64_t> startNs{0};
+                BufferedWriter out{1 << 16};
+                Format format = Format::JSONL;
+            };
+
+            // Never destroyed, so threads that record during shutdown find it intact
+            Log& log() {
+                static Log* shared = new Log();
+                return *shared;
+            }
+
+            std::int64_t steadyNs() {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                    .count();
+            }
+
+            // Gives the ring back when its thread exits
+            struct RingClaim {
+                Ring* ring = nullptr;
+                ~RingClaim() {
+                    if (ring) ring->owned.store(false, std::memory_order_release);
+                }
+            };
+
+            thread_local RingClaim claim;
+
+            Ring* claimRing() {
+                Log& shared = log();
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                for (Ring* ring : shared.rings) {
+                    bool expected = false;
+                    if (ring->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) return claim.ring = ring;
+                }
+                Ring* ring = new Ring(shared.ringCapacity, static_cast<std::uint32_t>(shared.rings.size()));
+                shared.rings.push_back(ring);
+                return claim.ring = ring;
+            }
+
+            void appendSquare(char*& out, int square) {
+                *out++ = static_cast<char>('a' + (square & 7));
+                *out++ = static_cast<char>('8' - (square >> 3));
+            }
+
+            void writeJson(BufferedWriter& out, const Event& event) {
+                char line[256];
+                int type = static_cast<int>(event.type);
+                int used = std::snprintf(line, sizeof(line), "{\"ns\":%llu,\"thread\":%u,\"game\":%u,\"type\":\"%s\"",
+                                         static_cast<unsigned long long>(event.timeNs), event.thread, event.game,
+                                         type < static_cast<int>(EventType::COUNT) ? typeNames[type] : "unknown");
+                const char* color = colorNames[event.color < 3 ? event.color : 0];
+                const char* piece = pieceNames[event.piece < 7 ? event.piece : 0];
+                char move[8];
+                char* end = move;
+                appendSquare(end, (event.move >> 6) & 63);
+                appendSquare(end, event.move & 63);
+                if (event.move >> 12) *end++ = "nbrq"[((event.move >> 12) - 1) & 3];
+                *end = '\0';
+
+                std::size_t room = sizeof(line) - static_cast<std::size_t>(used);
+                switch (event.type) {
+                    case EventType::ROUND_START:
+                        used += std::snprintf(line + used, room, ",\"round\":%d", event.values[0]);
+                        break;
+                    case EventType::MOVE:
+                    case EventType::CAPTURE:
+                    case EventType::PROMOTION:
+                        used += std::snprintf(line + used, room, ",\"ply\":%u,\"color\":\"%s\",\"piece\":\"%s\",\"move\":\"%s\"",
+                                              event.ply, color, piece, move);
+                        break;
+                    case EventType::CHECK:
+                        used += std::snprintf(line + used, room, ",\"ply\":%u,\"color\":\"%s\"", event.ply, color);
+                        break;
+                    case EventType::ROUND_RESULT:
+                        used += std::snprintf(line + used, room, ",\"result\":\"%s\",\"score\":[%d,%d]",
+                                              resultNames[event.result < 4 ? event.result : 0], event.values[0],
+                                              event.values[1]);
+                        break;
+                    case EventType::MATCH_RESULT:
+                        used += std::snprintf(line + used, room, ",\"winner\":%s%s%s,\"score\":[%d,%d]",
+                                              event.color ? "\"" : "", event.color ? color : "null", event.color ? "\"" : "",
+                                              event.values[0], event.values[1]);
+                        break;
+                    case EventType::DROPPED:
+                        used += std::snprintf(line + used, room, ",\"count\":%d", event.values[0]);
+                        break;
+                    default: break;
+                }
+                out.write(line, static_cast<std::size_t>(used));
+                out.write("}\n", 2);
+            }
+
+            void write(Log& shared, const Event& event) {
+                if (shared.format == Format::BINARY) shared.out.write(&event, sizeof(event));
+                else writeJson(shared.out, event);
+            }
+
+            // Formats everything the rings hold; returns the number of events written
+            std::size_t drain(Log& shared, std::vector<Ring*>& rings) {
+                {
+                    std::lock_guard<std::mutex> lock(shared.mutex);
+                    rings = shared.rings;
+                }
+                std::size_t count = 0;
+                for (Ring* ring : rings) {
+                    std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+                    std::uint64_t head = ring->head.load(std::memory_order_acquire);
+                    for (std::uint64_t position = tail; position != head; ++position) write(shared, ring->slots[position & ring->mask]);
+                    ring->tail.store(head, std::memory_order_release);
+                    count += static_cast<std::size_t>(head - tail);
+
+                    std::uint64_t dropped = ring->dropped.load(std::memory_order_relaxed) - ring->droppedAtOpen;
+                    if (dropped > ring->droppedReported) {
+                        Event note;
+                        note.type = EventType::DROPPED;
+                        note.timeNs = static_cast<std::uint64_t>(steadyNs() - shared.startNs.load(std::memory_order_relaxed));
+                        note.thread = ring->index;
+                        std::uint64_t lost = dropped - ring->droppedReported;
+                        note.values[0] = lost > 0x7fffffff ? 0x7fffffff : static_cast<std::int32_t>(lost);
+                        ring->droppedReported = dropped;
+                        write(shared, note);
+                        ++count;
+                    }
+                }
+                return count;
+            }
+
+            void writerLoop(Log& shared) {
+                bool unflushed = false;
+                std::vector<Ring*> rings; // Copied from the registry on each pass
+                while (true) {
+                    bool last = shared.stopping.load(std::memory_order_acquire); // Recording has stopped
+                    std::size_t count = drain(shared, rings);
+                    if (last) break;
+                    if (count > 0) {
+                        unflushed = true;
+                        continue;
+                    }
+                    // Idle: make what was written visible, then poll again. Recording threads
+                    // never signal the writer, which would cost them a system call.
+                    if (unflushed) shared.out.flush();
+                    unflushed = false;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+            }
+
+        } // namespace
+
+        namespace detail {
+
+            void push(const Event& event) {
+                Ring* ring = claim.ring ? claim.ring : claimRing();
+                std::uint64_t head = ring->head.load(std::memory_order_relaxed);
+                if (head - ring->tail.load(std::memory_order_acquire) > ring->mask) {
+                    ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    return;
+                }
+                Event& slot = ring->slots[head & ring->mask];
+                slot = event;
+                slot.timeNs = static_cast<std::uint64_t>(steadyNs() - log().startNs.load(std::memory_order_relaxed));
+                slot.thread = ring->index;
+                ring->head.store(head + 1, std::memory_order_release);
+            }
+
+        } // namespace detail
+
+        bool open(const std::string& path, Format format, std::size_t ringEvents) {
+            Log& shared = log();
+            std::lock_guard<std::mutex> control(shared.control);
+            if (shared.writer.joinable()) return false;
+            if (!shared.out.open(path)) return false;
+            shared.format = format;
+            if (format == Format::BINARY) {
+                char header[16] = {'H', 'C', 'E', 'V', 'E', 'N', 'T', 'S'};
+                std::uint32_t version = 1, recordSize = sizeof(Event);
+                std::memcpy(header + 8, &version, 4);
+                std::memcpy(header + 12, &recordSize, 4);
+                shared.out.write(header, sizeof(header));
+            }
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                std::size_t capacity = 16;
+                while (capacity < ringEvents) capacity <<= 1;
+                shared.ringCapacity = capacity; // For rings created from now on
+                // Whatever a previous log left behind is discarded, and counting starts over
+                for (Ring* ring : shared.rings) {
+                    ring->headAtOpen = ring->head.load(std::memory_order_acquire);
+                    ring->tail.store(ring->headAtOpen, std::memory_order_release);
+                    ring->droppedAtOpen = ring->dropped.load(std::memory_order_relaxed);
+                    ring->droppedReported = 0;
+                }
+            }
+            shared.startNs.store(steadyNs(), std::memory_order_relaxed);
+            shared.stopping.store(false, std::memory_order_relaxed);
+            shared.writer = std::thread(writerLoop, std::ref(shared));
+            detail::active.store(true, std::memory_order_release);
+            return true;
+        }
+
+        bool close() {
+            Log& shared = log();
+            std::lock_guard<std::mutex> control(shared.control);
+            if (!shared.writer.joinable()) return false;
+            detail::active.store(false, std::memory_order_release);
+            shared.stopping.store(true, std::memory_order_release);
+            shared.writer.join();
+            // A recorder that saw the log active just before it closed may have pushed after
+            // the writer's last pass; with the writer gone this thread takes what is left
+            std::vector<Ring*> rings;
+            drain(shared, rings);
+            return shared.out.close();
+        }
+
+        Totals totals() {
+            Log& shared = log();
+            Totals total;
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            for (const Ring* ring : shared.rings) {
+                total.recorded += ring->head.load(std::memory_order_acquire) - ring->headAtOpen;
+                total.dropped += ring->dropped.load(std::memory_order_relaxed) - ring->droppedAtOpen;
+            }
+            std::uint64_t pending = 0; // Recorded but not yet taken by the writer
+            for (const Ring* ring : shared.rings) {
+                pending += ring->head.load(std::memory_order_acquire) - ring->tail.load(std::memory_order_acquire);
+            }
+            total.written = total.recorded > pending ? total.recorded - pending : 0;
+            return total;
+        }
+
+        Format formatFor(const std::string& path) {
+            const std::string suffix = ".bin";
+            bool binary = path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+            return binary ? Format::BINARY : Format::JSONL;
+        }
+
+        std::uint32_t newGameId() {
+            static std::atomic<std::uint32_t> next(1);
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    } // namespace EventLog
+} // namespace HardChess
@@ -0,0 +1,129 @@
+#include "HardChess/Util/Stats.h"
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+namespace HardChess {
+    namespace Stats {
+
+        namespace {
+
+            const char* const counterNames[COUNTER_COUNT] = {
+                "legality_probes", "king_in_check", "board_copies",    "piece_clones",  "search_nodes",
+                "book_probes",     "book_hits",     "tablebase_probes", "tablebase_hits",
+                "move_cache_hits", "move_cache_misses",
+                "pool_requests",   "heap_fallbacks", "arena_bytes",
+            };
+
+            const char* const timerNames[TIMER_COUNT] = {
+                "turn", "player_input", "move_validation", "computer_move", "board_display", "end_of_round_check",
+            };
+
+            // Live threads' counters, plus the totals of threads that have exited. reset()
+            // only moves the baseline, so no thread's counters are written by another.
+            struct Registry {
+                std::mutex mutex;
+                std::vector<const ThreadCounters*> threads;
+                Snapshot retired;
+                Snapshot baseline;
+            };
+
+            // Never destroyed, so threads that exit during shutdown can still unregister
+            Registry& registry() {
+                static Registry* shared = new Registry();
+                return *shared;
+            }
+
+            void accumulate(Snapshot& total, const ThreadCounters& counters) {
+                for (int i = 0; i < COUNTER_COUNT; ++i) total.counters[i] += counters.counters[i].load(std::memory_order_relaxed);
+                for (int i = 0; i < TIMER_COUNT; ++i) {
+                    total.timerNs[i] += counters.timerNs[i].load(std::memory_order_relaxed);
+                    total.timerCalls[i] += counters.timerCalls[i].load(std::memory_order_relaxed);
+                }
+            }
+
+            Snapshot totals(Registry& shared) {
+                Snapshot total = shared.retired;
+                for (const ThreadCounters* counters : shared.threads) accumulate(total, *counters);
+                return total;
+            }
+
+        } // namespace
+
+        const char* name(Counter counter) {
+            return counterNames[static_cast<int>(counter)];
+        }
+
+        const char* name(Timer timer) {
+            return timerNames[static_cast<int>(timer)];
+        }
+
+        ThreadCounters::ThreadCounters() {
+            for (auto& slot : counters) slot.store(0, std::memory_order_relaxed);
+            for (auto& slot : timerNs) slot.store(0, std::memory_order_relaxed);
+            for (auto& slot : timerCalls) slot.store(0, std::memory_order_relaxed);
+            Registry& shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.threads.push_back(this);
+        }
+
+        ThreadCounters::~ThreadCounters() {
+            Registry& shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            accumulate(shared.retired, *this);
+            shared.threads.erase(std::find(shared.threads.begin(), shared.threads.end(), this));
+        }
+
+        Snapshot snapshot() {
+            Registry& shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            Snapshot total = totals(shared);
+            for (int i = 0; i < COUNTER_COUNT; ++i) total.counters[i] -= shared.baseline.counters[i];
+            for (int i = 0; i < TIMER_COUNT; ++i) {
+                total.timerNs[i] -= shared.baseline.timerNs[i];
+                total.timerCalls[i] -= shared.baseline.timerCalls[i];
+            }
+            return total;
+        }
+
+        void reset() {
+            Registry& shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.baseline = totals(shared);
+        }
+
+        void writeText(std::ostream& out, const Snapshot& snapshot) {
+            if (!ENABLED) {
+                out << "Statistics are compiled out of this build (HARDCHESS_NO_STATS).\n";
+                return;
+            }
+            out << "Counters:\n";
+            for (int i = 0; i < COUNTER_COUNT; ++i) {
+                out << "  " << std::left << std::setw(20) << counterNames[i] << std::right << snapshot.counters[i] << '\n';
+            }
+            out << "Timers:             calls    total ms     mean us\n";
+            for (int i = 0; i < TIMER_COUNT; ++i) {
+                double totalMs = snapshot.timerNs[i] / 1e6;
+                double meanUs = snapshot.timerCalls[i] ? snapshot.timerNs[i] / 1e3 / snapshot.timerCalls[i] : 0.0;
+                out << "  " << std::left << std::setw(20) << timerNames[i] << std::right << std::setw(8)
+                    << snapshot.timerCalls[i] << std::fixed << std::setprecision(1) << std::setw(12) << totalMs
+                    << std::setw(12) << meanUs << std::defaultfloat << '\n';
+            }
+        }
+
+        void writeJson(std::ostream& out, const Snapshot& snapshot) {
+            out << "{\n  \"enabled\": " << (ENABLED ? "true" : "false") << ",\n  \"counters\": {";
+            for (int i = 0; i < COUNTER_COUNT; ++i) {
+                out << (i ? ", " : "") << '"' << counterNames[i] << "\": " << snapshot.counters[i];
+            }
+            out << "},\n  \"timers\": {\n";
+            for (int i = 0; i < TIMER_COUNT; ++i) {
+                out << "    \"" << timerNames[i] << "\": {\"calls\": " << snapshot.timerCalls[i]
+                    << ", \"total_ns\": " << snapshot.timerNs[i] << "}" << (i + 1 < TIMER_COUNT ? "," : "") << '\n';
+            }
+            out << "  }\n}\n";
+        }
+
+    } // namespace Stats
+} // namespace HardChess
@@ -0,0 +1,64 @@
+#include "HardChess/Util/ThreadPool.h"
+
+namespace HardChess {
+
+    unsigned ThreadPool::defaultThreadCount() {
+        unsigned count = std::thread::hardware_concurrency();
+        return count == 0 ? 1 : count;
+    }
+
+    ThreadPool::ThreadPool(unsigned threads, std::size_t queueCapacity)
+        : capacity(queueCapacity), active(0), stopping(false) {
+        if (threads == 0) threads = defaultThreadCount();
+        if (capacity == 0) capacity = static_cast<std::size_t>(threads) * 4;
+        workers.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        taskAvailable.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    void ThreadPool::submit(std::function<void()> task) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            spaceAvailable.wait(lock, [this] { return tasks.size() < capacity; });
+            tasks.push_back(std::move(task));
+        }
+        taskAvailable.notify_one();
+    }
+
+    void ThreadPool::waitIdle() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return tasks.empty() && active == 0; });
+    }
+
+    void ThreadPool::workerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return; // Stopping and drained
+                task = std::move(tasks.front());
+                tasks.pop_front();
+                ++active;
+            }
+            spaceAvailable.notify_one();
+            task();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --active;
+                if (tasks.empty() && active == 0) idle.notify_all();
+            }
+        }
+    }
+
+} // namespace HardChess
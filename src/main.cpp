@@ -1,64 +1,292 @@
 #include "HardChess/Core/Game.h"
+#include "HardChess/Core/Match.h"
 #include "HardChess/Core/Player.h"
+#include "HardChess/Core/Zobrist.h"
+#include "HardChess/Engine/MateSolver.h"
+#include "HardChess/Engine/OpeningBook.h"
+#include "HardChess/Engine/Tablebase.h"
+#include "HardChess/IO/PgnWriter.h"
+#include "HardChess/Net/MatchServer.h"
+#include "HardChess/Net/Socket.h"
 #include "HardChess/UI/ConsoleUI.h"
+#include "HardChess/Util/EventLog.h"
+#include "HardChess/Util/Stats.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <unistd.h>
 
 using namespace HardChess;
 
-int main() {
+// Usage: HardChess [--book FILE] [--keys FILE] [--tb DIR] [--movetime MS] [--hint-time MS] [--hint-lines N] [--display MODE] [--stats-json FILE] [--pgn FILE] [--event-log FILE] [--mate FEN] [--mate-nodes N] [--mate-memory MB] [--serve ADDR] [--serve-threads N] [--engine-threads N] [--engine-depth N]
+//   --book FILE     Polyglot opening book for the computer player
+//   --tb DIR        Endgame tables generated by tbgen
+//   --keys FILE     Hash key table the book was built with (see Zobrist.h)
+//   --movetime MS   Computer thinking time per move once out of book (default 1000)
+//   --hint-time MS  Search budget of the `hint` command (default 200)
+//   --hint-lines N  Candidate moves the `hint` command suggests, best first (default 3)
+//   --display MODE  Board rendering: plain (default), ansi (redraw changed squares only)
+//                   or quiet (no per-move board, for batch play)
+//   --stats-json FILE  Write engine counters and turn timers as JSON when a match ends
+//   --pgn FILE      Append every finished round to FILE as a PGN game
+//   --event-log FILE  Log moves, captures, promotions, checks and results from a background
+//                   writer thread: JSON lines, or 32-byte binary records for a .bin FILE. Under
+//                   --serve it logs every hosted match and is closed when the server stops
+//   --mate FEN      Look for a forced mate in FEN, print it and exit instead of playing
+//   --mate-nodes N  Node budget of --mate and the `mate` command (default 2000000, 0 = none)
+//   --mate-memory MB  Proof table size of the mate search (default 64)
+//   --serve ADDR    Host matches for network clients instead of playing on the console (see
+//                   MatchServer.h): PORT or HOST:PORT (127.0.0.1 by default) or unix:PATH
+//   --serve-threads N  Event-loop threads of --serve (default 1)
+//   --engine-threads N  Threads computing the computer's moves under --serve (default: all cores)
+//   --engine-depth N  Search depth of computer moves under --serve instead of --movetime
+namespace {
+    int serverStopFd = -1; // MatchServer::stopDescriptor() while serving
+
+    // Only write(2), which is async-signal-safe: the server stops itself from its loop
+    void stopServer(int) {
+        int savedErrno = errno;
+        char byte = 1;
+        if (serverStopFd >= 0 && ::write(serverStopFd, &byte, 1) < 0) {
+            // A full pipe already has a stop pending
+        }
+        errno = savedErrno;
+    }
+
+    void printUsage() {
+        std::cerr << "usage: HardChess [--book FILE] [--keys FILE] [--tb DIR] [--movetime MS] [--hint-time MS] "
+                     "[--hint-lines N] [--display MODE] [--stats-json FILE] [--pgn FILE] [--event-log FILE] [--mate FEN] "
+                     "[--mate-nodes N] [--mate-memory MB] [--serve ADDR] [--serve-threads N] [--engine-threads N] "
+                     "[--engine-depth N]"
+                  << std::endl;
+    }
+
+    // Closes the open event log; returns the line reporting it
+    std::string closeEventLog() {
+        EventLog::Totals logged = EventLog::totals();
+        bool written = EventLog::close();
+        return "Event log: " + std::to_string(logged.recorded) + " events, " + std::to_string(logged.dropped) +
+               " dropped" + (written ? "." : "; writing the file failed.");
+    }
+} // namespace
+
+int main(int argc, char** argv) {
     ConsoleUI ui;
+    OpeningBook book;
+    Tablebase tablebase;
+    int computerMoveTime = 1000;
+    int hintTime = 200;
+    int hintLines = 3;
+    std::string statsJsonPath;
+    PgnWriter pgnOut;
+    std::string mateFEN;
+    MateLimits mateLimits;
+    mateLimits.nodes = 2000000;
+    ServerOptions serverOptions;
+    std::string serveAddress;
+    int engineDepth = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 2;
+        }
+        std::string value = argv[++i];
+        if (arg == "--book") {
+            if (!book.open(value)) {
+                std::cerr << "Cannot open opening book " << value << std::endl;
+                return 2;
+            }
+        } else if (arg == "--keys") {
+            if (!Zobrist::loadKeyTable(value)) {
+                std::cerr << "Cannot load key table " << value << std::endl;
+                return 2;
+            }
+        } else if (arg == "--tb") {
+            if (!tablebase.open(value)) {
+                std::cerr << "No endgame tables in " << value << std::endl;
+                return 2;
+            }
+        } else if (arg == "--movetime") {
+            computerMoveTime = std::atoi(value.c_str());
+        } else if (arg == "--hint-time") {
+            hintTime = std::atoi(value.c_str());
+        } else if (arg == "--hint-lines") {
+            hintLines = std::atoi(value.c_str());
+        } else if (arg == "--display") {
+            RenderMode mode;
+            if (!ConsoleUI::parseRenderMode(value, mode)) {
+                std::cerr << "Unknown display mode " << value << " (use plain, ansi or quiet)" << std::endl;
+                return 2;
+            }
+            ui.setRenderMode(mode);
+        } else if (arg == "--stats-json") {
+            statsJsonPath = value;
+        } else if (arg == "--pgn") {
+            if (!pgnOut.open(value, true)) {
+                std::cerr << "Cannot open " << value << " for writing" << std::endl;
+                return 2;
+            }
+        } else if (arg == "--event-log") {
+            if (!EventLog::open(value, EventLog::formatFor(value))) {
+                std::cerr << "Cannot open " << value << " for writing" << std::endl;
+                return 2;
+            }
+        } else if (arg == "--mate") {
+            mateFEN = value;
+        } else if (arg == "--mate-nodes") {
+            mateLimits.nodes = std::atoll(value.c_str());
+        } else if (arg == "--mate-memory") {
+            mateLimits.memoryMB = static_cast<std::size_t>(std::atoll(value.c_str()));
+        } else if (arg == "--serve") {
+            serveAddress = value;
+        } else if (arg == "--serve-threads") {
+            serverOptions.loops = static_cast<unsigned>(std::max(1, std::atoi(value.c_str())));
+        } else if (arg == "--engine-threads") {
+            serverOptions.engineThreads = static_cast<unsigned>(std::max(0, std::atoi(value.c_str())));
+        } else if (arg == "--engine-depth") {
+            engineDepth = std::atoi(value.c_str());
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (!mateFEN.empty()) {
+        Board board;
+        if (!board.fromFEN(mateFEN)) {
+            std::cerr << "Invalid FEN " << mateFEN << std::endl;
+            return 2;
+        }
+        MateSolver solver;
+        MateResult result = solver.solve(board, mateLimits);
+        std::cout << result.describe(board) << std::endl;
+        std::cout << "nodes=" << result.nodes << " seconds=" << result.seconds << " nodes/sec="
+                  << static_cast<long long>(result.seconds > 0 ? result.nodes / result.seconds : 0)
+                  << " table_entries=" << result.tableEntries << " collections=" << result.collections << std::endl;
+        return result.status == MateStatus::MATE ? 0 : 1;
+    }
+
+    if (!serveAddress.empty()) {
+        serverOptions.address = serveAddress;
+        if (engineDepth > 0) serverOptions.engineLimits.depth = engineDepth;
+        else serverOptions.engineLimits.timeMs = computerMoveTime;
+        if (book.isOpen()) serverOptions.book = &book;
+        if (tablebase.size() > 0) serverOptions.tablebase = &tablebase;
+        long descriptors = Socket::raiseDescriptorLimit();
+        MatchServer server(serverOptions);
+        std::string error;
+        if (!server.listen(error)) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        serverStopFd = server.stopDescriptor();
+        std::signal(SIGINT, stopServer);
+        std::signal(SIGTERM, stopServer);
+        std::cerr << "Serving matches on " << serveAddress << " (up to " << descriptors
+                  << " descriptors); Ctrl-C stops." << std::endl;
+        server.run();
+        std::signal(SIGINT, SIG_DFL);
+        std::signal(SIGTERM, SIG_DFL);
+        serverStopFd = -1;
+        std::cerr << "Server stopped." << std::endl;
+        if (EventLog::isOpen()) std::cerr << closeEventLog() << std::endl;
+        return 0;
+    }
+
+    // Match-level events carry the round's Game id, or 0 for the match result
+    auto logResult = [](EventLog::EventType type, std::uint32_t game, GameResult result, Color winner,
+                        const Player& white, const Player& black) {
+        EventLog::Event event;
+        event.type = type;
+        event.game = game;
+        event.result = static_cast<std::uint8_t>(result);
+        event.color = static_cast<std::uint8_t>(winner);
+        event.values[0] = white.getScore();
+        event.values[1] = black.getScore();
+        EventLog::record(event);
+    };
 
     ui.displayMessage("Welcome to HardChess!");
-    int roundsToWinMatch = 2;
 
     while (true) {
         int menuChoice = ui.displayMainMenu();
         if (menuChoice == 1) {
             // Start Game
-            std::string name1, name2;
+            std::string name1, name2, opponent;
             std::cout << "Enter name for Player 1 (White): ";
             std::cin >> name1;
-            std::cout << "Enter name for Player 2 (Black): ";
-            std::cin >> name2;
+            std::cout << "Play against the computer? (y/n): ";
+            std::cin >> opponent;
+            bool computerOpponent = !opponent.empty() && (opponent[0] == 'y' || opponent[0] == 'Y');
+            if (computerOpponent) {
+                name2 = "HardChess";
+            } else {
+                std::cout << "Enter name for Player 2 (Black): ";
+                std::cin >> name2;
+            }
 
             Player player1(name1, Color::WHITE);
-            Player player2(name2, Color::BLACK);
+            Player player2(name2, Color::BLACK, computerOpponent);
 
             int currentRoundNumber = 1;
-            ui.displayMessage("Win " + std::to_string(roundsToWinMatch) + " rounds to win the match. Each player has 3 hearts.");
+            char pgnDate[16];
+            std::time_t now = std::time(nullptr);
+            std::strftime(pgnDate, sizeof(pgnDate), "%Y.%m.%d", std::localtime(&now));
+            Stats::reset(); // The `stats` command and the JSON dump cover one match
+            bool quit = false; // A player typed exit: wind down and leave the program
+            ui.displayMessage("Win " + std::to_string(Match::ROUNDS_TO_WIN) + " rounds to win the match. Each player has 3 hearts.");
 
-            while (player1.getScore() < roundsToWinMatch && player2.getScore() < roundsToWinMatch &&
-                   player1.getHearts() > 0 && player2.getHearts() > 0) {
+            while (!Match::isMatchOver(player1, player2)) {
                 
                 ui.displayMessage("\n--- Starting Round " + std::to_string(currentRoundNumber) + " ---");
                 ui.displayPlayerStats(player1, player2);
 
                 Game currentRound(&player1, &player2, ui);
+                if (book.isOpen()) currentRound.setOpeningBook(&book);
+                if (tablebase.size() > 0) currentRound.setTablebase(&tablebase);
+                currentRound.setComputerMoveTime(computerMoveTime);
+                currentRound.setHintTime(hintTime);
+                currentRound.setHintLines(hintLines);
+                currentRound.setMateLimits(mateLimits);
+                EventLog::Event roundStart;
+                roundStart.type = EventLog::EventType::ROUND_START;
+                roundStart.game = currentRound.getId();
+                roundStart.values[0] = currentRoundNumber;
+                EventLog::record(roundStart);
                 currentRound.startRound();
 
                 while (!currentRound.isRoundOver()) {
                     currentRound.playTurn();
                 }
+                if (currentRound.getRoundState() == RoundState::ABANDONED) {
+                    quit = true;
+                    break;
+                }
+                if (pgnOut.isOpen()) {
+                    std::string round = std::to_string(currentRoundNumber);
+                    pgnOut.add(currentRound.getHistory(), {{"Event", "HardChess match"}, {"Site", "?"}, {"Date", pgnDate},
+                                                           {"Round", round}, {"White", player1.getName()},
+                                                           {"Black", player2.getName()}});
+                    pgnOut.flush(); // Finished rounds survive quitting in the middle of the next one
+                }
 
                 Player* roundWinner = currentRound.getRoundWinner();
-                Player* roundLoser = nullptr;
-
+                Player* roundLoser = roundWinner == &player1 ? &player2 : &player1;
+                if (roundWinner) Match::scoreRound(*roundWinner, *roundLoser);
+                logResult(EventLog::EventType::ROUND_RESULT, currentRound.getId(), currentRound.getHistory().getResult(),
+                          roundWinner ? roundWinner->getColor() : Color::NONE, player1, player2);
                 if (roundWinner) {
-                    roundWinner->incrementScore();
                     ui.displayRoundResult(roundWinner);
-                    
-                    if (roundWinner == &player1) roundLoser = &player2;
-                    else roundLoser = &player1;
-
-                    roundLoser->loseHeart();
                     ui.displayMessage(roundLoser->getName() + " loses a heart! Hearts remaining: " + std::to_string(roundLoser->getHearts()));
-
                     if (roundLoser->getHearts() == 0) {
                         ui.displayMessage(roundLoser->getName() + " has run out of hearts and loses the match!");
-                        if (roundWinner->getScore() < roundsToWinMatch) {
-                            while (roundWinner->getScore() < roundsToWinMatch) roundWinner->incrementScore();
-                        }
-                        break;
                     }
                 } else {
                     ui.displayRoundResult(nullptr);
@@ -67,22 +295,24 @@ int main() {
                 currentRoundNumber++;
             }
 
-            ui.displayMessage("\n--- Match Finished ---");
+            ui.displayMessage(quit ? "\n--- Match Abandoned ---" : "\n--- Match Finished ---");
+            if (!statsJsonPath.empty()) {
+                std::ofstream statsOut(statsJsonPath);
+                Stats::writeJson(statsOut, Stats::snapshot());
+                if (statsOut) ui.displayMessage("Match statistics written to " + statsJsonPath + ".");
+                else ui.displayMessage("Cannot write match statistics to " + statsJsonPath + ".");
+            }
+            if (quit) {
+                ui.displayMessage("Exiting the game. Goodbye!");
+                break;
+            }
             ui.displayPlayerStats(player1, player2);
 
-            if (player1.getScore() >= roundsToWinMatch) {
-                ui.displayMatchResult(&player1);
-            } else if (player2.getScore() >= roundsToWinMatch) {
-                ui.displayMatchResult(&player2);
-            } else if (player1.getHearts() == 0 && player2.getHearts() > 0) {
-                ui.displayMessage(player1.getName() + " ran out of hearts.");
-                ui.displayMatchResult(&player2);
-            } else if (player2.getHearts() == 0 && player1.getHearts() > 0) {
-                ui.displayMessage(player2.getName() + " ran out of hearts.");
-                ui.displayMatchResult(&player1);
-            } else {
-                ui.displayMessage("The match outcome is undetermined by score or hearts (edge case).");
-            }
+            const Player* matchWinner = Match::matchWinner(player1, player2);
+            if (matchWinner) ui.displayMatchResult(matchWinner);
+            else ui.displayMessage("The match outcome is undetermined by score or hearts (edge case).");
+            logResult(EventLog::EventType::MATCH_RESULT, 0, GameResult::UNKNOWN,
+                      matchWinner ? matchWinner->getColor() : Color::NONE, player1, player2);
         } else if (menuChoice == 2) {
             // Help & Rules
             ui.displayHelpAndRules();
@@ -93,5 +323,6 @@ int main() {
         }
     }
 
+    if (EventLog::isOpen()) ui.displayMessage(closeEventLog());
     return 0;
 }
\ No newline at end of file